@@ -0,0 +1,234 @@
+// pulgacpp benchmark harness - ns/op and cycles/op with JSON output
+// SPDX-License-Identifier: MIT
+//
+// A small self-contained harness for the library-wide benchmarks in this
+// directory. Each benchmark is a callable taking an operation count `n`
+// and performing `n` operations; the harness picks `n` so one sample takes
+// a fixed time, takes several samples and reports the median.
+//
+// Cycles come from the time-stamp counter on x86, which ticks at the
+// nominal clock rate: they match core cycles only when the core runs at
+// that rate (turbo and power saving off). Elsewhere only ns are reported.
+//
+// Command line (shared by every benchmark program):
+//   --filter=TEXT   run only benchmarks whose "group/name" contains TEXT
+//   --min-time=MS   time spent measuring each benchmark (default 200)
+//   --json[=PATH]   write the results as JSON to PATH, or to stdout
+//
+// Usage:
+//   int main(int argc, char **argv) {
+//       bench::Runner runner("safe_int", argc, argv);
+//       runner.run("i32", "checked_add", [](std::uint64_t n) { ... });
+//       return runner.finish();
+//   }
+
+#ifndef PULGACPP_BENCH_HPP
+#define PULGACPP_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define PULGACPP_BENCH_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PULGACPP_BENCH_HAS_TSC 1
+#else
+#define PULGACPP_BENCH_HAS_TSC 0
+#endif
+
+namespace pulgacpp::bench {
+
+/// Keeps `value` alive without letting the compiler see through it: the
+/// value must be materialized before, and reloaded after, this point.
+template <typename T> inline void keep(T &value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    static volatile const void *sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : "+r,m"(value) : : "memory");
+#endif
+}
+
+/// Time-stamp counter ticks, or 0 where there is none.
+[[nodiscard]] inline std::uint64_t cycles() noexcept {
+#if PULGACPP_BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/// One measured benchmark.
+struct Measurement {
+    std::string group;
+    std::string name;
+    std::uint64_t ops_per_sample = 0;
+    double ns_per_op = 0.0;     ///< Median over samples
+    double min_ns_per_op = 0.0; ///< Fastest sample
+    double cycles_per_op = 0.0; ///< Median; 0 without a cycle counter
+};
+
+class Runner {
+public:
+    static constexpr int SAMPLES = 7;
+
+    Runner(std::string_view suite, int argc, char **argv) : m_suite(suite) {
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            if (arg.starts_with("--filter=")) {
+                m_filter = arg.substr(9);
+            } else if (arg.starts_with("--min-time=")) {
+                m_min_time_ms = std::max(1.0, std::atof(argv[i] + 11));
+            } else if (arg == "--json") {
+                m_json = true;
+            } else if (arg.starts_with("--json=")) {
+                m_json = true;
+                m_json_path = arg.substr(7);
+            } else {
+                std::fprintf(stderr,
+                             "usage: %s [--filter=TEXT] [--min-time=MS] [--json[=PATH]]\n",
+                             argv[0]);
+                std::exit(2);
+            }
+        }
+        // With JSON on stdout the table goes to stderr
+        m_table = m_json && m_json_path.empty() ? stderr : stdout;
+        std::fprintf(m_table, "=== %s benchmarks ===\n", m_suite.c_str());
+    }
+
+    /// Measures `body(n)`, which must perform `n` operations.
+    template <typename F> void run(std::string_view group, std::string_view name, F body) {
+        std::string full = std::string(group) + "/" + std::string(name);
+        if (!m_filter.empty() && full.find(m_filter) == std::string::npos) {
+            return;
+        }
+
+        // Grow n until one sample takes its share of the time budget
+        double sample_ns = m_min_time_ms * 1e6 / SAMPLES;
+        std::uint64_t n = 16;
+        while (true) {
+            double ns = time(body, n).first;
+            if (ns >= sample_ns || n >= (std::uint64_t{1} << 40)) {
+                break;
+            }
+            double grow = ns > 0.0 ? 1.2 * sample_ns / ns : 10.0;
+            n = static_cast<std::uint64_t>(double(n) * std::clamp(grow, 2.0, 10.0));
+        }
+
+        std::vector<double> ns(SAMPLES), ticks(SAMPLES);
+        for (int s = 0; s < SAMPLES; ++s) {
+            auto [elapsed, counted] = time(body, n);
+            ns[s] = elapsed / double(n);
+            ticks[s] = counted / double(n);
+        }
+        Measurement m{std::string(group), std::string(name), n, median(ns),
+                      *std::min_element(ns.begin(), ns.end()), median(ticks)};
+        if (PULGACPP_BENCH_HAS_TSC) {
+            std::fprintf(m_table, "%-10s %-36s %9.3f ns/op %9.2f cycles/op\n",
+                         m.group.c_str(), m.name.c_str(), m.ns_per_op, m.cycles_per_op);
+        } else {
+            std::fprintf(m_table, "%-10s %-36s %9.3f ns/op\n", m.group.c_str(), m.name.c_str(),
+                         m.ns_per_op);
+        }
+        m_results.push_back(std::move(m));
+    }
+
+    /// Prints a section heading in the table (not part of the JSON).
+    void section(std::string_view title) {
+        std::fprintf(m_table, "\n--- %.*s ---\n", static_cast<int>(title.size()), title.data());
+    }
+
+    /// Writes the JSON report if requested. Returns the exit code for main.
+    [[nodiscard]] int finish() const {
+        if (!m_json) {
+            return 0;
+        }
+        std::FILE *out = m_json_path.empty() ? stdout : std::fopen(m_json_path.c_str(), "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "cannot write %s\n", m_json_path.c_str());
+            return 1;
+        }
+        std::fprintf(out, "{\n  \"suite\": \"%s\",\n  \"compiler\": \"%s\",\n", m_suite.c_str(),
+                     escaped(compiler()).c_str());
+        std::fprintf(out, "  \"has_cycles\": %s,\n  \"benchmarks\": [",
+                     PULGACPP_BENCH_HAS_TSC ? "true" : "false");
+        for (std::size_t i = 0; i < m_results.size(); ++i) {
+            const Measurement &m = m_results[i];
+            std::fprintf(out,
+                         "%s\n    {\"group\": \"%s\", \"name\": \"%s\", \"ops\": %llu, "
+                         "\"ns_per_op\": %.4f, \"min_ns_per_op\": %.4f, \"cycles_per_op\": %.3f}",
+                         i == 0 ? "" : ",", escaped(m.group).c_str(), escaped(m.name).c_str(),
+                         static_cast<unsigned long long>(m.ops_per_sample), m.ns_per_op,
+                         m.min_ns_per_op, m.cycles_per_op);
+        }
+        std::fprintf(out, "\n  ]\n}\n");
+        if (out != stdout) {
+            std::fclose(out);
+        }
+        return 0;
+    }
+
+    [[nodiscard]] const std::vector<Measurement> &results() const noexcept { return m_results; }
+
+private:
+    /// Nanoseconds and cycle-counter ticks for one call of body(n).
+    template <typename F> static std::pair<double, double> time(F &body, std::uint64_t n) {
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t first = cycles();
+        body(n);
+        std::uint64_t last = cycles();
+        auto stop = std::chrono::steady_clock::now();
+        return {std::chrono::duration<double, std::nano>(stop - start).count(),
+                double(last - first)};
+    }
+
+    static double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    static std::string compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    static std::string escaped(std::string_view text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out;
+    }
+
+    std::string m_suite;
+    std::string m_filter;
+    std::string m_json_path;
+    double m_min_time_ms = 200.0;
+    bool m_json = false;
+    std::FILE *m_table = stdout;
+    std::vector<Measurement> m_results;
+};
+
+} // namespace pulgacpp::bench
+
+#endif // PULGACPP_BENCH_HPP
@@ -0,0 +1,583 @@
+// Benchmark: geometry predicates vs hand-written versions on plain structs
+// Compile: g++ -std=c++23 -O2 -I.. bench_geometry.cpp -o bench_geometry
+//
+// Each benchmark tests pairs from two arrays of random shapes, about half
+// of which overlap, and reports nanoseconds per pair. The baselines are
+// what one would write without the library: squared distances for
+// circles, six comparisons for boxes and orientation signs for segments.
+//
+// The point cloud section compares a loop of Point / Vector3 methods over a
+// std::vector (array of structures) with the PointCloud2 / PointCloud3 batch
+// methods (structure of arrays), in nanoseconds per point.
+//
+// The spatial hash section moves every circle a little each frame and then
+// finds all overlapping pairs, reporting time per frame; the brute-force
+// baseline calls Circle::overlaps on every pair. The AABB tree section does
+// the same with 3D boxes against Box::intersects, and times ray_cast().
+//
+// The ray sections report nanoseconds per ray: Ray against 16 triangles or
+// spheres next to RayPacket doing the same 4 or 8 rays at a time, and
+// StaticBvh casting tiles of neighbouring rays one by one or as packets.
+
+#include "bench.hpp"
+#include "../pulgacpp/geometry/aabbtree.hpp"
+#include "../pulgacpp/geometry/bvh.hpp"
+#include "../pulgacpp/geometry/box.hpp"
+#include "../pulgacpp/geometry/circle.hpp"
+#include "../pulgacpp/geometry/linesegment.hpp"
+#include "../pulgacpp/geometry/pointcloud.hpp"
+#include "../pulgacpp/geometry/ray.hpp"
+#include "../pulgacpp/geometry/spatialhash.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace pulgacpp;
+
+namespace {
+
+constexpr std::size_t COUNT = 1024; // Power of two; fits in L1 with room
+
+struct RawCircle {
+    double x, y, r;
+};
+struct RawBox {
+    double min[3], max[3];
+};
+struct RawSegment {
+    double x1, y1, x2, y2;
+};
+
+bool raw_overlaps(const RawCircle &a, const RawCircle &b) {
+    double dx = a.x - b.x, dy = a.y - b.y, r = a.r + b.r;
+    return dx * dx + dy * dy < r * r;
+}
+
+bool raw_intersects(const RawBox &a, const RawBox &b) {
+    return a.min[0] <= b.max[0] && a.max[0] >= b.min[0] && a.min[1] <= b.max[1] &&
+           a.max[1] >= b.min[1] && a.min[2] <= b.max[2] && a.max[2] >= b.min[2];
+}
+
+double orient(double ax, double ay, double bx, double by, double cx, double cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+bool raw_intersects(const RawSegment &a, const RawSegment &b) {
+    double d1 = orient(a.x1, a.y1, a.x2, a.y2, b.x1, b.y1);
+    double d2 = orient(a.x1, a.y1, a.x2, a.y2, b.x2, b.y2);
+    double d3 = orient(b.x1, b.y1, b.x2, b.y2, a.x1, a.y1);
+    double d4 = orient(b.x1, b.y1, b.x2, b.y2, a.x2, a.y2);
+    return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+}
+
+/// Tests a[i % COUNT] against b[(i * 7 + 3) % COUNT] for i < n.
+template <typename V, typename Test>
+void pairs(bench::Runner &runner, const char *group, const char *name, const std::vector<V> &a,
+           const std::vector<V> &b, Test test) {
+    runner.run(group, name, [&a, &b, test](std::uint64_t n) {
+        std::uint64_t hits = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            hits += test(a[i % COUNT], b[(i * 7 + 3) % COUNT]) ? 1 : 0;
+        }
+        bench::keep(hits);
+    });
+}
+
+/// Runs `batch` (one pass over COUNT points) until at least n points are done.
+template <typename Batch>
+void points(bench::Runner &runner, const char *group, const char *name, Batch batch) {
+    runner.run(group, name, [batch](std::uint64_t n) {
+        for (std::uint64_t done = 0; done < n; done += COUNT) {
+            batch();
+        }
+    });
+}
+
+template <typename T> void point_clouds(bench::Runner &runner, const char *group) {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<T> coord(T(-100), T(100));
+    std::vector<Point<T>> aos2;
+    std::vector<Vector3<T>> aos3;
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        aos2.push_back(Point<T>::from(coord(rng), coord(rng)));
+        aos3.push_back(Vector3<T>::from(coord(rng), coord(rng), coord(rng)));
+    }
+    auto soa2 = PointCloud2<T>::from(aos2);
+    auto soa3 = PointCloud3<T>::from(aos3);
+    const auto p = Point<T>::from(T(3), T(4));
+    const auto v = Vector3<T>::from(T(1), T(2), T(3));
+    std::vector<T> out(COUNT);
+
+    points(runner, group, "Point::distance_to loop", [&] {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            out[i] = static_cast<T>(aos2[i].distance_to(p));
+        }
+        bench::keep(out);
+    });
+    points(runner, group, "PointCloud2::distances_to", [&] {
+        soa2.distances_to(p, out);
+        bench::keep(out);
+    });
+    points(runner, group, "Point::rotate loop", [&] {
+        std::vector<Point<T>> turned(COUNT);
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            auto r = aos2[i].rotate(0.5);
+            turned[i] = Point<T>::from(static_cast<T>(r.x()), static_cast<T>(r.y()));
+        }
+        bench::keep(turned);
+    });
+    points(runner, group, "PointCloud2::rotate", [&] {
+        auto turned = soa2.rotate(0.5);
+        bench::keep(turned);
+    });
+    points(runner, group, "Vector3::dot loop", [&] {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            out[i] = static_cast<T>(aos3[i].dot(v));
+        }
+        bench::keep(out);
+    });
+    points(runner, group, "PointCloud3::dot", [&] {
+        soa3.dot(v, out);
+        bench::keep(out);
+    });
+    points(runner, group, "vec3_normalized loop", [&] {
+        std::vector<Vector3<T>> units(COUNT);
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            auto u = vec3_normalized(aos3[i]).unwrap();
+            units[i] = Vector3<T>::from(static_cast<T>(u.x()), static_cast<T>(u.y()),
+                                        static_cast<T>(u.z()));
+        }
+        bench::keep(units);
+    });
+    points(runner, group, "PointCloud3::normalized", [&] {
+        auto units = soa3.normalized().unwrap();
+        bench::keep(units);
+    });
+}
+
+/// `count` circles of radius 1-4 in a square sized for about one overlap
+/// per circle, with a velocity each.
+struct Swarm {
+    std::vector<CircleD> circles;
+    std::vector<std::pair<double, double>> velocity;
+    double side;
+
+    explicit Swarm(std::size_t count) : side(std::sqrt(double(count)) * 12.0) {
+        std::mt19937_64 rng(11);
+        std::uniform_real_distribution<double> coord(0.0, side);
+        std::uniform_real_distribution<double> radius(1.0, 4.0);
+        std::uniform_real_distribution<double> speed(-1.0, 1.0);
+        for (std::size_t i = 0; i < count; ++i) {
+            circles.push_back(CircleD::from(PointD::from(coord(rng), coord(rng)), radius(rng)).unwrap());
+            velocity.emplace_back(speed(rng), speed(rng));
+        }
+    }
+
+    /// Moves circle i one step, bouncing off the walls.
+    CircleD step(std::size_t i) {
+        auto c = circles[i].center();
+        auto &[vx, vy] = velocity[i];
+        double x = c.x() + vx, y = c.y() + vy;
+        if (x < 0.0 || x > side) vx = -vx;
+        if (y < 0.0 || y > side) vy = -vy;
+        circles[i] = circles[i].with_center(PointD::from(x, y));
+        return circles[i];
+    }
+};
+
+void spatial_hash(bench::Runner &runner, std::size_t count, const char *grid_name,
+                  const char *brute_name) {
+    {
+        Swarm swarm(count);
+        auto grid = SpatialHashGrid<CircleD>::from(8.0).unwrap();
+        std::vector<SpatialHashGrid<CircleD>::Id> ids;
+        for (const auto &c : swarm.circles) {
+            ids.push_back(grid.insert(c));
+        }
+        runner.run("spatial-hash", grid_name, [&](std::uint64_t n) {
+            std::uint64_t pairs = 0;
+            for (std::uint64_t frame = 0; frame < n; ++frame) {
+                for (std::size_t i = 0; i < ids.size(); ++i) {
+                    grid.update(ids[i], swarm.step(i));
+                }
+                grid.for_each_overlapping_pair([&pairs](auto, auto) { ++pairs; });
+            }
+            bench::keep(pairs);
+        });
+    }
+    if (brute_name != nullptr) {
+        Swarm swarm(count);
+        runner.run("spatial-hash", brute_name, [&](std::uint64_t n) {
+            std::uint64_t pairs = 0;
+            for (std::uint64_t frame = 0; frame < n; ++frame) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    (void)swarm.step(i);
+                }
+                for (std::size_t i = 0; i < count; ++i) {
+                    for (std::size_t j = i + 1; j < count; ++j) {
+                        pairs += swarm.circles[i].overlaps(swarm.circles[j]) ? 1 : 0;
+                    }
+                }
+            }
+            bench::keep(pairs);
+        });
+    }
+}
+
+/// `count` cubes of side 1-4 in a cube sized for about one overlap per
+/// box, with a velocity each.
+struct BoxSwarm {
+    std::vector<AABB> boxes;
+    std::vector<Vec3d> velocity;
+    double side;
+
+    explicit BoxSwarm(std::size_t count) : side(std::cbrt(double(count)) * 8.0) {
+        std::mt19937_64 rng(12);
+        std::uniform_real_distribution<double> coord(0.0, side);
+        std::uniform_real_distribution<double> size(1.0, 4.0);
+        std::uniform_real_distribution<double> speed(-0.3, 0.3);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto corner = Vec3d::from(coord(rng), coord(rng), coord(rng));
+            boxes.push_back(AABB::cube(corner, size(rng) / 2).unwrap());
+            velocity.push_back(Vec3d::from(speed(rng), speed(rng), speed(rng)));
+        }
+    }
+
+    /// Moves box i one step, bouncing off the walls.
+    AABB step(std::size_t i) {
+        auto c = boxes[i].center();
+        auto v = velocity[i];
+        double x = c.x() + v.x(), y = c.y() + v.y(), z = c.z() + v.z();
+        velocity[i] = Vec3d::from(x < 0.0 || x > side ? -v.x() : v.x(),
+                                  y < 0.0 || y > side ? -v.y() : v.y(),
+                                  z < 0.0 || z > side ? -v.z() : v.z());
+        boxes[i] = AABB::cube(Vec3d::from(x, y, z), boxes[i].width() / 2).unwrap();
+        return boxes[i];
+    }
+};
+
+void aabb_tree(bench::Runner &runner, std::size_t count, const char *tree_name,
+               const char *brute_name) {
+    {
+        BoxSwarm swarm(count);
+        auto tree = DynamicAabbTree::from(0.5).unwrap();
+        std::vector<DynamicAabbTree::Id> ids;
+        for (const auto &b : swarm.boxes) {
+            ids.push_back(tree.insert(b));
+        }
+        runner.run("aabb-tree", tree_name, [&](std::uint64_t n) {
+            std::uint64_t pairs = 0;
+            for (std::uint64_t frame = 0; frame < n; ++frame) {
+                for (std::size_t i = 0; i < ids.size(); ++i) {
+                    auto v = swarm.velocity[i];
+                    // Fat boxes reach two frames ahead
+                    tree.update(ids[i], swarm.step(i), Vec3d::from(2 * v.x(), 2 * v.y(), 2 * v.z()));
+                }
+                tree.for_each_overlapping_pair([&pairs](auto, auto) { ++pairs; });
+            }
+            bench::keep(pairs);
+        });
+    }
+    if (brute_name != nullptr) {
+        BoxSwarm swarm(count);
+        runner.run("aabb-tree", brute_name, [&](std::uint64_t n) {
+            std::uint64_t pairs = 0;
+            for (std::uint64_t frame = 0; frame < n; ++frame) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    (void)swarm.step(i);
+                }
+                for (std::size_t i = 0; i < count; ++i) {
+                    for (std::size_t j = i + 1; j < count; ++j) {
+                        pairs += swarm.boxes[i].intersects(swarm.boxes[j]) ? 1 : 0;
+                    }
+                }
+            }
+            bench::keep(pairs);
+        });
+    }
+}
+
+/// Rays from below the swarm, roughly along +z, for ray_cast benchmarks.
+std::vector<std::pair<Vec3d, Vec3d>> swarm_rays(const BoxSwarm &swarm) {
+    std::mt19937_64 rng(13);
+    std::uniform_real_distribution<double> coord(0.0, swarm.side);
+    std::uniform_real_distribution<double> tilt(-0.5, 0.5);
+    std::vector<std::pair<Vec3d, Vec3d>> rays;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        rays.emplace_back(Vec3d::from(coord(rng), coord(rng), -1.0),
+                          Vec3d::from(tilt(rng), tilt(rng), 1.0));
+    }
+    return rays;
+}
+
+template <typename Tree>
+void ray_casts(bench::Runner &runner, const char *group, const char *name, const Tree &tree,
+               const std::vector<std::pair<Vec3d, Vec3d>> &rays) {
+    runner.run(group, name, [&](std::uint64_t n) {
+        double sum = 0.0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            auto [origin, direction] = rays[i % rays.size()];
+            sum += tree.ray_cast(origin, direction, 1e9).map([](auto hit) { return hit.t; }).unwrap_or(0.0);
+        }
+        bench::keep(sum);
+    });
+}
+
+void aabb_tree_rays(bench::Runner &runner, std::size_t count, const char *name) {
+    BoxSwarm swarm(count);
+    auto tree = DynamicAabbTree::from(0.0).unwrap();
+    for (const auto &b : swarm.boxes) {
+        (void)tree.insert(b);
+    }
+    ray_casts(runner, "aabb-tree", name, tree, swarm_rays(swarm));
+}
+
+/// Random rays through a 10-unit cube, against 16 triangles and 16 spheres
+/// in it: Ray one ray at a time, then RayPacket 4 and 8 rays at a time.
+template <typename T> void ray_kernels(bench::Runner &runner, const char *group) {
+    std::mt19937_64 rng(14);
+    std::uniform_real_distribution<T> coord(T(0), T(10));
+    std::uniform_real_distribution<T> unit(T(-1), T(1));
+    std::vector<Ray<T>> rays;
+    while (rays.size() < COUNT) {
+        auto origin = Vector3<T>::from(coord(rng), coord(rng), T(-1));
+        auto direction = Vector3<T>::from(unit(rng) / 4, unit(rng) / 4, T(1));
+        rays.push_back(Ray<T>::from(origin, direction).unwrap());
+    }
+    std::vector<std::array<Vector3<T>, 3>> triangles;
+    std::vector<Sphere<T>> spheres;
+    for (std::size_t i = 0; i < 16; ++i) {
+        auto p = [&] { return Vector3<T>::from(coord(rng), coord(rng), coord(rng)); };
+        triangles.push_back({p(), p(), p()});
+        spheres.push_back(Sphere<T>::from(p(), T(1)).unwrap());
+    }
+    const T max_t = T(100);
+
+    runner.run(group, "triangles, Ray", [&](std::uint64_t n) {
+        T sum = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const Ray<T> &ray = rays[i % COUNT];
+            T t = max_t;
+            for (const auto &[a, b, c] : triangles) {
+                t = ray.intersect_triangle(a, b, c, t).map([](auto hit) { return hit.t; }).unwrap_or(t);
+            }
+            sum += t;
+        }
+        bench::keep(sum);
+    });
+    runner.run(group, "spheres, Ray", [&](std::uint64_t n) {
+        T sum = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const Ray<T> &ray = rays[i % COUNT];
+            T t = max_t;
+            for (const auto &sphere : spheres) {
+                t = ray.intersect(sphere, t).unwrap_or(t);
+            }
+            sum += t;
+        }
+        bench::keep(sum);
+    });
+    auto packets = [&]<std::size_t N>(const char *triangle_name, const char *sphere_name) {
+        std::vector<RayPacket<T, N>> all;
+        for (std::size_t i = 0; i < COUNT; i += N) {
+            all.push_back(RayPacket<T, N>::from(std::span<const Ray<T>, N>(rays.data() + i, N)));
+        }
+        runner.run(group, triangle_name, [&](std::uint64_t n) {
+            T sum = 0;
+            for (std::uint64_t i = 0; i < n; i += N) {
+                std::array<T, N> t;
+                t.fill(max_t);
+                for (const auto &[a, b, c] : triangles) {
+                    (void)all[i / N % all.size()].intersect_triangle(a, b, c, t);
+                }
+                sum += t[0];
+            }
+            bench::keep(sum);
+        });
+        runner.run(group, sphere_name, [&](std::uint64_t n) {
+            T sum = 0;
+            for (std::uint64_t i = 0; i < n; i += N) {
+                std::array<T, N> t;
+                t.fill(max_t);
+                for (const auto &sphere : spheres) {
+                    (void)all[i / N % all.size()].intersect(sphere, t);
+                }
+                sum += t[0];
+            }
+            bench::keep(sum);
+        });
+    };
+    packets.template operator()<4>("triangles, RayPacket<4>", "spheres, RayPacket<4>");
+    packets.template operator()<8>("triangles, RayPacket<8>", "spheres, RayPacket<8>");
+}
+
+/// Rays in tiles of 8 like pixels of a camera: each tile starts from one
+/// point below the swarm and fans out slightly, so packets stay coherent.
+std::vector<Rayd> swarm_tiles(const BoxSwarm &swarm) {
+    std::mt19937_64 rng(15);
+    std::uniform_real_distribution<double> coord(0.0, swarm.side);
+    std::uniform_real_distribution<double> tilt(-0.5, 0.5);
+    std::vector<Rayd> rays;
+    while (rays.size() < 1024) {
+        auto origin = Vec3d::from(coord(rng), coord(rng), -1.0);
+        double dx = tilt(rng), dy = tilt(rng);
+        for (int k = 0; k < 8; ++k) {
+            auto direction = Vec3d::from(dx + (k % 4) * 0.002, dy + (k / 4) * 0.002, 1.0);
+            rays.push_back(Rayd::from(origin, direction).unwrap());
+        }
+    }
+    return rays;
+}
+
+template <std::size_t N, std::size_t Width>
+void packet_casts(bench::Runner &runner, const char *name, const StaticBvh<Width> &bvh,
+                  const std::vector<Rayd> &rays) {
+    std::vector<RayPacket<double, N>> packets;
+    for (std::size_t i = 0; i < rays.size(); i += N) {
+        packets.push_back(RayPacket<double, N>::from(std::span<const Rayd, N>(rays.data() + i, N)));
+    }
+    std::array<double, N> max_t;
+    max_t.fill(1e9);
+    runner.run("static-bvh", name, [&](std::uint64_t n) {
+        double sum = 0.0;
+        for (std::uint64_t i = 0; i < n; i += N) {
+            auto hits = bvh.ray_cast(packets[i / N % packets.size()], max_t);
+            for (const auto &hit : hits) {
+                sum += hit.map([](auto h) { return h.t; }).unwrap_or(0.0);
+            }
+        }
+        bench::keep(sum);
+    });
+}
+
+template <std::size_t Width>
+void static_bvh_build(bench::Runner &runner, const std::vector<AABB> &boxes, unsigned threads,
+                      const char *name) {
+    runner.run("static-bvh", name, [&](std::uint64_t n) {
+        std::size_t nodes = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            nodes += StaticBvh<Width>::from(std::span<const AABB>(boxes), {.threads = threads}).node_count();
+        }
+        bench::keep(nodes);
+    });
+}
+
+void static_bvh(bench::Runner &runner, std::size_t count) {
+    BoxSwarm swarm(count);
+    static_bvh_build<2>(runner, swarm.boxes, 1, "build Bvh2, 1 thread");
+    static_bvh_build<4>(runner, swarm.boxes, 1, "build Bvh4, 1 thread");
+    static_bvh_build<4>(runner, swarm.boxes, 0, "build Bvh4, all threads");
+
+    auto rays = swarm_rays(swarm);
+    const std::span<const AABB> boxes(swarm.boxes);
+    ray_casts(runner, "static-bvh", "ray_cast Bvh2", Bvh2::from(boxes), rays);
+    ray_casts(runner, "static-bvh", "ray_cast Bvh4", Bvh4::from(boxes), rays);
+    ray_casts(runner, "static-bvh", "ray_cast Bvh8", Bvh8::from(boxes), rays);
+
+    auto tiles = swarm_tiles(swarm);
+    std::vector<std::pair<Vec3d, Vec3d>> tile_rays;
+    for (const auto &ray : tiles) {
+        tile_rays.emplace_back(ray.origin(), ray.direction());
+    }
+    auto bvh4 = Bvh4::from(boxes);
+    ray_casts(runner, "static-bvh", "tiles, single Bvh4", bvh4, tile_rays);
+    packet_casts<4>(runner, "tiles, packets of 4 Bvh4", bvh4, tiles);
+    packet_casts<8>(runner, "tiles, packets of 8 Bvh4", bvh4, tiles);
+    packet_casts<8>(runner, "tiles, packets of 8 Bvh2", Bvh2::from(boxes), tiles);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bench::Runner runner("geometry", argc, argv);
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> coord(0.0, 100.0);
+    std::uniform_real_distribution<double> size(1.0, 20.0);
+
+    std::vector<CircleD> circles;
+    std::vector<RawCircle> raw_circles;
+    std::vector<AABB> boxes;
+    std::vector<RawBox> raw_boxes;
+    std::vector<Line2d> segments;
+    std::vector<RawSegment> raw_segments;
+    for (std::size_t i = 0; i < 2 * COUNT; ++i) {
+        double x = coord(rng), y = coord(rng), z = coord(rng), r = size(rng);
+        circles.push_back(CircleD::from(PointD::from(x, y), r).unwrap());
+        raw_circles.push_back({x, y, r});
+
+        double w = size(rng), h = size(rng), d = size(rng);
+        boxes.push_back(AABB::from_points(Vec3d::from(x, y, z), Vec3d::from(x + w, y + h, z + d)));
+        raw_boxes.push_back({{x, y, z}, {x + w, y + h, z + d}});
+
+        double x2 = coord(rng), y2 = coord(rng);
+        segments.push_back(Line2d::from(PointD::from(x, y), PointD::from(x2, y2)));
+        raw_segments.push_back({x, y, x2, y2});
+    }
+    auto halves = [](const auto &all) {
+        using V = typename std::decay_t<decltype(all)>::value_type;
+        return std::pair(std::vector<V>(all.begin(), all.begin() + COUNT),
+                         std::vector<V>(all.begin() + COUNT, all.end()));
+    };
+
+    runner.section("Circle::overlaps");
+    {
+        auto [a, b] = halves(circles);
+        auto [ra, rb] = halves(raw_circles);
+        pairs(runner, "circle", "CircleD::overlaps", a, b,
+              [](const CircleD &p, const CircleD &q) { return p.overlaps(q); });
+        pairs(runner, "circle", "raw squared distance", ra, rb,
+              [](const RawCircle &p, const RawCircle &q) { return raw_overlaps(p, q); });
+    }
+
+    runner.section("Box::intersects");
+    {
+        auto [a, b] = halves(boxes);
+        auto [ra, rb] = halves(raw_boxes);
+        pairs(runner, "box", "AABB::intersects", a, b,
+              [](const AABB &p, const AABB &q) { return p.intersects(q); });
+        pairs(runner, "box", "raw six comparisons", ra, rb,
+              [](const RawBox &p, const RawBox &q) { return raw_intersects(p, q); });
+    }
+
+    runner.section("LineSegment intersection");
+    {
+        auto [a, b] = halves(segments);
+        auto [ra, rb] = halves(raw_segments);
+        pairs(runner, "segment", "Line2d::intersects", a, b,
+              [](const Line2d &p, const Line2d &q) { return p.intersects(q); });
+        pairs(runner, "segment", "Line2d::intersection", a, b, [](const Line2d &p, const Line2d &q) {
+            return p.intersection(q).is_some();
+        });
+        pairs(runner, "segment", "raw orientation signs", ra, rb,
+              [](const RawSegment &p, const RawSegment &q) { return raw_intersects(p, q); });
+    }
+
+    runner.section("Point clouds: AoS loop vs SoA batch (ns per point)");
+    point_clouds<float>(runner, "cloud-f32");
+    point_clouds<double>(runner, "cloud-f64");
+
+    runner.section("SpatialHashGrid: move every circle, then all overlapping pairs (ns per frame)");
+    spatial_hash(runner, 2000, "grid, 2k circles", "brute force, 2k circles");
+    spatial_hash(runner, 100000, "grid, 100k circles", nullptr);
+
+    runner.section("DynamicAabbTree: move every box, then all intersecting pairs (ns per frame)");
+    aabb_tree(runner, 2000, "tree, 2k boxes", "brute force, 2k boxes");
+    aabb_tree(runner, 100000, "tree, 100k boxes", nullptr);
+
+    runner.section("DynamicAabbTree::ray_cast (ns per ray)");
+    aabb_tree_rays(runner, 100000, "first hit, 100k boxes");
+
+    runner.section("Ray vs RayPacket: 16 triangles or spheres (ns per ray)");
+    ray_kernels<float>(runner, "ray-f32");
+    ray_kernels<double>(runner, "ray-f64");
+
+    runner.section("StaticBvh over 100k boxes: build (ns per build), ray_cast (ns per ray)");
+    static_bvh(runner, 100000);
+
+    return runner.finish();
+}
@@ -0,0 +1,188 @@
+// Benchmark: cost of propagating failure through Optional and Result
+// Compile: g++ -std=c++23 -O2 -I.. bench_propagation.cpp -o bench_propagation
+//
+// The same three-level call chain is written five ways: plain ints with no
+// error handling, a bool error code with an out-parameter, std::optional,
+// pulgacpp::Optional and pulgacpp::Result. Every level is a non-inlined
+// function that does one checked add and passes failure up, so the figures
+// include the cost of returning each wrapper through the ABI. "ok" calls
+// always succeed; "err" calls fail at the innermost level.
+
+#include "bench.hpp"
+#include "../pulgacpp/i32/i32.hpp"
+#include "../pulgacpp/result/result.hpp"
+#include <cstdint>
+#include <optional>
+
+using namespace pulgacpp;
+
+namespace {
+
+enum class Error : std::uint8_t { Overflow };
+
+// --- Plain ints: the floor ---
+[[gnu::noinline]] int raw_inner(int x) { return x + 1; }
+[[gnu::noinline]] int raw_middle(int x) { return raw_inner(x) + 2; }
+[[gnu::noinline]] int raw_outer(int x) { return raw_middle(x) + 3; }
+
+// --- Error code ---
+[[gnu::noinline]] bool code_inner(i32 x, i32 &out) {
+    auto r = x.checked_add(i32(1));
+    if (r.is_none()) {
+        return false;
+    }
+    out = r.unwrap();
+    return true;
+}
+[[gnu::noinline]] bool code_middle(i32 x, i32 &out) {
+    i32 inner;
+    if (!code_inner(x, inner)) {
+        return false;
+    }
+    auto r = inner.checked_add(i32(2));
+    if (r.is_none()) {
+        return false;
+    }
+    out = r.unwrap();
+    return true;
+}
+[[gnu::noinline]] bool code_outer(i32 x, i32 &out) {
+    i32 middle;
+    if (!code_middle(x, middle)) {
+        return false;
+    }
+    auto r = middle.checked_add(i32(3));
+    if (r.is_none()) {
+        return false;
+    }
+    out = r.unwrap();
+    return true;
+}
+
+// --- std::optional ---
+[[gnu::noinline]] std::optional<i32> std_inner(i32 x) {
+    auto r = x.checked_add(i32(1));
+    if (r.is_none()) {
+        return std::nullopt;
+    }
+    return r.unwrap();
+}
+[[gnu::noinline]] std::optional<i32> std_middle(i32 x) {
+    auto inner = std_inner(x);
+    if (!inner) {
+        return std::nullopt;
+    }
+    auto r = inner->checked_add(i32(2));
+    if (r.is_none()) {
+        return std::nullopt;
+    }
+    return r.unwrap();
+}
+[[gnu::noinline]] std::optional<i32> std_outer(i32 x) {
+    auto middle = std_middle(x);
+    if (!middle) {
+        return std::nullopt;
+    }
+    auto r = middle->checked_add(i32(3));
+    if (r.is_none()) {
+        return std::nullopt;
+    }
+    return r.unwrap();
+}
+
+// --- Optional ---
+[[gnu::noinline]] Optional<i32> opt_inner(i32 x) { return x.checked_add(i32(1)); }
+[[gnu::noinline]] Optional<i32> opt_middle(i32 x) {
+    auto inner = opt_inner(x);
+    if (inner.is_none()) {
+        return None;
+    }
+    return inner.unwrap().checked_add(i32(2));
+}
+[[gnu::noinline]] Optional<i32> opt_outer(i32 x) {
+    auto middle = opt_middle(x);
+    if (middle.is_none()) {
+        return None;
+    }
+    return middle.unwrap().checked_add(i32(3));
+}
+
+// --- Result ---
+[[gnu::noinline]] Result<i32, Error> res_inner(i32 x) {
+    auto r = x.checked_add(i32(1));
+    if (r.is_none()) {
+        return Err(Error::Overflow);
+    }
+    return Ok(r.unwrap());
+}
+[[gnu::noinline]] Result<i32, Error> res_middle(i32 x) {
+    auto inner = res_inner(x);
+    if (inner.is_err()) {
+        return Err(inner.unwrap_err());
+    }
+    auto r = inner.unwrap().checked_add(i32(2));
+    if (r.is_none()) {
+        return Err(Error::Overflow);
+    }
+    return Ok(r.unwrap());
+}
+[[gnu::noinline]] Result<i32, Error> res_outer(i32 x) {
+    auto middle = res_middle(x);
+    if (middle.is_err()) {
+        return Err(middle.unwrap_err());
+    }
+    auto r = middle.unwrap().checked_add(i32(3));
+    if (r.is_none()) {
+        return Err(Error::Overflow);
+    }
+    return Ok(r.unwrap());
+}
+
+/// Calls `call(input)` n times, summing the results (-1 for a failure).
+template <typename Call>
+void calls(bench::Runner &runner, const char *group, const char *name, i32 input, Call call) {
+    runner.run(group, name, [=](std::uint64_t n) {
+        i32 x = input;
+        std::int64_t sum = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            bench::keep(x);
+            sum += call(x);
+        }
+        bench::keep(sum);
+    });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bench::Runner runner("propagation", argc, argv);
+    const i32 ok(1000);
+    const i32 err(i32::MAX);
+
+    runner.section("3 levels, success");
+    calls(runner, "ok", "raw int", ok, [](i32 x) { return raw_outer(x.get()); });
+    calls(runner, "ok", "error code", ok, [](i32 x) {
+        i32 out;
+        return code_outer(x, out) ? out.get() : -1;
+    });
+    calls(runner, "ok", "std::optional", ok, [](i32 x) {
+        auto r = std_outer(x);
+        return r ? r->get() : -1;
+    });
+    calls(runner, "ok", "Optional", ok, [](i32 x) { return opt_outer(x).unwrap_or(i32(-1)).get(); });
+    calls(runner, "ok", "Result", ok, [](i32 x) { return res_outer(x).unwrap_or(i32(-1)).get(); });
+
+    runner.section("3 levels, innermost fails");
+    calls(runner, "err", "error code", err, [](i32 x) {
+        i32 out;
+        return code_outer(x, out) ? out.get() : -1;
+    });
+    calls(runner, "err", "std::optional", err, [](i32 x) {
+        auto r = std_outer(x);
+        return r ? r->get() : -1;
+    });
+    calls(runner, "err", "Optional", err, [](i32 x) { return opt_outer(x).unwrap_or(i32(-1)).get(); });
+    calls(runner, "err", "Result", err, [](i32 x) { return res_outer(x).unwrap_or(i32(-1)).get(); });
+
+    return runner.finish();
+}
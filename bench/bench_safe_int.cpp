@@ -0,0 +1,83 @@
+// Benchmark: SafeInt checked/saturating/wrapping arithmetic vs raw integers
+// Compile: g++ -std=c++23 -O2 -I.. bench_safe_int.cpp -o bench_safe_int
+//
+// Every loop is a dependent chain `acc = acc op step` with `step` hidden
+// from the optimizer, so each operation waits for the previous one and the
+// figures are latencies. `step` is 0 for add and 1 for mul: the results
+// never overflow, so this measures what checking costs on the path taken
+// almost always, not the rare overflow branch.
+
+#include "bench.hpp"
+#include "../pulgacpp/i16/i16.hpp"
+#include "../pulgacpp/i32/i32.hpp"
+#include "../pulgacpp/i64/i64.hpp"
+#include "../pulgacpp/i8/i8.hpp"
+#include "../pulgacpp/u16/u16.hpp"
+#include "../pulgacpp/u32/u32.hpp"
+#include "../pulgacpp/u64/u64.hpp"
+#include "../pulgacpp/u8/u8.hpp"
+#if PULGACPP_HAS_INT128
+#include "../pulgacpp/i128/i128.hpp"
+#include "../pulgacpp/u128/u128.hpp"
+#endif
+#include <cstdint>
+
+using namespace pulgacpp;
+
+namespace {
+
+/// Runs `acc = op(acc, step)` as a dependent chain of `n` operations.
+template <typename V, typename Op>
+void chain(bench::Runner &runner, const char *group, const char *name, V start, V step, Op op) {
+    runner.run(group, name, [=](std::uint64_t n) {
+        V acc = start;
+        V s = step;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            bench::keep(s);
+            acc = op(acc, s);
+        }
+        bench::keep(acc);
+    });
+}
+
+template <typename S> void bench_type(bench::Runner &runner, const char *group) {
+    using T = typename S::underlying_type;
+    runner.section(group);
+
+    chain(runner, group, "raw add", T(1), T(0), [](T a, T b) { return static_cast<T>(a + b); });
+    chain(runner, group, "wrapping_add", S(T(1)), S(T(0)),
+          [](S a, S b) { return a.wrapping_add(b); });
+    chain(runner, group, "checked_add", S(T(1)), S(T(0)),
+          [](S a, S b) { return a.checked_add(b).unwrap_or(S()); });
+    chain(runner, group, "saturating_add", S(T(1)), S(T(0)),
+          [](S a, S b) { return a.saturating_add(b); });
+
+    chain(runner, group, "raw mul", T(3), T(1), [](T a, T b) { return static_cast<T>(a * b); });
+    chain(runner, group, "wrapping_mul", S(T(3)), S(T(1)),
+          [](S a, S b) { return a.wrapping_mul(b); });
+    chain(runner, group, "checked_mul", S(T(3)), S(T(1)),
+          [](S a, S b) { return a.checked_mul(b).unwrap_or(S()); });
+    chain(runner, group, "saturating_mul", S(T(3)), S(T(1)),
+          [](S a, S b) { return a.saturating_mul(b); });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bench::Runner runner("safe_int", argc, argv);
+
+    bench_type<i8>(runner, "i8");
+    bench_type<i16>(runner, "i16");
+    bench_type<i32>(runner, "i32");
+    bench_type<i64>(runner, "i64");
+    bench_type<u8>(runner, "u8");
+    bench_type<u16>(runner, "u16");
+    bench_type<u32>(runner, "u32");
+    bench_type<u64>(runner, "u64");
+#if PULGACPP_HAS_INT128
+    bench_type<i128>(runner, "i128");
+    bench_type<u128>(runner, "u128");
+#endif
+
+    return runner.finish();
+}
@@ -0,0 +1,130 @@
+# Checks the assembly of codegen/kernels.cpp against its `// CHECK` lines.
+#
+#   cmake -DSOURCE=codegen/kernels.cpp -DASM=kernels.s -P check_codegen.cmake
+#
+# Expects GNU-style x86-64 assembly (GCC or Clang, ELF). Fails with one
+# message per violated rule and prints the offending function.
+
+cmake_minimum_required(VERSION 3.21)
+
+if(NOT SOURCE OR NOT ASM)
+  message(FATAL_ERROR "usage: cmake -DSOURCE=<kernels.cpp> -DASM=<kernels.s> -P check_codegen.cmake")
+endif()
+
+file(STRINGS "${SOURCE}" check_lines REGEX "^// CHECK [A-Za-z0-9_]+:")
+file(STRINGS "${ASM}" asm_lines)
+
+# Instructions of `function`, one per list element, with local labels
+# replaced by `.L` so two functions can be compared.
+function(function_body function out_var)
+  set(body)
+  set(inside FALSE)
+  foreach(line IN LISTS asm_lines)
+    if(line STREQUAL "${function}:")
+      set(inside TRUE)
+    elseif(inside)
+      if(line MATCHES "^[ \t]*\\.size[ \t]+${function},")
+        break()
+      endif()
+      # Skip directives and labels; keep instructions
+      if(line MATCHES "^[ \t]+[a-z]" AND NOT line MATCHES "^[ \t]*\\.")
+        string(STRIP "${line}" line)
+        string(REGEX REPLACE "[ \t]+" " " line "${line}")
+        string(REGEX REPLACE "\\.L[A-Za-z0-9_$]+" ".L" line "${line}")
+        list(APPEND body "${line}")
+      endif()
+    endif()
+  endforeach()
+  set(${out_var} "${body}" PARENT_SCOPE)
+endfunction()
+
+set(failures 0)
+set(checked 0)
+foreach(check IN LISTS check_lines)
+  string(REGEX MATCH "^// CHECK ([A-Za-z0-9_]+): *(.*)$" _ "${check}")
+  set(function "${CMAKE_MATCH_1}")
+  string(REPLACE " " ";" rules "${CMAKE_MATCH_2}")
+
+  function_body(${function} body)
+  list(LENGTH body instructions)
+  if(instructions EQUAL 0)
+    message(SEND_ERROR "${function}: not found in ${ASM}")
+    math(EXPR failures "${failures} + 1")
+    continue()
+  endif()
+
+  set(branches 0)
+  set(errors)
+  foreach(instruction IN LISTS body)
+    if(instruction MATCHES "^j[a-z]+ " AND NOT instruction MATCHES "^jmp ")
+      math(EXPR branches "${branches} + 1")
+    endif()
+  endforeach()
+
+  foreach(rule IN LISTS rules)
+    if(rule STREQUAL "no-calls")
+      foreach(instruction IN LISTS body)
+        if(instruction MATCHES "^call" OR
+           (instruction MATCHES "^jmp" AND NOT instruction MATCHES "^jmp \\.L$"))
+          list(APPEND errors "calls out: '${instruction}'")
+        endif()
+      endforeach()
+    elseif(rule STREQUAL "no-panic")
+      foreach(instruction IN LISTS body)
+        if(instruction MATCHES "panic|abort")
+          list(APPEND errors "can panic: '${instruction}'")
+        endif()
+      endforeach()
+    elseif(rule MATCHES "^max-branches=([0-9]+)$")
+      if(branches GREATER CMAKE_MATCH_1)
+        list(APPEND errors "${branches} conditional branches, expected at most ${CMAKE_MATCH_1}")
+      endif()
+    elseif(rule MATCHES "^max-instructions=([0-9]+)$")
+      if(instructions GREATER CMAKE_MATCH_1)
+        list(APPEND errors "${instructions} instructions, expected at most ${CMAKE_MATCH_1}")
+      endif()
+    elseif(rule STREQUAL "vectorized")
+      set(found FALSE)
+      foreach(instruction IN LISTS body)
+        if(instruction MATCHES "^v?p(add|sub|mul|max|min|and|or|xor|cmp|shuf|unpck)[a-z]* ")
+          set(found TRUE)
+          break()
+        endif()
+      endforeach()
+      if(NOT found)
+        list(APPEND errors "not vectorized: no packed integer instructions")
+      endif()
+    elseif(rule MATCHES "^same-as=([A-Za-z0-9_]+)$")
+      # Compare mnemonics only: register allocation and operand order
+      # legitimately differ between equivalent functions
+      set(other "${CMAKE_MATCH_1}")
+      function_body(${other} other_body)
+      list(TRANSFORM body REPLACE " .*$" "" OUTPUT_VARIABLE mnemonics)
+      list(TRANSFORM other_body REPLACE " .*$" "" OUTPUT_VARIABLE other_mnemonics)
+      if(NOT mnemonics STREQUAL other_mnemonics)
+        list(LENGTH other_body other_instructions)
+        list(APPEND errors
+             "differs from ${other} (${instructions} vs ${other_instructions} instructions)")
+      endif()
+    else()
+      message(FATAL_ERROR "${function}: unknown rule '${rule}'")
+    endif()
+  endforeach()
+
+  math(EXPR checked "${checked} + 1")
+  if(errors)
+    math(EXPR failures "${failures} + 1")
+    list(JOIN errors "\n  " text)
+    list(JOIN body "\n    " listing)
+    message(SEND_ERROR "${function}:\n  ${text}\n  assembly:\n    ${listing}")
+  else()
+    message(STATUS "${function}: ${instructions} instructions, ${branches} branches: ok")
+  endif()
+endforeach()
+
+if(checked EQUAL 0)
+  message(FATAL_ERROR "no CHECK lines in ${SOURCE}")
+endif()
+if(failures GREATER 0)
+  message(FATAL_ERROR "${failures} of ${checked} codegen checks failed")
+endif()
@@ -0,0 +1,181 @@
+// Codegen regression kernels: what SafeInt code must compile down to
+// SPDX-License-Identifier: MIT
+//
+// This file is compiled to assembly (-O3, as in a Release build) and never
+// linked. check_codegen.cmake then checks each `// CHECK <function>:`
+// line below against the body of that function:
+//
+//   no-calls            no call, and no jump out of the function
+//   no-panic            no reference to panic() or abort()
+//   max-branches=N      at most N conditional jumps
+//   max-instructions=N  at most N instructions
+//   vectorized          uses packed integer SIMD instructions
+//   same-as=OTHER       the same instructions as OTHER, in the same order
+//
+// Kernels are extern "C" so their symbols are easy to find, and take raw
+// integers or pointers so the ABI does not depend on SafeInt. The limits
+// are what GCC and Clang produce today plus a little slack; a failure
+// means a change added branches, calls or lost vectorization on a path
+// that is supposed to cost nothing.
+
+#include "pulgacpp/i32/i32.hpp"
+#include "pulgacpp/i64/i64.hpp"
+#include "pulgacpp/ranged/ranged.hpp"
+#include "pulgacpp/result/result.hpp"
+#include "pulgacpp/u16/u16.hpp"
+#include "pulgacpp/u32/u32.hpp"
+#include "pulgacpp/u64/u64.hpp"
+#include "pulgacpp/u8/u8.hpp"
+#include <cstddef>
+#include <cstdint>
+
+using namespace pulgacpp;
+
+namespace {
+
+enum class ChainError : std::uint8_t { Overflow };
+
+Result<i32, ChainError> result_step(i32 a, i32 b) {
+  auto sum = a.checked_add(b);
+  if (sum.is_none()) {
+    return Err(ChainError::Overflow);
+  }
+  return Ok(sum.unwrap());
+}
+
+} // namespace
+
+extern "C" {
+
+// ==================== Wrapping loops: identical to raw ====================
+
+// CHECK raw_add_i32: no-calls vectorized
+void raw_add_i32(std::int32_t *out, const std::int32_t *a, const std::int32_t *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<std::int32_t>(static_cast<std::uint32_t>(a[i]) +
+                                       static_cast<std::uint32_t>(b[i]));
+  }
+}
+
+// CHECK wrapping_add_i32: no-calls vectorized same-as=raw_add_i32
+void wrapping_add_i32(i32 *out, const i32 *a, const i32 *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = a[i].wrapping_add(b[i]);
+  }
+}
+
+// CHECK raw_add_u8: no-calls vectorized
+void raw_add_u8(std::uint8_t *out, const std::uint8_t *a, const std::uint8_t *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<std::uint8_t>(a[i] + b[i]);
+  }
+}
+
+// CHECK wrapping_add_u8: no-calls vectorized same-as=raw_add_u8
+void wrapping_add_u8(u8 *out, const u8 *a, const u8 *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = a[i].wrapping_add(b[i]);
+  }
+}
+
+// CHECK raw_mul_u32: no-calls vectorized
+void raw_mul_u32(std::uint32_t *out, const std::uint32_t *a, const std::uint32_t *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = a[i] * b[i];
+  }
+}
+
+// CHECK wrapping_mul_u32: no-calls vectorized same-as=raw_mul_u32
+void wrapping_mul_u32(u32 *out, const u32 *a, const u32 *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = a[i].wrapping_mul(b[i]);
+  }
+}
+
+// CHECK saturating_add_u8: no-calls vectorized
+void saturating_add_u8(u8 *out, const u8 *a, const u8 *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = a[i].saturating_add(b[i]);
+  }
+}
+
+// ==================== Checked: one branch, no calls ====================
+
+// CHECK checked_add_i32: no-calls no-panic max-branches=1 max-instructions=14
+bool checked_add_i32(std::int32_t a, std::int32_t b, std::int32_t *out) {
+  auto sum = i32(a).checked_add(i32(b));
+  if (sum.is_none()) {
+    return false;
+  }
+  *out = sum.unwrap().get();
+  return true;
+}
+
+// CHECK checked_add_u64: no-calls no-panic max-branches=1 max-instructions=16
+bool checked_add_u64(std::uint64_t a, std::uint64_t b, std::uint64_t *out) {
+  auto sum = u64(a).checked_add(u64(b));
+  if (sum.is_none()) {
+    return false;
+  }
+  *out = sum.unwrap().get();
+  return true;
+}
+
+// CHECK checked_mul_i64: no-calls no-panic max-branches=1 max-instructions=16
+bool checked_mul_i64(std::int64_t a, std::int64_t b, std::int64_t *out) {
+  auto product = i64(a).checked_mul(i64(b));
+  if (product.is_none()) {
+    return false;
+  }
+  *out = product.unwrap().get();
+  return true;
+}
+
+// ==================== Optional and Result propagation ====================
+
+// CHECK optional_chain_i32: no-calls no-panic max-branches=2 max-instructions=20
+std::int32_t optional_chain_i32(std::int32_t a, std::int32_t b, std::int32_t c) {
+  auto ab = i32(a).checked_add(i32(b));
+  if (ab.is_none()) {
+    return -1;
+  }
+  auto abc = ab.unwrap().checked_add(i32(c));
+  if (abc.is_none()) {
+    return -1;
+  }
+  return abc.unwrap().get();
+}
+
+// CHECK unwrap_or_i32: no-calls no-panic max-branches=1 max-instructions=16
+std::int32_t unwrap_or_i32(std::int32_t a, std::int32_t b) {
+  return i32(a).checked_mul(i32(b)).unwrap_or(i32(0)).get();
+}
+
+// unwrap() of a value the compiler can see is Some must not keep the panic
+// CHECK unwrap_known_some: no-calls no-panic max-branches=0 max-instructions=3
+std::int32_t unwrap_known_some(std::int32_t a) {
+  return Optional<i32>(Some(i32(a))).unwrap().get();
+}
+
+// CHECK result_chain_i32: no-calls no-panic max-branches=2 max-instructions=20
+std::int32_t result_chain_i32(std::int32_t a, std::int32_t b, std::int32_t c) {
+  auto ab = result_step(i32(a), i32(b));
+  if (ab.is_err()) {
+    return -1;
+  }
+  auto abc = result_step(ab.unwrap(), i32(c));
+  if (abc.is_err()) {
+    return -1;
+  }
+  return abc.unwrap().get();
+}
+
+// ==================== Ranged: no checks at all ====================
+
+// CHECK ranged_mul_add: no-calls max-branches=0 max-instructions=8
+std::uint32_t ranged_mul_add(std::uint8_t a, std::uint8_t b, std::uint16_t c) {
+  auto sum = ranged(u8(a)) * ranged(u8(b)) + ranged(u16(c));
+  return sum.get().get();
+}
+
+} // extern "C"
@@ -13,7 +13,21 @@
 //   #include <pulgacpp/u32/u32.hpp>   // Include only u32
 //   #include <pulgacpp/u64/u64.hpp>   // Include only u64
 //   #include <pulgacpp/usize/usize.hpp>  // Include only usize
+//   #include <pulgacpp/i128/i128.hpp>    // Include only i128 (needs __int128)
+//   #include <pulgacpp/u128/u128.hpp>    // Include only u128 (needs __int128)
+//   #include <pulgacpp/bigint/bigint.hpp>  // Arbitrary-precision BigInt
+//   #include <pulgacpp/nonzero/nonzero.hpp>  // NonZero<S>
+//   #include <pulgacpp/bounded/bounded.hpp>  // Bounded<S, Lo, Hi>
+//   #include <pulgacpp/ranged/ranged.hpp>    // Ranged<Lo, Hi>
+//   #include <pulgacpp/divider/divider.hpp>  // Divider<S>
+//   #include <pulgacpp/modint/modint.hpp>    // ModInt<S, M>, Montgomery, Barrett
+//   #include <pulgacpp/fixed/fixed.hpp>      // Fixed<S, FracBits>, Q16_16, Q32_32
+//   #include <pulgacpp/packed/packed.hpp>    // PackedArray<Bits, Signed>, RankSelect
 //   #include <pulgacpp/result/result.hpp>  // Include only Result<T,E>
+//   #include <pulgacpp/batch/batch.hpp>    // Bulk span arithmetic
+//   #include <pulgacpp/codec/codec.hpp>    // Varint and bit-packing codecs
+//   #include <pulgacpp/endian/endian.hpp>  // BigEndian<T>, LittleEndian<T>, RecordView
+//   #include <pulgacpp/atomic/atomic.hpp>  // Atomic<S>, ShardedCounter<S>
 //   #include <pulgacpp/geometry/geometry.hpp>  // Include geometry types
 
 #ifndef PULGACPP_HPP
@@ -28,6 +42,7 @@
 #include "pulgacpp/i32/i32.hpp"
 #include "pulgacpp/i64/i64.hpp"
 #include "pulgacpp/i8/i8.hpp"
+#include "pulgacpp/i128/i128.hpp"
 #include "pulgacpp/isize/isize.hpp"
 
 
@@ -36,11 +51,42 @@
 #include "pulgacpp/u32/u32.hpp"
 #include "pulgacpp/u64/u64.hpp"
 #include "pulgacpp/u8/u8.hpp"
+#include "pulgacpp/u128/u128.hpp"
 #include "pulgacpp/usize/usize.hpp"
 
+// Arbitrary precision
+#include "pulgacpp/bigint/bigint.hpp"
+
+// Refined integers
+#include "pulgacpp/bounded/bounded.hpp"
+#include "pulgacpp/divider/divider.hpp"
+#include "pulgacpp/nonzero/nonzero.hpp"
+#include "pulgacpp/ranged/ranged.hpp"
+
+// Modular arithmetic
+#include "pulgacpp/modint/modint.hpp"
+
+// Fixed point
+#include "pulgacpp/fixed/fixed.hpp"
+
+// Packed sub-byte arrays
+#include "pulgacpp/packed/packed.hpp"
+
+// Bulk arithmetic over spans
+#include "pulgacpp/batch/batch.hpp"
+
+// Binary integer codecs
+#include "pulgacpp/codec/codec.hpp"
+
+// Byte-order aware values and record views
+#include "pulgacpp/endian/endian.hpp"
+
+// Thread-safe SafeInts and counters
+#include "pulgacpp/atomic/atomic.hpp"
 
 // Geometry (2D/3D shapes and angles)
 #include "pulgacpp/geometry/geometry.hpp"
+#include "pulgacpp/geometry/endian_traits.hpp"
 
 // Scientific constants
 #include "pulgacpp/constants/constants.hpp"
@@ -0,0 +1,294 @@
+// pulgacpp::Atomic - Lock-free SafeInts and sharded counters
+// SPDX-License-Identifier: MIT
+//
+// std::atomic<std::uint64_t>::fetch_add wraps silently on overflow.
+// Atomic<S> keeps SafeInt's rules for shared values: checked_fetch_add
+// refuses an update that would overflow (the value is left unchanged) and
+// saturating_fetch_add clamps, both with a compare-exchange loop over the
+// same checked_add/saturating_add that S uses. Wrapping is still available,
+// explicitly, as a plain fetch_add.
+//
+// A single atomic written by many threads moves its cache line from core
+// to core on every update. ShardedCounter<S> gives each thread one of
+// `Shards` counters on its own cache lines and only adds them up when the
+// total is read, so increments scale with the number of threads.
+//
+// Only types whose std::atomic is always lock-free qualify (up to 64 bits
+// on mainstream targets).
+//
+// Usage:
+//   #include <pulgacpp/atomic/atomic.hpp>
+//
+//   Atomic<u32> slots(100_u32);
+//   if (slots.checked_fetch_sub(1_u32).is_none()) { /* none left */ }
+//
+//   ShardedCounter<u64> requests;          // shared by all worker threads
+//   requests.saturating_add(1_u64);        // touches this thread's shard
+//   Optional<u64> total = requests.total();
+
+#ifndef PULGACPP_ATOMIC_HPP
+#define PULGACPP_ATOMIC_HPP
+
+#include "../core/safe_int.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace pulgacpp {
+
+namespace detail {
+
+/// SafeInts whose underlying std::atomic needs no lock.
+template <typename S>
+concept AtomicSafeInteger =
+    SafeInteger<S> && std::atomic<typename S::underlying_type>::is_always_lock_free;
+
+/// Shards are a multiple of this apart. Two lines rather than one, because
+/// x86 cores prefetch the adjacent line of a pair, which makes neighbours
+/// on a single 64-byte line still contend.
+inline constexpr std::size_t SHARD_ALIGN = 128;
+
+/// Round-robin shard number of the calling thread, fixed on first use.
+[[nodiscard]] inline std::size_t thread_shard() noexcept {
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t shard = next.fetch_add(1, std::memory_order_relaxed);
+  return shard;
+}
+
+} // namespace detail
+
+// ==================== Atomic ====================
+
+/// A SafeInt that can be read and updated from several threads.
+///
+/// Read-modify-write operations return the value before the update, like
+/// std::atomic::fetch_add. Checked operations return None and change
+/// nothing if the update would overflow; they take the same memory orders
+/// as std::atomic and default to sequential consistency.
+template <detail::AtomicSafeInteger S> class Atomic {
+  using T = typename S::underlying_type;
+
+public:
+  using value_type = S;
+
+  /// Zero.
+  constexpr Atomic() noexcept : m_value(T(0)) {}
+
+  constexpr explicit Atomic(S value) noexcept : m_value(value.get()) {}
+
+  Atomic(const Atomic &) = delete;
+  Atomic &operator=(const Atomic &) = delete;
+
+  // ==================== Plain access ====================
+
+  [[nodiscard]] S load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    return S(m_value.load(order));
+  }
+
+  void store(S value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    m_value.store(value.get(), order);
+  }
+
+  [[nodiscard]] S exchange(S value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return S(m_value.exchange(value.get(), order));
+  }
+
+  /// Replaces the value with `desired` if it equals `expected`; otherwise
+  /// loads the current value into `expected`. May fail spuriously.
+  [[nodiscard]] bool compare_exchange_weak(S &expected, S desired,
+                                           std::memory_order order = std::memory_order_seq_cst) noexcept {
+    T raw = expected.get();
+    bool done = m_value.compare_exchange_weak(raw, desired.get(), order);
+    expected = S(raw);
+    return done;
+  }
+
+  /// compare_exchange_weak without spurious failures.
+  [[nodiscard]] bool compare_exchange_strong(S &expected, S desired,
+                                             std::memory_order order = std::memory_order_seq_cst) noexcept {
+    T raw = expected.get();
+    bool done = m_value.compare_exchange_strong(raw, desired.get(), order);
+    expected = S(raw);
+    return done;
+  }
+
+  // ==================== Checked ====================
+
+  /// Adds `delta` unless the sum overflows. Returns the previous value, or
+  /// None (and leaves the value alone) on overflow.
+  [[nodiscard]] Optional<S> checked_fetch_add(S delta,
+                                              std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return update(order, [delta](S current) { return current.checked_add(delta); });
+  }
+
+  /// Subtracts `delta` unless the difference overflows.
+  [[nodiscard]] Optional<S> checked_fetch_sub(S delta,
+                                              std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return update(order, [delta](S current) { return current.checked_sub(delta); });
+  }
+
+  // ==================== Saturating ====================
+
+  /// Adds `delta`, clamping to S::MIN / S::MAX. Returns the previous value.
+  S saturating_fetch_add(S delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return update(order, [delta](S current) { return Some(current.saturating_add(delta)); }).unwrap();
+  }
+
+  S saturating_fetch_sub(S delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return update(order, [delta](S current) { return Some(current.saturating_sub(delta)); }).unwrap();
+  }
+
+  // ==================== Wrapping ====================
+
+  /// Adds `delta` modulo 2^BITS with a single fetch_add.
+  S wrapping_fetch_add(S delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return S(m_value.fetch_add(delta.get(), order));
+  }
+
+  S wrapping_fetch_sub(S delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return S(m_value.fetch_sub(delta.get(), order));
+  }
+
+  // ==================== Extremes ====================
+
+  /// Raises the value to `value` if it is larger. Returns the previous value.
+  S fetch_max(S value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    T current = m_value.load(std::memory_order_relaxed);
+    while (current < value.get() &&
+           !m_value.compare_exchange_weak(current, value.get(), order, std::memory_order_relaxed)) {
+    }
+    return S(current);
+  }
+
+  /// Lowers the value to `value` if it is smaller.
+  S fetch_min(S value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    T current = m_value.load(std::memory_order_relaxed);
+    while (current > value.get() &&
+           !m_value.compare_exchange_weak(current, value.get(), order, std::memory_order_relaxed)) {
+    }
+    return S(current);
+  }
+
+private:
+  /// Compare-exchange loop: replaces the value with `next(current)` until
+  /// no other thread got in between, or gives up when `next` returns None.
+  template <typename Next>
+  Optional<S> update(std::memory_order order, Next next) noexcept {
+    T current = m_value.load(std::memory_order_relaxed);
+    while (true) {
+      Optional<S> updated = next(S(current));
+      if (updated.is_none()) {
+        return None;
+      }
+      if (m_value.compare_exchange_weak(current, updated.unwrap().get(), order,
+                                        std::memory_order_relaxed)) {
+        return Some(S(current));
+      }
+    }
+  }
+
+  std::atomic<T> m_value;
+};
+
+// ==================== ShardedCounter ====================
+
+/// A counter updated by many threads and read rarely.
+///
+/// Each thread is assigned one of `Shards` counters round-robin the first
+/// time it touches any ShardedCounter, and only ever updates that one.
+/// Each shard sits on its own pair of cache lines, so threads on different
+/// shards never contend. Reading adds the shards up exactly, wider than S,
+/// and checks the result.
+///
+/// Updates are relaxed: they are atomic but order no other memory. A total
+/// read while other threads update is the sum of some value of each shard,
+/// not necessarily a value the counter had at one instant.
+template <detail::AtomicSafeInteger S, std::size_t Shards = 64>
+  requires(Shards > 0)
+class ShardedCounter {
+  using T = typename S::underlying_type;
+
+public:
+  using value_type = S;
+  static constexpr std::size_t SHARDS = Shards;
+
+  /// All shards zero.
+  ShardedCounter() noexcept = default;
+
+  ShardedCounter(const ShardedCounter &) = delete;
+  ShardedCounter &operator=(const ShardedCounter &) = delete;
+
+  /// Adds `delta` to this thread's shard. Returns false and changes nothing
+  /// if the shard would overflow.
+  [[nodiscard]] bool checked_add(S delta) noexcept {
+    return local().checked_fetch_add(delta, std::memory_order_relaxed).is_some();
+  }
+
+  /// Subtracts `delta` from this thread's shard unless it would overflow.
+  /// Unsigned shards cannot go below zero, so an unsigned counter can only
+  /// take back what this thread added.
+  [[nodiscard]] bool checked_sub(S delta) noexcept {
+    return local().checked_fetch_sub(delta, std::memory_order_relaxed).is_some();
+  }
+
+  /// Adds `delta` to this thread's shard, clamping the shard at S::MAX (or
+  /// S::MIN). A saturated shard makes saturating_total() saturate too.
+  void saturating_add(S delta) noexcept {
+    (void)local().saturating_fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  void saturating_sub(S delta) noexcept {
+    (void)local().saturating_fetch_sub(delta, std::memory_order_relaxed);
+  }
+
+  /// Sum of all shards, or None if it does not fit in S.
+  [[nodiscard]] Optional<S> total() const noexcept {
+    detail::WideAccumulator sum = sum_shards();
+    if (!sum.fits<T>()) {
+      return None;
+    }
+    return Some(S(sum.low<T>()));
+  }
+
+  /// Sum of all shards, clamped to S::MIN / S::MAX.
+  [[nodiscard]] S saturating_total() const noexcept {
+    detail::WideAccumulator sum = sum_shards();
+    if (!sum.fits<T>()) {
+      return S(sum.is_negative() ? S::MIN : S::MAX);
+    }
+    return S(sum.low<T>());
+  }
+
+  /// Sets every shard to zero. Updates made concurrently may be lost.
+  void reset() noexcept {
+    for (auto &shard : m_shards) {
+      shard.value.store(S(), std::memory_order_relaxed);
+    }
+  }
+
+private:
+  struct alignas(detail::SHARD_ALIGN) Shard {
+    Atomic<S> value;
+  };
+
+  [[nodiscard]] Atomic<S> &local() noexcept {
+    return m_shards[detail::thread_shard() % Shards].value;
+  }
+
+  [[nodiscard]] detail::WideAccumulator sum_shards() const noexcept {
+    detail::WideAccumulator sum;
+    for (const auto &shard : m_shards) {
+      sum.add(shard.value.load(std::memory_order_relaxed).get());
+    }
+    return sum;
+  }
+
+  std::array<Shard, Shards> m_shards{};
+};
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_ATOMIC_HPP
@@ -0,0 +1,58 @@
+// Benchmark: shared counters incremented by every hardware thread
+// Compile: g++ -std=c++23 -O2 -pthread -I../.. bench_atomic.cpp -o bench_atomic
+
+#include "atomic.hpp"
+#include "../u64/u64.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+namespace {
+
+constexpr int PER_THREAD = 1 << 22;
+
+/// Runs `body()` PER_THREAD times on each of `threads` threads.
+template <typename F> void run(const char *name, unsigned threads, F body) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                body();
+            }
+        });
+    }
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-40s %8.3f ns/increment\n", name, ns / (double(threads) * PER_THREAD));
+}
+
+} // namespace
+
+int main() {
+    unsigned threads = std::thread::hardware_concurrency();
+    threads = threads == 0 ? 1 : threads;
+    std::printf("=== Shared counters (%u threads, %d increments each) ===\n", threads, PER_THREAD);
+
+    std::atomic<std::uint64_t> raw{0};
+    run("std::atomic<uint64_t>::fetch_add", threads, [&] { raw.fetch_add(1, std::memory_order_relaxed); });
+
+    Atomic<u64> checked;
+    run("Atomic<u64>::checked_fetch_add", threads,
+        [&] { (void)checked.checked_fetch_add(1_u64, std::memory_order_relaxed); });
+
+    ShardedCounter<u64> sharded;
+    run("ShardedCounter<u64>::saturating_add", threads, [&] { sharded.saturating_add(1_u64); });
+
+    bool same = raw.load() == checked.load().get() && sharded.total().unwrap() == checked.load();
+    std::printf("totals agree: %s\n", same ? "yes" : "NO");
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Test program for pulgacpp::Atomic and ShardedCounter
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -pthread -I../.. main.cpp -o test_atomic
+
+#include "atomic.hpp"
+#include "../i32/i32.hpp"
+#include "../i64/i64.hpp"
+#include "../i8/i8.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include "../u8/u8.hpp"
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+/// Runs `body(t)` on `threads` threads and waits for all of them.
+template <typename F> void parallel(int threads, F body) {
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back(body, t);
+    }
+    for (auto &thread : pool) {
+        thread.join();
+    }
+}
+
+static_assert(sizeof(Atomic<u32>) == sizeof(std::uint32_t));
+static_assert(sizeof(ShardedCounter<u64, 4>) == 4 * detail::SHARD_ALIGN);
+
+int main() {
+    std::cout << "=== pulgacpp::Atomic Test Suite ===\n\n";
+
+    // --- Atomic ---
+    std::cout << "--- Atomic ---\n";
+    {
+        Atomic<u8> a(250_u8);
+        test(a.checked_fetch_add(5_u8).unwrap() == 250_u8 && a.load() == 255_u8, "checked_fetch_add returns the old value");
+        test(a.checked_fetch_add(1_u8).is_none() && a.load() == 255_u8, "overflow is refused and changes nothing");
+        test(a.saturating_fetch_add(10_u8) == 255_u8 && a.load() == 255_u8, "saturating_fetch_add clamps");
+        test(a.wrapping_fetch_add(1_u8) == 255_u8 && a.load() == 0_u8, "wrapping_fetch_add wraps explicitly");
+        test(a.checked_fetch_sub(1_u8).is_none() && a.saturating_fetch_sub(1_u8) == 0_u8 && a.load() == 0_u8,
+             "unsigned subtraction stops at zero");
+
+        Atomic<i8> s(i8(std::int8_t{-120}));
+        test(s.checked_fetch_sub(10_i8).is_none() && s.saturating_fetch_sub(10_i8) == i8(std::int8_t{-120}) &&
+                 s.load() == i8(i8::MIN),
+             "signed subtraction saturates at MIN");
+
+        Atomic<i64> m;
+        test(m.fetch_max(7_i64) == 0_i64 && m.fetch_max(3_i64) == 7_i64 && m.load() == 7_i64, "fetch_max");
+        test(m.fetch_min(i64(std::int64_t{-2})) == 7_i64 && m.load() == i64(std::int64_t{-2}), "fetch_min");
+
+        u64 expected = 1_u64;
+        test(!Atomic<u64>(5_u64).compare_exchange_strong(expected, 9_u64) && expected == 5_u64,
+             "failed compare-exchange loads the current value");
+        Atomic<u64> e(5_u64);
+        test(e.compare_exchange_strong(expected, 9_u64) && e.exchange(1_u64) == 9_u64, "compare-exchange and exchange");
+    }
+
+    // --- Atomic across threads ---
+    std::cout << "\n--- Atomic across threads ---\n";
+    {
+        Atomic<u32> hits;
+        parallel(8, [&](int) {
+            for (int i = 0; i < 20000; ++i) {
+                (void)hits.checked_fetch_add(1_u32, std::memory_order_relaxed);
+            }
+        });
+        test(hits.load() == 160000_u32, "no lost updates");
+
+        // 8 threads race to take 1000 tickets; exactly 1000 succeed
+        Atomic<u32> tickets(1000_u32);
+        Atomic<u32> taken;
+        parallel(8, [&](int) {
+            for (int i = 0; i < 500; ++i) {
+                if (tickets.checked_fetch_sub(1_u32).is_some()) {
+                    (void)taken.wrapping_fetch_add(1_u32);
+                }
+            }
+        });
+        test(taken.load() == 1000_u32 && tickets.load() == 0_u32, "checked_fetch_sub never goes below zero");
+
+        Atomic<u8> near(200_u8);
+        parallel(4, [&](int) {
+            for (int i = 0; i < 100; ++i) {
+                (void)near.saturating_fetch_add(1_u8);
+            }
+        });
+        test(near.load() == 255_u8, "concurrent saturating adds stop at MAX");
+    }
+
+    // --- ShardedCounter ---
+    std::cout << "\n--- ShardedCounter ---\n";
+    {
+        ShardedCounter<u64> requests;
+        parallel(16, [&](int) {
+            for (int i = 0; i < 10000; ++i) {
+                requests.saturating_add(1_u64);
+            }
+        });
+        test(requests.total().unwrap() == 160000_u64, "total adds up every shard");
+
+        ShardedCounter<i32, 8> balance;
+        parallel(8, [&](int t) {
+            for (int i = 0; i < 1000; ++i) {
+                (void)(t % 2 == 0 ? balance.checked_add(3_i32) : balance.checked_sub(1_i32));
+            }
+        });
+        test(balance.total().unwrap() == 8000_i32, "signed shards can be negative");
+
+        // Shards that fit on their own but not together
+        ShardedCounter<u8, 4> small;
+        parallel(4, [&](int) {
+            for (int i = 0; i < 100; ++i) {
+                small.saturating_add(1_u8);
+            }
+        });
+        test(small.total().is_none() && small.saturating_total() == 255_u8, "total past MAX is None");
+        small.reset();
+        test(small.total().unwrap() == 0_u8, "reset");
+
+        ShardedCounter<i8, 4> low;
+        parallel(4, [&](int) {
+            for (int i = 0; i < 100; ++i) {
+                low.saturating_sub(1_i8);
+            }
+        });
+        test(low.total().is_none() && low.saturating_total() == i8(i8::MIN), "total below MIN saturates to MIN");
+
+        ShardedCounter<u64, 1> one;
+        test(one.checked_add(u64(u64::MAX)) && !one.checked_add(1_u64) && one.total().unwrap() == u64(u64::MAX),
+             "a full shard refuses checked_add");
+        ShardedCounter<i64, 2> wide;
+        parallel(2, [&](int) { wide.saturating_add(i64(i64::MAX)); });
+        test(wide.total().is_none() && wide.saturating_total() == i64(i64::MAX), "64-bit totals are computed wider");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
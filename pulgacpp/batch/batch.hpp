@@ -0,0 +1,1307 @@
+// pulgacpp::batch - Bulk arithmetic over spans of safe integers
+// SPDX-License-Identifier: MIT
+//
+// Span-level versions of the SafeInt arithmetic methods. Instead of building
+// one Optional per element, a bulk checked operation reports a single
+// aggregated result: Ok, or the index of the first element that overflowed.
+//
+// Kernels are vectorized (AVX2 / SSE4.2 / NEON) with runtime CPU dispatch and
+// fall back to a scalar loop built on the SafeInt methods themselves, so
+// every path produces exactly the values the per-element API would.
+//
+// Usage:
+//   #include <pulgacpp/batch/batch.hpp>
+//
+//   std::vector<i32> a = ..., b = ..., sum(a.size());
+//   auto r = batch::checked_add<i32>(a, b, sum);
+//   if (r.is_err()) { log(r.unwrap_err().index); }
+//
+//   auto buckets = Divider<u32>::from(n).expect("n > 0");
+//   (void)batch::checked_rem<u32>(hashes, buckets, slots);
+//
+//   Optional<i64> total = batch::checked_sum<i64>(amounts);  // exact, checked once
+//
+//   auto values = batch::parse<i32>(file_contents);  // one value per line
+
+#ifndef PULGACPP_BATCH_HPP
+#define PULGACPP_BATCH_HPP
+
+#include "../core/safe_int.hpp"
+#include "../core/simd.hpp"
+#include "../divider/divider.hpp"
+#include "../modint/modint.hpp"
+#include "../result/result.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace pulgacpp {
+
+namespace batch {
+
+/// Error of a bulk checked operation: the first element that overflowed.
+struct Overflow {
+  std::size_t index;
+
+  [[nodiscard]] constexpr bool
+  operator==(const Overflow &other) const noexcept = default;
+};
+
+} // namespace batch
+
+namespace detail {
+
+/// Lane type twice as wide as T with the same signedness (for multiplies).
+template <typename T>
+using double_width_t = std::conditional_t<
+    sizeof(T) == 1,
+    std::conditional_t<std::is_signed_v<T>, std::int16_t, std::uint16_t>,
+    std::conditional_t<
+        sizeof(T) == 2,
+        std::conditional_t<std::is_signed_v<T>, std::int32_t, std::uint32_t>,
+        std::conditional_t<std::is_signed_v<T>, std::int64_t,
+                           std::uint64_t>>>;
+
+// ==================== Checked kernels ====================
+// The result lanes always hold the wrapped value; the mask marks overflow.
+
+template <SafeInteger S> struct CheckedAddOp {
+  using T = typename S::underlying_type;
+
+  static T scalar(T a, T b, bool &flag) noexcept {
+    auto [result, overflow] = S(a).overflowing_add(S(b));
+    flag = overflow;
+    return result.get();
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  static PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                            M &mask) noexcept {
+    using U = simd::vec<std::make_unsigned_t<T>, sizeof(V)>;
+    r = (V)((U)a + (U)b);
+    if constexpr (std::is_signed_v<T>) {
+      // Overflow iff both operands differ in sign from the result
+      mask = ((a ^ r) & (b ^ r)) < 0;
+    } else {
+      mask = r < a;
+    }
+  }
+#endif
+};
+
+template <SafeInteger S> struct CheckedSubOp {
+  using T = typename S::underlying_type;
+
+  static T scalar(T a, T b, bool &flag) noexcept {
+    auto [result, overflow] = S(a).overflowing_sub(S(b));
+    flag = overflow;
+    return result.get();
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  static PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                            M &mask) noexcept {
+    using U = simd::vec<std::make_unsigned_t<T>, sizeof(V)>;
+    r = (V)((U)a - (U)b);
+    if constexpr (std::is_signed_v<T>) {
+      // Overflow iff the operands differ in sign and the result flips a's
+      mask = ((a ^ b) & (a ^ r)) < 0;
+    } else {
+      mask = a < b;
+    }
+  }
+#endif
+};
+
+template <SafeInteger S> struct CheckedMulOp {
+  using T = typename S::underlying_type;
+
+  static T scalar(T a, T b, bool &flag) noexcept {
+    auto [result, overflow] = S(a).overflowing_mul(S(b));
+    flag = overflow;
+    return result.get();
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  static PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                            M &mask) noexcept {
+    if constexpr (sizeof(T) < 8) {
+      // Exact product in double-width lanes, then check it narrows back
+      using W = double_width_t<T>;
+      using VW = simd::vec<W, sizeof(V) * 2>;
+      VW product =
+          __builtin_convertvector(a, VW) * __builtin_convertvector(b, VW);
+      r = __builtin_convertvector(product, V);
+      mask = __builtin_convertvector(__builtin_convertvector(r, VW) != product,
+                                     M);
+    } else {
+      // No 64x64->128 vector multiply: per lane via the overflow intrinsics
+      for (std::size_t k = 0; k < sizeof(V) / sizeof(T); ++k) {
+        bool flag = false;
+        r[k] = scalar(a[k], b[k], flag);
+        mask[k] = flag ? -1 : 0;
+      }
+    }
+  }
+#endif
+};
+
+// ==================== Saturating kernels ====================
+// These never flag an element, so the mask is always zero.
+
+template <SafeInteger S> struct SaturatingAddOp {
+  using T = typename S::underlying_type;
+
+  static T scalar(T a, T b, bool &) noexcept {
+    return S(a).saturating_add(S(b)).get();
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  static PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                            M &mask) noexcept {
+    using U = simd::vec<std::make_unsigned_t<T>, sizeof(V)>;
+    V sum = (V)((U)a + (U)b);
+    if constexpr (std::is_signed_v<T>) {
+      // Overflow always goes in the direction of a's sign
+      M overflow = ((a ^ sum) & (b ^ sum)) < 0;
+      V limit = (a >> (sizeof(T) * 8 - 1)) ^ S::MAX;
+      simd::select(r, overflow, limit, sum);
+    } else {
+      r = sum | (V)(sum < a);
+    }
+    mask = M{};
+  }
+#endif
+};
+
+template <SafeInteger S> struct SaturatingSubOp {
+  using T = typename S::underlying_type;
+
+  static T scalar(T a, T b, bool &) noexcept {
+    return S(a).saturating_sub(S(b)).get();
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  static PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                            M &mask) noexcept {
+    using U = simd::vec<std::make_unsigned_t<T>, sizeof(V)>;
+    V diff = (V)((U)a - (U)b);
+    if constexpr (std::is_signed_v<T>) {
+      M overflow = ((a ^ b) & (a ^ diff)) < 0;
+      V limit = (a >> (sizeof(T) * 8 - 1)) ^ S::MAX;
+      simd::select(r, overflow, limit, diff);
+    } else {
+      r = diff & ~(V)(a < b);
+    }
+    mask = M{};
+  }
+#endif
+};
+
+template <SafeInteger S> struct SaturatingMulOp {
+  using T = typename S::underlying_type;
+
+  static T scalar(T a, T b, bool &) noexcept {
+    return S(a).saturating_mul(S(b)).get();
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  static PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                            M &mask) noexcept {
+    if constexpr (sizeof(T) < 8) {
+      // Clamp the exact double-width product, then narrow
+      using W = double_width_t<T>;
+      using VW = simd::vec<W, sizeof(V) * 2>;
+      using MW = simd::vec<simd::mask_lane<W>, sizeof(V) * 2>;
+      VW product =
+          __builtin_convertvector(a, VW) * __builtin_convertvector(b, VW);
+      VW hi = VW{} + static_cast<W>(S::MAX);
+      simd::select(product, (MW)(product > hi), hi, product);
+      if constexpr (std::is_signed_v<T>) {
+        VW lo = VW{} + static_cast<W>(S::MIN);
+        simd::select(product, (MW)(product < lo), lo, product);
+      }
+      r = __builtin_convertvector(product, V);
+    } else {
+      for (std::size_t k = 0; k < sizeof(V) / sizeof(T); ++k) {
+        r[k] = S(a[k]).saturating_mul(S(b[k])).get();
+      }
+    }
+    mask = M{};
+  }
+#endif
+};
+
+// ==================== Wrapping kernels ====================
+
+template <SafeInteger S> struct WrappingAddOp {
+  using T = typename S::underlying_type;
+
+  static T scalar(T a, T b, bool &) noexcept {
+    return S(a).wrapping_add(S(b)).get();
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  static PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                            M &mask) noexcept {
+    using U = simd::vec<std::make_unsigned_t<T>, sizeof(V)>;
+    r = (V)((U)a + (U)b);
+    mask = M{};
+  }
+#endif
+};
+
+template <SafeInteger S> struct WrappingSubOp {
+  using T = typename S::underlying_type;
+
+  static T scalar(T a, T b, bool &) noexcept {
+    return S(a).wrapping_sub(S(b)).get();
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  static PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                            M &mask) noexcept {
+    using U = simd::vec<std::make_unsigned_t<T>, sizeof(V)>;
+    r = (V)((U)a - (U)b);
+    mask = M{};
+  }
+#endif
+};
+
+template <SafeInteger S> struct WrappingMulOp {
+  using T = typename S::underlying_type;
+
+  static T scalar(T a, T b, bool &) noexcept {
+    return S(a).wrapping_mul(S(b)).get();
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  static PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                            M &mask) noexcept {
+    using U = simd::vec<std::make_unsigned_t<T>, sizeof(V)>;
+    r = (V)((U)a * (U)b);
+    mask = M{};
+  }
+#endif
+};
+
+// ==================== Division by a Divider ====================
+// The mask marks signed MIN / -1; the lane holds the wrapped result.
+
+enum class DivideKind { Quotient, Remainder, Floor };
+
+template <SafeInteger S, DivideKind Kind> struct DivideOp {
+  using T = typename S::underlying_type;
+  using U = std::make_unsigned_t<T>;
+  static constexpr unsigned BITS = sizeof(T) * 8;
+
+  Divider<S> divider;
+
+  T scalar(T a, bool &flag) const noexcept {
+    flag = divider.overflows(a);
+    if constexpr (Kind == DivideKind::Floor) {
+      return divider.floor_quotient(a);
+    } else if constexpr (Kind == DivideKind::Remainder) {
+      return divider.remainder(a, divider.quotient(a));
+    } else {
+      return divider.quotient(a);
+    }
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <typename V, typename M>
+  PULGACPP_ALWAYS_INLINE void vector(const V &a, V &r, M &mask) const noexcept {
+    static_assert(sizeof(T) < 8, "64-bit lanes use the scalar loop");
+    using VU = simd::vec<U, sizeof(V)>;
+    using W = double_width_t<U>;
+    using VW = simd::vec<W, sizeof(V) * 2>;
+    const auto &magic = divider.magic();
+    const T d = divider.divisor().get();
+
+    // Signed: divide |a| and restore the sign, as Divider::quotient does
+    VU n = (VU)a;
+    VU sign = VU{};
+    if constexpr (std::is_signed_v<T>) {
+      sign = (VU)(a >> (BITS - 1));
+      n = (n ^ sign) - sign;
+    }
+    VU t;
+    if constexpr (sizeof(T) == 4) {
+      // Even and odd 32-bit lanes as 64-bit lanes: two 32x32->64
+      // multiplies (pmuludq) instead of a 64-bit multiply
+      using V64 = simd::vec<std::uint64_t, sizeof(V)>;
+      constexpr std::uint64_t LOW = 0xFFFFFFFFu;
+      const V64 m = V64{} + std::uint64_t(magic.multiplier);
+      V64 even, odd;
+      simd::mul_lo32(even, (V64)n, m);
+      simd::mul_lo32(odd, (V64)n >> 32, m);
+      t = (VU)((even >> 32) | (odd & ~LOW));
+    } else {
+      VW product = __builtin_convertvector(n, VW) * (W)magic.multiplier;
+      t = __builtin_convertvector(product >> BITS, VU);
+    }
+    VU q = (t + ((n - t) >> magic.pre_shift)) >> magic.post_shift;
+    if constexpr (std::is_signed_v<T>) {
+      VU negate = d < 0 ? ~sign : sign;
+      q = (q ^ negate) - negate;
+    }
+
+    if constexpr (Kind == DivideKind::Quotient) {
+      r = (V)q;
+    } else {
+      V rem = (V)((VU)a - q * (U)d);
+      if constexpr (Kind == DivideKind::Remainder) {
+        r = rem;
+      } else if constexpr (std::is_signed_v<T>) {
+        // Round down when the remainder is non-zero and its sign differs
+        M adjust = (rem != 0) & ((rem ^ d) < 0);
+        r = (V)(q + (VU)adjust);
+      } else {
+        r = (V)q;
+      }
+    }
+
+    if constexpr (std::is_signed_v<T>) {
+      mask = d == -1 ? (M)(a == S::MIN) : M{};
+    } else {
+      mask = M{};
+    }
+  }
+#endif
+};
+
+template <DivideKind Kind, SafeInteger S>
+[[nodiscard]] inline Result<void, batch::Overflow>
+run_divide(std::span<const S> a, const Divider<S> &divider,
+           std::span<S> out) noexcept {
+  if (a.size() != out.size()) {
+    panic("batch: span lengths differ");
+  }
+  using T = typename S::underlying_type;
+  const DivideOp<S, Kind> op{divider};
+  std::size_t first = 0;
+  if constexpr (sizeof(T) == 8) {
+    // No 64x64->128 vector multiply; a scalar mulx per element beats
+    // moving lanes in and out of vector registers
+    first = simd::map1_scalar(op, simd::raw_ptr<T>(a.data()),
+                              simd::raw_ptr<T>(out.data()), a.size());
+  } else {
+    first = simd::dispatch_map1(op, simd::raw_ptr<T>(a.data()),
+                                simd::raw_ptr<T>(out.data()), a.size());
+  }
+  if (first == a.size()) {
+    return Result<void, batch::Overflow>::ok();
+  }
+  return Err(batch::Overflow{first});
+}
+
+template <SafeInteger S>
+inline void check_lengths(std::span<const S> a, std::span<const S> b,
+                          std::span<S> out) noexcept {
+  if (a.size() != b.size() || a.size() != out.size()) {
+    panic("batch: span lengths differ");
+  }
+}
+
+template <typename Op, SafeInteger S>
+[[nodiscard]] inline Result<void, batch::Overflow>
+run_checked(std::span<const S> a, std::span<const S> b,
+            std::span<S> out) noexcept {
+  check_lengths(a, b, out);
+  using T = typename S::underlying_type;
+  std::size_t first = simd::dispatch_map2<Op, T>(
+      simd::raw_ptr<T>(a.data()), simd::raw_ptr<T>(b.data()),
+      simd::raw_ptr<T>(out.data()), a.size());
+  if (first == a.size()) {
+    return Result<void, batch::Overflow>::ok();
+  }
+  return Err(batch::Overflow{first});
+}
+
+template <typename Op, SafeInteger S>
+inline void run_total(std::span<const S> a, std::span<const S> b,
+                      std::span<S> out) noexcept {
+  check_lengths(a, b, out);
+  using T = typename S::underlying_type;
+  (void)simd::dispatch_map2<Op, T>(simd::raw_ptr<T>(a.data()),
+                                   simd::raw_ptr<T>(b.data()),
+                                   simd::raw_ptr<T>(out.data()), a.size());
+}
+
+// ==================== Modular kernels ====================
+// Multiply and power through a Montgomery or Barrett reducer. `Raw*` work
+// on a ModInt's stored representation; `*Mod` take and return plain
+// values, like the reducers' mul_mod / pow_mod. Nothing is ever flagged.
+
+enum class ModKind { RawMul, RawPow, MulMod, PowMod };
+
+template <typename R> struct is_montgomery : std::false_type {};
+template <typename S> struct is_montgomery<Montgomery<S>> : std::true_type {};
+
+#if PULGACPP_VECTOR_EXT
+/// Montgomery constants broadcast to 64-bit lanes for the u32 kernels.
+template <typename V64> struct MontgomeryLanes {
+  V64 modulus;
+  V64 inverse;
+  V64 r2;
+  V64 one;
+};
+
+/// r = REDC(x * y) per 64-bit lane, for 32-bit values in the low half of
+/// each lane. Every product is a single 32x32->64 mul_lo32.
+template <typename V64>
+PULGACPP_ALWAYS_INLINE void montgomery_lanes(V64 &r, const V64 &x, const V64 &y,
+                                             const MontgomeryLanes<V64> &c) noexcept {
+  using M64 = simd::vec<std::int64_t, sizeof(V64)>;
+  V64 product, q, qm;
+  simd::mul_lo32(product, x, y);
+  simd::mul_lo32(q, product, c.inverse);
+  simd::mul_lo32(qm, q, c.modulus);
+  V64 h = qm >> 32;
+  V64 hi = product >> 32;
+  // Both sides are below 2^32, so a signed compare is exact
+  V64 wrap = (V64)((M64)hi < (M64)h);
+  r = hi - h + (wrap & c.modulus);
+}
+#endif
+
+template <typename Reducer, ModKind Kind> struct ModOp {
+  using S = typename Reducer::value_type;
+  using T = typename Reducer::underlying_type;
+
+  Reducer reducer;
+  std::uint64_t exponent = 0;
+
+  T scalar(T a, T b, bool &flag) const noexcept {
+    flag = false;
+    if constexpr (Kind == ModKind::RawMul) {
+      return reducer.multiply(a, b);
+    } else {
+      return reducer.mul_mod(S(a), S(b)).get();
+    }
+  }
+
+  T scalar(T a, bool &flag) const noexcept {
+    flag = false;
+    if constexpr (Kind == ModKind::RawPow) {
+      return reducer.pow_raw(a, exponent);
+    } else {
+      return reducer.pow_mod(S(a), exponent).get();
+    }
+  }
+
+#if PULGACPP_VECTOR_EXT
+  // Only Montgomery<u32> has vector kernels; see run_modular. The 32-bit
+  // lanes are split into even and odd halves held in 64-bit lanes.
+  template <typename V64>
+  PULGACPP_ALWAYS_INLINE MontgomeryLanes<V64> lanes() const noexcept {
+    return {V64{} + std::uint64_t(reducer.modulus().get()),
+            V64{} + std::uint64_t(reducer.inverse()),
+            V64{} + std::uint64_t(reducer.r2()),
+            V64{} + std::uint64_t(reducer.one().get())};
+  }
+
+  template <typename V, typename M>
+  PULGACPP_ALWAYS_INLINE void vector(const V &a, const V &b, V &r,
+                                     M &mask) const noexcept {
+    using V64 = simd::vec<std::uint64_t, sizeof(V)>;
+    const auto c = lanes<V64>();
+    V64 even_a = (V64)a, odd_a = (V64)a >> 32;
+    V64 even_b = (V64)b, odd_b = (V64)b >> 32;
+    if constexpr (Kind == ModKind::MulMod) {
+      montgomery_lanes(even_a, even_a, c.r2, c);
+      montgomery_lanes(odd_a, odd_a, c.r2, c);
+    }
+    V64 even, odd;
+    montgomery_lanes(even, even_a, even_b, c);
+    montgomery_lanes(odd, odd_a, odd_b, c);
+    r = (V)(even | (odd << 32));
+    mask = M{};
+  }
+
+  template <typename V, typename M>
+  PULGACPP_ALWAYS_INLINE void vector(const V &a, V &r, M &mask) const noexcept {
+    using V64 = simd::vec<std::uint64_t, sizeof(V)>;
+    const auto c = lanes<V64>();
+    V64 even = (V64)a, odd = (V64)a >> 32;
+    if constexpr (Kind == ModKind::PowMod) {
+      montgomery_lanes(even, even, c.r2, c);
+      montgomery_lanes(odd, odd, c.r2, c);
+    }
+    V64 even_result = c.one, odd_result = c.one;
+    for (std::uint64_t e = exponent; e != 0; e >>= 1) {
+      if (e & 1) {
+        montgomery_lanes(even_result, even_result, even, c);
+        montgomery_lanes(odd_result, odd_result, odd, c);
+      }
+      montgomery_lanes(even, even, even, c);
+      montgomery_lanes(odd, odd, odd, c);
+    }
+    if constexpr (Kind == ModKind::PowMod) {
+      // Back to plain residues: REDC(x * 1)
+      V64 one = V64{} + std::uint64_t(1);
+      montgomery_lanes(even_result, even_result, one, c);
+      montgomery_lanes(odd_result, odd_result, one, c);
+    }
+    r = (V)(even_result | (odd_result << 32));
+    mask = M{};
+  }
+#endif
+};
+
+/// True if ModOp<Reducer, ...> has vector kernels.
+template <typename Reducer>
+constexpr bool vectorized_reducer_v =
+    is_montgomery<Reducer>::value &&
+    sizeof(typename Reducer::underlying_type) == 4;
+
+template <ModKind Kind, typename Reducer, typename Elem>
+inline void run_modular(const Reducer &reducer, std::span<const Elem> a,
+                        std::span<const Elem> b, std::span<Elem> out) noexcept {
+  if (a.size() != b.size() || a.size() != out.size()) {
+    panic("batch: span lengths differ");
+  }
+  using T = typename Reducer::underlying_type;
+  const ModOp<Reducer, Kind> op{reducer};
+  if constexpr (vectorized_reducer_v<Reducer>) {
+    (void)simd::dispatch_map2(op, simd::raw_ptr<T>(a.data()),
+                              simd::raw_ptr<T>(b.data()),
+                              simd::raw_ptr<T>(out.data()), a.size());
+  } else {
+    // No 64x64->128 vector multiply (and Barrett needs 128-bit lanes)
+    (void)simd::map2_scalar(op, simd::raw_ptr<T>(a.data()),
+                            simd::raw_ptr<T>(b.data()),
+                            simd::raw_ptr<T>(out.data()), a.size());
+  }
+}
+
+template <ModKind Kind, typename Reducer, typename Elem>
+inline void run_modular(const Reducer &reducer, std::span<const Elem> a,
+                        std::uint64_t exponent, std::span<Elem> out) noexcept {
+  if (a.size() != out.size()) {
+    panic("batch: span lengths differ");
+  }
+  using T = typename Reducer::underlying_type;
+  const ModOp<Reducer, Kind> op{reducer, exponent};
+  if constexpr (vectorized_reducer_v<Reducer>) {
+    (void)simd::dispatch_map1(op, simd::raw_ptr<T>(a.data()),
+                              simd::raw_ptr<T>(out.data()), a.size());
+  } else {
+    (void)simd::map1_scalar(op, simd::raw_ptr<T>(a.data()),
+                            simd::raw_ptr<T>(out.data()), a.size());
+  }
+}
+
+// ==================== Reduction kernels ====================
+// Sums are exact. Each vector lane keeps a 128-bit partial sum as a u64
+// low lane and an i64 high lane (the carries, minus one per negative
+// term), which cannot overflow before 2^63 terms. The lanes are folded
+// into a WideAccumulator at the end, so the range check happens once, on
+// the final value. Every lane is widened to 64 bits, so a vector holds
+// Bytes / 8 elements of any width. Terms of at most 16 bits (the values of
+// an 8 or 16-bit type, products of 8-bit ones) are first added in 32-bit
+// lanes, Bytes / 4 at a time, in blocks short enough not to overflow.
+
+#if PULGACPP_VECTOR_EXT
+/// Converts to 32-bit lanes one doubling at a time: GCC widens 8-bit lanes
+/// straight to 32 bits element by element.
+template <typename V, typename V32>
+PULGACPP_ALWAYS_INLINE void widen(const V &v, V32 &out) noexcept {
+  using T = std::remove_cvref_t<decltype(v[0])>;
+  if constexpr (sizeof(T) == 1) {
+    out = __builtin_convertvector(
+        __builtin_convertvector(v, simd::vec<double_width_t<T>, sizeof(V) * 2>), V32);
+  } else {
+    out = __builtin_convertvector(v, V32);
+  }
+}
+
+/// Sum of `values` (or of `a[i] * b[i]` when Products) for T of at most
+/// 16 bits (8 for products), via 32-bit lanes.
+template <bool Products, typename T, std::size_t Bytes>
+PULGACPP_ALWAYS_INLINE std::size_t reduce_narrow(const T *a, const T *b,
+                                                 std::size_t n,
+                                                 WideAccumulator &acc) noexcept {
+  constexpr std::size_t L = Bytes / 4;
+  // |term| <= 2^16, so 2^15 terms per lane stay below 2^31
+  constexpr std::size_t BLOCK = L << 15;
+  using W32 = std::conditional_t<std::is_signed_v<T>, std::int32_t, std::uint32_t>;
+  using V = simd::vec<T, L * sizeof(T)>;
+  using V32 = simd::vec<W32, Bytes>;
+  std::size_t i = 0;
+  while (i + L <= n) {
+    std::size_t stop = i + std::min(BLOCK, (n - i) / L * L);
+    V32 sum{};
+    for (; i < stop; i += L) {
+      V va;
+      simd::load(va, a + i);
+      V32 wa;
+      widen(va, wa);
+      if constexpr (Products) {
+        V vb;
+        V32 wb;
+        simd::load(vb, b + i);
+        widen(vb, wb);
+        sum += wa * wb;
+      } else {
+        sum += wa;
+      }
+    }
+    for (std::size_t k = 0; k < L; ++k) {
+      acc.add(sum[k]);
+    }
+  }
+  return i;
+}
+#endif
+
+/// `values` added to `acc`.
+template <SafeInteger S> struct SumKernel {
+  using T = typename S::underlying_type;
+
+  static void scalar(const T *a, const T *, std::size_t n,
+                     WideAccumulator &acc) noexcept {
+    // A local copy stays in registers: `a` may alias acc's 64-bit words
+    WideAccumulator sum = acc;
+    for (std::size_t i = 0; i < n; ++i) {
+      sum.add(a[i]);
+    }
+    acc = sum;
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <std::size_t Bytes>
+  static PULGACPP_ALWAYS_INLINE std::size_t
+  vector(const T *a, const T *, std::size_t n, WideAccumulator &acc) noexcept {
+    if constexpr (sizeof(T) <= 2) {
+      return reduce_narrow<false, T, Bytes>(a, nullptr, n, acc);
+    }
+    constexpr std::size_t L = Bytes / 8;
+    using V = simd::vec<T, L * sizeof(T)>;
+    using W = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+    using VW = simd::vec<W, Bytes>;
+    using VU = simd::vec<std::uint64_t, Bytes>;
+    using VH = simd::vec<std::int64_t, Bytes>;
+    VU low{};
+    VH high{};
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+      V v;
+      simd::load(v, a + i);
+      VW w = __builtin_convertvector(v, VW);
+      VU next = low + (VU)w;
+      high -= (VH)(next < low); // carry out of the low lane
+      if constexpr (std::is_signed_v<T>) {
+        high += (VH)w >> 63; // sign extension of a negative term
+      }
+      low = next;
+    }
+    fold(low, high, acc);
+    return i;
+  }
+#endif
+
+#if PULGACPP_VECTOR_EXT
+  template <typename VU, typename VH>
+  static PULGACPP_ALWAYS_INLINE void fold(const VU &low, const VH &high,
+                                          WideAccumulator &acc) noexcept {
+    for (std::size_t k = 0; k < sizeof(VU) / 8; ++k) {
+      acc.add(low[k], static_cast<std::uint64_t>(high[k]), high[k] < 0);
+    }
+  }
+#endif
+};
+
+/// `a[i] * b[i]` added to `acc`, with exact products.
+template <SafeInteger S> struct DotKernel {
+  using T = typename S::underlying_type;
+
+  /// Full product of two values of up to 64 bits as a 128-bit term.
+  static void add_product(T a, T b, WideAccumulator &acc) noexcept {
+    if constexpr (sizeof(T) < 8) {
+      using W = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+      acc.add(static_cast<W>(static_cast<W>(a) * static_cast<W>(b)));
+    } else {
+      auto ua = static_cast<std::uint64_t>(a);
+      auto ub = static_cast<std::uint64_t>(b);
+      std::uint64_t low = ua * ub;
+      std::uint64_t high = mul_high<std::uint64_t, typename S::wider_type>(ua, ub);
+      bool negative = false;
+      if constexpr (std::is_signed_v<T>) {
+        // Signed high half from the unsigned one
+        high -= (a < 0 ? ub : 0) + (b < 0 ? ua : 0);
+        negative = static_cast<std::int64_t>(high) < 0;
+      }
+      acc.add(low, high, negative);
+    }
+  }
+
+  static void scalar(const T *a, const T *b, std::size_t n,
+                     WideAccumulator &acc) noexcept {
+    WideAccumulator sum = acc;
+    for (std::size_t i = 0; i < n; ++i) {
+      add_product(a[i], b[i], sum);
+    }
+    acc = sum;
+  }
+
+#if PULGACPP_VECTOR_EXT
+  template <std::size_t Bytes>
+  static PULGACPP_ALWAYS_INLINE std::size_t
+  vector(const T *a, const T *b, std::size_t n, WideAccumulator &acc) noexcept {
+    static_assert(sizeof(T) < 8, "64-bit products use the scalar loop");
+    if constexpr (sizeof(T) == 1) {
+      return reduce_narrow<true, T, Bytes>(a, b, n, acc);
+    }
+    constexpr std::size_t L = Bytes / 8;
+    using V = simd::vec<T, L * sizeof(T)>;
+    using W = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+    using VW = simd::vec<W, Bytes>;
+    using VU = simd::vec<std::uint64_t, Bytes>;
+    using VH = simd::vec<std::int64_t, Bytes>;
+    VU low{};
+    VH high{};
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+      V va, vb;
+      simd::load(va, a + i);
+      simd::load(vb, b + i);
+      VU product;
+      if constexpr (sizeof(T) <= 2) {
+        // The product fits in 32 bits
+        using W32 = std::conditional_t<std::is_signed_v<T>, std::int32_t, std::uint32_t>;
+        using V32 = simd::vec<W32, L * 4>;
+        V32 p = __builtin_convertvector(va, V32) * __builtin_convertvector(vb, V32);
+        product = (VU)__builtin_convertvector(p, VW);
+      } else {
+        VU ua = (VU)__builtin_convertvector(va, VW);
+        VU ub = (VU)__builtin_convertvector(vb, VW);
+        simd::mul_lo32(product, ua, ub);
+        if constexpr (std::is_signed_v<T>) {
+          // Signed product from the unsigned one of the low 32 bits
+          product -= (VU)((VH)ua >> 63) & (ub << 32);
+          product -= (VU)((VH)ub >> 63) & (ua << 32);
+        }
+      }
+      VU next = low + product;
+      high -= (VH)(next < low);
+      if constexpr (std::is_signed_v<T>) {
+        high += (VH)product >> 63;
+      }
+      low = next;
+    }
+    SumKernel<S>::fold(low, high, acc);
+    return i;
+  }
+#endif
+};
+
+#if PULGACPP_VECTOR_EXT
+#if PULGACPP_SIMD_X86
+template <typename Kernel, typename T>
+PULGACPP_TARGET_AVX2 std::size_t reduce_avx2(const T *a, const T *b, std::size_t n,
+                                             WideAccumulator &acc) noexcept {
+  return Kernel::template vector<32>(a, b, n, acc);
+}
+
+template <typename Kernel, typename T>
+PULGACPP_TARGET_SSE42 std::size_t reduce_sse42(const T *a, const T *b, std::size_t n,
+                                               WideAccumulator &acc) noexcept {
+  return Kernel::template vector<16>(a, b, n, acc);
+}
+#endif
+
+template <typename Kernel, typename T>
+std::size_t reduce_native(const T *a, const T *b, std::size_t n,
+                          WideAccumulator &acc) noexcept {
+  return Kernel::template vector<16>(a, b, n, acc);
+}
+#endif // PULGACPP_VECTOR_EXT
+
+/// Runs a reduction kernel on the active instruction set; the scalar loop
+/// finishes the elements left over by the vector loop.
+template <typename Kernel, typename T>
+void dispatch_reduce(const T *a, const T *b, std::size_t n,
+                     WideAccumulator &acc) noexcept {
+  std::size_t done = 0;
+#if PULGACPP_VECTOR_EXT
+  switch (simd::active_isa()) {
+#if PULGACPP_SIMD_X86
+  case simd::Isa::Avx2:
+    done = reduce_avx2<Kernel, T>(a, b, n, acc);
+    break;
+  case simd::Isa::Sse42:
+    done = reduce_sse42<Kernel, T>(a, b, n, acc);
+    break;
+#endif
+  case simd::Isa::Scalar:
+    break;
+  default:
+    done = reduce_native<Kernel, T>(a, b, n, acc);
+    break;
+  }
+#endif
+  Kernel::scalar(a + done, b == nullptr ? nullptr : b + done, n - done, acc);
+}
+
+template <typename T> struct is_modint : std::false_type {};
+template <ModularBase S, typename S::underlying_type M>
+struct is_modint<ModInt<S, M>> : std::true_type {};
+
+} // namespace detail
+
+namespace batch {
+
+// ==================== Checked arithmetic ====================
+// `out[i] = a[i] op b[i]` for every i. On overflow the error carries the
+// first overflowing index; every element of `out` is still written, with
+// overflowing elements holding the wrapped result. `out` may be the same
+// span as `a` or `b`. Panics if the span lengths differ.
+
+/// Element-wise checked addition.
+template <detail::SafeInteger S>
+[[nodiscard]] inline Result<void, Overflow>
+checked_add(std::span<const std::type_identity_t<S>> a,
+            std::span<const std::type_identity_t<S>> b,
+            std::span<S> out) noexcept {
+  return detail::run_checked<detail::CheckedAddOp<S>, S>(a, b, out);
+}
+
+/// Element-wise checked subtraction.
+template <detail::SafeInteger S>
+[[nodiscard]] inline Result<void, Overflow>
+checked_sub(std::span<const std::type_identity_t<S>> a,
+            std::span<const std::type_identity_t<S>> b,
+            std::span<S> out) noexcept {
+  return detail::run_checked<detail::CheckedSubOp<S>, S>(a, b, out);
+}
+
+/// Element-wise checked multiplication.
+template <detail::SafeInteger S>
+[[nodiscard]] inline Result<void, Overflow>
+checked_mul(std::span<const std::type_identity_t<S>> a,
+            std::span<const std::type_identity_t<S>> b,
+            std::span<S> out) noexcept {
+  return detail::run_checked<detail::CheckedMulOp<S>, S>(a, b, out);
+}
+
+// ==================== Saturating arithmetic ====================
+// `out[i] = a[i].saturating_op(b[i])`, clamping to MIN/MAX.
+
+/// Element-wise saturating addition.
+template <detail::SafeInteger S>
+inline void saturating_add(std::span<const std::type_identity_t<S>> a,
+                           std::span<const std::type_identity_t<S>> b,
+                           std::span<S> out) noexcept {
+  detail::run_total<detail::SaturatingAddOp<S>, S>(a, b, out);
+}
+
+/// Element-wise saturating subtraction.
+template <detail::SafeInteger S>
+inline void saturating_sub(std::span<const std::type_identity_t<S>> a,
+                           std::span<const std::type_identity_t<S>> b,
+                           std::span<S> out) noexcept {
+  detail::run_total<detail::SaturatingSubOp<S>, S>(a, b, out);
+}
+
+/// Element-wise saturating multiplication.
+template <detail::SafeInteger S>
+inline void saturating_mul(std::span<const std::type_identity_t<S>> a,
+                           std::span<const std::type_identity_t<S>> b,
+                           std::span<S> out) noexcept {
+  detail::run_total<detail::SaturatingMulOp<S>, S>(a, b, out);
+}
+
+// ==================== Wrapping arithmetic ====================
+// `out[i] = a[i].wrapping_op(b[i])`, modulo 2^BITS.
+
+/// Element-wise wrapping addition.
+template <detail::SafeInteger S>
+inline void wrapping_add(std::span<const std::type_identity_t<S>> a,
+                         std::span<const std::type_identity_t<S>> b,
+                         std::span<S> out) noexcept {
+  detail::run_total<detail::WrappingAddOp<S>, S>(a, b, out);
+}
+
+/// Element-wise wrapping subtraction.
+template <detail::SafeInteger S>
+inline void wrapping_sub(std::span<const std::type_identity_t<S>> a,
+                         std::span<const std::type_identity_t<S>> b,
+                         std::span<S> out) noexcept {
+  detail::run_total<detail::WrappingSubOp<S>, S>(a, b, out);
+}
+
+/// Element-wise wrapping multiplication.
+template <detail::SafeInteger S>
+inline void wrapping_mul(std::span<const std::type_identity_t<S>> a,
+                         std::span<const std::type_identity_t<S>> b,
+                         std::span<S> out) noexcept {
+  detail::run_total<detail::WrappingMulOp<S>, S>(a, b, out);
+}
+
+// ==================== Division by a Divider ====================
+// `out[i] = divider.op(a[i])` without a hardware divide. The divisor is
+// never zero, so the only error is signed MIN / -1: its index is reported
+// as an Overflow and the element holds the wrapped result (MIN for /, 0
+// for %). `out` may be the same span as `a`. Panics if the lengths differ.
+
+/// Element-wise truncating division by a precomputed divisor.
+template <detail::SafeInteger S>
+[[nodiscard]] inline Result<void, Overflow>
+checked_div(std::span<const std::type_identity_t<S>> a,
+            const Divider<S> &divider, std::span<S> out) noexcept {
+  return detail::run_divide<detail::DivideKind::Quotient, S>(a, divider, out);
+}
+
+/// Element-wise remainder (sign of the dividend) by a precomputed divisor.
+template <detail::SafeInteger S>
+[[nodiscard]] inline Result<void, Overflow>
+checked_rem(std::span<const std::type_identity_t<S>> a,
+            const Divider<S> &divider, std::span<S> out) noexcept {
+  return detail::run_divide<detail::DivideKind::Remainder, S>(a, divider, out);
+}
+
+/// Element-wise division rounded towards negative infinity.
+template <detail::SafeInteger S>
+[[nodiscard]] inline Result<void, Overflow>
+div_floor(std::span<const std::type_identity_t<S>> a,
+          const Divider<S> &divider, std::span<S> out) noexcept {
+  return detail::run_divide<detail::DivideKind::Floor, S>(a, divider, out);
+}
+
+// ==================== Reductions ====================
+// Sums and dot products are computed exactly, wider than S, and checked
+// once at the end: an intermediate total outside S's range is fine as long
+// as the final one fits (a sequential fold over checked_add would give up
+// at the first overflowing prefix). Products are full width too, so a dot
+// product overflows only if its value does. Use checked_prefix_sum when
+// every prefix has to fit.
+
+/// Exact running total of values or products, for reducing a long span
+/// in pieces. Accumulators of different pieces can be merged in any order
+/// with the same result, so each thread can reduce its own chunk.
+template <detail::SafeInteger S>
+  requires(S::BITS <= 64)
+class Accumulator {
+  using T = typename S::underlying_type;
+
+public:
+  /// Adds every value.
+  void add(std::span<const std::type_identity_t<S>> values) noexcept {
+    detail::dispatch_reduce<detail::SumKernel<S>, T>(
+        detail::simd::raw_ptr<T>(values.data()), nullptr, values.size(), m_sum);
+  }
+
+  /// Adds `a[i] * b[i]` for every i. Panics if the lengths differ.
+  void add_products(std::span<const std::type_identity_t<S>> a,
+                    std::span<const std::type_identity_t<S>> b) noexcept {
+    if (a.size() != b.size()) {
+      panic("batch: span lengths differ");
+    }
+    const T *pa = detail::simd::raw_ptr<T>(a.data());
+    const T *pb = detail::simd::raw_ptr<T>(b.data());
+    if constexpr (sizeof(T) == 8) {
+      // No 64x64->128 vector multiply
+      detail::DotKernel<S>::scalar(pa, pb, a.size(), m_sum);
+    } else {
+      detail::dispatch_reduce<detail::DotKernel<S>, T>(pa, pb, a.size(), m_sum);
+    }
+  }
+
+  /// Adds the total of another accumulator.
+  void merge(const Accumulator &other) noexcept { m_sum.merge(other.m_sum); }
+
+  /// The total, or None if it does not fit in S.
+  [[nodiscard]] Optional<S> total() const noexcept {
+    if (!m_sum.fits<T>()) {
+      return None;
+    }
+    return Some(S(m_sum.low<T>()));
+  }
+
+  /// The total clamped to S::MIN / S::MAX.
+  [[nodiscard]] S saturating_total() const noexcept {
+    if (!m_sum.fits<T>()) {
+      return S(m_sum.is_negative() ? S::MIN : S::MAX);
+    }
+    return S(m_sum.low<T>());
+  }
+
+private:
+  detail::WideAccumulator m_sum;
+};
+
+/// Sum of all values, or None if it does not fit in S.
+template <detail::SafeInteger S>
+  requires(S::BITS <= 64)
+[[nodiscard]] inline Optional<S>
+checked_sum(std::span<const std::type_identity_t<S>> values) noexcept {
+  Accumulator<S> sum;
+  sum.add(values);
+  return sum.total();
+}
+
+/// Sum of all values clamped to S::MIN / S::MAX. This clamps the exact
+/// sum, which is not always what folding saturating_add would give.
+template <detail::SafeInteger S>
+  requires(S::BITS <= 64)
+[[nodiscard]] inline S
+saturating_sum(std::span<const std::type_identity_t<S>> values) noexcept {
+  Accumulator<S> sum;
+  sum.add(values);
+  return sum.saturating_total();
+}
+
+/// Sum of `a[i] * b[i]`, or None if it does not fit in S. Panics if the
+/// lengths differ.
+template <detail::SafeInteger S>
+  requires(S::BITS <= 64)
+[[nodiscard]] inline Optional<S>
+checked_dot(std::span<const std::type_identity_t<S>> a,
+            std::span<const std::type_identity_t<S>> b) noexcept {
+  Accumulator<S> sum;
+  sum.add_products(a, b);
+  return sum.total();
+}
+
+/// Product of all values (1 for an empty span), or None if it does not fit
+/// in S. Like the sums, only the final value is checked: a zero anywhere
+/// makes the product zero.
+template <detail::SafeInteger S>
+  requires(S::BITS <= 64)
+[[nodiscard]] inline Optional<S>
+checked_product(std::span<const std::type_identity_t<S>> values) noexcept {
+  using T = typename S::underlying_type;
+  using U = typename S::unsigned_type;
+  using W = std::uint64_t;
+  if (std::find(values.begin(), values.end(), S(T(0))) != values.end()) {
+    return Some(S(T(0)));
+  }
+  // |product| only grows, so once it passes 2^BITS it never fits again
+  U magnitude = 1;
+  bool negative = false;
+  for (S value : values) {
+    T v = value.get();
+    U abs = static_cast<U>(v);
+    if constexpr (std::is_signed_v<T>) {
+      negative ^= v < 0;
+      abs = v < 0 ? static_cast<U>(U(0) - abs) : abs;
+    }
+    if constexpr (sizeof(T) == 8) {
+      auto [next, overflow] = detail::checked_mul_native<U>(magnitude, abs);
+      if (overflow) {
+        return None;
+      }
+      magnitude = next;
+    } else {
+      // Both factors fit in 32 bits, so the product fits in W
+      auto next = static_cast<W>(magnitude) * static_cast<W>(abs);
+      if (next > static_cast<W>(static_cast<U>(~U(0)))) {
+        return None;
+      }
+      magnitude = static_cast<U>(next);
+    }
+  }
+  if constexpr (std::is_signed_v<T>) {
+    constexpr U limit = static_cast<U>(S::MAX);
+    if (magnitude > limit + (negative ? 1 : 0)) {
+      return None;
+    }
+    return Some(S(static_cast<T>(negative ? U(0) - magnitude : magnitude)));
+  } else {
+    return Some(S(magnitude));
+  }
+}
+
+/// `out[i] = values[0] + ... + values[i]`, checking every prefix. The
+/// error is the first index whose prefix overflows, exactly as a loop over
+/// checked_add would report; `out` is written up to that index and the
+/// rest is unspecified. `out` may be the same span as `values`. Panics if
+/// the lengths differ.
+template <detail::SafeInteger S>
+[[nodiscard]] inline Result<void, Overflow>
+checked_prefix_sum(std::span<const std::type_identity_t<S>> values,
+                   std::span<S> out) noexcept {
+  using T = typename S::underlying_type;
+  if (values.size() != out.size()) {
+    panic("batch: span lengths differ");
+  }
+  const T *in = detail::simd::raw_ptr<T>(values.data());
+  T *result = detail::simd::raw_ptr<T>(out.data());
+  auto add = [](T a, T b) -> std::pair<T, bool> {
+    if constexpr (sizeof(T) >= 8) {
+      return detail::checked_add_native<T>(a, b);
+    } else {
+      auto sum = static_cast<std::int64_t>(a) + static_cast<std::int64_t>(b);
+      return {static_cast<T>(sum), sum < S::MIN || sum > S::MAX};
+    }
+  };
+  // A serial chain with no branch per element: overflow flags of a block
+  // of 64 are collected in a mask and looked at once per block
+  T running = 0;
+  constexpr std::size_t BLOCK = 64;
+  for (std::size_t start = 0; start < values.size(); start += BLOCK) {
+    std::size_t stop = std::min(values.size(), start + BLOCK);
+    std::uint64_t overflowed = 0;
+    for (std::size_t i = start; i < stop; ++i) {
+      auto [next, flag] = add(running, in[i]);
+      overflowed |= std::uint64_t(flag) << (i - start);
+      running = next;
+      result[i] = next;
+    }
+    if (overflowed != 0) {
+      return Err(Overflow{start + static_cast<std::size_t>(std::countr_zero(overflowed))});
+    }
+  }
+  return Result<void, Overflow>::ok();
+}
+
+// ==================== Modular arithmetic ====================
+// Bulk products and powers modulo a ModInt's compile-time modulus or a
+// runtime Montgomery / Barrett reducer. These cannot fail. u32 Montgomery
+// uses the vector kernels; 64-bit moduli and Barrett run a scalar loop,
+// which the 64x64->128 multiply keeps fast. `out` may alias an input.
+// Panics if the lengths differ.
+
+/// `out[i] = a[i] * b[i]` in the ring of `Mod`.
+template <typename Mod>
+  requires detail::is_modint<Mod>::value
+inline void mul(std::span<const std::type_identity_t<Mod>> a,
+                std::span<const std::type_identity_t<Mod>> b,
+                std::span<Mod> out) noexcept {
+  detail::run_modular<detail::ModKind::RawMul>(Mod::reducer(), a, b, out);
+}
+
+/// `out[i] = base[i]^exponent` in the ring of `Mod`.
+template <typename Mod>
+  requires detail::is_modint<Mod>::value
+inline void pow(std::span<const std::type_identity_t<Mod>> base,
+                std::uint64_t exponent, std::span<Mod> out) noexcept {
+  detail::run_modular<detail::ModKind::RawPow>(Mod::reducer(), base, exponent,
+                                              out);
+}
+
+/// `out[i] = a[i] * b[i] mod m` for any plain values.
+template <detail::ModularBase S>
+inline void mul_mod(std::span<const std::type_identity_t<S>> a,
+                    std::span<const std::type_identity_t<S>> b,
+                    const Montgomery<S> &reducer, std::span<S> out) noexcept {
+  detail::run_modular<detail::ModKind::MulMod>(reducer, a, b, out);
+}
+
+template <detail::ModularBase S>
+inline void mul_mod(std::span<const std::type_identity_t<S>> a,
+                    std::span<const std::type_identity_t<S>> b,
+                    const Barrett<S> &reducer, std::span<S> out) noexcept {
+  detail::run_modular<detail::ModKind::MulMod>(reducer, a, b, out);
+}
+
+/// `out[i] = base[i]^exponent mod m` for any plain values.
+template <detail::ModularBase S>
+inline void pow_mod(std::span<const std::type_identity_t<S>> base,
+                    std::uint64_t exponent, const Montgomery<S> &reducer,
+                    std::span<S> out) noexcept {
+  detail::run_modular<detail::ModKind::PowMod>(reducer, base, exponent, out);
+}
+
+template <detail::ModularBase S>
+inline void pow_mod(std::span<const std::type_identity_t<S>> base,
+                    std::uint64_t exponent, const Barrett<S> &reducer,
+                    std::span<S> out) noexcept {
+  detail::run_modular<detail::ModKind::PowMod>(reducer, base, exponent, out);
+}
+
+// ==================== Text ====================
+// Whole-buffer versions of S::parse and S::to_chars for delimited numeric
+// text (one value per line, CSV columns, ...).
+
+/// Parses every `delimiter`-separated field of `text` and appends the values
+/// to `out`. A single trailing delimiter is allowed. Stops at the first bad
+/// field; its error position is an offset into `text`, and `out` keeps the
+/// values parsed before it.
+template <detail::SafeInteger S>
+[[nodiscard]] inline Result<void, ParseError>
+parse_into(std::string_view text, std::vector<S> &out, char delimiter = '\n') {
+  const char *origin = text.data();
+  const char *p = origin;
+  const char *last = origin + text.size();
+  while (p != last) {
+    auto parsed =
+        detail::parse_integer<typename S::underlying_type>(p, last, origin);
+    if (!parsed.ok) {
+      if (parsed.error.kind == ParseError::Kind::InvalidDigit &&
+          parsed.ptr == p && *p == delimiter) {
+        // Empty field between two delimiters
+        return Err(ParseError{ParseError::Kind::Empty, parsed.error.position});
+      }
+      return Err(parsed.error);
+    }
+    out.push_back(S(parsed.value));
+    p = parsed.ptr;
+    if (p == last) {
+      break;
+    }
+    if (*p != delimiter) {
+      return Err(ParseError{ParseError::Kind::InvalidDigit,
+                            static_cast<std::size_t>(p - origin)});
+    }
+    ++p;
+  }
+  return Result<void, ParseError>::ok();
+}
+
+/// Parses every `delimiter`-separated field of `text` into a new vector.
+template <detail::SafeInteger S>
+[[nodiscard]] inline Result<std::vector<S>, ParseError>
+parse(std::string_view text, char delimiter = '\n') {
+  std::vector<S> values;
+  auto result = parse_into<S>(text, values, delimiter);
+  if (result.is_err()) {
+    return Err(result.unwrap_err());
+  }
+  return Ok(std::move(values));
+}
+
+/// Appends `values` to `out` in decimal, separated by `delimiter` (no
+/// trailing delimiter). The output round-trips through parse().
+template <detail::SafeInteger S>
+inline void format_into(std::span<const std::type_identity_t<S>> values,
+                        std::string &out, char delimiter = '\n') {
+  if (values.empty()) {
+    return;
+  }
+  // Reserve the worst case once and write straight into the string
+  std::size_t start = out.size();
+  out.resize(start + values.size() * (S::MAX_CHARS + 1));
+  char *p = out.data() + start;
+  char *last = out.data() + out.size();
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    if (i != 0) {
+      *p++ = delimiter;
+    }
+    p = values[i].to_chars(p, last).ptr;
+  }
+  out.resize(static_cast<std::size_t>(p - out.data()));
+}
+
+} // namespace batch
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_BATCH_HPP
@@ -0,0 +1,87 @@
+// Benchmark: checked reductions against a sequential checked_add fold
+// Compile: g++ -std=c++23 -O2 -I../.. bench_batch.cpp -o bench_batch
+
+#include "batch.hpp"
+#include "../i32/i32.hpp"
+#include "../i64/i64.hpp"
+#include "../i8/i8.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace pulgacpp;
+using detail::simd::Isa;
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 20;
+constexpr int ROUNDS = 50;
+
+/// Keeps `value` alive without letting the compiler see through it.
+template <typename T> void keep(T &value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+template <typename F> void run(const char *name, F body) {
+    body(); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        body();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-36s %8.3f ns/value\n", name, ns / (double(ROUNDS) * COUNT));
+}
+
+template <typename S> void bench(const char *title) {
+    using T = typename S::underlying_type;
+    std::printf("\n--- %s ---\n", title);
+    std::mt19937_64 rng(42);
+    std::vector<S> a(COUNT), b(COUNT), out(COUNT);
+    for (std::size_t i = 0; i < COUNT; i += 2) {
+        // Pairs x, -x keep every prefix small, so the fold never stops early
+        auto x = static_cast<T>(rng() % 64);
+        a[i] = S(x);
+        a[i + 1] = S(static_cast<T>(-x));
+        b[i] = S(static_cast<T>(rng() % 64));
+        b[i + 1] = S(static_cast<T>(rng() % 64));
+    }
+
+    run("fold with checked_add", [&] {
+        Optional<S> sum = Some(S(T(0)));
+        for (std::size_t i = 0; i < COUNT && sum.is_some(); ++i) {
+            sum = sum.unwrap().checked_add(a[i]);
+        }
+        keep(sum);
+    });
+    run("checked_prefix_sum", [&] {
+        auto r = batch::checked_prefix_sum<S>(a, out);
+        keep(r);
+    });
+    for (Isa isa : {Isa::Scalar, Isa::Avx2}) {
+        detail::simd::set_active_isa(isa);
+        const char *suffix = isa == Isa::Scalar ? "scalar" : "best instruction set";
+        char name[64];
+        std::snprintf(name, sizeof(name), "checked_sum %s", suffix);
+        run(name, [&] {
+            auto sum = batch::checked_sum<S>(a);
+            keep(sum);
+        });
+        std::snprintf(name, sizeof(name), "checked_dot %s", suffix);
+        run(name, [&] {
+            auto dot = batch::checked_dot<S>(a, b);
+            keep(dot);
+        });
+    }
+}
+
+} // namespace
+
+int main() {
+    std::printf("=== Checked reductions (%zu values) ===\n", COUNT);
+    bench<i8>("i8");
+    bench<i32>("i32");
+    bench<i64>("i64");
+    return 0;
+}
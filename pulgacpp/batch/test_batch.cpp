@@ -0,0 +1,545 @@
+// Test suite for pulgacpp::batch
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. test_batch.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. test_batch.cpp -o test_batch
+
+#include "batch.hpp"
+#include "../i16/i16.hpp"
+#include "../i32/i32.hpp"
+#include "../i64/i64.hpp"
+#include "../i8/i8.hpp"
+#include "../u16/u16.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include "../u8/u8.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+using detail::simd::Isa;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const std::string &name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+const char *isa_name(Isa isa) {
+  switch (isa) {
+  case Isa::Scalar:
+    return "scalar";
+  case Isa::Native:
+    return "native";
+  case Isa::Sse42:
+    return "sse4.2";
+  case Isa::Avx2:
+    return "avx2";
+  }
+  return "?";
+}
+
+/// Random values biased towards the edges of the range so that overflow
+/// happens on a good fraction of elements.
+template <typename S> std::vector<S> random_values(std::size_t n, unsigned seed) {
+  using T = typename S::underlying_type;
+  std::mt19937_64 rng(seed);
+  std::vector<S> values(n);
+  for (auto &v : values) {
+    auto bits = rng();
+    switch (bits % 4) {
+    case 0:
+      v = S(static_cast<T>(S::MAX - static_cast<T>((bits >> 8) % 4)));
+      break;
+    case 1:
+      v = S(static_cast<T>(S::MIN + static_cast<T>((bits >> 8) % 4)));
+      break;
+    case 2:
+      v = S(static_cast<T>((bits >> 8) % 16));
+      break;
+    default:
+      v = S(static_cast<T>(bits >> 8));
+      break;
+    }
+  }
+  return values;
+}
+
+/// Compares a bulk checked op with the per-element Optional-returning one.
+template <typename S, typename Bulk, typename Single>
+bool matches_scalar(Bulk bulk, Single single, std::size_t n, unsigned seed) {
+  auto a = random_values<S>(n, seed);
+  auto b = random_values<S>(n, seed + 1);
+  std::vector<S> out(n);
+
+  auto result = bulk(std::span<const S>(a), std::span<const S>(b),
+                     std::span<S>(out));
+
+  std::size_t expected_first = n;
+  for (std::size_t i = 0; i < n; ++i) {
+    Optional<S> r = single(a[i], b[i]);
+    if (r.is_some()) {
+      if (out[i] != r.unwrap()) {
+        return false;
+      }
+    } else if (expected_first == n) {
+      expected_first = i;
+    }
+  }
+  if (expected_first == n) {
+    return result.is_ok();
+  }
+  return result.is_err() && result.unwrap_err().index == expected_first;
+}
+
+/// Compares a bulk saturating/wrapping op with the per-element method.
+template <typename S, typename Bulk, typename Single>
+bool matches_total(Bulk bulk, Single single, std::size_t n, unsigned seed) {
+  auto a = random_values<S>(n, seed);
+  auto b = random_values<S>(n, seed + 1);
+  std::vector<S> out(n);
+
+  bulk(std::span<const S>(a), std::span<const S>(b), std::span<S>(out));
+
+  for (std::size_t i = 0; i < n; ++i) {
+    if (out[i] != single(a[i], b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Compares a bulk division by `divisor` with the Divider's own method.
+template <typename S, typename Bulk, typename Single>
+bool matches_divider(Bulk bulk, Single single, S divisor, std::size_t n,
+                     unsigned seed) {
+  auto a = random_values<S>(n, seed);
+  auto divider = Divider<S>::from(divisor).unwrap();
+  std::vector<S> out(n);
+
+  auto result = bulk(std::span<const S>(a), divider, std::span<S>(out));
+
+  std::size_t expected_first = n;
+  for (std::size_t i = 0; i < n; ++i) {
+    Optional<S> r = single(divider, a[i]);
+    if (r.is_some()) {
+      if (out[i] != r.unwrap()) {
+        return false;
+      }
+    } else if (expected_first == n) {
+      expected_first = i;
+    }
+  }
+  if (expected_first == n) {
+    return result.is_ok();
+  }
+  return result.is_err() && result.unwrap_err().index == expected_first;
+}
+
+template <typename S> void test_divide(const std::string &suffix) {
+  using T = typename S::underlying_type;
+  std::vector<T> divisors = {T(1), T(3), T(7), T(16), T(100), S::MAX};
+  if constexpr (S::MIN < 0) {
+    divisors.insert(divisors.end(), {T(-1), T(-7), S::MIN});
+  }
+  bool div_ok = true, rem_ok = true, floor_ok = true;
+  for (T d : divisors) {
+    for (std::size_t n : {0u, 5u, 33u, 1000u}) {
+      div_ok &= matches_divider<S>(
+          [](auto a, auto &dv, auto o) { return batch::checked_div<S>(a, dv, o); },
+          [](auto &dv, S x) { return dv.checked_div(x); }, S(d), n, 101);
+      rem_ok &= matches_divider<S>(
+          [](auto a, auto &dv, auto o) { return batch::checked_rem<S>(a, dv, o); },
+          [](auto &dv, S x) { return dv.checked_rem(x); }, S(d), n, 202);
+      floor_ok &= matches_divider<S>(
+          [](auto a, auto &dv, auto o) { return batch::div_floor<S>(a, dv, o); },
+          [](auto &dv, S x) { return dv.div_floor(x); }, S(d), n, 303);
+    }
+  }
+  test(div_ok, "checked_div by Divider matches scalar" + suffix);
+  test(rem_ok, "checked_rem by Divider matches scalar" + suffix);
+  test(floor_ok, "div_floor by Divider matches scalar" + suffix);
+}
+
+/// Bulk modular products and powers against the reducers' own scalar
+/// functions, for odd (Montgomery) and even (Barrett) moduli.
+template <typename S> void test_modular(const char *type_name, Isa isa) {
+  using T = typename S::underlying_type;
+  std::string suffix =
+      std::string(" (") + type_name + ", " + isa_name(isa) + ")";
+  bool mont_ok = true, barrett_ok = true;
+  for (T m : {T(1), T(3), T(1000000007), T(S::MAX), T(S::MAX - 58), T(S::MAX / 3)}) {
+    auto mont = Montgomery<S>::from(S(m)).unwrap();
+    auto barrett = Barrett<S>::from(S(T(m - 1 + (m == 1)))).unwrap();
+    for (std::size_t n : {0u, 1u, 7u, 33u, 1000u}) {
+      auto a = random_values<S>(n, 404), b = random_values<S>(n, 505);
+      std::vector<S> out(n), pow_out(n);
+      batch::mul_mod<S>(a, b, mont, out);
+      batch::pow_mod<S>(a, 65537, mont, pow_out);
+      for (std::size_t i = 0; i < n; ++i) {
+        mont_ok &= out[i] == mont.mul_mod(a[i], b[i]) &&
+                   pow_out[i] == mont.pow_mod(a[i], 65537);
+      }
+      batch::mul_mod<S>(a, b, barrett, out);
+      batch::pow_mod<S>(a, 65537, barrett, pow_out);
+      for (std::size_t i = 0; i < n; ++i) {
+        barrett_ok &= out[i] == barrett.mul_mod(a[i], b[i]) &&
+                      pow_out[i] == barrett.pow_mod(a[i], 65537);
+      }
+    }
+  }
+  test(mont_ok, "mul_mod / pow_mod with Montgomery match scalar" + suffix);
+  test(barrett_ok, "mul_mod / pow_mod with Barrett match scalar" + suffix);
+
+  using Fp = ModInt<S, T(S::MAX - 58)>;
+  auto values = random_values<S>(1000, 606);
+  std::vector<Fp> a(values.size()), b(values.size()), out(values.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    a[i] = Fp::from(values[i]);
+    b[i] = Fp::from(values[values.size() - 1 - i]);
+  }
+  batch::mul<Fp>(a, b, out);
+  bool mul_ok = true;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    mul_ok &= out[i] == a[i] * b[i];
+  }
+  batch::pow<Fp>(a, 12345, out);
+  bool pow_ok = true;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    pow_ok &= out[i] == a[i].pow(12345);
+  }
+  test(mul_ok && pow_ok, "ModInt mul / pow match scalar" + suffix);
+}
+
+template <typename S> void test_width(const char *type_name, Isa isa) {
+  std::string suffix =
+      std::string(" (") + type_name + ", " + isa_name(isa) + ")";
+
+  for (std::size_t n : {0u, 1u, 7u, 33u, 1000u}) {
+    std::string size = " n=" + std::to_string(n);
+    test(matches_scalar<S>(
+             [](auto a, auto b, auto o) { return batch::checked_add<S>(a, b, o); },
+             [](S x, S y) { return x.checked_add(y); }, n, 11),
+         "checked_add matches SafeInt" + size + suffix);
+    test(matches_scalar<S>(
+             [](auto a, auto b, auto o) { return batch::checked_sub<S>(a, b, o); },
+             [](S x, S y) { return x.checked_sub(y); }, n, 22),
+         "checked_sub matches SafeInt" + size + suffix);
+    test(matches_scalar<S>(
+             [](auto a, auto b, auto o) { return batch::checked_mul<S>(a, b, o); },
+             [](S x, S y) { return x.checked_mul(y); }, n, 33),
+         "checked_mul matches SafeInt" + size + suffix);
+
+    test(matches_total<S>(
+             [](auto a, auto b, auto o) { batch::saturating_add<S>(a, b, o); },
+             [](S x, S y) { return x.saturating_add(y); }, n, 44),
+         "saturating_add matches SafeInt" + size + suffix);
+    test(matches_total<S>(
+             [](auto a, auto b, auto o) { batch::saturating_sub<S>(a, b, o); },
+             [](S x, S y) { return x.saturating_sub(y); }, n, 55),
+         "saturating_sub matches SafeInt" + size + suffix);
+    test(matches_total<S>(
+             [](auto a, auto b, auto o) { batch::saturating_mul<S>(a, b, o); },
+             [](S x, S y) { return x.saturating_mul(y); }, n, 66),
+         "saturating_mul matches SafeInt" + size + suffix);
+    test(matches_total<S>(
+             [](auto a, auto b, auto o) { batch::wrapping_add<S>(a, b, o); },
+             [](S x, S y) { return x.wrapping_add(y); }, n, 77),
+         "wrapping_add matches SafeInt" + size + suffix);
+    test(matches_total<S>(
+             [](auto a, auto b, auto o) { batch::wrapping_sub<S>(a, b, o); },
+             [](S x, S y) { return x.wrapping_sub(y); }, n, 88),
+         "wrapping_sub matches SafeInt" + size + suffix);
+    test(matches_total<S>(
+             [](auto a, auto b, auto o) { batch::wrapping_mul<S>(a, b, o); },
+             [](S x, S y) { return x.wrapping_mul(y); }, n, 99),
+         "wrapping_mul matches SafeInt" + size + suffix);
+  }
+  test_divide<S>(suffix);
+}
+
+/// Sums, dot products and prefix sums against an exact __int128 reference.
+/// The sums of random edge values overflow S on the way but not always at
+/// the end, which is the case a sequential checked fold gets wrong.
+template <typename S> void test_reduction(const char *type_name, Isa isa) {
+  using T = typename S::underlying_type;
+  std::string suffix =
+      std::string(" (") + type_name + ", " + isa_name(isa) + ")";
+  auto fits = [](__int128 v) { return v >= __int128(S::MIN) && v <= __int128(S::MAX); };
+  auto clamp = [](__int128 v) {
+    return S(static_cast<T>(v < __int128(S::MIN) ? __int128(S::MIN)
+                            : v > __int128(S::MAX) ? __int128(S::MAX)
+                                                   : v));
+  };
+
+  bool sum_ok = true, sat_ok = true, dot_ok = true, prefix_ok = true;
+  for (std::size_t n : {0u, 1u, 7u, 33u, 1000u}) {
+    for (unsigned seed : {1u, 2u, 3u}) {
+      auto a = random_values<S>(n, seed), b = random_values<S>(n, seed + 10);
+      // Cancel most of the sum so that some totals fit
+      for (std::size_t i = 1; i < n; i += 2) {
+        if constexpr (S::MIN < 0) {
+          a[i] = a[i - 1].wrapping_neg();
+        }
+      }
+      __int128 sum = 0, dot = 0;
+      bool dot_huge = false; // beyond __int128, so certainly beyond S
+      for (std::size_t i = 0; i < n; ++i) {
+        sum += __int128(a[i].get());
+        using P = std::conditional_t<S::MIN < 0, __int128, unsigned __int128>;
+        P product = P(a[i].get()) * P(b[i].get());
+        dot_huge |= __builtin_add_overflow(dot, product, &dot);
+      }
+      Optional<S> total = batch::checked_sum<S>(a);
+      sum_ok &= fits(sum) ? total.is_some() && total.unwrap() == S(static_cast<T>(sum))
+                          : total.is_none();
+      sat_ok &= batch::saturating_sum<S>(a) == clamp(sum);
+      Optional<S> product = batch::checked_dot<S>(a, b);
+      dot_ok &= !dot_huge && fits(dot) ? product.is_some() && product.unwrap() == S(static_cast<T>(dot))
+                          : product.is_none();
+
+      std::vector<S> out(n);
+      auto prefix = batch::checked_prefix_sum<S>(a, out);
+      __int128 running = 0;
+      std::size_t expected_first = n;
+      for (std::size_t i = 0; i < n; ++i) {
+        running += __int128(a[i].get());
+        if (!fits(running)) {
+          expected_first = i;
+          break;
+        }
+        prefix_ok &= out[i] == S(static_cast<T>(running));
+      }
+      prefix_ok &= expected_first == n
+                       ? prefix.is_ok()
+                       : prefix.is_err() && prefix.unwrap_err().index == expected_first;
+    }
+  }
+  test(sum_ok, "checked_sum matches exact sum" + suffix);
+  test(sat_ok, "saturating_sum clamps the exact sum" + suffix);
+  test(dot_ok, "checked_dot matches exact dot product" + suffix);
+  test(prefix_ok, "checked_prefix_sum reports the first overflowing prefix" + suffix);
+
+  // Chunks accumulated separately and merged give the same total
+  auto values = random_values<S>(1000, 77);
+  batch::Accumulator<S> whole, left, right;
+  whole.add(values);
+  left.add(std::span<const S>(values).first(333));
+  right.add(std::span<const S>(values).subspan(333));
+  left.merge(right);
+  test(left.saturating_total() == whole.saturating_total() &&
+           left.total().is_some() == whole.total().is_some(),
+       "merged chunks equal one pass" + suffix);
+}
+
+int main() {
+  std::cout << "=== pulgacpp::batch Test Suite ===\n\n";
+
+  // --- Basic behaviour ---
+  std::cout << "--- Basics ---\n";
+  {
+    std::vector<i32> a(100, 1_i32), b(100, 2_i32), out(100);
+    auto ok = batch::checked_add<i32>(a, b, out);
+    test(ok.is_ok(), "checked_add without overflow is Ok");
+    test(out[0] == 3_i32 && out[99] == 3_i32, "checked_add writes every element");
+
+    a[42] = i32(i32::MAX);
+    a[77] = i32(i32::MAX);
+    auto err = batch::checked_add<i32>(a, b, out);
+    test(err.is_err(), "checked_add with overflow is Err");
+    test(err.unwrap_err().index == 42, "Err carries the first overflowing index");
+    test(out[43] == 3_i32 && out[99] == 3_i32,
+         "elements after the overflow are still computed");
+    test(out[42] == i32(i32::MAX).wrapping_add(2_i32),
+         "overflowing element holds the wrapped value");
+
+    auto in_place = batch::checked_mul<i32>(b, b, std::span<i32>(b));
+    test(in_place.is_ok() && b[0] == 4_i32, "output may alias an input");
+
+    std::vector<u8> x{250_u8, 1_u8}, y{10_u8, 1_u8}, z(2);
+    auto sub = batch::checked_sub<u8>(y, x, z);
+    test(sub.is_err() && sub.unwrap_err().index == 0, "u8 checked_sub underflow index");
+  }
+
+  // --- Saturating / wrapping ---
+  std::cout << "\n--- Saturating and Wrapping ---\n";
+  {
+    std::vector<u8> pixels{10_u8, 200_u8, 250_u8}, gain{50_u8, 50_u8, 50_u8}, out(3);
+    batch::saturating_add<u8>(pixels, gain, out);
+    test(out[0] == 60_u8 && out[1] == 250_u8 && out[2] == u8(u8::MAX),
+         "u8 saturating_add clamps at 255");
+
+    std::vector<i16> samples{i16(static_cast<std::int16_t>(-30000)), 1000_i16};
+    std::vector<i16> boost{i16(static_cast<std::int16_t>(-10000)), 2000_i16}, mixed(2);
+    batch::saturating_add<i16>(samples, boost, mixed);
+    test(mixed[0] == i16(i16::MIN) && mixed[1] == 3000_i16,
+         "i16 saturating_add clamps at MIN");
+
+    batch::saturating_mul<i16>(samples, boost, mixed);
+    test(mixed[0] == i16(i16::MAX), "i16 saturating_mul clamps at MAX");
+
+    std::vector<u32> h{0xFFFFFFFF_u32}, k{2_u32}, w(1);
+    batch::wrapping_mul<u32>(h, k, w);
+    test(w[0] == 0xFFFFFFFE_u32, "u32 wrapping_mul wraps");
+  }
+
+  // --- Division ---
+  std::cout << "\n--- Division by a Divider ---\n";
+  {
+    std::vector<u32> hashes{0_u32, 99_u32, 1000_u32, u32(u32::MAX)}, buckets(4);
+    auto by_ten = Divider<u32>::from(10_u32).unwrap();
+    auto ok = batch::checked_rem<u32>(hashes, by_ten, buckets);
+    test(ok.is_ok() && buckets[1] == 9_u32 && buckets[3] == 5_u32,
+         "checked_rem by Divider");
+
+    std::vector<i32> values{i32(-7), 7_i32, i32(i32::MIN), 3_i32}, out(4);
+    auto floor = batch::div_floor<i32>(values, Divider<i32>::from(2_i32).unwrap(), out);
+    test(floor.is_ok() && out[0] == i32(-4) && out[1] == 3_i32, "div_floor rounds down");
+    auto minus_one = Divider<i32>::from(i32(-1)).unwrap();
+    auto err = batch::checked_div<i32>(values, minus_one, std::span<i32>(values));
+    test(err.is_err() && err.unwrap_err().index == 2, "MIN / -1 is reported by index");
+    test(values[0] == 7_i32 && values[2] == i32(i32::MIN), "in place, MIN / -1 wraps");
+  }
+
+  // --- Modular arithmetic ---
+  std::cout << "\n--- Modular Arithmetic ---\n";
+  {
+    using Fp = ModInt<u32, 998244353>;
+    std::vector<Fp> a{Fp::from(2), Fp::from(-1), Fp::from(12345)};
+    std::vector<Fp> b{Fp::from(3), Fp::from(-1), Fp()}, out(3);
+    batch::mul<Fp>(a, b, out);
+    test(out[0] == Fp::from(6) && out[1] == Fp::from(1) && out[2] == Fp(),
+         "mul over ModInt spans");
+    batch::pow<Fp>(a, 998244352, std::span<Fp>(a));
+    test(a[0] == Fp::from(1) && a[2] == Fp::from(1), "pow in place (Fermat)");
+
+    auto mont = Montgomery<u64>::from(u64(std::uint64_t{1000000007})).unwrap();
+    std::vector<u64> x{u64(u64::MAX), 2_u64}, y{2_u64, 500000004_u64}, z(2);
+    batch::mul_mod<u64>(x, y, mont, z);
+    test(z[0] == u64(static_cast<std::uint64_t>(
+                     static_cast<unsigned __int128>(u64::MAX) * 2 % 1000000007)) &&
+             z[1] == 1_u64,
+         "mul_mod with a runtime Montgomery modulus");
+    auto barrett = Barrett<u32>::from(1000000_u32).unwrap();
+    std::vector<u32> bases{100_u32, 7_u32}, powers(2);
+    batch::pow_mod<u32>(bases, 3, barrett, powers);
+    test(powers[0] == 0_u32 && powers[1] == 343_u32, "pow_mod with an even Barrett modulus");
+  }
+
+  // --- Reductions ---
+  std::cout << "\n--- Reductions ---\n";
+  {
+    std::vector<i32> ledger{i32(i32::MAX), 10_i32, i32(-20), i32(i32::MIN)};
+    auto sum = batch::checked_sum<i32>(ledger);
+    test(sum.is_some() && sum.unwrap() == i32(-11),
+         "checked_sum only checks the final total");
+    std::vector<i32> fold = ledger;
+    test(batch::checked_prefix_sum<i32>(fold, std::span<i32>(fold)).unwrap_err().index == 1,
+         "checked_prefix_sum stops at the first overflowing prefix");
+
+    std::vector<u8> big{200_u8, 200_u8};
+    test(batch::checked_sum<u8>(big).is_none(), "u8 sum above 255 is None");
+    test(batch::saturating_sum<u8>(big) == u8(u8::MAX), "saturating_sum clamps");
+
+    std::vector<i64> x{i64(i64::MAX), i64(i64::MAX)}, y{2_i64, i64(std::int64_t{-2})};
+    auto dot = batch::checked_dot<i64>(x, y);
+    test(dot.is_some() && dot.unwrap() == 0_i64, "checked_dot products are full width");
+
+    std::vector<u8> empty;
+    test(batch::checked_sum<u8>(empty).unwrap() == 0_u8, "empty sum is zero");
+    test(batch::checked_product<u8>(empty).unwrap() == 1_u8, "empty product is one");
+    std::vector<i8> factors{i8(std::int8_t{-2}), 4_i8, 16_i8};
+    test(batch::checked_product<i8>(factors).unwrap() == i8(i8::MIN),
+         "checked_product reaches MIN");
+    factors[0] = 2_i8;
+    test(batch::checked_product<i8>(factors).is_none(), "checked_product overflow");
+    std::vector<u16> zeroed{u16(u16::MAX), u16(u16::MAX), 0_u16};
+    test(batch::checked_product<u16>(zeroed).unwrap() == 0_u16,
+         "a zero factor makes the product zero");
+  }
+
+  // --- Text ---
+  std::cout << "\n--- Text ---\n";
+  {
+    auto lines = batch::parse<i32>("12\n-7\n2147483647\n");
+    test(lines.is_ok() && lines.unwrap() == std::vector<i32>{12_i32, i32(-7), i32(i32::MAX)},
+         "parse newline-separated buffer with trailing newline");
+
+    auto csv = batch::parse<u16>("1,22,333", ',');
+    test(csv.is_ok() && csv.unwrap().size() == 3 && csv.unwrap()[2] == 333_u16,
+         "parse comma-separated buffer");
+
+    auto bad = batch::parse<i32>("1\n2\nx3\n");
+    test(bad.is_err() && bad.unwrap_err() == ParseError{ParseError::Kind::InvalidDigit, 4},
+         "error position is an offset into the whole buffer");
+
+    auto range = batch::parse<u8>("255,256", ',');
+    test(range.is_err() && range.unwrap_err().kind == ParseError::Kind::PosOverflow &&
+             range.unwrap_err().position == 6,
+         "out-of-range field reports overflow at its last digit");
+
+    auto gap = batch::parse<i32>("1,,2", ',');
+    test(gap.is_err() && gap.unwrap_err() == ParseError{ParseError::Kind::Empty, 2},
+         "empty field is reported as Empty");
+
+    std::vector<i64> partial;
+    auto stopped = batch::parse_into<i64>("5 6", partial, ' ');
+    auto more = batch::parse_into<i64>("7 z", partial, ' ');
+    test(stopped.is_ok() && more.is_err() && partial.size() == 3,
+         "parse_into appends and keeps values before an error");
+
+    std::mt19937_64 rng(11);
+    std::vector<i32> values(10000);
+    for (auto &v : values) {
+      v = i32(static_cast<std::int32_t>(rng()) >> (rng() % 32));
+    }
+    std::string text = "header:";
+    batch::format_into<i32>(values, text, ',');
+    auto round = batch::parse<i32>(std::string_view(text).substr(7), ',');
+    test(round.is_ok() && round.unwrap() == values, "format_into round-trips through parse");
+  }
+
+  // --- Every width on every instruction set the CPU supports ---
+  std::cout << "\n--- Vector kernels vs SafeInt ---\n";
+  for (Isa requested : {Isa::Scalar, Isa::Native, Isa::Sse42, Isa::Avx2}) {
+    Isa isa = detail::simd::set_active_isa(requested);
+    if (isa != requested) {
+      continue; // not supported here
+    }
+    test_width<i8>("i8", isa);
+    test_width<u8>("u8", isa);
+    test_width<i16>("i16", isa);
+    test_width<u16>("u16", isa);
+    test_width<i32>("i32", isa);
+    test_width<u32>("u32", isa);
+    test_width<i64>("i64", isa);
+    test_width<u64>("u64", isa);
+    test_reduction<i8>("i8", isa);
+    test_reduction<u8>("u8", isa);
+    test_reduction<i16>("i16", isa);
+    test_reduction<u16>("u16", isa);
+    test_reduction<i32>("i32", isa);
+    test_reduction<u32>("u32", isa);
+    test_reduction<i64>("i64", isa);
+    test_reduction<u64>("u64", isa);
+    test_modular<u32>("u32", isa);
+    test_modular<u64>("u64", isa);
+  }
+  detail::simd::set_active_isa(detail::simd::detect_isa());
+
+  // --- Summary ---
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,1018 @@
+// pulgacpp::BigInt - Arbitrary-precision signed integer
+// SPDX-License-Identifier: MIT
+//
+// BigInt is where a SafeInt computation goes when it no longer fits: the
+// *_or_promote functions run the checked operation and, on overflow, return
+// the exact result as a BigInt instead of None.
+//
+// Representation: sign + magnitude in 64-bit limbs (least significant first).
+// Up to two limbs (128 bits) are stored inline, so every value an i64/u64
+// operation can produce - and anything that fits in i128/u128 - is handled
+// without touching the heap.
+//
+// Usage:
+//   #include <pulgacpp/bigint/bigint.hpp>
+//
+//   auto r = mul_or_promote(price, quantity);   // Promoted<i64>
+//   r = r * 1000_i64;                           // keeps going in BigInt
+//   if (auto small = r.narrow(); small.is_some()) { ... }
+//   std::cout << r.to_bigint() << "\n";
+
+#ifndef PULGACPP_BIGINT_HPP
+#define PULGACPP_BIGINT_HPP
+
+#include "../core/safe_int.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace pulgacpp {
+
+namespace detail::bigint {
+
+using limb = std::uint64_t;
+
+// ============================================================
+// Single-limb primitives
+// ============================================================
+
+/// Full 64x64 -> 128-bit product, returned as {low, high}.
+[[nodiscard]] inline std::pair<limb, limb> mul_wide(limb a, limb b) noexcept {
+#if PULGACPP_HAS_INT128
+  unsigned __int128 p = mul_wide_u64(a, b);
+  return {static_cast<limb>(p), static_cast<limb>(p >> 64)};
+#elif PULGACPP_MSVC_INTRINSICS && defined(_M_X64)
+  limb high = 0;
+  limb low = _umul128(a, b, &high);
+  return {low, high};
+#else
+  // 32-bit partial products
+  limb a0 = a & 0xFFFFFFFFu, a1 = a >> 32;
+  limb b0 = b & 0xFFFFFFFFu, b1 = b >> 32;
+  limb p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  limb middle = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+  limb low = (middle << 32) | (p00 & 0xFFFFFFFFu);
+  limb high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+  return {low, high};
+#endif
+}
+
+/// Divides the two-limb value high:low by d (requires high < d).
+/// Returns {quotient, remainder}.
+[[nodiscard]] inline std::pair<limb, limb> div_wide(limb high, limb low,
+                                                    limb d) noexcept {
+#if PULGACPP_HAS_INT128
+  unsigned __int128 n = (static_cast<unsigned __int128>(high) << 64) | low;
+  return {static_cast<limb>(n / d), static_cast<limb>(n % d)};
+#else
+  // Hacker's Delight divlu: normalize, then two 64/32 steps
+  int shift = std::countl_zero(d);
+  d <<= shift;
+  if (shift != 0) {
+    high = (high << shift) | (low >> (64 - shift));
+    low <<= shift;
+  }
+  limb d1 = d >> 32, d0 = d & 0xFFFFFFFFu;
+  limb l1 = low >> 32, l0 = low & 0xFFFFFFFFu;
+
+  limb q1 = high / d1, r = high % d1;
+  while (q1 > 0xFFFFFFFFu || q1 * d0 > ((r << 32) | l1)) {
+    --q1;
+    r += d1;
+    if (r > 0xFFFFFFFFu)
+      break;
+  }
+  limb mid = (high << 32 | l1) - q1 * d;
+
+  limb q0 = mid / d1;
+  r = mid % d1;
+  while (q0 > 0xFFFFFFFFu || q0 * d0 > ((r << 32) | l0)) {
+    --q0;
+    r += d1;
+    if (r > 0xFFFFFFFFu)
+      break;
+  }
+  limb rem = ((mid << 32) | l0) - q0 * d;
+  return {(q1 << 32) | q0, rem >> shift};
+#endif
+}
+
+// ============================================================
+// Magnitude arithmetic on limb arrays
+// ============================================================
+// Lengths are explicit; outputs never alias inputs unless noted.
+
+/// Number of limbs once leading zeros are dropped.
+[[nodiscard]] inline std::size_t normalized(const limb *a,
+                                            std::size_t n) noexcept {
+  while (n > 0 && a[n - 1] == 0) {
+    --n;
+  }
+  return n;
+}
+
+/// Three-way comparison of two normalized magnitudes.
+[[nodiscard]] inline int compare(const limb *a, std::size_t an, const limb *b,
+                                 std::size_t bn) noexcept {
+  if (an != bn) {
+    return an < bn ? -1 : 1;
+  }
+  for (std::size_t i = an; i-- > 0;) {
+    if (a[i] != b[i]) {
+      return a[i] < b[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+/// out[0..max(an, bn)] = a + b (one extra limb for the carry).
+/// `out` may alias `a`.
+inline void add(const limb *a, std::size_t an, const limb *b, std::size_t bn,
+                limb *out) noexcept {
+  if (an < bn) {
+    std::swap(a, b);
+    std::swap(an, bn);
+  }
+  limb carry = 0;
+  for (std::size_t i = 0; i < bn; ++i) {
+    limb s = a[i] + carry;
+    limb c1 = s < carry;
+    out[i] = s + b[i];
+    carry = c1 | (out[i] < s);
+  }
+  for (std::size_t i = bn; i < an; ++i) {
+    out[i] = a[i] + carry;
+    carry = out[i] < carry;
+  }
+  out[an] = carry;
+}
+
+/// out[0..an) = a - b, requires a >= b. `out` may alias `a`.
+inline void sub(const limb *a, std::size_t an, const limb *b, std::size_t bn,
+                limb *out) noexcept {
+  limb borrow = 0;
+  for (std::size_t i = 0; i < bn; ++i) {
+    limb d = a[i] - b[i];
+    limb b1 = a[i] < b[i];
+    out[i] = d - borrow;
+    borrow = b1 | (d < borrow);
+  }
+  for (std::size_t i = bn; i < an; ++i) {
+    out[i] = a[i] - borrow;
+    borrow = a[i] < borrow;
+  }
+}
+
+/// acc[0..n) += x[0..xn), propagating the carry; returns the carry out.
+inline limb add_into(limb *acc, std::size_t n, const limb *x,
+                     std::size_t xn) noexcept {
+  limb carry = 0;
+  std::size_t i = 0;
+  for (; i < xn; ++i) {
+    limb s = acc[i] + carry;
+    limb c1 = s < carry;
+    acc[i] = s + x[i];
+    carry = c1 | (acc[i] < s);
+  }
+  for (; carry != 0 && i < n; ++i) {
+    acc[i] += carry;
+    carry = acc[i] < carry;
+  }
+  return carry;
+}
+
+/// acc[0..n) -= x[0..xn); the caller guarantees no final borrow.
+inline void sub_from(limb *acc, std::size_t n, const limb *x,
+                     std::size_t xn) noexcept {
+  limb borrow = 0;
+  std::size_t i = 0;
+  for (; i < xn; ++i) {
+    limb d = acc[i] - x[i];
+    limb b1 = acc[i] < x[i];
+    acc[i] = d - borrow;
+    borrow = b1 | (d < borrow);
+  }
+  for (; borrow != 0 && i < n; ++i) {
+    limb old = acc[i];
+    acc[i] = old - borrow;
+    borrow = old < borrow;
+  }
+}
+
+/// out[0..an] = a * m + addend (one extra limb). `out` may alias `a`.
+inline void mul_small(const limb *a, std::size_t an, limb m, limb addend,
+                      limb *out) noexcept {
+  limb carry = addend;
+  for (std::size_t i = 0; i < an; ++i) {
+    auto [low, high] = mul_wide(a[i], m);
+    low += carry;
+    high += low < carry;
+    out[i] = low;
+    carry = high;
+  }
+  out[an] = carry;
+}
+
+/// a[0..an) /= d in place; returns the remainder.
+inline limb div_small(limb *a, std::size_t an, limb d) noexcept {
+  limb rem = 0;
+  for (std::size_t i = an; i-- > 0;) {
+    auto [q, r] = div_wide(rem, a[i], d);
+    a[i] = q;
+    rem = r;
+  }
+  return rem;
+}
+
+/// out[0..an+bn) = a * b, schoolbook. `out` must be zeroed.
+inline void mul_schoolbook(const limb *a, std::size_t an, const limb *b,
+                           std::size_t bn, limb *out) noexcept {
+  for (std::size_t i = 0; i < an; ++i) {
+    limb carry = 0;
+    for (std::size_t j = 0; j < bn; ++j) {
+      auto [low, high] = mul_wide(a[i], b[j]);
+      low += carry;
+      high += low < carry;
+      low += out[i + j];
+      high += low < out[i + j];
+      out[i + j] = low;
+      carry = high;
+    }
+    out[i + bn] = carry;
+  }
+}
+
+/// Temporary limbs: on the stack for small sizes, on the heap beyond, so
+/// that arithmetic on 128-bit values never allocates. Zero-initialized.
+class Scratch {
+public:
+  explicit Scratch(std::size_t n) : m_size(n) {
+    if (n > INLINE) {
+      m_heap.resize(n);
+    }
+  }
+
+  [[nodiscard]] limb *data() noexcept {
+    return m_size > INLINE ? m_heap.data() : m_inline;
+  }
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+private:
+  static constexpr std::size_t INLINE = 8;
+  limb m_inline[INLINE] = {};
+  std::vector<limb> m_heap;
+  std::size_t m_size;
+};
+
+/// Operand size (in limbs) from which Karatsuba beats schoolbook.
+inline constexpr std::size_t KARATSUBA_THRESHOLD = 32;
+
+/// out[0..an+bn) = a * b. `out` must be zeroed and must not alias a or b.
+inline void mul(const limb *a, std::size_t an, const limb *b, std::size_t bn,
+                limb *out) {
+  if (an < bn) {
+    std::swap(a, b);
+    std::swap(an, bn);
+  }
+  if (bn < KARATSUBA_THRESHOLD) {
+    mul_schoolbook(a, an, b, bn, out);
+    return;
+  }
+
+  if (2 * bn <= an) {
+    // Unbalanced: multiply b by bn-sized slices of a
+    std::vector<limb> part(2 * bn);
+    for (std::size_t offset = 0; offset < an; offset += bn) {
+      std::size_t len = std::min(bn, an - offset);
+      std::fill(part.begin(), part.end(), 0);
+      mul(a + offset, len, b, bn, part.data());
+      add_into(out + offset, an + bn - offset, part.data(), len + bn);
+    }
+    return;
+  }
+
+  // a = a1*B^h + a0, b = b1*B^h + b0
+  // a*b = z2*B^2h + (z1 - z2 - z0)*B^h + z0, z1 = (a0 + a1)(b0 + b1)
+  std::size_t h = an / 2;
+  const limb *a0 = a, *a1 = a + h, *b0 = b, *b1 = b + h;
+  std::size_t a0n = normalized(a0, h), a1n = an - h;
+  std::size_t b0n = normalized(b0, h), b1n = bn - h;
+
+  std::vector<limb> z0(a0n + b0n), z2(a1n + b1n);
+  mul(a0, a0n, b0, b0n, z0.data());
+  mul(a1, a1n, b1, b1n, z2.data());
+
+  std::vector<limb> sa(std::max(a0n, a1n) + 1), sb(std::max(b0n, b1n) + 1);
+  add(a0, a0n, a1, a1n, sa.data());
+  add(b0, b0n, b1, b1n, sb.data());
+  std::size_t san = normalized(sa.data(), sa.size());
+  std::size_t sbn = normalized(sb.data(), sb.size());
+
+  std::vector<limb> z1(san + sbn + 1);
+  mul(sa.data(), san, sb.data(), sbn, z1.data());
+  sub_from(z1.data(), z1.size(), z0.data(), z0.size());
+  sub_from(z1.data(), z1.size(), z2.data(), z2.size());
+
+  std::size_t n = an + bn;
+  add_into(out, n, z0.data(), normalized(z0.data(), z0.size()));
+  add_into(out + h, n - h, z1.data(), normalized(z1.data(), z1.size()));
+  add_into(out + 2 * h, n - 2 * h, z2.data(), normalized(z2.data(), z2.size()));
+}
+
+/// Knuth's algorithm D. a (an limbs) / b (bn >= 2 limbs, normalized, a >= b).
+/// Writes an - bn + 1 quotient limbs to q and bn remainder limbs to r.
+inline void divmod(const limb *a, std::size_t an, const limb *b,
+                   std::size_t bn, limb *q, limb *r) {
+  // Normalize so the divisor's top bit is set
+  int shift = std::countl_zero(b[bn - 1]);
+  std::vector<limb> u(an + 1), v(bn);
+  for (std::size_t i = bn; i-- > 0;) {
+    v[i] = (b[i] << shift) |
+           (shift != 0 && i > 0 ? b[i - 1] >> (64 - shift) : 0);
+  }
+  u[an] = shift != 0 ? a[an - 1] >> (64 - shift) : 0;
+  for (std::size_t i = an; i-- > 0;) {
+    u[i] = (a[i] << shift) |
+           (shift != 0 && i > 0 ? a[i - 1] >> (64 - shift) : 0);
+  }
+
+  limb top = v[bn - 1], second = v[bn - 2];
+  for (std::size_t j = an - bn + 1; j-- > 0;) {
+    // Estimate the quotient digit from the top two limbs
+    limb qhat, rhat;
+    bool rhat_overflow = false;
+    if (u[j + bn] >= top) {
+      qhat = ~limb(0);
+      rhat = u[j + bn - 1] + top;
+      rhat_overflow = rhat < top;
+    } else {
+      auto [qq, rr] = div_wide(u[j + bn], u[j + bn - 1], top);
+      qhat = qq;
+      rhat = rr;
+    }
+    while (!rhat_overflow) {
+      auto [low, high] = mul_wide(qhat, second);
+      if (high < rhat || (high == rhat && low <= u[j + bn - 2])) {
+        break;
+      }
+      --qhat;
+      rhat += top;
+      rhat_overflow = rhat < top;
+    }
+
+    // u[j..j+bn] -= qhat * v
+    limb carry = 0, borrow = 0;
+    for (std::size_t i = 0; i < bn; ++i) {
+      auto [low, high] = mul_wide(qhat, v[i]);
+      low += carry;
+      high += low < carry;
+      carry = high;
+      limb d = u[i + j] - low;
+      limb b1 = u[i + j] < low;
+      u[i + j] = d - borrow;
+      borrow = b1 | (d < borrow);
+    }
+    limb d = u[j + bn] - carry;
+    limb b1 = u[j + bn] < carry;
+    u[j + bn] = d - borrow;
+    borrow = b1 | (d < borrow);
+
+    if (borrow != 0) {
+      // qhat was one too large: add v back
+      --qhat;
+      limb c = 0;
+      for (std::size_t i = 0; i < bn; ++i) {
+        limb s = u[i + j] + c;
+        limb c1 = s < c;
+        u[i + j] = s + v[i];
+        c = c1 | (u[i + j] < s);
+      }
+      u[j + bn] += c;
+    }
+    q[j] = qhat;
+  }
+
+  // Un-normalize the remainder
+  for (std::size_t i = 0; i < bn; ++i) {
+    r[i] = (u[i] >> shift) | (shift != 0 ? u[i + 1] << (64 - shift) : 0);
+  }
+}
+
+} // namespace detail::bigint
+
+/// Arbitrary-precision signed integer.
+///
+/// Arithmetic never overflows; division truncates toward zero like the
+/// built-in operators (the remainder takes the sign of the dividend).
+/// Values up to 128 bits are stored inline without allocating.
+class BigInt {
+public:
+  using limb_type = std::uint64_t;
+
+  /// Limbs stored inline before switching to the heap.
+  static constexpr std::size_t INLINE_LIMBS = 2;
+
+  // ==================== Construction ====================
+
+  BigInt() noexcept : m_inline{0, 0} {}
+
+  template <std::integral T>
+    requires(!std::same_as<T, bool>)
+  explicit BigInt(T value) noexcept : m_inline{0, 0} {
+    assign_integer(value);
+  }
+
+#if PULGACPP_HAS_INT128
+  explicit BigInt(__int128 value) noexcept : m_inline{0, 0} {
+    assign_integer(value);
+  }
+  explicit BigInt(unsigned __int128 value) noexcept : m_inline{0, 0} {
+    assign_integer(value);
+  }
+#endif
+
+  template <detail::SafeInteger S>
+  explicit BigInt(S value) noexcept : m_inline{0, 0} {
+    assign_integer(value.get());
+  }
+
+  /// Parses an optionally signed decimal string ("-12345").
+  /// Returns None if the text is empty or contains anything else.
+  [[nodiscard]] static Optional<BigInt> from_string(std::string_view text) {
+    bool negative = false;
+    if (!text.empty() && (text[0] == '-' || text[0] == '+')) {
+      negative = text[0] == '-';
+      text.remove_prefix(1);
+    }
+    if (text.empty()) {
+      return None;
+    }
+    BigInt result;
+    // 19 decimal digits at a time fit in one limb
+    while (!text.empty()) {
+      std::size_t len = std::min<std::size_t>(text.size(), 19);
+      limb_type chunk = 0, scale = 1;
+      for (std::size_t i = 0; i < len; ++i) {
+        char c = text[i];
+        if (c < '0' || c > '9') {
+          return None;
+        }
+        chunk = chunk * 10 + static_cast<limb_type>(c - '0');
+        scale *= 10;
+      }
+      result.mul_add_small(scale, chunk);
+      text.remove_prefix(len);
+    }
+    result.m_negative = negative && result.m_size != 0;
+    return Some(std::move(result));
+  }
+
+  // ==================== Copy / move ====================
+
+  BigInt(const BigInt &other) : m_inline{0, 0} {
+    assign_limbs(other.data(), other.m_size);
+    m_negative = other.m_negative;
+  }
+
+  BigInt(BigInt &&other) noexcept
+      : m_size(other.m_size), m_capacity(other.m_capacity),
+        m_negative(other.m_negative) {
+    if (other.is_inline()) {
+      m_inline[0] = other.m_inline[0];
+      m_inline[1] = other.m_inline[1];
+    } else {
+      m_heap = other.m_heap;
+      other.m_capacity = INLINE_LIMBS;
+      other.m_inline[0] = other.m_inline[1] = 0;
+    }
+    other.m_size = 0;
+    other.m_negative = false;
+  }
+
+  BigInt &operator=(const BigInt &other) {
+    if (this != &other) {
+      assign_limbs(other.data(), other.m_size);
+      m_negative = other.m_negative;
+    }
+    return *this;
+  }
+
+  BigInt &operator=(BigInt &&other) noexcept {
+    if (this != &other) {
+      release();
+      m_size = other.m_size;
+      m_capacity = other.m_capacity;
+      m_negative = other.m_negative;
+      if (other.is_inline()) {
+        m_inline[0] = other.m_inline[0];
+        m_inline[1] = other.m_inline[1];
+      } else {
+        m_heap = other.m_heap;
+        other.m_capacity = INLINE_LIMBS;
+        other.m_inline[0] = other.m_inline[1] = 0;
+      }
+      other.m_size = 0;
+      other.m_negative = false;
+    }
+    return *this;
+  }
+
+  ~BigInt() { release(); }
+
+  // ==================== Queries ====================
+
+  [[nodiscard]] bool is_zero() const noexcept { return m_size == 0; }
+  [[nodiscard]] bool is_negative() const noexcept { return m_negative; }
+  [[nodiscard]] bool is_positive() const noexcept {
+    return m_size != 0 && !m_negative;
+  }
+
+  /// Returns -1, 0, or 1.
+  [[nodiscard]] int signum() const noexcept {
+    return m_size == 0 ? 0 : (m_negative ? -1 : 1);
+  }
+
+  /// Number of significant bits of |value| (0 for zero).
+  [[nodiscard]] std::size_t bit_length() const noexcept {
+    if (m_size == 0) {
+      return 0;
+    }
+    limb_type top = data()[m_size - 1];
+    std::size_t bits = 64;
+    while ((top & (limb_type(1) << 63)) == 0) {
+      top <<= 1;
+      --bits;
+    }
+    return (m_size - 1) * 64 + bits;
+  }
+
+  /// Number of 64-bit limbs in use.
+  [[nodiscard]] std::size_t limb_count() const noexcept { return m_size; }
+
+  /// True while the value lives in the inline buffer (no heap allocation).
+  [[nodiscard]] bool is_inline() const noexcept {
+    return m_capacity == INLINE_LIMBS;
+  }
+
+  /// Least-significant-first view of the magnitude.
+  [[nodiscard]] const limb_type *limbs() const noexcept { return data(); }
+
+  // ==================== Conversions ====================
+
+  /// Converts back to a SafeInt, returning None if the value doesn't fit.
+  template <detail::SafeInteger S>
+  [[nodiscard]] Optional<S> narrow() const noexcept {
+    using T = typename S::underlying_type;
+    using U = detail::make_unsigned_int_t<T>;
+    constexpr std::size_t max_limbs = (sizeof(U) + 7) / 8;
+    if (m_size > max_limbs) {
+      return None;
+    }
+    U magnitude = 0;
+    for (std::size_t i = m_size; i-- > 0;) {
+      if constexpr (sizeof(U) > 8) {
+        magnitude = (magnitude << 64) | data()[i];
+      } else {
+        magnitude = static_cast<U>(data()[i]);
+      }
+    }
+    if (m_size == 1 && static_cast<limb_type>(magnitude) != data()[0]) {
+      return None; // didn't fit in a narrower U
+    }
+    if (m_negative) {
+      if constexpr (!detail::is_signed_int_v<T>) {
+        return None;
+      } else {
+        U limit = static_cast<U>(0) - static_cast<U>(S::MIN);
+        if (magnitude > limit) {
+          return None;
+        }
+        return Some(S(static_cast<T>(static_cast<U>(0) - magnitude)));
+      }
+    }
+    if (magnitude > static_cast<U>(S::MAX)) {
+      return None;
+    }
+    return Some(S(static_cast<T>(magnitude)));
+  }
+
+  /// Decimal representation, with a leading '-' for negative values.
+  [[nodiscard]] std::string to_string() const {
+    if (m_size == 0) {
+      return "0";
+    }
+    constexpr limb_type CHUNK = 10'000'000'000'000'000'000ULL; // 10^19
+    std::vector<limb_type> work(data(), data() + m_size);
+    std::size_t n = m_size;
+    std::vector<limb_type> chunks;
+    while (n > 0) {
+      chunks.push_back(detail::bigint::div_small(work.data(), n, CHUNK));
+      n = detail::bigint::normalized(work.data(), n);
+    }
+    std::string text = m_negative ? "-" : "";
+    text += std::to_string(chunks.back());
+    for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+      std::string part = std::to_string(chunks[i]);
+      text.append(19 - part.size(), '0');
+      text += part;
+    }
+    return text;
+  }
+
+  // ==================== Arithmetic ====================
+
+  [[nodiscard]] BigInt operator-() const {
+    BigInt result(*this);
+    result.m_negative = !m_negative && m_size != 0;
+    return result;
+  }
+
+  [[nodiscard]] BigInt abs() const {
+    BigInt result(*this);
+    result.m_negative = false;
+    return result;
+  }
+
+  [[nodiscard]] friend BigInt operator+(const BigInt &a, const BigInt &b) {
+    return add_signed(a, b, b.m_negative);
+  }
+
+  [[nodiscard]] friend BigInt operator-(const BigInt &a, const BigInt &b) {
+    return add_signed(a, b, !b.m_negative && b.m_size != 0);
+  }
+
+  [[nodiscard]] friend BigInt operator*(const BigInt &a, const BigInt &b) {
+    if (a.m_size == 0 || b.m_size == 0) {
+      return BigInt();
+    }
+    std::size_t n = a.m_size + b.m_size;
+    detail::bigint::Scratch out(n);
+    detail::bigint::mul(a.data(), a.m_size, b.data(), b.m_size, out.data());
+    BigInt result;
+    result.assign_limbs(out.data(), n);
+    result.m_negative = (a.m_negative != b.m_negative) && result.m_size != 0;
+    return result;
+  }
+
+  /// Quotient truncated toward zero, or None when dividing by zero.
+  [[nodiscard]] Optional<BigInt> checked_div(const BigInt &rhs) const {
+    if (rhs.is_zero()) {
+      return None;
+    }
+    return Some(divmod(*this, rhs).first);
+  }
+
+  /// Remainder with the sign of the dividend, or None when dividing by zero.
+  [[nodiscard]] Optional<BigInt> checked_rem(const BigInt &rhs) const {
+    if (rhs.is_zero()) {
+      return None;
+    }
+    return Some(divmod(*this, rhs).second);
+  }
+
+  /// Panics on division by zero; use checked_div to handle it.
+  [[nodiscard]] friend BigInt operator/(const BigInt &a, const BigInt &b) {
+    if (b.is_zero()) {
+      panic("BigInt division by zero");
+    }
+    return divmod(a, b).first;
+  }
+
+  /// Panics on division by zero; use checked_rem to handle it.
+  [[nodiscard]] friend BigInt operator%(const BigInt &a, const BigInt &b) {
+    if (b.is_zero()) {
+      panic("BigInt division by zero");
+    }
+    return divmod(a, b).second;
+  }
+
+  BigInt &operator+=(const BigInt &rhs) { return *this = *this + rhs; }
+  BigInt &operator-=(const BigInt &rhs) { return *this = *this - rhs; }
+  BigInt &operator*=(const BigInt &rhs) { return *this = *this * rhs; }
+  BigInt &operator/=(const BigInt &rhs) { return *this = *this / rhs; }
+  BigInt &operator%=(const BigInt &rhs) { return *this = *this % rhs; }
+
+  /// this^exponent by repeated squaring.
+  [[nodiscard]] BigInt pow(std::uint32_t exponent) const {
+    BigInt result(1);
+    BigInt base(*this);
+    while (exponent != 0) {
+      if (exponent & 1) {
+        result *= base;
+      }
+      exponent >>= 1;
+      if (exponent != 0) {
+        base *= base;
+      }
+    }
+    return result;
+  }
+
+  // ==================== Comparison ====================
+
+  [[nodiscard]] friend bool operator==(const BigInt &a,
+                                       const BigInt &b) noexcept {
+    return a.m_negative == b.m_negative &&
+           detail::bigint::compare(a.data(), a.m_size, b.data(), b.m_size) ==
+               0;
+  }
+
+  [[nodiscard]] friend std::strong_ordering
+  operator<=>(const BigInt &a, const BigInt &b) noexcept {
+    if (a.m_negative != b.m_negative) {
+      return a.m_negative ? std::strong_ordering::less
+                          : std::strong_ordering::greater;
+    }
+    int c = detail::bigint::compare(a.data(), a.m_size, b.data(), b.m_size);
+    if (a.m_negative) {
+      c = -c;
+    }
+    return c < 0    ? std::strong_ordering::less
+           : c == 0 ? std::strong_ordering::equal
+                    : std::strong_ordering::greater;
+  }
+
+  // Stream output
+  friend std::ostream &operator<<(std::ostream &os, const BigInt &value) {
+    return os << value.to_string();
+  }
+
+private:
+  [[nodiscard]] limb_type *data() noexcept {
+    return is_inline() ? m_inline : m_heap;
+  }
+  [[nodiscard]] const limb_type *data() const noexcept {
+    return is_inline() ? m_inline : m_heap;
+  }
+
+  void release() noexcept {
+    if (!is_inline()) {
+      delete[] m_heap;
+      m_capacity = INLINE_LIMBS;
+      m_inline[0] = m_inline[1] = 0;
+    }
+  }
+
+  /// Grows the buffer to hold `n` limbs, keeping the current contents.
+  void reserve(std::size_t n) {
+    if (n <= m_capacity) {
+      return;
+    }
+    std::size_t capacity = std::max<std::size_t>(n, 2 * m_capacity);
+    auto *buffer = new limb_type[capacity]();
+    std::memcpy(buffer, data(), m_size * sizeof(limb_type));
+    release();
+    m_heap = buffer;
+    m_capacity = static_cast<std::uint32_t>(capacity);
+  }
+
+  /// Replaces the magnitude with p[0..n), dropping leading zeros.
+  /// `p` may point into this object's own buffer.
+  void assign_limbs(const limb_type *p, std::size_t n) {
+    n = detail::bigint::normalized(p, n);
+    if (n > m_capacity) {
+      auto *buffer = new limb_type[n];
+      std::memcpy(buffer, p, n * sizeof(limb_type));
+      release();
+      m_heap = buffer;
+      m_capacity = static_cast<std::uint32_t>(n);
+    } else {
+      std::memmove(data(), p, n * sizeof(limb_type));
+    }
+    m_size = static_cast<std::uint32_t>(n);
+    if (m_size == 0) {
+      m_negative = false;
+    }
+  }
+
+  template <typename T> void assign_integer(T value) noexcept {
+    using U = detail::make_unsigned_int_t<T>;
+    U magnitude = static_cast<U>(value);
+    m_negative = false;
+    if constexpr (detail::is_signed_int_v<T>) {
+      if (value < 0) {
+        m_negative = true;
+        magnitude = static_cast<U>(0) - magnitude;
+      }
+    }
+    m_inline[0] = static_cast<limb_type>(magnitude);
+    if constexpr (sizeof(U) > 8) {
+      m_inline[1] = static_cast<limb_type>(magnitude >> 64);
+    } else {
+      m_inline[1] = 0;
+    }
+    m_size = static_cast<std::uint32_t>(
+        detail::bigint::normalized(m_inline, INLINE_LIMBS));
+  }
+
+  /// |this| = |this| * m + addend
+  void mul_add_small(limb_type m, limb_type addend) {
+    reserve(m_size + 1);
+    detail::bigint::mul_small(data(), m_size, m, addend, data());
+    m_size = static_cast<std::uint32_t>(
+        detail::bigint::normalized(data(), m_size + 1));
+  }
+
+  /// a + (b with its sign replaced by `b_negative`)
+  static BigInt add_signed(const BigInt &a, const BigInt &b, bool b_negative) {
+    BigInt result;
+    std::size_t n = std::max(a.m_size, b.m_size) + 1;
+    detail::bigint::Scratch scratch(n);
+    limb_type *out = scratch.data();
+
+    if (a.m_negative == b_negative) {
+      detail::bigint::add(a.data(), a.m_size, b.data(), b.m_size, out);
+      result.assign_limbs(out, n);
+      result.m_negative = a.m_negative && result.m_size != 0;
+      return result;
+    }
+    int c = detail::bigint::compare(a.data(), a.m_size, b.data(), b.m_size);
+    if (c >= 0) {
+      detail::bigint::sub(a.data(), a.m_size, b.data(), b.m_size, out);
+      result.assign_limbs(out, a.m_size);
+      result.m_negative = a.m_negative && result.m_size != 0;
+    } else {
+      detail::bigint::sub(b.data(), b.m_size, a.data(), a.m_size, out);
+      result.assign_limbs(out, b.m_size);
+      result.m_negative = b_negative && result.m_size != 0;
+    }
+    return result;
+  }
+
+  /// {quotient, remainder}, truncating toward zero. `b` must be non-zero.
+  static std::pair<BigInt, BigInt> divmod(const BigInt &a, const BigInt &b) {
+    BigInt quotient, remainder;
+    int c = detail::bigint::compare(a.data(), a.m_size, b.data(), b.m_size);
+    if (c < 0) {
+      remainder = a;
+      return {std::move(quotient), std::move(remainder)};
+    }
+    if (b.m_size == 1) {
+      detail::bigint::Scratch q(a.m_size);
+      std::memcpy(q.data(), a.data(), a.m_size * sizeof(limb_type));
+      limb_type r = detail::bigint::div_small(q.data(), q.size(), b.data()[0]);
+      quotient.assign_limbs(q.data(), q.size());
+      remainder.assign_limbs(&r, 1);
+    } else {
+      detail::bigint::Scratch q(a.m_size - b.m_size + 1), r(b.m_size);
+      detail::bigint::divmod(a.data(), a.m_size, b.data(), b.m_size, q.data(),
+                             r.data());
+      quotient.assign_limbs(q.data(), q.size());
+      remainder.assign_limbs(r.data(), r.size());
+    }
+    quotient.m_negative = (a.m_negative != b.m_negative) && !quotient.is_zero();
+    remainder.m_negative = a.m_negative && !remainder.is_zero();
+    return {std::move(quotient), std::move(remainder)};
+  }
+
+  std::uint32_t m_size = 0;                 // limbs in use (no leading zeros)
+  std::uint32_t m_capacity = INLINE_LIMBS;  // INLINE_LIMBS while inline
+  bool m_negative = false;                  // never set for zero
+  union {
+    limb_type m_inline[INLINE_LIMBS];
+    limb_type *m_heap;
+  };
+};
+
+// ============================================================
+// SafeInt promotion
+// ============================================================
+
+/// Either a value that still fits in S, or the exact result as a BigInt.
+///
+/// Produced by add_or_promote / sub_or_promote / mul_or_promote. Further
+/// arithmetic stays in S while it can (using the checked SafeInt methods)
+/// and continues in BigInt after the first overflow.
+template <detail::SafeInteger S> class Promoted {
+public:
+  explicit Promoted(S value) noexcept : m_small(value) {}
+  explicit Promoted(BigInt value) : m_big(std::move(value)), m_promoted(true) {}
+
+  /// True once the value has left S.
+  [[nodiscard]] bool is_promoted() const noexcept { return m_promoted; }
+
+  /// The value as S, or None if it no longer fits.
+  [[nodiscard]] Optional<S> narrow() const noexcept {
+    if (!m_promoted) {
+      return Some(m_small);
+    }
+    return m_big.template narrow<S>();
+  }
+
+  /// The exact value as a BigInt (inline, no allocation, while it fits S).
+  [[nodiscard]] BigInt to_bigint() const {
+    return m_promoted ? m_big : BigInt(m_small);
+  }
+
+  [[nodiscard]] friend Promoted operator+(const Promoted &a, S b) {
+    if (!a.m_promoted) {
+      return promote_step(a.m_small.checked_add(b), a.m_small, b,
+                          std::plus<>{});
+    }
+    return Promoted(a.m_big + BigInt(b));
+  }
+
+  [[nodiscard]] friend Promoted operator-(const Promoted &a, S b) {
+    if (!a.m_promoted) {
+      return promote_step(a.m_small.checked_sub(b), a.m_small, b,
+                          std::minus<>{});
+    }
+    return Promoted(a.m_big - BigInt(b));
+  }
+
+  [[nodiscard]] friend Promoted operator*(const Promoted &a, S b) {
+    if (!a.m_promoted) {
+      return promote_step(a.m_small.checked_mul(b), a.m_small, b,
+                          std::multiplies<>{});
+    }
+    return Promoted(a.m_big * BigInt(b));
+  }
+
+  [[nodiscard]] friend Promoted operator+(const Promoted &a,
+                                          const Promoted &b) {
+    if (!b.m_promoted) {
+      return a + b.m_small;
+    }
+    return Promoted(a.to_bigint() + b.m_big);
+  }
+
+  [[nodiscard]] friend Promoted operator-(const Promoted &a,
+                                          const Promoted &b) {
+    if (!b.m_promoted) {
+      return a - b.m_small;
+    }
+    return Promoted(a.to_bigint() - b.m_big);
+  }
+
+  [[nodiscard]] friend Promoted operator*(const Promoted &a,
+                                          const Promoted &b) {
+    if (!b.m_promoted) {
+      return a * b.m_small;
+    }
+    return Promoted(a.to_bigint() * b.m_big);
+  }
+
+  Promoted &operator+=(S rhs) { return *this = *this + rhs; }
+  Promoted &operator-=(S rhs) { return *this = *this - rhs; }
+  Promoted &operator*=(S rhs) { return *this = *this * rhs; }
+
+private:
+  /// Keeps the checked result, or redoes the operation exactly in BigInt.
+  template <typename Op>
+  static Promoted promote_step(Optional<S> checked, S a, S b, Op op) {
+    if (checked.is_some()) {
+      return Promoted(checked.unwrap());
+    }
+    return Promoted(op(BigInt(a), BigInt(b)));
+  }
+
+  S m_small{};
+  BigInt m_big;
+  bool m_promoted = false;
+};
+
+/// a + b, continuing in BigInt if it overflows S.
+template <detail::SafeInteger S>
+[[nodiscard]] Promoted<S> add_or_promote(S a, S b) {
+  return Promoted<S>(a) + b;
+}
+
+/// a - b, continuing in BigInt if it overflows S.
+template <detail::SafeInteger S>
+[[nodiscard]] Promoted<S> sub_or_promote(S a, S b) {
+  return Promoted<S>(a) - b;
+}
+
+/// a * b, continuing in BigInt if it overflows S.
+template <detail::SafeInteger S>
+[[nodiscard]] Promoted<S> mul_or_promote(S a, S b) {
+  return Promoted<S>(a) * b;
+}
+
+} // namespace pulgacpp
+
+// std::hash specialization for unordered containers
+template <> struct std::hash<pulgacpp::BigInt> {
+  [[nodiscard]] std::size_t
+  operator()(const pulgacpp::BigInt &value) const noexcept {
+    std::size_t h = value.is_negative() ? 0x9E3779B97F4A7C15ULL : 0;
+    for (std::size_t i = 0; i < value.limb_count(); ++i) {
+      h ^= std::hash<std::uint64_t>{}(value.limbs()[i]) + 0x9E3779B97F4A7C15ULL +
+           (h << 6) + (h >> 2);
+    }
+    return h;
+  }
+};
+
+#endif // PULGACPP_BIGINT_HPP
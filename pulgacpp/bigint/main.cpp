@@ -0,0 +1,251 @@
+// Test program for pulgacpp::BigInt
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_bigint
+
+#include "bigint.hpp"
+#include "../i64/i64.hpp"
+#include "../i8/i8.hpp"
+#include "../u64/u64.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Counts heap allocations so the tests can check the inline storage.
+// noinline keeps GCC from pairing an inlined free() with a new-expression
+// (-Wmismatched-new-delete).
+static std::size_t g_allocations = 0;
+
+[[gnu::noinline]] void *operator new(std::size_t size) {
+    ++g_allocations;
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+[[gnu::noinline]] void operator delete(void *p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+[[gnu::noinline]] void *operator new[](std::size_t size) { return ::operator new(size); }
+[[gnu::noinline]] void operator delete[](void *p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+BigInt big(std::string_view text) { return BigInt::from_string(text).unwrap(); }
+
+/// Random value with `limbs` 64-bit limbs and a random sign.
+BigInt random_big(std::mt19937_64 &rng, std::size_t limbs) {
+    BigInt result;
+    BigInt base = BigInt(1ULL << 32) * BigInt(1ULL << 32);
+    for (std::size_t i = 0; i < limbs; ++i) {
+        result = result * base + BigInt(rng());
+    }
+    return (rng() & 1) ? -result : result;
+}
+
+int main() {
+    std::cout << "=== pulgacpp::BigInt Test Suite ===\n\n";
+
+    // --- Construction ---
+    std::cout << "--- Construction ---\n";
+    {
+        test(BigInt().is_zero() && BigInt().to_string() == "0", "default is zero");
+        test(BigInt(-42).to_string() == "-42", "from int");
+        test(BigInt(INT64_MIN).to_string() == "-9223372036854775808", "from INT64_MIN");
+        test(BigInt(UINT64_MAX).to_string() == "18446744073709551615", "from UINT64_MAX");
+        test(BigInt(i64(i64::MIN)) == BigInt(INT64_MIN), "from SafeInt");
+        test(big("-000123") == BigInt(-123), "from_string with leading zeros");
+        test(big("+7") == BigInt(7), "from_string with plus sign");
+        test(big("-0").is_zero() && !big("-0").is_negative(), "negative zero is zero");
+        test(BigInt::from_string("").is_none(), "empty string rejected");
+        test(BigInt::from_string("12a3").is_none(), "non-digit rejected");
+        test(BigInt::from_string("-").is_none(), "lone sign rejected");
+
+        std::string digits = "123456789012345678901234567890123456789012345678901234567890";
+        test(big(digits).to_string() == digits, "60-digit round trip");
+        test(big("-" + digits).to_string() == "-" + digits, "negative round trip");
+        test(big("100000000000000000000").to_string() == "100000000000000000000",
+             "10^20 keeps inner zero chunk");
+    }
+
+    // --- Arithmetic ---
+    std::cout << "\n--- Arithmetic ---\n";
+    {
+        test(BigInt(5) + BigInt(-8) == BigInt(-3), "5 + -8");
+        test(BigInt(-5) - BigInt(-8) == BigInt(3), "-5 - -8");
+        test(BigInt(UINT64_MAX) + BigInt(1) == big("18446744073709551616"), "carry into second limb");
+        test(big("18446744073709551616") - BigInt(1) == BigInt(UINT64_MAX), "borrow from second limb");
+        test(BigInt(-6) * BigInt(7) == BigInt(-42), "sign of product");
+        test(BigInt(7) * BigInt(0) == BigInt() && !(BigInt(-7) * BigInt(0)).is_negative(), "times zero");
+
+        BigInt factorial(1);
+        for (int i = 2; i <= 30; ++i) {
+            factorial *= BigInt(i);
+        }
+        test(factorial.to_string() == "265252859812191058636308480000000", "30!");
+        test(BigInt(2).pow(200).to_string() ==
+                 "1606938044258990275541962092341162602522202993782792835301376",
+             "2^200");
+        test(BigInt(-3).pow(3) == BigInt(-27), "(-3)^3");
+    }
+
+    // --- Division ---
+    std::cout << "\n--- Division ---\n";
+    {
+        test(BigInt(7) / BigInt(-2) == BigInt(-3) && BigInt(7) % BigInt(-2) == BigInt(1),
+             "truncating division, remainder keeps dividend sign");
+        test(BigInt(-7) / BigInt(2) == BigInt(-3) && BigInt(-7) % BigInt(2) == BigInt(-1),
+             "negative dividend");
+        test(BigInt(3).checked_div(BigInt()).is_none(), "checked_div by zero is None");
+        test(BigInt(3).checked_rem(BigInt()).is_none(), "checked_rem by zero is None");
+
+        BigInt f50 = BigInt(1);
+        for (int i = 2; i <= 50; ++i) {
+            f50 *= BigInt(i);
+        }
+        BigInt f30 = BigInt(1);
+        for (int i = 2; i <= 30; ++i) {
+            f30 *= BigInt(i);
+        }
+        BigInt q = f50 / f30;
+        BigInt expected(1);
+        for (int i = 31; i <= 50; ++i) {
+            expected *= BigInt(i);
+        }
+        test(q == expected && (f50 % f30).is_zero(), "50! / 30! (multi-limb divisor)");
+
+        std::mt19937_64 rng(5);
+        bool ok = true;
+        for (int i = 0; i < 300; ++i) {
+            BigInt a = random_big(rng, 1 + rng() % 12);
+            BigInt b = random_big(rng, 1 + rng() % 6);
+            if (b.is_zero()) {
+                continue;
+            }
+            BigInt quotient = a / b, remainder = a % b;
+            ok = ok && quotient * b + remainder == a && remainder.abs() < b.abs() &&
+                 (remainder.is_zero() || remainder.is_negative() == a.is_negative());
+        }
+        test(ok, "a == (a / b) * b + a % b for random values");
+    }
+
+    // --- Karatsuba ---
+    std::cout << "\n--- Karatsuba ---\n";
+    {
+        // (x + 1)(x - 1) == x^2 - 1 with x large enough to use Karatsuba
+        std::mt19937_64 rng(9);
+        BigInt x = random_big(rng, 80).abs();
+        BigInt one(1);
+        test((x + one) * (x - one) == x * x - one, "(x+1)(x-1) == x^2 - 1 (80 limbs)");
+
+        // Compare against a product built from small schoolbook pieces
+        bool ok = true;
+        for (std::size_t n : {31u, 32u, 33u, 64u, 100u, 150u}) {
+            BigInt a = random_big(rng, n), b = random_big(rng, n / 2 + 1);
+            BigInt split = BigInt(1ULL << 32) * BigInt(1ULL << 32);
+            BigInt shift = split.pow(static_cast<std::uint32_t>(n / 2));
+            BigInt hi = a / shift, lo = a % shift;
+            ok = ok && a * b == hi * b * shift + lo * b;
+        }
+        test(ok, "unbalanced and balanced products agree with decomposition");
+    }
+
+    // --- Narrowing ---
+    std::cout << "\n--- Narrowing ---\n";
+    {
+        test(BigInt(127).narrow<i8>().unwrap() == 127_i8, "127 narrows to i8");
+        test(BigInt(128).narrow<i8>().is_none(), "128 does not narrow to i8");
+        test(BigInt(-128).narrow<i8>().unwrap() == i8(i8::MIN), "-128 narrows to i8");
+        test(BigInt(-1).narrow<u64>().is_none(), "-1 does not narrow to u64");
+        test(BigInt(INT64_MIN).narrow<i64>().unwrap() == i64(i64::MIN), "INT64_MIN round trip");
+        test(big("9223372036854775808").narrow<i64>().is_none(), "i64::MAX + 1 does not narrow");
+        test(big("18446744073709551616").narrow<u64>().is_none(), "2^64 does not narrow to u64");
+    }
+
+    // --- Promotion from SafeInt ---
+    std::cout << "\n--- Promotion ---\n";
+    {
+        auto fits = mul_or_promote(1000_i64, 1000_i64);
+        test(!fits.is_promoted() && fits.narrow().unwrap() == 1000000_i64,
+             "in-range product stays in i64");
+
+        auto over = mul_or_promote(i64(i64::MAX), 2_i64);
+        test(over.is_promoted(), "overflowing product is promoted");
+        test(over.to_bigint() == BigInt(INT64_MAX) * BigInt(2), "promoted value is exact");
+        test(over.narrow().is_none(), "promoted value does not narrow");
+
+        auto back = over - i64(i64::MAX) - i64(i64::MAX) + 5_i64;
+        test(back.narrow().unwrap() == 5_i64, "promoted chain can come back into range");
+
+        auto chain = add_or_promote(u64(u64::MAX), 1_u64) * 3_u64;
+        test(chain.to_bigint().to_string() == "55340232221128654848", "u64 chain continues in BigInt");
+
+        auto diff = sub_or_promote(0_u64, 1_u64);
+        test(diff.to_bigint() == BigInt(-1), "u64 underflow promotes to -1");
+
+        Promoted<i64> total(0_i64);
+        for (int i = 0; i < 10; ++i) {
+            total += i64(i64::MAX);
+        }
+        test(total.to_bigint() == BigInt(INT64_MAX) * BigInt(10), "accumulator promotes");
+    }
+
+    // --- Allocation ---
+    std::cout << "\n--- Allocation ---\n";
+    {
+        BigInt a(INT64_MAX), b(UINT64_MAX);
+        std::size_t before = g_allocations;
+        BigInt p = a * b;       // 127 bits
+        BigInt s = p + b - a;   // still 128 bits
+        BigInt q = p / b;       // single-limb divisor
+        auto promoted = mul_or_promote(i64(i64::MAX), i64(i64::MIN));
+        bool inline_only = p.is_inline() && s.is_inline() && q.is_inline() &&
+                           promoted.to_bigint().is_inline();
+        test(g_allocations == before && inline_only, "128-bit arithmetic does not allocate");
+
+        BigInt c = p * p;
+        test(!c.is_inline() && c.limb_count() == 4, "larger values move to the heap");
+    }
+
+    // --- STL / comparison ---
+    std::cout << "\n--- Comparison and STL ---\n";
+    {
+        test(BigInt(-5) < BigInt(3) && BigInt(-5) < BigInt(-3) && big("18446744073709551616") > BigInt(UINT64_MAX),
+             "ordering across signs and sizes");
+        std::unordered_set<BigInt> seen{BigInt(1), BigInt(-1), big("18446744073709551616"), BigInt(1)};
+        test(seen.size() == 3, "unordered_set<BigInt>");
+        BigInt moved = big("123456789012345678901234567890");
+        BigInt target = std::move(moved);
+        test(target.to_string() == "123456789012345678901234567890" && moved.is_zero(),
+             "move leaves source empty");
+        BigInt self = BigInt(41);
+        self = self + self;
+        self += BigInt(-82);
+        test(self.is_zero(), "self-referencing arithmetic");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,234 @@
+// pulgacpp::Bounded - Integer restricted to a compile-time range
+// SPDX-License-Identifier: MIT
+//
+// Bounded<S, Lo, Hi> holds an S in [Lo, Hi]. The range is checked once when
+// the value is created; get() then tells the optimizer about it, and the
+// range itself enables operations that need no runtime checks:
+//   - `a / b` and `a % b` when [Lo, Hi] excludes both 0 and -1
+//   - at(array, i) when [Lo, Hi] lies inside the array
+//   - Optional<Bounded> uses a value outside the range as None
+//
+// Usage:
+//   #include <pulgacpp/bounded/bounded.hpp>
+//
+//   using Weekday = Bounded<u8, 0, 6>;
+//   std::array<std::string_view, 7> names = {...};
+//   auto day = Weekday::from(input).expect("weekday");
+//   std::string_view name = at(names, day);   // no bounds check
+
+#ifndef PULGACPP_BOUNDED_HPP
+#define PULGACPP_BOUNDED_HPP
+
+#include "../core/safe_int.hpp"
+
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace pulgacpp {
+
+/// A SafeInt value known to lie in [Lo, Hi].
+template <detail::SafeInteger S, typename S::underlying_type Lo,
+          typename S::underlying_type Hi>
+  requires(Lo <= Hi)
+class Bounded {
+public:
+  using value_type = S;
+  using underlying_type = typename S::underlying_type;
+
+  static constexpr underlying_type MIN = Lo;
+  static constexpr underlying_type MAX = Hi;
+
+  // ==================== Construction ====================
+
+  /// Returns None if `value` is outside [Lo, Hi].
+  [[nodiscard]] static constexpr Optional<Bounded> from(S value) noexcept {
+    if (value.get() < Lo || value.get() > Hi) {
+      return None;
+    }
+    return Some(Bounded(value));
+  }
+
+  /// Returns None if `value` is outside [Lo, Hi].
+  template <std::integral T>
+  [[nodiscard]] static constexpr Optional<Bounded> from(T value) noexcept {
+    auto converted = S::from(value);
+    if (converted.is_none()) {
+      return None;
+    }
+    return from(converted.unwrap());
+  }
+
+  /// Clamps `value` into [Lo, Hi].
+  [[nodiscard]] static constexpr Bounded saturating_from(S value) noexcept {
+    if (value.get() < Lo) {
+      return Bounded(S(Lo));
+    }
+    if (value.get() > Hi) {
+      return Bounded(S(Hi));
+    }
+    return Bounded(value);
+  }
+
+  /// Compile-time constant: `Bounded<u8, 0, 6>::constant<3>()`.
+  template <underlying_type Value>
+    requires(Value >= Lo && Value <= Hi)
+  [[nodiscard]] static constexpr Bounded constant() noexcept {
+    return Bounded(S(Value));
+  }
+
+  /// Default: Lo.
+  constexpr Bounded() noexcept : m_value(Lo) {}
+
+  // ==================== Accessors ====================
+
+  /// The value. Also tells the optimizer it lies in [Lo, Hi].
+  [[nodiscard]] constexpr S get() const noexcept {
+    PULGACPP_ASSUME(m_value.get() >= Lo && m_value.get() <= Hi);
+    return m_value;
+  }
+
+  [[nodiscard]] constexpr explicit operator S() const noexcept { return get(); }
+
+  /// Re-bounds into a range that contains this one (always succeeds).
+  template <underlying_type NewLo, underlying_type NewHi>
+    requires(NewLo <= Lo && Hi <= NewHi)
+  [[nodiscard]] constexpr Bounded<S, NewLo, NewHi> widen() const noexcept {
+    // Cannot fail: get() already tells the optimizer the value is in range
+    return Bounded<S, NewLo, NewHi>::from(get()).unwrap();
+  }
+
+  // ==================== Comparison ====================
+
+  [[nodiscard]] constexpr auto
+  operator<=>(const Bounded &other) const noexcept = default;
+  [[nodiscard]] constexpr bool
+  operator==(const Bounded &other) const noexcept = default;
+
+  friend std::ostream &operator<<(std::ostream &os, Bounded value) {
+    return os << value.m_value;
+  }
+
+private:
+  constexpr explicit Bounded(S value) noexcept : m_value(value) {}
+
+  friend struct niche_traits<Bounded>;
+
+  S m_value;
+};
+
+// ==================== Traits ====================
+
+namespace detail {
+
+template <typename T> struct is_bounded : std::false_type {};
+
+template <SafeInteger S, typename S::underlying_type Lo,
+          typename S::underlying_type Hi>
+struct is_bounded<Bounded<S, Lo, Hi>> : std::true_type {};
+
+/// True if B's range contains neither 0 nor -1 (the two bad divisors).
+template <typename B> constexpr bool is_safe_divisor_range() noexcept {
+  if constexpr (is_signed_int_v<typename B::underlying_type>) {
+    return B::MIN > 0 || B::MAX < -1;
+  } else {
+    return B::MIN > 0;
+  }
+}
+
+/// True if every value of B is a valid index into N elements.
+template <typename B, std::size_t N>
+constexpr bool is_index_range() noexcept {
+  if constexpr (is_signed_int_v<typename B::underlying_type>) {
+    if (B::MIN < 0) {
+      return false;
+    }
+  }
+  return static_cast<std::size_t>(B::MAX) < N;
+}
+
+} // namespace detail
+
+/// Concept satisfied by every Bounded instantiation
+template <typename B>
+concept BoundedInteger = detail::is_bounded<B>::value;
+
+// ==================== Unchecked division ====================
+// A divisor range without 0 and -1 rules out both division errors.
+
+template <BoundedInteger B>
+  requires(detail::is_safe_divisor_range<B>())
+[[nodiscard]] constexpr typename B::value_type
+operator/(typename B::value_type lhs, B rhs) noexcept {
+  using U = typename B::underlying_type;
+  return typename B::value_type(static_cast<U>(lhs.get() / rhs.get().get()));
+}
+
+template <BoundedInteger B>
+  requires(detail::is_safe_divisor_range<B>())
+[[nodiscard]] constexpr typename B::value_type
+operator%(typename B::value_type lhs, B rhs) noexcept {
+  using U = typename B::underlying_type;
+  return typename B::value_type(static_cast<U>(lhs.get() % rhs.get().get()));
+}
+
+// ==================== Unchecked indexing ====================
+// Allowed when every value of the index type is a valid position.
+
+template <typename T, std::size_t N, BoundedInteger B>
+  requires(detail::is_index_range<B, N>())
+[[nodiscard]] constexpr T &at(std::array<T, N> &array, B index) noexcept {
+  return array[static_cast<std::size_t>(index.get().get())];
+}
+
+template <typename T, std::size_t N, BoundedInteger B>
+  requires(detail::is_index_range<B, N>())
+[[nodiscard]] constexpr const T &at(const std::array<T, N> &array,
+                                    B index) noexcept {
+  return array[static_cast<std::size_t>(index.get().get())];
+}
+
+template <typename T, std::size_t N, BoundedInteger B>
+  requires(detail::is_index_range<B, N>())
+[[nodiscard]] constexpr T &at(T (&array)[N], B index) noexcept {
+  return array[static_cast<std::size_t>(index.get().get())];
+}
+
+// ==================== Niche ====================
+
+/// Optional<Bounded> stores None as the underlying type's MIN (or MAX, if
+/// the range starts at MIN). A range covering the whole type has no niche.
+template <detail::SafeInteger S, typename S::underlying_type Lo,
+          typename S::underlying_type Hi>
+  requires(Lo > S::MIN || Hi < S::MAX)
+struct niche_traits<Bounded<S, Lo, Hi>> {
+  static constexpr typename S::underlying_type NONE =
+      Lo > S::MIN ? S::MIN : S::MAX;
+
+  [[nodiscard]] static constexpr Bounded<S, Lo, Hi> none() noexcept {
+    return Bounded<S, Lo, Hi>(S(NONE));
+  }
+  [[nodiscard]] static constexpr bool
+  is_none(const Bounded<S, Lo, Hi> &value) noexcept {
+    return value.m_value.get() == NONE;
+  }
+};
+
+} // namespace pulgacpp
+
+// std::hash specialization for unordered containers
+template <pulgacpp::detail::SafeInteger S, typename S::underlying_type Lo,
+          typename S::underlying_type Hi>
+struct std::hash<pulgacpp::Bounded<S, Lo, Hi>> {
+  [[nodiscard]] std::size_t
+  operator()(pulgacpp::Bounded<S, Lo, Hi> value) const noexcept {
+    return std::hash<S>{}(value.get());
+  }
+};
+
+#endif // PULGACPP_BOUNDED_HPP
@@ -0,0 +1,125 @@
+// Test program for pulgacpp::Bounded
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_bounded
+
+#include "bounded.hpp"
+#include "../i16/i16.hpp"
+#include "../i32/i32.hpp"
+#include "../u8/u8.hpp"
+#include "../usize/usize.hpp"
+#include <array>
+#include <iostream>
+#include <string_view>
+#include <unordered_set>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+using Weekday = Bounded<u8, 0, 6>;
+using Percent = Bounded<i32, 0, 100>;
+using Divisor = Bounded<i32, 1, 1000>;
+using NegativeDivisor = Bounded<i16, -100, -2>;
+using Byte = Bounded<u8, 0, 255>; // whole range: no niche
+
+template <typename B, typename Arg>
+concept Divisible = requires(Arg a, B b) { a / b; };
+
+template <typename B, typename Array>
+concept Indexable = requires(Array &a, B b) { at(a, b); };
+
+int main() {
+    std::cout << "=== pulgacpp::Bounded Test Suite ===\n\n";
+
+    // --- Construction ---
+    std::cout << "--- Construction ---\n";
+    {
+        test(Weekday::from(6_u8).is_some() && Weekday::from(7_u8).is_none(), "from() checks the range");
+        test(Percent::from(-1).is_none() && Percent::from(100).is_some(), "from(int) checks the range");
+        test(Percent::saturating_from(i32(250)).get() == 100_i32, "saturating_from clamps high");
+        test(Percent::saturating_from(i32(-3)).get() == 0_i32, "saturating_from clamps low");
+        test(Weekday().get() == 0_u8, "default is Lo");
+        test(Weekday::constant<3>().get() == 3_u8, "constant<3>()");
+        test(Weekday::MIN == 0 && Weekday::MAX == 6, "MIN / MAX");
+        auto wide = Weekday::constant<5>().widen<0, 9>();
+        test(wide.get() == 5_u8 && decltype(wide)::MAX == 9, "widen to a larger range");
+    }
+
+    // --- Division ---
+    std::cout << "\n--- Division ---\n";
+    {
+        auto d = Divisor::constant<7>();
+        test(i32(-100) / d == i32(-14), "i32 / Bounded<i32, 1, 1000>");
+        test(i32(-100) % d == i32(-2), "i32 % Bounded<i32, 1, 1000>");
+        test(i32(i32::MIN) / d == i32(i32::MIN / 7), "MIN / positive divisor is fine");
+        test(i16(i16::MIN) / NegativeDivisor::constant<-2>() == 16384_i16,
+             "negative range without -1 divides unchecked");
+
+        static_assert(Divisible<Divisor, i32>);
+        static_assert(Divisible<NegativeDivisor, i16>);
+        static_assert(!Divisible<Percent, i32>, "range containing 0 has no operator/");
+        static_assert(!Divisible<Bounded<i32, -5, -1>, i32>, "range containing -1 has no operator/");
+        static_assert(Divisible<Bounded<u8, 1, 9>, u8>);
+        test(true, "operator/ exists only for safe divisor ranges");
+    }
+
+    // --- Indexing ---
+    std::cout << "\n--- Indexing ---\n";
+    {
+        std::array<std::string_view, 7> names = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+        test(at(names, Weekday::constant<4>()) == "Fri", "at(std::array, Bounded)");
+        int raw[7] = {0, 10, 20, 30, 40, 50, 60};
+        at(raw, Weekday::constant<2>()) += 5;
+        test(raw[2] == 25, "at(C array, Bounded) is writable");
+
+        static_assert(Indexable<Weekday, std::array<int, 7>>);
+        static_assert(!Indexable<Weekday, std::array<int, 6>>, "range past the end");
+        static_assert(!Indexable<Bounded<i32, -1, 3>, std::array<int, 7>>, "negative range");
+        static_assert(Indexable<Bounded<usize, 0, 9>, int[10]>);
+        test(true, "at() exists only for in-bounds ranges");
+    }
+
+    // --- Optional niche ---
+    std::cout << "\n--- Compact Optional ---\n";
+    {
+        test(sizeof(Optional<Weekday>) == 1, "Optional<Bounded<u8, 0, 6>> is 1 byte");
+        test(sizeof(Optional<Percent>) == 4, "Optional<Bounded<i32, 0, 100>> is 4 bytes");
+        test(sizeof(Optional<Bounded<u8, 0, 254>>) == 1, "niche at MAX when the range starts at MIN");
+        test(sizeof(Optional<Byte>) == 2, "full range keeps the flag");
+        Optional<Bounded<u8, 0, 254>> none;
+        test(none.is_none() && Bounded<u8, 0, 254>::from(254_u8).is_some(), "MAX niche semantics");
+        Optional<Percent> p = Percent::from(0).unwrap();
+        test(p.is_some() && p.unwrap().get() == 0_i32, "Some(Lo) is not None");
+    }
+
+    // --- STL / comparison ---
+    std::cout << "\n--- Comparison and STL ---\n";
+    {
+        test(Weekday::constant<1>() < Weekday::constant<2>(), "ordering");
+        std::unordered_set<Weekday> days{Weekday::constant<1>(), Weekday::constant<1>()};
+        test(days.size() == 1, "unordered_set<Bounded>");
+        constexpr auto c = Percent::constant<50>();
+        static_assert(c.get() == 50_i32);
+        test(true, "constexpr construction");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+// Benchmark: size and decode speed of the codecs on typical columns
+// Compile: g++ -std=c++23 -O2 -I../.. bench_codec.cpp -o bench_codec
+
+#include "codec.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace pulgacpp;
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 20;
+constexpr int ROUNDS = 50;
+
+/// Keeps `value` alive without letting the compiler see through it.
+template <typename T> void keep(T &value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+template <typename F> void run(const char *name, std::size_t bytes, F body) {
+    body(); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        body();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-28s %6.2f bytes/value %8.3f ns/value\n", name, double(bytes) / COUNT,
+                ns / (double(ROUNDS) * COUNT));
+}
+
+template <typename S, typename Encode, typename Decode>
+void bench_codec(const char *name, const std::vector<S> &values, Encode encode, Decode decode) {
+    std::vector<std::uint8_t> bytes;
+    encode(values, bytes);
+    std::vector<S> out(values.size());
+    run(name, bytes.size(), [&] {
+        auto read = decode(bytes, out);
+        keep(read);
+        keep(out[0]);
+    });
+    if (out != values) {
+        std::printf("  round trip FAILED\n");
+    }
+}
+
+template <typename S> void bench(const char *title, const std::vector<S> &values) {
+    std::printf("\n--- %s ---\n", title);
+    bench_codec<S>(
+        "varint", values, [](const auto &v, auto &out) { codec::encode_varint<S>(v, out); },
+        [](const auto &in, auto &out) { return codec::decode_varint<S>(in, out); });
+    if constexpr (sizeof(typename S::underlying_type) <= 4) {
+        bench_codec<S>(
+            "group varint", values, [](const auto &v, auto &out) { codec::encode_group_varint<S>(v, out); },
+            [](const auto &in, auto &out) { return codec::decode_group_varint<S>(in, out); });
+    }
+    bench_codec<S>(
+        "frame of reference", values, [](const auto &v, auto &out) { codec::encode_for<S>(v, out); },
+        [](const auto &in, auto &out) { return codec::decode_for<S>(in, out); });
+}
+
+} // namespace
+
+int main() {
+    std::printf("=== Integer codecs (%zu values) ===\n", COUNT);
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    auto next = [&] {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return x;
+    };
+
+    std::vector<u32> counters(COUNT);
+    for (auto &v : counters) {
+        v = u32(static_cast<std::uint32_t>(next() % 5000));
+    }
+    bench("u32 counters in [0, 5000)", counters);
+
+    std::vector<u64> timestamps(COUNT);
+    std::uint64_t t = 1'700'000'000'000;
+    for (auto &v : timestamps) {
+        t += next() % 64;
+        v = u64(t);
+    }
+    bench("u64 millisecond timestamps", timestamps);
+    return 0;
+}
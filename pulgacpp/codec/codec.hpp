@@ -0,0 +1,427 @@
+// pulgacpp::codec - Compact binary encodings for spans of safe integers
+// SPDX-License-Identifier: MIT
+//
+// Encoders append to a std::vector<std::uint8_t>; decoders fill a span of
+// SafeInts whose length is the number of values to read, and return the
+// number of bytes consumed. Decoding validates everything: truncated input,
+// over-long encodings and values outside the target type all come back as
+// a DecodeError, so the decoded SafeInts need no further checks.
+//
+//   varint       LEB128, 7 bits per byte (signed types zigzag first)
+//   group varint 4 values behind one tag byte of byte lengths (<= 32 bits)
+//   frame of ref blocks of 128 values as (value - block minimum) in the
+//                fewest bits that hold the block's range (BP128 layout)
+//
+// All multi-byte fields are little-endian.
+//
+// Usage:
+//   #include <pulgacpp/codec/codec.hpp>
+//
+//   std::vector<std::uint8_t> bytes;
+//   codec::encode_varint<i64>(timestamps, bytes);
+//
+//   std::vector<i64> decoded(count);
+//   auto read = codec::decode_varint<i64>(bytes, decoded);
+//   if (read.is_err()) { log(read.unwrap_err().message()); }
+
+#ifndef PULGACPP_CODEC_HPP
+#define PULGACPP_CODEC_HPP
+
+#include "../core/safe_int.hpp"
+#include "../result/result.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace pulgacpp {
+
+namespace codec {
+
+/// Why a byte stream could not be decoded, and where.
+struct DecodeError {
+  enum class Kind : std::uint8_t {
+    Truncated,  ///< The input ended in the middle of a value or header
+    Overlong,   ///< A varint has more bytes than the type can need
+    OutOfRange, ///< A decoded value does not fit in the target type
+    BadHeader,  ///< A block header is invalid (bit width too large)
+  };
+
+  Kind kind;
+  /// Offset into the input of the value or header that failed.
+  std::size_t position;
+
+  /// Short description of the error kind.
+  [[nodiscard]] constexpr std::string_view message() const noexcept {
+    switch (kind) {
+    case Kind::Truncated:
+      return "unexpected end of encoded input";
+    case Kind::Overlong:
+      return "varint is longer than the target type allows";
+    case Kind::OutOfRange:
+      return "decoded value does not fit in target type";
+    case Kind::BadHeader:
+      return "invalid block header";
+    }
+    return "";
+  }
+
+  [[nodiscard]] constexpr bool
+  operator==(const DecodeError &other) const noexcept = default;
+};
+
+/// Values per frame-of-reference block.
+inline constexpr std::size_t FOR_BLOCK = 128;
+
+} // namespace codec
+
+namespace detail {
+
+/// SafeInts of up to 64 bits: every codec's value fits in a uint64_t.
+template <typename S>
+concept CodecInteger =
+    SafeInteger<S> && sizeof(typename S::underlying_type) <= 8;
+
+/// Group varint stores at most 4 bytes per value.
+template <typename S>
+concept GroupVarintInteger =
+    SafeInteger<S> && sizeof(typename S::underlying_type) <= 4;
+
+[[nodiscard]] inline std::uint64_t load_le64(const std::uint8_t *p) noexcept {
+  std::uint64_t value;
+  std::memcpy(&value, p, sizeof value);
+  if constexpr (std::endian::native == std::endian::big) {
+    value = std::byteswap(value);
+  }
+  return value;
+}
+
+/// Little-endian load of the `n` (<= 8) bytes at `p`; the rest is zero.
+[[nodiscard]] inline std::uint64_t load_le(const std::uint8_t *p,
+                                           std::size_t n) noexcept {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    value |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+  }
+  return value;
+}
+
+inline void store_le(std::vector<std::uint8_t> &out, std::uint64_t value,
+                     std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+/// Raw bits of a value as unsigned, zigzagged for signed types so small
+/// magnitudes of either sign stay small.
+template <typename S>
+[[nodiscard]] constexpr std::uint64_t wire_bits(S value) noexcept {
+  using T = typename S::underlying_type;
+  using U = typename S::unsigned_type;
+  if constexpr (is_signed_int_v<T>) {
+    T v = value.get();
+    // (v << 1) ^ (v >> (BITS - 1)), with the shift done unsigned
+    U zigzag = static_cast<U>(static_cast<U>(static_cast<U>(v) << 1) ^
+                              static_cast<U>(v >> (S::BITS - 1)));
+    return zigzag;
+  } else {
+    return static_cast<std::uint64_t>(value.get());
+  }
+}
+
+/// Inverse of wire_bits; None if `bits` is wider than S.
+template <typename S>
+[[nodiscard]] constexpr Optional<S> from_wire_bits(std::uint64_t bits) noexcept {
+  using T = typename S::underlying_type;
+  using U = typename S::unsigned_type;
+  if constexpr (S::BITS < 64) {
+    if (bits >> S::BITS != 0) {
+      return None;
+    }
+  }
+  auto u = static_cast<U>(bits);
+  if constexpr (is_signed_int_v<T>) {
+    return Some(S(static_cast<T>(static_cast<U>(u >> 1) ^ static_cast<U>(-(u & 1)))));
+  } else {
+    return Some(S(static_cast<T>(u)));
+  }
+}
+
+} // namespace detail
+
+namespace codec {
+
+// ==================== Zigzag ====================
+
+/// Maps a signed value to unsigned so that 0, -1, 1, -2, ... become
+/// 0, 1, 2, 3, ... Unsigned values are returned unchanged.
+template <detail::CodecInteger S>
+[[nodiscard]] constexpr typename S::unsigned_type zigzag_encode(S value) noexcept {
+  return static_cast<typename S::unsigned_type>(detail::wire_bits(value));
+}
+
+/// Inverse of zigzag_encode. Total: every unsigned value maps back.
+template <detail::CodecInteger S>
+[[nodiscard]] constexpr S
+zigzag_decode(typename S::unsigned_type value) noexcept {
+  return detail::from_wire_bits<S>(static_cast<std::uint64_t>(value)).unwrap();
+}
+
+// ==================== Varint (LEB128) ====================
+
+/// Longest varint of S: ceil(BITS / 7) bytes.
+template <detail::CodecInteger S>
+inline constexpr std::size_t MAX_VARINT_BYTES = (S::BITS + 6) / 7;
+
+/// Appends `values` as LEB128 varints: 7 bits per byte, low bits first, the
+/// high bit of each byte set when more follow. Signed values are zigzagged
+/// first (protobuf `sint`), so -1 takes one byte.
+template <detail::CodecInteger S>
+inline void encode_varint(std::span<const std::type_identity_t<S>> values,
+                          std::vector<std::uint8_t> &out) {
+  std::size_t start = out.size();
+  out.resize(start + values.size() * MAX_VARINT_BYTES<S>);
+  std::uint8_t *p = out.data() + start;
+  for (S value : values) {
+    std::uint64_t bits = detail::wire_bits(value);
+    while (bits >= 0x80) {
+      *p++ = static_cast<std::uint8_t>(bits | 0x80);
+      bits >>= 7;
+    }
+    *p++ = static_cast<std::uint8_t>(bits);
+  }
+  out.resize(static_cast<std::size_t>(p - out.data()));
+}
+
+/// Decodes `out.size()` varints from the start of `in` and returns the
+/// number of bytes read. On error, `out` holds the values before the bad
+/// one.
+template <detail::CodecInteger S>
+[[nodiscard]] inline Result<std::size_t, DecodeError>
+decode_varint(std::span<const std::uint8_t> in, std::span<S> out) noexcept {
+  constexpr std::size_t max_bytes = MAX_VARINT_BYTES<S>;
+  const std::uint8_t *p = in.data();
+  const std::uint8_t *last = p + in.size();
+  for (S &slot : out) {
+    const std::uint8_t *start = p;
+    auto position = static_cast<std::size_t>(start - in.data());
+    // One bound covers both the end of the input and the longest varint
+    std::size_t available = static_cast<std::size_t>(last - p);
+    std::size_t limit = available < max_bytes ? available : max_bytes;
+    std::uint64_t bits = 0;
+    unsigned shift = 0;
+    std::size_t n = 0;
+    for (;;) {
+      if (n == limit) {
+        return Err(DecodeError{limit == max_bytes ? DecodeError::Kind::Overlong
+                                                  : DecodeError::Kind::Truncated,
+                               position});
+      }
+      std::uint8_t byte = p[n++];
+      bits |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        // The last byte of a maximal varint may carry bits past BITS (or
+        // past 64), which the shift above would have dropped
+        if (n == max_bytes && (byte >> (S::BITS - shift)) != 0) {
+          return Err(DecodeError{DecodeError::Kind::OutOfRange, position});
+        }
+        break;
+      }
+      shift += 7;
+    }
+    auto value = detail::from_wire_bits<S>(bits);
+    if (value.is_none()) {
+      return Err(DecodeError{DecodeError::Kind::OutOfRange, position});
+    }
+    slot = value.unwrap();
+    p += n;
+  }
+  return Ok(static_cast<std::size_t>(p - in.data()));
+}
+
+// ==================== Group Varint ====================
+
+/// Appends `values` in groups of four: a tag byte whose bit pairs hold
+/// (byte length - 1) of each value, low pair first, then the values
+/// little-endian in that many bytes. A final group of fewer than four
+/// values has zero pairs for the missing ones and no bytes for them.
+/// Signed values are zigzagged first.
+template <detail::GroupVarintInteger S>
+inline void encode_group_varint(std::span<const std::type_identity_t<S>> values,
+                                std::vector<std::uint8_t> &out) {
+  std::size_t start = out.size();
+  out.resize(start + (values.size() + 3) / 4 + values.size() * 4);
+  std::uint8_t *p = out.data() + start;
+  for (std::size_t i = 0; i < values.size(); i += 4) {
+    std::uint8_t *tag = p++;
+    *tag = 0;
+    std::size_t group = std::min<std::size_t>(4, values.size() - i);
+    for (std::size_t j = 0; j < group; ++j) {
+      auto bits = static_cast<std::uint32_t>(detail::wire_bits(values[i + j]));
+      unsigned length = bits == 0 ? 1 : static_cast<unsigned>(4 - std::countl_zero(bits) / 8);
+      *tag = static_cast<std::uint8_t>(*tag | ((length - 1) << (2 * j)));
+      for (unsigned b = 0; b < length; ++b) {
+        *p++ = static_cast<std::uint8_t>(bits >> (8 * b));
+      }
+    }
+  }
+  out.resize(static_cast<std::size_t>(p - out.data()));
+}
+
+/// Decodes `out.size()` group-varint values and returns the number of
+/// bytes read.
+template <detail::GroupVarintInteger S>
+[[nodiscard]] inline Result<std::size_t, DecodeError>
+decode_group_varint(std::span<const std::uint8_t> in, std::span<S> out) noexcept {
+  const std::uint8_t *p = in.data();
+  const std::uint8_t *last = p + in.size();
+  for (std::size_t i = 0; i < out.size(); i += 4) {
+    auto position = static_cast<std::size_t>(p - in.data());
+    if (p == last) {
+      return Err(DecodeError{DecodeError::Kind::Truncated, position});
+    }
+    unsigned tag = *p++;
+    std::size_t group = std::min<std::size_t>(4, out.size() - i);
+    std::size_t needed = 0;
+    for (std::size_t j = 0; j < group; ++j) {
+      needed += ((tag >> (2 * j)) & 3) + 1;
+    }
+    if (static_cast<std::size_t>(last - p) < needed) {
+      return Err(DecodeError{DecodeError::Kind::Truncated, position});
+    }
+    // With 8 readable bytes per value, mask a 64-bit load instead of
+    // assembling bytes
+    bool wide_loads = static_cast<std::size_t>(last - p) >= needed + 8;
+    for (std::size_t j = 0; j < group; ++j) {
+      unsigned length = ((tag >> (2 * j)) & 3) + 1;
+      std::uint64_t bits = wide_loads ? detail::load_le64(p) & (~std::uint64_t(0) >> (64 - 8 * length))
+                                      : detail::load_le(p, length);
+      auto value = detail::from_wire_bits<S>(bits);
+      if (value.is_none()) {
+        return Err(DecodeError{DecodeError::Kind::OutOfRange,
+                               static_cast<std::size_t>(p - in.data())});
+      }
+      out[i + j] = value.unwrap();
+      p += length;
+    }
+  }
+  return Ok(static_cast<std::size_t>(p - in.data()));
+}
+
+// ==================== Frame of Reference ====================
+
+/// Appends `values` in blocks of FOR_BLOCK (the last block may be
+/// shorter). Each block is a header, one byte of bit width `b` and the
+/// block minimum as a little-endian S, followed by every (value - minimum)
+/// in `b` bits, packed low bits first and rounded up to whole bytes.
+/// Sorted or clustered data (ids, timestamps, small counters) packs into a
+/// few bits per value.
+template <detail::CodecInteger S>
+inline void encode_for(std::span<const std::type_identity_t<S>> values,
+                       std::vector<std::uint8_t> &out) {
+  using U = typename S::unsigned_type;
+  constexpr std::size_t width = sizeof(typename S::underlying_type);
+  for (std::size_t i = 0; i < values.size(); i += FOR_BLOCK) {
+    auto block = values.subspan(i, std::min(FOR_BLOCK, values.size() - i));
+    auto [lo, hi] = std::minmax_element(block.begin(), block.end());
+    U base = static_cast<U>(lo->get());
+    U range = static_cast<U>(static_cast<U>(hi->get()) - base);
+    auto bits = static_cast<unsigned>(std::bit_width(static_cast<std::uint64_t>(range)));
+    out.push_back(static_cast<std::uint8_t>(bits));
+    detail::store_le(out, static_cast<std::uint64_t>(base), width);
+    if (bits == 0) {
+      continue;
+    }
+
+    std::size_t start = out.size();
+    out.resize(start + (block.size() * bits + 7) / 8);
+    std::uint8_t *p = out.data() + start;
+    std::uint64_t acc = 0;
+    unsigned filled = 0;
+    for (S value : block) {
+      auto delta = static_cast<std::uint64_t>(static_cast<U>(static_cast<U>(value.get()) - base));
+      acc |= delta << filled;
+      filled += bits;
+      if (filled >= 64) {
+        std::uint64_t word = acc;
+        if constexpr (std::endian::native == std::endian::big) {
+          word = std::byteswap(word);
+        }
+        std::memcpy(p, &word, 8);
+        p += 8;
+        filled -= 64;
+        // The bits of delta that did not fit in the word just written
+        acc = filled == 0 ? 0 : delta >> (bits - filled);
+      }
+    }
+    for (; filled > 0; filled = filled > 8 ? filled - 8 : 0) {
+      *p++ = static_cast<std::uint8_t>(acc);
+      acc >>= 8;
+    }
+  }
+}
+
+/// Decodes `out.size()` frame-of-reference values and returns the number
+/// of bytes read.
+template <detail::CodecInteger S>
+[[nodiscard]] inline Result<std::size_t, DecodeError>
+decode_for(std::span<const std::uint8_t> in, std::span<S> out) noexcept {
+  using T = typename S::underlying_type;
+  using U = typename S::unsigned_type;
+  constexpr std::size_t width = sizeof(T);
+  const std::uint8_t *p = in.data();
+  const std::uint8_t *last = p + in.size();
+  for (std::size_t i = 0; i < out.size(); i += FOR_BLOCK) {
+    auto position = static_cast<std::size_t>(p - in.data());
+    if (static_cast<std::size_t>(last - p) < 1 + width) {
+      return Err(DecodeError{DecodeError::Kind::Truncated, position});
+    }
+    unsigned bits = *p;
+    if (bits > S::BITS) {
+      return Err(DecodeError{DecodeError::Kind::BadHeader, position});
+    }
+    auto base = static_cast<U>(detail::load_le(p + 1, width));
+    p += 1 + width;
+    std::size_t count = std::min(FOR_BLOCK, out.size() - i);
+    std::size_t bytes = (count * bits + 7) / 8;
+    if (static_cast<std::size_t>(last - p) < bytes) {
+      return Err(DecodeError{DecodeError::Kind::Truncated, position});
+    }
+
+    // Largest delta that keeps base + delta <= MAX (modular subtraction
+    // gives the distance for signed bases too)
+    auto headroom = static_cast<std::uint64_t>(static_cast<U>(static_cast<U>(S::MAX) - base));
+    std::uint64_t mask = bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+    for (std::size_t j = 0; j < count; ++j) {
+      std::size_t bit = j * bits;
+      const std::uint8_t *q = p + bit / 8;
+      unsigned shift = static_cast<unsigned>(bit % 8);
+      std::size_t tail = static_cast<std::size_t>(last - q);
+      std::uint64_t word = tail >= 8 ? detail::load_le64(q) : detail::load_le(q, tail);
+      std::uint64_t delta = word >> shift;
+      if (shift + bits > 64) {
+        delta |= static_cast<std::uint64_t>(q[8]) << (64 - shift);
+      }
+      delta &= mask;
+      if (delta > headroom) {
+        return Err(DecodeError{DecodeError::Kind::OutOfRange, position});
+      }
+      out[i + j] = S(static_cast<T>(static_cast<U>(base + static_cast<U>(delta))));
+    }
+    p += bytes;
+  }
+  return Ok(static_cast<std::size_t>(p - in.data()));
+}
+
+} // namespace codec
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_CODEC_HPP
@@ -0,0 +1,225 @@
+// Test program for pulgacpp::codec
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_codec
+
+#include "codec.hpp"
+#include "../i16/i16.hpp"
+#include "../i32/i32.hpp"
+#include "../i64/i64.hpp"
+#include "../i8/i8.hpp"
+#include "../u16/u16.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include "../u8/u8.hpp"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+using Bytes = std::vector<std::uint8_t>;
+
+/// Edge values, small values of both signs, clustered runs and random bits.
+template <typename S> std::vector<S> samples(std::size_t count, unsigned seed) {
+    using T = typename S::underlying_type;
+    std::vector<S> values = {S(T(0)), S(T(1)), S(S::MAX), S(S::MIN), S(T(S::MAX - 1)), S(T(S::MIN + 1))};
+    std::mt19937_64 rng(seed);
+    T base = static_cast<T>(rng());
+    while (values.size() < count) {
+        switch (rng() % 4) {
+        case 0:
+            values.emplace_back(static_cast<T>(rng()));
+            break;
+        case 1:
+            values.emplace_back(static_cast<T>(rng() % 300));
+            break;
+        case 2:
+            values.emplace_back(static_cast<T>(T(0) - static_cast<T>(rng() % 300)));
+            break;
+        default:
+            values.emplace_back(static_cast<T>(base + static_cast<T>(rng() % 1000)));
+            break;
+        }
+    }
+    return values;
+}
+
+template <typename S, typename Encode, typename Decode>
+bool round_trips(Encode encode, Decode decode, unsigned seed) {
+    for (std::size_t count : {0u, 1u, 3u, 4u, 5u, 127u, 128u, 129u, 1000u}) {
+        auto values = samples<S>(count, seed);
+        values.resize(count);
+        Bytes bytes = {0xAB}; // encoders append
+        encode(std::span<const S>(values), bytes);
+        std::vector<S> decoded(count);
+        auto read = decode(std::span<const std::uint8_t>(bytes).subspan(1), std::span<S>(decoded));
+        if (read.is_err() || read.unwrap() != bytes.size() - 1 || decoded != values) {
+            return false;
+        }
+        // Every proper prefix of a non-empty encoding is truncated
+        for (std::size_t cut = 0; cut + 1 < bytes.size(); cut += 1 + cut / 8) {
+            auto r = decode(std::span<const std::uint8_t>(bytes).subspan(1, cut), std::span<S>(decoded));
+            if (r.is_ok() || r.unwrap_err().kind != codec::DecodeError::Kind::Truncated) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename S> bool varint_round_trips(unsigned seed) {
+    return round_trips<S>([](auto v, Bytes &out) { codec::encode_varint<S>(v, out); },
+                          [](auto in, auto out) { return codec::decode_varint<S>(in, out); }, seed);
+}
+
+template <typename S> bool group_varint_round_trips(unsigned seed) {
+    return round_trips<S>([](auto v, Bytes &out) { codec::encode_group_varint<S>(v, out); },
+                          [](auto in, auto out) { return codec::decode_group_varint<S>(in, out); }, seed);
+}
+
+template <typename S> bool for_round_trips(unsigned seed) {
+    return round_trips<S>([](auto v, Bytes &out) { codec::encode_for<S>(v, out); },
+                          [](auto in, auto out) { return codec::decode_for<S>(in, out); }, seed);
+}
+
+template <typename S> codec::DecodeError::Kind varint_error(Bytes bytes) {
+    std::vector<S> out(1);
+    return codec::decode_varint<S>(bytes, out).unwrap_err().kind;
+}
+
+int main() {
+    std::cout << "=== pulgacpp::codec Test Suite ===\n\n";
+    using Kind = codec::DecodeError::Kind;
+
+    // --- Zigzag ---
+    std::cout << "--- Zigzag ---\n";
+    {
+        test(codec::zigzag_encode(0_i32) == 0u && codec::zigzag_encode(i32(-1)) == 1u &&
+                 codec::zigzag_encode(1_i32) == 2u && codec::zigzag_encode(i32(-2)) == 3u,
+             "0, -1, 1, -2 -> 0, 1, 2, 3");
+        test(codec::zigzag_encode(i64(i64::MIN)) == UINT64_MAX && codec::zigzag_encode(i64(i64::MAX)) == UINT64_MAX - 1,
+             "zigzag of MIN and MAX");
+        test(codec::zigzag_encode(i8(std::int8_t{-128})) == 255, "zigzag of i8 MIN");
+        bool all = true;
+        for (int v = -128; v <= 127; ++v) {
+            auto s = i8(static_cast<std::int8_t>(v));
+            all &= codec::zigzag_decode<i8>(codec::zigzag_encode(s)) == s;
+        }
+        test(all, "zigzag round-trips every i8");
+        test(codec::zigzag_encode(200_u8) == 200, "unsigned values pass through");
+    }
+
+    // --- Varint ---
+    std::cout << "\n--- Varint ---\n";
+    {
+        Bytes bytes;
+        std::vector<u32> values = {0_u32, 127_u32, 128_u32, 300_u32, u32(u32::MAX)};
+        codec::encode_varint<u32>(values, bytes);
+        test(bytes == Bytes{0x00, 0x7F, 0x80, 0x01, 0xAC, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F}, "LEB128 bytes");
+        bytes.clear();
+        std::vector<i64> negative = {i64(std::int64_t{-1}), i64(std::int64_t{-64})};
+        codec::encode_varint<i64>(negative, bytes);
+        test(bytes == Bytes{0x01, 0x7F}, "small negative values take one byte");
+
+        test(varint_round_trips<u8>(1) && varint_round_trips<u16>(2) && varint_round_trips<u32>(3) &&
+                 varint_round_trips<u64>(4),
+             "unsigned varints round-trip");
+        test(varint_round_trips<i8>(5) && varint_round_trips<i16>(6) && varint_round_trips<i32>(7) &&
+                 varint_round_trips<i64>(8),
+             "signed varints round-trip");
+
+        test(varint_error<u32>({0xFF, 0xFF, 0xFF, 0xFF, 0x10}) == Kind::OutOfRange, "u32: a 33rd bit is out of range");
+        test(varint_error<u32>({0x80, 0x80, 0x80, 0x80, 0x80, 0x00}) == Kind::Overlong, "u32: six bytes are overlong");
+        test(varint_error<u64>({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02}) == Kind::OutOfRange,
+             "u64: a 65th bit is out of range");
+        test(varint_error<u8>({0x80, 0x02}) == Kind::OutOfRange, "u8: 256 is out of range");
+        test(varint_error<u16>({0x80}) == Kind::Truncated, "continuation at the end is truncated");
+        test(varint_error<u16>({}) == Kind::Truncated, "empty input is truncated");
+
+        std::vector<u64> max = {u64(u64::MAX)};
+        bytes.clear();
+        codec::encode_varint<u64>(max, bytes);
+        std::vector<u64> back(1);
+        test(bytes.size() == 10 && codec::decode_varint<u64>(bytes, back).is_ok() && back == max, "u64::MAX is 10 bytes");
+
+        Bytes two = {0x05, 0x80, 0x01, 0xFF};
+        std::vector<u16> out(2);
+        auto read = codec::decode_varint<u16>(two, out);
+        test(read.unwrap() == 3 && out[0] == 5_u16 && out[1] == 128_u16, "returns the bytes read; trailing bytes stay");
+        auto bad = codec::decode_varint<u16>(Bytes{0x05, 0x80, 0x80, 0x04}, out);
+        test(bad.unwrap_err() == codec::DecodeError{Kind::OutOfRange, 1}, "error position is the bad value's offset");
+    }
+
+    // --- Group Varint ---
+    std::cout << "\n--- Group Varint ---\n";
+    {
+        Bytes bytes;
+        std::vector<u32> values = {1_u32, 256_u32, 65536_u32, u32(u32::MAX), 7_u32};
+        codec::encode_group_varint<u32>(values, bytes);
+        test(bytes == Bytes{0xE4, 0x01, 0x00, 0x01, 0x00, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x07},
+             "tag byte and little-endian values");
+        test(group_varint_round_trips<u8>(9) && group_varint_round_trips<u16>(10) &&
+                 group_varint_round_trips<u32>(11),
+             "unsigned group varints round-trip");
+        test(group_varint_round_trips<i8>(12) && group_varint_round_trips<i16>(13) &&
+                 group_varint_round_trips<i32>(14),
+             "signed group varints round-trip");
+        std::vector<u16> out(1);
+        test(codec::decode_group_varint<u16>(Bytes{0x02, 0x00, 0x00, 0x01}, out).unwrap_err().kind == Kind::OutOfRange,
+             "u16: a 3-byte value is out of range");
+    }
+
+    // --- Frame of Reference ---
+    std::cout << "\n--- Frame of Reference ---\n";
+    {
+        std::vector<u64> ids;
+        for (std::uint64_t i = 0; i < 256; ++i) {
+            ids.emplace_back(std::uint64_t{1'700'000'000'000} + i * 3);
+        }
+        Bytes bytes;
+        codec::encode_for<u64>(ids, bytes);
+        test(bytes.size() == 2 * (1 + 8 + 128 * 9 / 8), "256 clustered u64 values take 9 bits each");
+        std::vector<u64> same(300, u64(std::uint64_t{42}));
+        bytes.clear();
+        codec::encode_for<u64>(same, bytes);
+        test(bytes.size() == 3 * 9, "constant blocks are header only");
+
+        test(for_round_trips<u8>(15) && for_round_trips<u16>(16) && for_round_trips<u32>(17) &&
+                 for_round_trips<u64>(18),
+             "unsigned frame of reference round-trips");
+        test(for_round_trips<i8>(19) && for_round_trips<i16>(20) && for_round_trips<i32>(21) &&
+                 for_round_trips<i64>(22),
+             "signed frame of reference round-trips");
+
+        std::vector<i8> out(1);
+        test(codec::decode_for<i8>(Bytes{9, 0x00}, out).unwrap_err().kind == Kind::BadHeader,
+             "bit width above BITS is a bad header");
+        test(codec::decode_for<i8>(Bytes{8, 0x7F, 0x01}, out).unwrap_err().kind == Kind::OutOfRange,
+             "base + delta past MAX is out of range");
+        test(codec::decode_for<i8>(Bytes{8, 0x80, 0xFF}, out).is_ok() && out[0] == 127_i8, "-128 + 255 = 127");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
@@ -100,7 +100,12 @@ inline constexpr double Q_E = ELEMENTARY_CHARGE; // Alias
 
 /// Electron mass (kg)
 inline constexpr double ELECTRON_MASS = 9.1093837015e-31;
+// <cmath> may define M_E (Euler's number) as a macro; declare the alias
+// without it and restore it afterwards
+#pragma push_macro("M_E")
+#undef M_E
 inline constexpr double M_E = ELECTRON_MASS; // Alias
+#pragma pop_macro("M_E")
 
 /// Proton mass (kg)
 inline constexpr double PROTON_MASS = 1.67262192369e-27;
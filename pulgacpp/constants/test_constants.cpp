@@ -50,7 +50,10 @@ int main() {
   test(physics::H == physics::PLANCK, "H alias works");
   test(approx_eq(physics::ELECTRON_MASS, 9.1093837015e-31),
        "ELECTRON_MASS ≈ 9.109e-31");
+#pragma push_macro("M_E")
+#undef M_E
   test(physics::M_E == physics::ELECTRON_MASS, "M_E alias works");
+#pragma pop_macro("M_E")
   test(approx_eq(physics::BOLTZMANN, 1.380649e-23), "BOLTZMANN ≈ 1.38e-23");
   test(physics::STANDARD_PRESSURE == 101325.0, "STANDARD_PRESSURE = 101325 Pa");
 
@@ -0,0 +1,280 @@
+// pulgacpp::detail charconv - Decimal parsing and formatting kernels
+// SPDX-License-Identifier: MIT
+//
+// This is an internal implementation detail behind SafeInt::parse,
+// SafeInt::to_chars and the batch text functions. ParseError is the public
+// error type those APIs return.
+//
+// Parsing reads eight digits at a time with SWAR (one 64-bit load, a digit
+// check and three multiplies) and finishes the tail one digit at a time.
+// Each step is range-checked against the type's limit before it is applied,
+// so nothing wraps at any width up to 128 bits. Formatting writes two digits
+// per division using a lookup table.
+
+#ifndef PULGACPP_CORE_CHARCONV_HPP
+#define PULGACPP_CORE_CHARCONV_HPP
+
+#include "overflow.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace pulgacpp {
+
+/// Why a string could not be parsed as an integer, and where.
+struct ParseError {
+  enum class Kind : std::uint8_t {
+    Empty,        ///< The input was empty
+    InvalidDigit, ///< A character that is not a digit (or a lone sign)
+    PosOverflow,  ///< The value is larger than the type's MAX
+    NegOverflow,  ///< The value is smaller than the type's MIN
+  };
+
+  Kind kind;
+  /// Offset of the offending character in the input (0 for Empty).
+  std::size_t position;
+
+  /// Short description of the error kind.
+  [[nodiscard]] constexpr std::string_view message() const noexcept {
+    switch (kind) {
+    case Kind::Empty:
+      return "cannot parse integer from empty string";
+    case Kind::InvalidDigit:
+      return "invalid digit found in string";
+    case Kind::PosOverflow:
+      return "number too large to fit in target type";
+    case Kind::NegOverflow:
+      return "number too small to fit in target type";
+    }
+    return "";
+  }
+
+  [[nodiscard]] constexpr bool
+  operator==(const ParseError &other) const noexcept = default;
+};
+
+namespace detail {
+
+// ============================================================
+// Parsing
+// ============================================================
+
+/// Accumulator for parsing a T: 64 bits for everything up to 64-bit types,
+/// unsigned 128 bits for the 128-bit types.
+template <typename T>
+using parse_accumulator_t =
+    std::conditional_t<(sizeof(T) > 8), make_unsigned_int_t<T>, std::uint64_t>;
+
+/// Loads 8 characters as a little-endian 64-bit word.
+[[nodiscard]] inline std::uint64_t load_eight_chars(const char *p) noexcept {
+  std::uint64_t chunk;
+  std::memcpy(&chunk, p, sizeof(chunk));
+  if constexpr (std::endian::native == std::endian::big) {
+    chunk = ((chunk & 0x00FF00FF00FF00FFULL) << 8) |
+            ((chunk >> 8) & 0x00FF00FF00FF00FFULL);
+    chunk = ((chunk & 0x0000FFFF0000FFFFULL) << 16) |
+            ((chunk >> 16) & 0x0000FFFF0000FFFFULL);
+    chunk = (chunk << 32) | (chunk >> 32);
+  }
+  return chunk;
+}
+
+/// True if all 8 bytes of `chunk` are ASCII '0'..'9'.
+[[nodiscard]] constexpr bool is_eight_digits(std::uint64_t chunk) noexcept {
+  // High nibble must be 3, and adding 6 must not carry into it
+  return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+         0x3333333333333333ULL;
+}
+
+/// Value of 8 ASCII digits (first character in the lowest byte).
+[[nodiscard]] constexpr std::uint32_t
+parse_eight_digits(std::uint64_t chunk) noexcept {
+  chunk -= 0x3030303030303030ULL;
+  chunk = (chunk * 10) + (chunk >> 8); // pairs of digits
+  chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+           (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+          32;
+  return static_cast<std::uint32_t>(chunk);
+}
+
+/// Result of parse_integer: the value, one past the last character consumed,
+/// and whether parsing failed (with `error` describing why).
+template <typename T> struct ParsedInteger {
+  T value;
+  const char *ptr;
+  bool ok;
+  ParseError error;
+};
+
+/// Parses an optionally signed decimal integer of primitive type T from the
+/// front of [first, last), stopping at the first non-digit. `origin` is the
+/// start of the whole input and is only used to compute error positions.
+template <typename T>
+[[nodiscard]] constexpr ParsedInteger<T>
+parse_integer(const char *first, const char *last,
+              const char *origin) noexcept {
+  using Acc = parse_accumulator_t<T>;
+  using Unsigned = make_unsigned_int_t<T>;
+
+  auto fail = [&](ParseError::Kind kind, const char *at) {
+    return ParsedInteger<T>{T{}, at, false,
+                            ParseError{kind, static_cast<std::size_t>(at - origin)}};
+  };
+
+  if (first == last) {
+    return fail(ParseError::Kind::Empty, first);
+  }
+
+  const char *p = first;
+  bool negative = false;
+  if (*p == '+') {
+    ++p;
+  } else if (*p == '-' && is_signed_int_v<T>) {
+    negative = true;
+    ++p;
+  }
+  if (p == last || static_cast<unsigned char>(*p - '0') > 9) {
+    return fail(ParseError::Kind::InvalidDigit, p);
+  }
+
+  // Largest magnitude allowed: MAX, or |MIN| = MAX + 1 when negative
+  Acc limit = static_cast<Acc>(std::numeric_limits<T>::max());
+  if (negative) {
+    limit += 1;
+  }
+  auto overflow_kind = negative ? ParseError::Kind::NegOverflow
+                                : ParseError::Kind::PosOverflow;
+
+  // value * base + digits <= limit  <=>  value < limit / base, or
+  // value == limit / base and digits <= limit % base
+  const Acc limit_div10 = limit / 10;
+  const auto limit_mod10 = static_cast<unsigned>(limit % 10);
+
+  Acc value = 0;
+  if (!std::is_constant_evaluated()) {
+    // Fast path: eight digits per step while the result stays in range
+    const Acc limit_div8 = limit / 100000000;
+    const auto limit_mod8 = static_cast<std::uint32_t>(limit % 100000000);
+    while (last - p >= 8) {
+      std::uint64_t chunk = load_eight_chars(p);
+      if (!is_eight_digits(chunk)) {
+        break;
+      }
+      std::uint32_t digits = parse_eight_digits(chunk);
+      if (value > limit_div8 || (value == limit_div8 && digits > limit_mod8)) {
+        break; // the digit loop below finds the exact position
+      }
+      value = value * 100000000 + digits;
+      p += 8;
+    }
+  }
+
+  for (; p != last; ++p) {
+    unsigned digit = static_cast<unsigned char>(*p - '0');
+    if (digit > 9) {
+      break;
+    }
+    if (value > limit_div10 || (value == limit_div10 && digit > limit_mod10)) {
+      return fail(overflow_kind, p);
+    }
+    value = value * 10 + digit;
+  }
+
+  auto magnitude = static_cast<Unsigned>(value);
+  T result = negative ? static_cast<T>(Unsigned(0) - magnitude)
+                      : static_cast<T>(magnitude);
+  return ParsedInteger<T>{result, p, true, ParseError{}};
+}
+
+// ============================================================
+// Formatting
+// ============================================================
+
+/// "00" "01" ... "99"
+inline constexpr char DIGIT_PAIRS[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536"
+    "37383940414243444546474849505152535455565758596061626364656667686970717273"
+    "7475767778798081828384858687888990919293949596979899";
+
+/// Writes the decimal digits of `value` so that they end at `end`.
+/// Returns the position of the first digit.
+[[nodiscard]] constexpr char *write_decimal_backward(char *end,
+                                                     std::uint64_t value) noexcept {
+  while (value >= 100) {
+    auto pair = static_cast<unsigned>(value % 100) * 2;
+    value /= 100;
+    *--end = DIGIT_PAIRS[pair + 1];
+    *--end = DIGIT_PAIRS[pair];
+  }
+  if (value >= 10) {
+    auto pair = static_cast<unsigned>(value) * 2;
+    *--end = DIGIT_PAIRS[pair + 1];
+    *--end = DIGIT_PAIRS[pair];
+  } else {
+    *--end = static_cast<char>('0' + value);
+  }
+  return end;
+}
+
+#if PULGACPP_HAS_INT128
+[[nodiscard]] constexpr char *
+write_decimal_backward(char *end, unsigned __int128 value) noexcept {
+  // Peel off 19-digit blocks with one 128-bit division each, then finish
+  // with the 64-bit loop
+  constexpr std::uint64_t BLOCK = 10000000000000000000ULL; // 10^19
+  while (value > std::numeric_limits<std::uint64_t>::max()) {
+    auto low = static_cast<std::uint64_t>(value % BLOCK);
+    value /= BLOCK;
+    char *block_start = end - 19;
+    char *digits = write_decimal_backward(end, low);
+    while (digits != block_start) {
+      *--digits = '0';
+    }
+    end = block_start;
+  }
+  return write_decimal_backward(end, static_cast<std::uint64_t>(value));
+}
+#endif // PULGACPP_HAS_INT128
+
+/// Upper bound on the characters needed to print any T (digits plus sign).
+template <typename T>
+inline constexpr std::size_t max_decimal_chars_v =
+    static_cast<std::size_t>(std::numeric_limits<T>::digits10) + 2;
+
+/// Writes `value` in decimal into a buffer ending at `end`; returns the
+/// position of the first character. The buffer must hold
+/// max_decimal_chars_v<T> characters.
+template <typename T>
+[[nodiscard]] constexpr char *format_integer_backward(char *end,
+                                                      T value) noexcept {
+  using Unsigned = make_unsigned_int_t<T>;
+  auto magnitude = static_cast<Unsigned>(value);
+  bool negative = false;
+  if constexpr (is_signed_int_v<T>) {
+    if (value < 0) {
+      negative = true;
+      magnitude = Unsigned(0) - magnitude;
+    }
+  }
+  char *first;
+  if constexpr (sizeof(T) > 8) {
+    first = write_decimal_backward(end, magnitude);
+  } else {
+    first = write_decimal_backward(end, static_cast<std::uint64_t>(magnitude));
+  }
+  if (negative) {
+    *--first = '-';
+  }
+  return first;
+}
+
+} // namespace detail
+} // namespace pulgacpp
+
+#endif // PULGACPP_CORE_CHARCONV_HPP
@@ -0,0 +1,191 @@
+// pulgacpp::detail::CheckedExpr - Overflow-tracking arithmetic chains
+// SPDX-License-Identifier: MIT
+//
+// This is an internal implementation detail. Users get it through the
+// integer headers and create one with pulgacpp::checked_expr().
+//
+// A CheckedExpr carries a value together with a sticky overflow bit. Every
+// add/sub/mul ORs its overflow flag into the bit, so a long chain compiles to
+// straight-line code and is checked once at the end instead of branching on
+// an Optional after every step. 64-bit steps use the checked_*_i64/u64
+// primitives from overflow.hpp (a single flag-setting instruction where the
+// compiler has overflow builtins); narrower types use the overflowing_*
+// methods, which compute in the wider type.
+//
+// Usage:
+//   auto total = checked_expr(price) * quantity + shipping - discount;
+//   Optional<i64> result = total.value();  // None if any step overflowed
+
+#ifndef PULGACPP_CORE_CHECKED_EXPR_HPP
+#define PULGACPP_CORE_CHECKED_EXPR_HPP
+
+#include "safe_int.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace pulgacpp {
+
+namespace detail {
+
+/// Value of type S plus a sticky "some step overflowed" flag.
+/// Once set, the flag stays set; the value then holds the wrapped result of
+/// the chain (what the wrapping_* methods would give) and should be ignored.
+template <SafeInteger S> class CheckedExpr {
+public:
+  using value_type = S;
+
+  constexpr CheckedExpr() noexcept = default;
+  constexpr explicit CheckedExpr(S value) noexcept : m_value(value) {}
+
+  // ==================== Result ====================
+
+  /// The final value, or None if any step of the chain overflowed.
+  [[nodiscard]] constexpr Optional<S> value() const noexcept {
+    if (m_overflow) {
+      return None;
+    }
+    return Some(m_value);
+  }
+
+  /// The final value, or `fallback` if any step overflowed.
+  [[nodiscard]] constexpr S value_or(S fallback) const noexcept {
+    return m_overflow ? fallback : m_value;
+  }
+
+  /// True if any step of the chain overflowed.
+  [[nodiscard]] constexpr bool is_overflowed() const noexcept {
+    return m_overflow;
+  }
+
+  /// The value computed so far, wrapped if the chain overflowed.
+  [[nodiscard]] constexpr S wrapped() const noexcept { return m_value; }
+
+  // ==================== Compound assignment ====================
+
+  constexpr CheckedExpr &operator+=(S rhs) noexcept {
+    if constexpr (S::BITS == 64) {
+      if (!std::is_constant_evaluated()) {
+        return track(step64(rhs, checked_add_i64, checked_add_u64));
+      }
+    }
+    return track(m_value.overflowing_add(rhs));
+  }
+
+  constexpr CheckedExpr &operator-=(S rhs) noexcept {
+    if constexpr (S::BITS == 64) {
+      if (!std::is_constant_evaluated()) {
+        return track(step64(rhs, checked_sub_i64, checked_sub_u64));
+      }
+    }
+    return track(m_value.overflowing_sub(rhs));
+  }
+
+  constexpr CheckedExpr &operator*=(S rhs) noexcept {
+    if constexpr (S::BITS == 64) {
+      if (!std::is_constant_evaluated()) {
+        return track(step64(rhs, checked_mul_i64, checked_mul_u64));
+      }
+    }
+    return track(m_value.overflowing_mul(rhs));
+  }
+
+  constexpr CheckedExpr &operator+=(CheckedExpr rhs) noexcept {
+    m_overflow |= rhs.m_overflow;
+    return *this += rhs.m_value;
+  }
+
+  constexpr CheckedExpr &operator-=(CheckedExpr rhs) noexcept {
+    m_overflow |= rhs.m_overflow;
+    return *this -= rhs.m_value;
+  }
+
+  constexpr CheckedExpr &operator*=(CheckedExpr rhs) noexcept {
+    m_overflow |= rhs.m_overflow;
+    return *this *= rhs.m_value;
+  }
+
+  // ==================== Binary operators ====================
+
+  [[nodiscard]] friend constexpr CheckedExpr operator+(CheckedExpr lhs,
+                                                       S rhs) noexcept {
+    return lhs += rhs;
+  }
+  [[nodiscard]] friend constexpr CheckedExpr operator+(S lhs,
+                                                       CheckedExpr rhs) noexcept {
+    return CheckedExpr(lhs) += rhs;
+  }
+  [[nodiscard]] friend constexpr CheckedExpr
+  operator+(CheckedExpr lhs, CheckedExpr rhs) noexcept {
+    return lhs += rhs;
+  }
+
+  [[nodiscard]] friend constexpr CheckedExpr operator-(CheckedExpr lhs,
+                                                       S rhs) noexcept {
+    return lhs -= rhs;
+  }
+  [[nodiscard]] friend constexpr CheckedExpr operator-(S lhs,
+                                                       CheckedExpr rhs) noexcept {
+    return CheckedExpr(lhs) -= rhs;
+  }
+  [[nodiscard]] friend constexpr CheckedExpr
+  operator-(CheckedExpr lhs, CheckedExpr rhs) noexcept {
+    return lhs -= rhs;
+  }
+
+  [[nodiscard]] friend constexpr CheckedExpr operator*(CheckedExpr lhs,
+                                                       S rhs) noexcept {
+    return lhs *= rhs;
+  }
+  [[nodiscard]] friend constexpr CheckedExpr operator*(S lhs,
+                                                       CheckedExpr rhs) noexcept {
+    return CheckedExpr(lhs) *= rhs;
+  }
+  [[nodiscard]] friend constexpr CheckedExpr
+  operator*(CheckedExpr lhs, CheckedExpr rhs) noexcept {
+    return lhs *= rhs;
+  }
+
+private:
+  using underlying_type = typename S::underlying_type;
+
+  // Runs one 64-bit step through overflow.hpp. isize/usize may use a
+  // different 64-bit type than std::int64_t, hence the casts.
+  template <typename SignedFn, typename UnsignedFn>
+  std::pair<S, bool> step64(S rhs, SignedFn signed_fn,
+                            UnsignedFn unsigned_fn) const noexcept {
+    if constexpr (std::is_signed_v<underlying_type>) {
+      auto [result, overflow] =
+          signed_fn(static_cast<std::int64_t>(m_value.get()),
+                    static_cast<std::int64_t>(rhs.get()));
+      return {S(static_cast<underlying_type>(result)), overflow};
+    } else {
+      auto [result, overflow] =
+          unsigned_fn(static_cast<std::uint64_t>(m_value.get()),
+                      static_cast<std::uint64_t>(rhs.get()));
+      return {S(static_cast<underlying_type>(result)), overflow};
+    }
+  }
+
+  constexpr CheckedExpr &track(std::pair<S, bool> step) noexcept {
+    m_value = step.first;
+    m_overflow |= step.second;
+    return *this;
+  }
+
+  S m_value{};
+  bool m_overflow = false;
+};
+
+} // namespace detail
+
+/// Starts an overflow-tracking arithmetic chain from `value`.
+template <detail::SafeInteger S>
+[[nodiscard]] constexpr detail::CheckedExpr<S> checked_expr(S value) noexcept {
+  return detail::CheckedExpr<S>(value);
+}
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_CORE_CHECKED_EXPR_HPP
@@ -0,0 +1,297 @@
+// pulgacpp::instrument - Per-call-site counters of overflow events
+// SPDX-License-Identifier: MIT
+//
+// Opt-in: compile with PULGACPP_INSTRUMENT=1 (the same value in every
+// translation unit) to count, for each call site, how often
+//   - a checked_* method returned None,
+//   - a saturating_* method clamped,
+//   - unwrap() / expect() panicked on None.
+// With it, those methods take a trailing std::source_location parameter
+// defaulted to the caller's location; callers do not change.
+//
+// Counting is lock-free: each thread writes only its own table, a fixed
+// open-addressing hash table of call sites allocated on the thread's first
+// event (if that allocation fails, the thread's events are only counted as
+// dropped). Nothing happens on the path that does not overflow except passing
+// the location (one pointer). Without PULGACPP_INSTRUMENT the parameters
+// and counters are not compiled in at all, and snapshot() is empty.
+//
+// Usage:
+//   // g++ -DPULGACPP_INSTRUMENT=1 ...
+//   #include <pulgacpp/i32/i32.hpp>
+//
+//   instrument::dump(std::cerr);   // e.g. at shutdown
+//   //    1843  checked_none  src/billing.cpp:88:31  Money apply_discount(...)
+//   //      12  saturated     src/audio.cpp:40:18   void mix(...)
+
+#ifndef PULGACPP_CORE_INSTRUMENT_HPP
+#define PULGACPP_CORE_INSTRUMENT_HPP
+
+#ifndef PULGACPP_INSTRUMENT
+#define PULGACPP_INSTRUMENT 0
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <ostream>
+#include <source_location>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Call-site plumbing for the instrumented methods. PULGACPP_SITE_PARAM is
+// appended to a parameter list, PULGACPP_SITE_PARAM_ONLY is an entire one,
+// PULGACPP_SITE_ARG forwards the site, and PULGACPP_RECORD(Event) counts an
+// event at it. All four are empty when instrumentation is off.
+#if PULGACPP_INSTRUMENT
+#define PULGACPP_SITE_PARAM                                                    \
+  , ::std::source_location pulgacpp_site = ::std::source_location::current()
+#define PULGACPP_SITE_PARAM_ONLY                                               \
+  ::std::source_location pulgacpp_site = ::std::source_location::current()
+#define PULGACPP_SITE_ARG , pulgacpp_site
+#define PULGACPP_RECORD(event)                                                 \
+  do {                                                                         \
+    if (!std::is_constant_evaluated()) {                                       \
+      ::pulgacpp::instrument::detail::record(                                  \
+          ::pulgacpp::instrument::Event::event, pulgacpp_site);                \
+    }                                                                          \
+  } while (0)
+#else
+#define PULGACPP_SITE_PARAM
+#define PULGACPP_SITE_PARAM_ONLY
+#define PULGACPP_SITE_ARG
+#define PULGACPP_RECORD(event)                                                 \
+  do {                                                                         \
+  } while (0)
+#endif
+
+namespace pulgacpp::instrument {
+
+/// True when built with PULGACPP_INSTRUMENT=1.
+inline constexpr bool ENABLED = PULGACPP_INSTRUMENT != 0;
+
+enum class Event : std::uint8_t {
+  CheckedNone, ///< A checked_* method returned None
+  Saturated,   ///< A saturating_* method clamped to MIN or MAX
+  Panic,       ///< unwrap() or expect() was called on None
+};
+
+[[nodiscard]] constexpr std::string_view event_name(Event event) noexcept {
+  switch (event) {
+  case Event::CheckedNone:
+    return "checked_none";
+  case Event::Saturated:
+    return "saturated";
+  case Event::Panic:
+    return "panic";
+  }
+  return "?";
+}
+
+/// Events of one kind at one call site, summed over all threads.
+struct SiteCount {
+  std::string_view file;
+  std::string_view function;
+  std::uint32_t line = 0;
+  std::uint32_t column = 0;
+  Event event = Event::CheckedNone;
+  std::uint64_t count = 0;
+};
+
+/// Called on every event after it is counted, on the thread that hit it,
+/// e.g. to break into a debugger or feed a sampling profiler. For a Panic
+/// it runs just before the program aborts.
+using Hook = void (*)(Event, const std::source_location &) noexcept;
+
+namespace detail {
+
+/// Call sites per thread table; events at further sites are only counted
+/// in `dropped`.
+inline constexpr std::size_t SITE_SLOTS = 1024;
+
+struct Slot {
+  // Published last (release), so a reader that sees the file sees the rest
+  std::atomic<const char *> file{nullptr};
+  const char *function = nullptr;
+  std::uint32_t line = 0;
+  std::uint32_t column = 0;
+  Event event = Event::CheckedNone;
+  // Written only by the owning thread; atomic so snapshot() can read it
+  std::atomic<std::uint64_t> count{0};
+};
+
+struct Table {
+  Slot slots[SITE_SLOTS];
+  std::atomic<std::uint64_t> dropped{0};
+  Table *next = nullptr;
+};
+
+#if PULGACPP_INSTRUMENT
+/// Every thread table ever created. Tables are never freed, so the counts
+/// of finished threads stay visible.
+inline std::atomic<Table *> g_tables{nullptr};
+inline std::atomic<Hook> g_hook{nullptr};
+/// Events on threads whose table could not be allocated
+inline std::atomic<std::uint64_t> g_unallocated{0};
+
+/// The calling thread's table, allocated on first use; nullptr if that
+/// allocation fails (it is tried again on the next event).
+[[nodiscard]] inline Table *local_table() noexcept {
+  thread_local Table *table = nullptr;
+  if (table == nullptr) {
+    table = new (std::nothrow) Table();
+    if (table == nullptr) {
+      return nullptr;
+    }
+    table->next = g_tables.load(std::memory_order_relaxed);
+    while (!g_tables.compare_exchange_weak(table->next, table,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+  }
+  return table;
+}
+
+/// Counts one event at `site` in the calling thread's table.
+inline void record(Event event, const std::source_location &site) noexcept {
+  Table *local = local_table();
+  if (local == nullptr) {
+    g_unallocated.fetch_add(1, std::memory_order_relaxed);
+    if (Hook hook = g_hook.load(std::memory_order_acquire)) {
+      hook(event, site);
+    }
+    return;
+  }
+  Table &table = *local;
+  auto key = reinterpret_cast<std::uintptr_t>(site.file_name()) ^
+             (std::uintptr_t{site.line()} << 16) ^ site.column() ^
+             (static_cast<std::uintptr_t>(event) << 12);
+  std::size_t index = static_cast<std::size_t>(key * 0x9E3779B97F4A7C15ull >> 32);
+  bool counted = false;
+  for (std::size_t probe = 0; probe < SITE_SLOTS && !counted; ++probe) {
+    Slot &slot = table.slots[(index + probe) % SITE_SLOTS];
+    const char *file = slot.file.load(std::memory_order_relaxed);
+    if (file == nullptr) {
+      slot.function = site.function_name();
+      slot.line = site.line();
+      slot.column = site.column();
+      slot.event = event;
+      slot.count.store(1, std::memory_order_relaxed);
+      slot.file.store(site.file_name(), std::memory_order_release);
+      counted = true;
+    } else if (file == site.file_name() && slot.line == site.line() &&
+               slot.column == site.column() && slot.event == event) {
+      slot.count.store(slot.count.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+      counted = true;
+    }
+  }
+  if (!counted) {
+    table.dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (Hook hook = g_hook.load(std::memory_order_acquire)) {
+    hook(event, site);
+  }
+}
+#endif // PULGACPP_INSTRUMENT
+
+} // namespace detail
+
+/// Counts of every call site with at least one event, merged across
+/// threads and sorted by count, highest first. Counts being updated by
+/// other threads may be slightly behind.
+[[nodiscard]] inline std::vector<SiteCount> snapshot() {
+  std::vector<SiteCount> sites;
+#if PULGACPP_INSTRUMENT
+  for (auto *table = detail::g_tables.load(std::memory_order_acquire);
+       table != nullptr; table = table->next) {
+    for (const auto &slot : table->slots) {
+      const char *file = slot.file.load(std::memory_order_acquire);
+      std::uint64_t count = slot.count.load(std::memory_order_relaxed);
+      if (file != nullptr && count > 0) {
+        sites.push_back({file, slot.function, slot.line, slot.column,
+                         slot.event, count});
+      }
+    }
+  }
+  // The same site recorded by several threads (or with different file
+  // name pointers from different translation units) is merged here
+  auto key = [](const SiteCount &s) {
+    return std::tie(s.file, s.line, s.column, s.event);
+  };
+  std::sort(sites.begin(), sites.end(),
+            [&](const SiteCount &a, const SiteCount &b) { return key(a) < key(b); });
+  std::vector<SiteCount> merged;
+  for (const auto &site : sites) {
+    if (!merged.empty() && key(merged.back()) == key(site)) {
+      merged.back().count += site.count;
+    } else {
+      merged.push_back(site);
+    }
+  }
+  std::stable_sort(merged.begin(), merged.end(),
+                   [](const SiteCount &a, const SiteCount &b) { return a.count > b.count; });
+  sites = std::move(merged);
+#endif
+  return sites;
+}
+
+/// Events that were not counted at their site: those at call sites beyond
+/// the capacity of their thread's table, and those on threads whose table
+/// could not be allocated.
+[[nodiscard]] inline std::uint64_t dropped() noexcept {
+  std::uint64_t total = 0;
+#if PULGACPP_INSTRUMENT
+  total += detail::g_unallocated.load(std::memory_order_relaxed);
+  for (auto *table = detail::g_tables.load(std::memory_order_acquire);
+       table != nullptr; table = table->next) {
+    total += table->dropped.load(std::memory_order_relaxed);
+  }
+#endif
+  return total;
+}
+
+/// Writes snapshot() as one line per site: count, event, location and
+/// function.
+inline void dump(std::ostream &os) {
+  for (const auto &site : snapshot()) {
+    os << site.count << '\t' << event_name(site.event) << '\t' << site.file
+       << ':' << site.line << ':' << site.column << '\t' << site.function
+       << '\n';
+  }
+  if (std::uint64_t lost = dropped(); lost > 0) {
+    os << lost << "\tdropped (site tables full or unallocated)\n";
+  }
+}
+
+/// Sets every count to zero. Events recorded concurrently may be lost.
+inline void reset() noexcept {
+#if PULGACPP_INSTRUMENT
+  for (auto *table = detail::g_tables.load(std::memory_order_acquire);
+       table != nullptr; table = table->next) {
+    for (auto &slot : table->slots) {
+      slot.count.store(0, std::memory_order_relaxed);
+    }
+    table->dropped.store(0, std::memory_order_relaxed);
+  }
+  detail::g_unallocated.store(0, std::memory_order_relaxed);
+#endif
+}
+
+/// Installs a hook called on every event (nullptr removes it). Does
+/// nothing without PULGACPP_INSTRUMENT.
+inline void set_hook(Hook hook) noexcept {
+#if PULGACPP_INSTRUMENT
+  detail::g_hook.store(hook, std::memory_order_release);
+#else
+  (void)hook;
+#endif
+}
+
+} // namespace pulgacpp::instrument
+
+#endif // PULGACPP_CORE_INSTRUMENT_HPP
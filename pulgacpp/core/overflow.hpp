@@ -1,12 +1,14 @@
 // pulgacpp::detail::overflow - Cross-platform overflow detection for 64-bit
-// arithmetic SPDX-License-Identifier: MIT
+// and 128-bit arithmetic SPDX-License-Identifier: MIT
 //
 // This provides compiler-intrinsic-based overflow detection for cases where
-// no wider integer type is available (i.e., 64-bit types on MSVC).
+// no wider integer type is available (i.e., 64-bit types on MSVC, and the
+// 128-bit types everywhere).
 
 #ifndef PULGACPP_CORE_OVERFLOW_HPP
 #define PULGACPP_CORE_OVERFLOW_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
@@ -21,6 +23,42 @@
 #define PULGACPP_MSVC_INTRINSICS 0
 #endif
 
+// GCC/Clang checked-arithmetic builtins
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_add_overflow) &&                                   \
+    __has_builtin(__builtin_sub_overflow) &&                                   \
+    __has_builtin(__builtin_mul_overflow)
+#define PULGACPP_OVERFLOW_BUILTINS 1
+#endif
+#endif
+#ifndef PULGACPP_OVERFLOW_BUILTINS
+#define PULGACPP_OVERFLOW_BUILTINS 0
+#endif
+
+// Native 128-bit integers (GCC/Clang on 64-bit targets; not MSVC)
+#if defined(__SIZEOF_INT128__)
+#define PULGACPP_HAS_INT128 1
+#else
+#define PULGACPP_HAS_INT128 0
+#endif
+
+// Optimizer hint that `cond` always holds (used to publish invariants such as
+// NonZero's, so checks downstream of them fold away). Undefined behavior if
+// `cond` is false.
+#if defined(__clang__)
+#define PULGACPP_ASSUME(cond) __builtin_assume(cond)
+#elif defined(__GNUC__)
+#define PULGACPP_ASSUME(cond)                                                  \
+  do {                                                                         \
+    if (!(cond))                                                               \
+      __builtin_unreachable();                                                 \
+  } while (0)
+#elif defined(_MSC_VER)
+#define PULGACPP_ASSUME(cond) __assume(cond)
+#else
+#define PULGACPP_ASSUME(cond) ((void)0)
+#endif
+
 namespace pulgacpp {
 namespace detail {
 
@@ -31,6 +69,34 @@ namespace detail {
 template <typename Underlying, typename Wider>
 constexpr bool needs_intrinsic_overflow_v = std::is_same_v<Underlying, Wider>;
 
+// ============================================================
+// Integer traits that also cover __int128
+// In strict ISO mode (-std=c++XX) the standard traits do not recognise
+// __int128, so SafeInt uses these instead.
+// ============================================================
+template <typename T> struct int_traits {
+  static constexpr bool is_signed = std::is_signed_v<T>;
+  using unsigned_type = std::make_unsigned_t<T>;
+};
+
+#if PULGACPP_HAS_INT128
+template <> struct int_traits<__int128> {
+  static constexpr bool is_signed = true;
+  using unsigned_type = unsigned __int128;
+};
+
+template <> struct int_traits<unsigned __int128> {
+  static constexpr bool is_signed = false;
+  using unsigned_type = unsigned __int128;
+};
+#endif
+
+template <typename T>
+constexpr bool is_signed_int_v = int_traits<T>::is_signed;
+
+template <typename T>
+using make_unsigned_int_t = typename int_traits<T>::unsigned_type;
+
 // ============================================================
 // Signed 64-bit overflow detection
 // ============================================================
@@ -39,14 +105,11 @@ constexpr bool needs_intrinsic_overflow_v = std::is_same_v<Underlying, Wider>;
 /// Returns {result, overflowed}
 [[nodiscard]] inline std::pair<std::int64_t, bool>
 checked_add_i64(std::int64_t a, std::int64_t b) noexcept {
-#if defined(__has_builtin)
-#if __has_builtin(__builtin_add_overflow)
+#if PULGACPP_OVERFLOW_BUILTINS
   std::int64_t result = 0;
   bool overflow = __builtin_add_overflow(a, b, &result);
   return {result, overflow};
-#endif
-#endif
-#if PULGACPP_MSVC_INTRINSICS
+#elif PULGACPP_MSVC_INTRINSICS
   // MSVC: Manual overflow detection for signed addition
   // Overflow occurs if signs of operands are same but result sign differs
   std::int64_t result = static_cast<std::int64_t>(
@@ -71,14 +134,11 @@ checked_add_i64(std::int64_t a, std::int64_t b) noexcept {
 /// Returns {result, overflowed}
 [[nodiscard]] inline std::pair<std::int64_t, bool>
 checked_sub_i64(std::int64_t a, std::int64_t b) noexcept {
-#if defined(__has_builtin)
-#if __has_builtin(__builtin_sub_overflow)
+#if PULGACPP_OVERFLOW_BUILTINS
   std::int64_t result = 0;
   bool overflow = __builtin_sub_overflow(a, b, &result);
   return {result, overflow};
-#endif
-#endif
-#if PULGACPP_MSVC_INTRINSICS
+#elif PULGACPP_MSVC_INTRINSICS
   // Overflow occurs if operands have different signs and result sign differs
   // from a
   std::int64_t result = static_cast<std::int64_t>(
@@ -101,14 +161,11 @@ checked_sub_i64(std::int64_t a, std::int64_t b) noexcept {
 /// Returns {result, overflowed}
 [[nodiscard]] inline std::pair<std::int64_t, bool>
 checked_mul_i64(std::int64_t a, std::int64_t b) noexcept {
-#if defined(__has_builtin)
-#if __has_builtin(__builtin_mul_overflow)
+#if PULGACPP_OVERFLOW_BUILTINS
   std::int64_t result = 0;
   bool overflow = __builtin_mul_overflow(a, b, &result);
   return {result, overflow};
-#endif
-#endif
-#if PULGACPP_MSVC_INTRINSICS
+#elif PULGACPP_MSVC_INTRINSICS
   // Use __mulh to get high 64 bits of 128-bit signed product
   std::int64_t result = a * b;
   std::int64_t high = __mulh(a, b);
@@ -144,14 +201,11 @@ checked_mul_i64(std::int64_t a, std::int64_t b) noexcept {
 /// Returns {result, overflowed}
 [[nodiscard]] inline std::pair<std::uint64_t, bool>
 checked_add_u64(std::uint64_t a, std::uint64_t b) noexcept {
-#if defined(__has_builtin)
-#if __has_builtin(__builtin_add_overflow)
+#if PULGACPP_OVERFLOW_BUILTINS
   std::uint64_t result = 0;
   bool overflow = __builtin_add_overflow(a, b, &result);
   return {result, overflow};
-#endif
-#endif
-#if PULGACPP_MSVC_INTRINSICS
+#elif PULGACPP_MSVC_INTRINSICS
   // Use _addcarry_u64 intrinsic
   std::uint64_t result = 0;
   unsigned char carry = _addcarry_u64(0, a, b, &result);
@@ -173,14 +227,11 @@ checked_add_u64(std::uint64_t a, std::uint64_t b) noexcept {
 /// Returns {result, underflowed}
 [[nodiscard]] inline std::pair<std::uint64_t, bool>
 checked_sub_u64(std::uint64_t a, std::uint64_t b) noexcept {
-#if defined(__has_builtin)
-#if __has_builtin(__builtin_sub_overflow)
+#if PULGACPP_OVERFLOW_BUILTINS
   std::uint64_t result = 0;
   bool overflow = __builtin_sub_overflow(a, b, &result);
   return {result, overflow};
-#endif
-#endif
-#if PULGACPP_MSVC_INTRINSICS
+#elif PULGACPP_MSVC_INTRINSICS
   // Use _subborrow_u64 intrinsic
   std::uint64_t result = 0;
   unsigned char borrow = _subborrow_u64(0, a, b, &result);
@@ -199,14 +250,11 @@ checked_sub_u64(std::uint64_t a, std::uint64_t b) noexcept {
 /// Returns {result, overflowed}
 [[nodiscard]] inline std::pair<std::uint64_t, bool>
 checked_mul_u64(std::uint64_t a, std::uint64_t b) noexcept {
-#if defined(__has_builtin)
-#if __has_builtin(__builtin_mul_overflow)
+#if PULGACPP_OVERFLOW_BUILTINS
   std::uint64_t result = 0;
   bool overflow = __builtin_mul_overflow(a, b, &result);
   return {result, overflow};
-#endif
-#endif
-#if PULGACPP_MSVC_INTRINSICS
+#elif PULGACPP_MSVC_INTRINSICS
   // Use __umulh to get high 64 bits of 128-bit unsigned product
   std::uint64_t result = a * b;
   std::uint64_t high = __umulh(a, b);
@@ -226,6 +274,335 @@ checked_mul_u64(std::uint64_t a, std::uint64_t b) noexcept {
 #endif
 }
 
+#if PULGACPP_HAS_INT128
+// ============================================================
+// 128-bit overflow detection
+// ============================================================
+// The fallbacks work on two 64-bit limbs so that they only need a
+// 64x64->128 multiply, which every compiler with __int128 lowers to a
+// single instruction on 64-bit targets.
+
+/// Full 128-bit product of two 64-bit values.
+[[nodiscard]] constexpr unsigned __int128
+mul_wide_u64(std::uint64_t a, std::uint64_t b) noexcept {
+  return static_cast<unsigned __int128>(a) * static_cast<unsigned __int128>(b);
+}
+
+/// Checked addition for unsigned 128-bit integers.
+/// Returns {result, overflowed}
+[[nodiscard]] constexpr std::pair<unsigned __int128, bool>
+checked_add_u128(unsigned __int128 a, unsigned __int128 b) noexcept {
+#if PULGACPP_OVERFLOW_BUILTINS
+  unsigned __int128 result = 0;
+  bool overflow = __builtin_add_overflow(a, b, &result);
+  return {result, overflow};
+#else
+  unsigned __int128 result = a + b;
+  return {result, result < a};
+#endif
+}
+
+/// Checked subtraction for unsigned 128-bit integers.
+/// Returns {result, underflowed}
+[[nodiscard]] constexpr std::pair<unsigned __int128, bool>
+checked_sub_u128(unsigned __int128 a, unsigned __int128 b) noexcept {
+#if PULGACPP_OVERFLOW_BUILTINS
+  unsigned __int128 result = 0;
+  bool overflow = __builtin_sub_overflow(a, b, &result);
+  return {result, overflow};
+#else
+  return {a - b, b > a};
+#endif
+}
+
+/// Checked multiplication for unsigned 128-bit integers.
+/// Returns {result, overflowed}
+[[nodiscard]] constexpr std::pair<unsigned __int128, bool>
+checked_mul_u128(unsigned __int128 a, unsigned __int128 b) noexcept {
+#if PULGACPP_OVERFLOW_BUILTINS
+  unsigned __int128 result = 0;
+  bool overflow = __builtin_mul_overflow(a, b, &result);
+  return {result, overflow};
+#else
+  // a = a1:a0, b = b1:b0 (64-bit limbs). The product fits only if at most
+  // one high limb is non-zero and the cross term plus carry fits 64 bits.
+  auto a0 = static_cast<std::uint64_t>(a);
+  auto a1 = static_cast<std::uint64_t>(a >> 64);
+  auto b0 = static_cast<std::uint64_t>(b);
+  auto b1 = static_cast<std::uint64_t>(b >> 64);
+  unsigned __int128 low = mul_wide_u64(a0, b0);
+  unsigned __int128 cross = mul_wide_u64(a1, b0) + mul_wide_u64(a0, b1);
+  bool overflow = (a1 != 0 && b1 != 0) || (cross >> 64) != 0;
+  unsigned __int128 high = (cross << 64);
+  unsigned __int128 result = low + high;
+  overflow = overflow || result < low;
+  return {result, overflow};
+#endif
+}
+
+/// Checked addition for signed 128-bit integers.
+/// Returns {result, overflowed}
+[[nodiscard]] constexpr std::pair<__int128, bool>
+checked_add_i128(__int128 a, __int128 b) noexcept {
+#if PULGACPP_OVERFLOW_BUILTINS
+  __int128 result = 0;
+  bool overflow = __builtin_add_overflow(a, b, &result);
+  return {result, overflow};
+#else
+  auto result = static_cast<__int128>(static_cast<unsigned __int128>(a) +
+                                      static_cast<unsigned __int128>(b));
+  return {result, ((a ^ result) & (b ^ result)) < 0};
+#endif
+}
+
+/// Checked subtraction for signed 128-bit integers.
+/// Returns {result, overflowed}
+[[nodiscard]] constexpr std::pair<__int128, bool>
+checked_sub_i128(__int128 a, __int128 b) noexcept {
+#if PULGACPP_OVERFLOW_BUILTINS
+  __int128 result = 0;
+  bool overflow = __builtin_sub_overflow(a, b, &result);
+  return {result, overflow};
+#else
+  auto result = static_cast<__int128>(static_cast<unsigned __int128>(a) -
+                                      static_cast<unsigned __int128>(b));
+  return {result, ((a ^ b) & (a ^ result)) < 0};
+#endif
+}
+
+/// Checked multiplication for signed 128-bit integers.
+/// Returns {result, overflowed}
+[[nodiscard]] constexpr std::pair<__int128, bool>
+checked_mul_i128(__int128 a, __int128 b) noexcept {
+#if PULGACPP_OVERFLOW_BUILTINS
+  __int128 result = 0;
+  bool overflow = __builtin_mul_overflow(a, b, &result);
+  return {result, overflow};
+#else
+  // Multiply magnitudes, then check against the limit for the result sign
+  using u128 = unsigned __int128;
+  u128 ua = a < 0 ? u128(0) - static_cast<u128>(a) : static_cast<u128>(a);
+  u128 ub = b < 0 ? u128(0) - static_cast<u128>(b) : static_cast<u128>(b);
+  auto [magnitude, overflow] = checked_mul_u128(ua, ub);
+  bool negative = (a < 0) != (b < 0);
+  u128 limit = (u128(1) << 127) - (negative ? 0 : 1);
+  auto result =
+      static_cast<__int128>(static_cast<u128>(a) * static_cast<u128>(b));
+  return {result, overflow || magnitude > limit};
+#endif
+}
+
+/// Value of an integer literal given as its characters (for the raw literal
+/// operators of i128/u128, whose values can exceed unsigned long long).
+/// Accepts decimal, 0x hex, 0b binary and leading-0 octal, with ' separators.
+/// Returns {value, overflowed}.
+template <char... Chars>
+[[nodiscard]] constexpr std::pair<unsigned __int128, bool>
+parse_u128_literal() noexcept {
+  constexpr char text[] = {Chars..., '\0'};
+  std::size_t i = 0;
+  unsigned base = 10;
+  if (text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+    base = 16;
+    i = 2;
+  } else if (text[0] == '0' && (text[1] == 'b' || text[1] == 'B')) {
+    base = 2;
+    i = 2;
+  } else if (text[0] == '0') {
+    base = 8;
+  }
+
+  unsigned __int128 value = 0;
+  bool overflow = false;
+  for (; text[i] != '\0'; ++i) {
+    char c = text[i];
+    if (c == '\'') {
+      continue;
+    }
+    unsigned digit = (c >= '0' && c <= '9')   ? unsigned(c - '0')
+                     : (c >= 'a' && c <= 'f') ? unsigned(c - 'a' + 10)
+                                              : unsigned(c - 'A' + 10);
+    auto [scaled, mul_overflow] = checked_mul_u128(value, base);
+    auto [next, add_overflow] = checked_add_u128(scaled, digit);
+    overflow = overflow || mul_overflow || add_overflow;
+    value = next;
+  }
+  return {value, overflow};
+}
+#endif // PULGACPP_HAS_INT128
+
+// ============================================================
+// Width dispatch for SafeInt types without a wider type
+// ============================================================
+
+/// Checked add/sub/mul for a 64-bit or 128-bit primitive T, forwarding to
+/// the matching function above. Returns {result, overflowed}.
+template <typename T>
+[[nodiscard]] constexpr std::pair<T, bool> checked_add_native(T a,
+                                                              T b) noexcept {
+#if PULGACPP_HAS_INT128
+  if constexpr (sizeof(T) == 16) {
+    if constexpr (is_signed_int_v<T>) {
+      return checked_add_i128(a, b);
+    } else {
+      return checked_add_u128(a, b);
+    }
+  } else
+#endif
+  if constexpr (is_signed_int_v<T>) {
+    auto [result, overflow] = checked_add_i64(a, b);
+    return {static_cast<T>(result), overflow};
+  } else {
+    auto [result, overflow] = checked_add_u64(a, b);
+    return {static_cast<T>(result), overflow};
+  }
+}
+
+template <typename T>
+[[nodiscard]] constexpr std::pair<T, bool> checked_sub_native(T a,
+                                                              T b) noexcept {
+#if PULGACPP_HAS_INT128
+  if constexpr (sizeof(T) == 16) {
+    if constexpr (is_signed_int_v<T>) {
+      return checked_sub_i128(a, b);
+    } else {
+      return checked_sub_u128(a, b);
+    }
+  } else
+#endif
+  if constexpr (is_signed_int_v<T>) {
+    auto [result, overflow] = checked_sub_i64(a, b);
+    return {static_cast<T>(result), overflow};
+  } else {
+    auto [result, overflow] = checked_sub_u64(a, b);
+    return {static_cast<T>(result), overflow};
+  }
+}
+
+template <typename T>
+[[nodiscard]] constexpr std::pair<T, bool> checked_mul_native(T a,
+                                                              T b) noexcept {
+#if PULGACPP_HAS_INT128
+  if constexpr (sizeof(T) == 16) {
+    if constexpr (is_signed_int_v<T>) {
+      return checked_mul_i128(a, b);
+    } else {
+      return checked_mul_u128(a, b);
+    }
+  } else
+#endif
+  if constexpr (is_signed_int_v<T>) {
+    auto [result, overflow] = checked_mul_i64(a, b);
+    return {static_cast<T>(result), overflow};
+  } else {
+    auto [result, overflow] = checked_mul_u64(a, b);
+    return {static_cast<T>(result), overflow};
+  }
+}
+
+// ============================================================
+// Multiply-high
+// Upper half of the full product, used by precomputed division and
+// modular reduction. `Wide` is a SafeInt's wider_type and is used when it
+// is twice as wide as U.
+// ============================================================
+
+template <typename U, typename Wide>
+[[nodiscard]] constexpr U mul_high(U a, U b) noexcept {
+  constexpr unsigned bits = sizeof(U) * 8;
+  using W = make_unsigned_int_t<Wide>;
+  if constexpr (sizeof(W) >= 2 * sizeof(U)) {
+    return static_cast<U>((static_cast<W>(a) * static_cast<W>(b)) >> bits);
+  } else {
+    static_assert(bits == 64);
+#if PULGACPP_MSVC_INTRINSICS && defined(_M_X64)
+    if (!std::is_constant_evaluated()) {
+      return __umulh(a, b);
+    }
+#endif
+    // 32-bit partial products
+    std::uint64_t a0 = a & 0xFFFFFFFFu, a1 = a >> 32;
+    std::uint64_t b0 = b & 0xFFFFFFFFu, b1 = b >> 32;
+    std::uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0;
+    std::uint64_t middle =
+        (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+    return a1 * b1 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+  }
+}
+
+// ============================================================
+// Exact wide sums
+// A 192-bit two's complement accumulator built from 64-bit words, so it
+// needs no __int128. It holds any sum of fewer than 2^63 terms of up to
+// 128 bits (such as products of two 64-bit values) without overflowing,
+// which lets bulk sums check the range once, on the final value.
+// ============================================================
+
+class WideAccumulator {
+public:
+  /// Adds the 128-bit term `high:low`. `negative` says whether it is a
+  /// signed term below zero (two's complement) rather than an unsigned
+  /// one.
+  constexpr void add(std::uint64_t low, std::uint64_t high,
+                     bool negative) noexcept {
+    std::uint64_t w0 = m_w0 + low;
+    std::uint64_t carry = w0 < low ? 1 : 0;
+    std::uint64_t w1 = m_w1 + high;
+    std::uint64_t carry1 = w1 < high ? 1 : 0;
+    w1 += carry;
+    carry1 += (w1 < carry) ? 1 : 0;
+    m_w0 = w0;
+    m_w1 = w1;
+    m_w2 += static_cast<std::int64_t>(carry1) - (negative ? 1 : 0);
+  }
+
+  /// Adds an integer of up to 64 bits.
+  template <typename T> constexpr void add(T value) noexcept {
+    static_assert(sizeof(T) <= 8);
+    bool negative = false;
+    if constexpr (is_signed_int_v<T>) {
+      negative = value < 0;
+    }
+    add(static_cast<std::uint64_t>(value), negative ? ~std::uint64_t{0} : 0,
+        negative);
+  }
+
+  /// Adds another accumulator's total.
+  constexpr void merge(const WideAccumulator &other) noexcept {
+    add(other.m_w0, other.m_w1, false);
+    m_w2 += other.m_w2;
+  }
+
+  [[nodiscard]] constexpr bool is_negative() const noexcept {
+    return m_w2 < 0;
+  }
+
+  /// True if the total is representable as T (up to 64 bits).
+  template <typename T> [[nodiscard]] constexpr bool fits() const noexcept {
+    static_assert(sizeof(T) <= 8);
+    auto low = static_cast<T>(m_w0);
+    if (static_cast<std::uint64_t>(low) != m_w0) {
+      return false;
+    }
+    bool negative = false;
+    if constexpr (is_signed_int_v<T>) {
+      negative = low < 0;
+    }
+    return m_w1 == (negative ? ~std::uint64_t{0} : 0) &&
+           m_w2 == (negative ? -1 : 0);
+  }
+
+  /// The total truncated to T; exact when fits<T>().
+  template <typename T> [[nodiscard]] constexpr T low() const noexcept {
+    return static_cast<T>(m_w0);
+  }
+
+private:
+  std::uint64_t m_w0 = 0;
+  std::uint64_t m_w1 = 0;
+  std::int64_t m_w2 = 0;
+};
+
 } // namespace detail
 } // namespace pulgacpp
 
@@ -8,15 +8,22 @@
 #define PULGACPP_CORE_SAFE_INT_HPP
 
 #include "../optional/optional.hpp"
+#include "../result/result.hpp"
+#include "charconv.hpp"
+#include "instrument.hpp"
 #include "overflow.hpp"
 
 #include <bit>
+#include <charconv>
 #include <concepts>
 #include <cstdint>
 #include <limits>
 #include <ostream>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
 #include <utility>
+#include <version>
 
 
 namespace pulgacpp::detail {
@@ -32,7 +39,7 @@ class SafeInt {
 public:
   using underlying_type = Underlying;
   using wider_type = Wider;
-  using unsigned_type = std::make_unsigned_t<Underlying>;
+  using unsigned_type = make_unsigned_int_t<Underlying>;
 
   static constexpr underlying_type MIN =
       std::numeric_limits<underlying_type>::min();
@@ -53,6 +60,11 @@ public:
   /// Creates a SafeInt from a value, returning None if out of range.
   template <std::integral T>
   [[nodiscard]] static constexpr Optional<SafeInt> from(T value) noexcept {
+    if constexpr (std::is_signed_v<T> && !IsSigned) {
+      if (value < 0) {
+        return None;
+      }
+    }
     // Use the wider type for safe comparison
     auto wide_value = static_cast<wider_type>(value);
     if (wide_value < static_cast<wider_type>(MIN) ||
@@ -64,12 +76,20 @@ public:
 
   /// Creates a SafeInt from a value, saturating at MIN/MAX if out of range.
   template <std::integral T>
-  [[nodiscard]] static constexpr SafeInt saturating_from(T value) noexcept {
+  [[nodiscard]] static constexpr SafeInt saturating_from(T value PULGACPP_SITE_PARAM) noexcept {
+    if constexpr (std::is_signed_v<T> && !IsSigned) {
+      if (value < 0) {
+        PULGACPP_RECORD(Saturated);
+        return SafeInt(MIN);
+      }
+    }
     auto wide_value = static_cast<wider_type>(value);
     if (wide_value < static_cast<wider_type>(MIN)) {
+      PULGACPP_RECORD(Saturated);
       return SafeInt(MIN);
     }
     if (wide_value > static_cast<wider_type>(MAX)) {
+      PULGACPP_RECORD(Saturated);
       return SafeInt(MAX);
     }
     return SafeInt(static_cast<underlying_type>(value));
@@ -87,18 +107,25 @@ public:
   /// Converts to type T, returning None if the value doesn't fit.
   template <std::integral T>
   [[nodiscard]] constexpr Optional<T> to() const noexcept {
-    if constexpr (std::is_signed_v<T>) {
+    if constexpr (std::is_signed_v<T> && IsSigned) {
       if (m_value < std::numeric_limits<T>::min() ||
           m_value > std::numeric_limits<T>::max()) {
         return None;
       }
+    } else if constexpr (std::is_signed_v<T>) {
+      // Compare unsigned to unsigned: a signed bound would convert to a huge
+      // unsigned value and reject everything
+      if (m_value > static_cast<std::make_unsigned_t<T>>(
+                        std::numeric_limits<T>::max())) {
+        return None;
+      }
     } else {
       if constexpr (IsSigned) {
         if (m_value < 0) {
           return None;
         }
       }
-      if (static_cast<std::make_unsigned_t<underlying_type>>(m_value) >
+      if (static_cast<unsigned_type>(m_value) >
           std::numeric_limits<T>::max()) {
         return None;
       }
@@ -111,6 +138,48 @@ public:
     return static_cast<T>(m_value);
   }
 
+  // ==================== Text conversion ====================
+
+  /// Most characters to_chars() can write (all digits plus a sign).
+  static constexpr std::size_t MAX_CHARS =
+      max_decimal_chars_v<underlying_type>;
+
+  /// Parses a decimal integer: optional '+' (or '-' for signed types)
+  /// followed by digits, with nothing else around it. Values out of range
+  /// are an error, never wrapped or clamped.
+  [[nodiscard]] static constexpr Result<SafeInt, ParseError>
+  parse(std::string_view text) noexcept {
+    const char *first = text.data();
+    const char *last = first + text.size();
+    auto parsed = parse_integer<underlying_type>(first, last, first);
+    if (!parsed.ok) {
+      return Err(parsed.error);
+    }
+    if (parsed.ptr != last) {
+      return Err(ParseError{ParseError::Kind::InvalidDigit,
+                            static_cast<std::size_t>(parsed.ptr - first)});
+    }
+    return Ok(SafeInt(parsed.value));
+  }
+
+  /// Writes the value in decimal to [first, last), like std::to_chars.
+  /// On success `ptr` is one past the last character written; if the
+  /// buffer is too small, returns {last, std::errc::value_too_large}.
+  constexpr std::to_chars_result to_chars(char *first,
+                                          char *last) const noexcept {
+    char buffer[MAX_CHARS] = {};
+    char *end = buffer + MAX_CHARS;
+    char *start = format_integer_backward(end, m_value);
+    auto length = end - start;
+    if (last - first < length) {
+      return {last, std::errc::value_too_large};
+    }
+    for (char *p = start; p != end; ++p) {
+      *first++ = *p;
+    }
+    return {first, std::errc{}};
+  }
+
   // ==================== Inter-type conversions ====================
 
   /// Concept to detect a pulgacpp SafeInt type
@@ -141,36 +210,33 @@ public:
     using target_underlying = typename Target::underlying_type;
 
     // Handle signed -> unsigned conversion
-    if constexpr (!std::is_signed_v<target_underlying> && IsSigned) {
+    if constexpr (!is_signed_int_v<target_underlying> && IsSigned) {
       if (m_value < 0) {
         return None;
       }
     }
 
     // Check bounds
-    if constexpr (std::is_signed_v<target_underlying> &&
-                  std::is_signed_v<underlying_type>) {
+    if constexpr (is_signed_int_v<target_underlying> && IsSigned) {
       // Both signed
       if (m_value < static_cast<underlying_type>(Target::MIN) ||
           m_value > static_cast<underlying_type>(Target::MAX)) {
         return None;
       }
-    } else if constexpr (!std::is_signed_v<target_underlying> &&
-                         !std::is_signed_v<underlying_type>) {
+    } else if constexpr (!is_signed_int_v<target_underlying> && !IsSigned) {
       // Both unsigned
       if (m_value > static_cast<underlying_type>(Target::MAX)) {
         return None;
       }
-    } else if constexpr (std::is_signed_v<target_underlying> &&
-                         !std::is_signed_v<underlying_type>) {
+    } else if constexpr (is_signed_int_v<target_underlying> && !IsSigned) {
       // Unsigned -> signed
       if (m_value > static_cast<underlying_type>(Target::MAX)) {
         return None;
       }
     } else {
       // Signed -> unsigned (already checked for negative above)
-      if (static_cast<std::make_unsigned_t<underlying_type>>(m_value) >
-          static_cast<std::make_unsigned_t<underlying_type>>(Target::MAX)) {
+      if (static_cast<unsigned_type>(m_value) >
+          static_cast<unsigned_type>(Target::MAX)) {
         return None;
       }
     }
@@ -188,26 +254,21 @@ public:
 
   // Checked arithmetic - returns Optional<SafeInt>
   [[nodiscard]] constexpr Optional<SafeInt>
-  checked_add(SafeInt rhs) const noexcept {
-    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type> &&
-                  Bits == 64) {
-      // Use intrinsic-based overflow detection for 64-bit types
-      if constexpr (IsSigned) {
-        auto [result, overflow] = checked_add_i64(m_value, rhs.m_value);
-        if (overflow)
-          return None;
-        return Some(SafeInt(result));
-      } else {
-        auto [result, overflow] = checked_add_u64(m_value, rhs.m_value);
-        if (overflow)
-          return None;
-        return Some(SafeInt(result));
+  checked_add(SafeInt rhs PULGACPP_SITE_PARAM) const noexcept {
+    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type>) {
+      // No wider type (64-bit on MSVC, 128-bit): use the intrinsics
+      auto [result, overflow] = checked_add_native(m_value, rhs.m_value);
+      if (overflow) {
+        PULGACPP_RECORD(CheckedNone);
+        return None;
       }
+      return Some(SafeInt(result));
     } else {
       wider_type result = static_cast<wider_type>(m_value) +
                           static_cast<wider_type>(rhs.m_value);
       if (result < static_cast<wider_type>(MIN) ||
           result > static_cast<wider_type>(MAX)) {
+        PULGACPP_RECORD(CheckedNone);
         return None;
       }
       return Some(SafeInt(static_cast<underlying_type>(result)));
@@ -215,25 +276,20 @@ public:
   }
 
   [[nodiscard]] constexpr Optional<SafeInt>
-  checked_sub(SafeInt rhs) const noexcept {
-    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type> &&
-                  Bits == 64) {
-      if constexpr (IsSigned) {
-        auto [result, overflow] = checked_sub_i64(m_value, rhs.m_value);
-        if (overflow)
-          return None;
-        return Some(SafeInt(result));
-      } else {
-        auto [result, overflow] = checked_sub_u64(m_value, rhs.m_value);
-        if (overflow)
-          return None;
-        return Some(SafeInt(result));
+  checked_sub(SafeInt rhs PULGACPP_SITE_PARAM) const noexcept {
+    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type>) {
+      auto [result, overflow] = checked_sub_native(m_value, rhs.m_value);
+      if (overflow) {
+        PULGACPP_RECORD(CheckedNone);
+        return None;
       }
+      return Some(SafeInt(result));
     } else {
       wider_type result = static_cast<wider_type>(m_value) -
                           static_cast<wider_type>(rhs.m_value);
       if (result < static_cast<wider_type>(MIN) ||
           result > static_cast<wider_type>(MAX)) {
+        PULGACPP_RECORD(CheckedNone);
         return None;
       }
       return Some(SafeInt(static_cast<underlying_type>(result)));
@@ -241,25 +297,20 @@ public:
   }
 
   [[nodiscard]] constexpr Optional<SafeInt>
-  checked_mul(SafeInt rhs) const noexcept {
-    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type> &&
-                  Bits == 64) {
-      if constexpr (IsSigned) {
-        auto [result, overflow] = checked_mul_i64(m_value, rhs.m_value);
-        if (overflow)
-          return None;
-        return Some(SafeInt(result));
-      } else {
-        auto [result, overflow] = checked_mul_u64(m_value, rhs.m_value);
-        if (overflow)
-          return None;
-        return Some(SafeInt(result));
+  checked_mul(SafeInt rhs PULGACPP_SITE_PARAM) const noexcept {
+    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type>) {
+      auto [result, overflow] = checked_mul_native(m_value, rhs.m_value);
+      if (overflow) {
+        PULGACPP_RECORD(CheckedNone);
+        return None;
       }
+      return Some(SafeInt(result));
     } else {
       wider_type result = static_cast<wider_type>(m_value) *
                           static_cast<wider_type>(rhs.m_value);
       if (result < static_cast<wider_type>(MIN) ||
           result > static_cast<wider_type>(MAX)) {
+        PULGACPP_RECORD(CheckedNone);
         return None;
       }
       return Some(SafeInt(static_cast<underlying_type>(result)));
@@ -267,13 +318,15 @@ public:
   }
 
   [[nodiscard]] constexpr Optional<SafeInt>
-  checked_div(SafeInt rhs) const noexcept {
+  checked_div(SafeInt rhs PULGACPP_SITE_PARAM) const noexcept {
     if (rhs.m_value == 0) {
+      PULGACPP_RECORD(CheckedNone);
       return None;
     }
     // Handle overflow case for signed: MIN / -1 overflows
     if constexpr (IsSigned) {
       if (m_value == MIN && rhs.m_value == static_cast<underlying_type>(-1)) {
+        PULGACPP_RECORD(CheckedNone);
         return None;
       }
     }
@@ -281,26 +334,37 @@ public:
   }
 
   [[nodiscard]] constexpr Optional<SafeInt>
-  checked_rem(SafeInt rhs) const noexcept {
+  checked_rem(SafeInt rhs PULGACPP_SITE_PARAM) const noexcept {
     if (rhs.m_value == 0) {
+      PULGACPP_RECORD(CheckedNone);
       return None;
     }
+    // MIN % -1 is mathematically 0 but overflows (and traps) in the
+    // division instruction
+    if constexpr (IsSigned) {
+      if (m_value == MIN && rhs.m_value == static_cast<underlying_type>(-1)) {
+        PULGACPP_RECORD(CheckedNone);
+        return None;
+      }
+    }
     return Some(SafeInt(static_cast<underlying_type>(m_value % rhs.m_value)));
   }
 
-  [[nodiscard]] constexpr Optional<SafeInt> checked_neg() const noexcept
+  [[nodiscard]] constexpr Optional<SafeInt> checked_neg(PULGACPP_SITE_PARAM_ONLY) const noexcept
     requires IsSigned
   {
     if (m_value == MIN) {
+      PULGACPP_RECORD(CheckedNone);
       return None;
     }
     return Some(SafeInt(static_cast<underlying_type>(-m_value)));
   }
 
-  [[nodiscard]] constexpr Optional<SafeInt> checked_abs() const noexcept
+  [[nodiscard]] constexpr Optional<SafeInt> checked_abs(PULGACPP_SITE_PARAM_ONLY) const noexcept
     requires IsSigned
   {
     if (m_value == MIN) {
+      PULGACPP_RECORD(CheckedNone);
       return None;
     }
     return Some(SafeInt(
@@ -308,84 +372,109 @@ public:
   }
 
   // Saturating arithmetic - clamps to MIN/MAX
-  [[nodiscard]] constexpr SafeInt saturating_add(SafeInt rhs) const noexcept {
-    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type> &&
-                  Bits == 64) {
+  [[nodiscard]] constexpr SafeInt saturating_add(SafeInt rhs PULGACPP_SITE_PARAM) const noexcept {
+    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type>) {
       if constexpr (IsSigned) {
-        auto [result, overflow] = checked_add_i64(m_value, rhs.m_value);
+        auto [result, overflow] = checked_add_native(m_value, rhs.m_value);
         if (overflow) {
+          PULGACPP_RECORD(Saturated);
           // Determine direction: positive overflow -> MAX, negative -> MIN
           return SafeInt((m_value > 0 && rhs.m_value > 0) ? MAX : MIN);
         }
         return SafeInt(result);
       } else {
-        auto [result, overflow] = checked_add_u64(m_value, rhs.m_value);
-        if (overflow)
+        auto [result, overflow] = checked_add_native(m_value, rhs.m_value);
+        if (overflow) {
+          PULGACPP_RECORD(Saturated);
           return SafeInt(MAX);
+        }
         return SafeInt(result);
       }
     } else {
       wider_type result = static_cast<wider_type>(m_value) +
                           static_cast<wider_type>(rhs.m_value);
-      if (result < static_cast<wider_type>(MIN))
+      if (result < static_cast<wider_type>(MIN)) {
+        PULGACPP_RECORD(Saturated);
         return SafeInt(MIN);
-      if (result > static_cast<wider_type>(MAX))
+      }
+      if (result > static_cast<wider_type>(MAX)) {
+        PULGACPP_RECORD(Saturated);
         return SafeInt(MAX);
+      }
       return SafeInt(static_cast<underlying_type>(result));
     }
   }
 
-  [[nodiscard]] constexpr SafeInt saturating_sub(SafeInt rhs) const noexcept {
-    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type> &&
-                  Bits == 64) {
+  [[nodiscard]] constexpr SafeInt saturating_sub(SafeInt rhs PULGACPP_SITE_PARAM) const noexcept {
+    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type>) {
       if constexpr (IsSigned) {
-        auto [result, overflow] = checked_sub_i64(m_value, rhs.m_value);
+        auto [result, overflow] = checked_sub_native(m_value, rhs.m_value);
         if (overflow) {
+          PULGACPP_RECORD(Saturated);
           // Determine direction
           return SafeInt((m_value > 0 && rhs.m_value < 0) ? MAX : MIN);
         }
         return SafeInt(result);
       } else {
-        auto [result, overflow] = checked_sub_u64(m_value, rhs.m_value);
-        if (overflow)
+        auto [result, overflow] = checked_sub_native(m_value, rhs.m_value);
+        if (overflow) {
+          PULGACPP_RECORD(Saturated);
           return SafeInt(MIN); // Underflow for unsigned
+        }
         return SafeInt(result);
       }
     } else {
+      if constexpr (!IsSigned) {
+        // An unsigned wider type would wrap instead of going below MIN
+        if (m_value < rhs.m_value) {
+          PULGACPP_RECORD(Saturated);
+          return SafeInt(MIN);
+        }
+      }
       wider_type result = static_cast<wider_type>(m_value) -
                           static_cast<wider_type>(rhs.m_value);
-      if (result < static_cast<wider_type>(MIN))
+      if (result < static_cast<wider_type>(MIN)) {
+        PULGACPP_RECORD(Saturated);
         return SafeInt(MIN);
-      if (result > static_cast<wider_type>(MAX))
+      }
+      if (result > static_cast<wider_type>(MAX)) {
+        PULGACPP_RECORD(Saturated);
         return SafeInt(MAX);
+      }
       return SafeInt(static_cast<underlying_type>(result));
     }
   }
 
-  [[nodiscard]] constexpr SafeInt saturating_mul(SafeInt rhs) const noexcept {
-    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type> &&
-                  Bits == 64) {
+  [[nodiscard]] constexpr SafeInt saturating_mul(SafeInt rhs PULGACPP_SITE_PARAM) const noexcept {
+    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type>) {
       if constexpr (IsSigned) {
-        auto [result, overflow] = checked_mul_i64(m_value, rhs.m_value);
+        auto [result, overflow] = checked_mul_native(m_value, rhs.m_value);
         if (overflow) {
+          PULGACPP_RECORD(Saturated);
           // Same sign -> positive overflow, different sign -> negative overflow
           bool same_sign = (m_value >= 0) == (rhs.m_value >= 0);
           return SafeInt(same_sign ? MAX : MIN);
         }
         return SafeInt(result);
       } else {
-        auto [result, overflow] = checked_mul_u64(m_value, rhs.m_value);
-        if (overflow)
+        auto [result, overflow] = checked_mul_native(m_value, rhs.m_value);
+        if (overflow) {
+          PULGACPP_RECORD(Saturated);
           return SafeInt(MAX);
+        }
         return SafeInt(result);
       }
     } else {
       wider_type result = static_cast<wider_type>(m_value) *
                           static_cast<wider_type>(rhs.m_value);
-      if (result < static_cast<wider_type>(MIN))
+      if (result < static_cast<wider_type>(MIN)) {
+        PULGACPP_RECORD(Saturated);
         return SafeInt(MIN);
-      if (result > static_cast<wider_type>(MAX))
+      }
+      if (result > static_cast<wider_type>(MAX)) {
+        PULGACPP_RECORD(Saturated);
         return SafeInt(MAX);
+      }
       return SafeInt(static_cast<underlying_type>(result));
     }
   }
@@ -417,15 +506,9 @@ public:
   // Overflowing arithmetic - returns (result, did_overflow)
   [[nodiscard]] constexpr std::pair<SafeInt, bool>
   overflowing_add(SafeInt rhs) const noexcept {
-    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type> &&
-                  Bits == 64) {
-      if constexpr (IsSigned) {
-        auto [result, overflow] = checked_add_i64(m_value, rhs.m_value);
-        return {SafeInt(result), overflow};
-      } else {
-        auto [result, overflow] = checked_add_u64(m_value, rhs.m_value);
-        return {SafeInt(result), overflow};
-      }
+    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type>) {
+      auto [result, overflow] = checked_add_native(m_value, rhs.m_value);
+      return {SafeInt(result), overflow};
     } else {
       wider_type result = static_cast<wider_type>(m_value) +
                           static_cast<wider_type>(rhs.m_value);
@@ -437,15 +520,9 @@ public:
 
   [[nodiscard]] constexpr std::pair<SafeInt, bool>
   overflowing_sub(SafeInt rhs) const noexcept {
-    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type> &&
-                  Bits == 64) {
-      if constexpr (IsSigned) {
-        auto [result, overflow] = checked_sub_i64(m_value, rhs.m_value);
-        return {SafeInt(result), overflow};
-      } else {
-        auto [result, overflow] = checked_sub_u64(m_value, rhs.m_value);
-        return {SafeInt(result), overflow};
-      }
+    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type>) {
+      auto [result, overflow] = checked_sub_native(m_value, rhs.m_value);
+      return {SafeInt(result), overflow};
     } else {
       wider_type result = static_cast<wider_type>(m_value) -
                           static_cast<wider_type>(rhs.m_value);
@@ -457,15 +534,9 @@ public:
 
   [[nodiscard]] constexpr std::pair<SafeInt, bool>
   overflowing_mul(SafeInt rhs) const noexcept {
-    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type> &&
-                  Bits == 64) {
-      if constexpr (IsSigned) {
-        auto [result, overflow] = checked_mul_i64(m_value, rhs.m_value);
-        return {SafeInt(result), overflow};
-      } else {
-        auto [result, overflow] = checked_mul_u64(m_value, rhs.m_value);
-        return {SafeInt(result), overflow};
-      }
+    if constexpr (needs_intrinsic_overflow_v<underlying_type, wider_type>) {
+      auto [result, overflow] = checked_mul_native(m_value, rhs.m_value);
+      return {SafeInt(result), overflow};
     } else {
       wider_type result = static_cast<wider_type>(m_value) *
                           static_cast<wider_type>(rhs.m_value);
@@ -550,8 +621,14 @@ public:
   }
 
   [[nodiscard]] constexpr unsigned int count_ones() const noexcept {
-    return static_cast<unsigned int>(
-        std::popcount(static_cast<unsigned_type>(m_value)));
+    if constexpr (Bits == 128) {
+      // std::popcount and friends do not accept __int128 in strict mode
+      return static_cast<unsigned int>(std::popcount(low_half()) +
+                                       std::popcount(high_half()));
+    } else {
+      return static_cast<unsigned int>(
+          std::popcount(static_cast<unsigned_type>(m_value)));
+    }
   }
 
   [[nodiscard]] constexpr unsigned int count_zeros() const noexcept {
@@ -559,13 +636,25 @@ public:
   }
 
   [[nodiscard]] constexpr unsigned int leading_zeros() const noexcept {
-    return static_cast<unsigned int>(
-        std::countl_zero(static_cast<unsigned_type>(m_value)));
+    if constexpr (Bits == 128) {
+      return high_half() != 0
+                 ? static_cast<unsigned int>(std::countl_zero(high_half()))
+                 : 64 + static_cast<unsigned int>(std::countl_zero(low_half()));
+    } else {
+      return static_cast<unsigned int>(
+          std::countl_zero(static_cast<unsigned_type>(m_value)));
+    }
   }
 
   [[nodiscard]] constexpr unsigned int trailing_zeros() const noexcept {
-    return static_cast<unsigned int>(
-        std::countr_zero(static_cast<unsigned_type>(m_value)));
+    if constexpr (Bits == 128) {
+      return low_half() != 0
+                 ? static_cast<unsigned int>(std::countr_zero(low_half()))
+                 : 64 + static_cast<unsigned int>(std::countr_zero(high_half()));
+    } else {
+      return static_cast<unsigned int>(
+          std::countr_zero(static_cast<unsigned_type>(m_value)));
+    }
   }
 
   // Stream output
@@ -573,15 +662,74 @@ public:
     if constexpr (Bits <= 8) {
       // Print as int to avoid char interpretation
       return os << static_cast<int>(value.m_value);
+    } else if constexpr (Bits == 128) {
+      // iostreams have no __int128 overload: format the digits by hand
+      char buffer[MAX_CHARS];
+      char *end = buffer + MAX_CHARS;
+      char *first = format_integer_backward(end, value.m_value);
+      return os.write(first, end - first);
     } else {
       return os << value.m_value;
     }
   }
 
 private:
+  // 64-bit halves of a 128-bit value (only instantiated when Bits == 128)
+  [[nodiscard]] constexpr std::uint64_t low_half() const noexcept {
+    return static_cast<std::uint64_t>(static_cast<unsigned_type>(m_value));
+  }
+  [[nodiscard]] constexpr std::uint64_t high_half() const noexcept {
+    return static_cast<std::uint64_t>(static_cast<unsigned_type>(m_value) >>
+                                      64);
+  }
+
   underlying_type m_value;
 };
 
+// ==================== Type Traits ====================
+
+/// Detects instantiations of SafeInt (i8, u32, isize, ...)
+template <typename T> struct is_safe_int : std::false_type {};
+
+template <typename Underlying, typename Wider, unsigned Bits, bool IsSigned>
+struct is_safe_int<SafeInt<Underlying, Wider, Bits, IsSigned>>
+    : std::true_type {};
+
+/// Concept satisfied by every SafeInt instantiation
+template <typename T>
+concept SafeInteger = is_safe_int<T>::value;
+
 } // namespace pulgacpp::detail
 
+#if defined(__cpp_lib_format)
+#include <format>
+
+/// std::format support. For up to 64 bits the standard integer format specs
+/// ({:x}, {:+}, {:>8}, ...) apply to the underlying value. The standard
+/// library has no formatter for __int128, so 128-bit values are formatted as
+/// decimal text and accept string specs (width, fill, alignment).
+template <typename Underlying, typename Wider, unsigned Bits, bool IsSigned>
+struct std::formatter<
+    pulgacpp::detail::SafeInt<Underlying, Wider, Bits, IsSigned>, char>
+    : std::formatter<
+          std::conditional_t<Bits == 128, std::string_view, Underlying>, char> {
+  template <typename FormatContext>
+  auto format(pulgacpp::detail::SafeInt<Underlying, Wider, Bits, IsSigned> value,
+              FormatContext &ctx) const {
+    if constexpr (Bits == 128) {
+      char buffer[pulgacpp::detail::max_decimal_chars_v<Underlying>];
+      char *end = value.to_chars(buffer, buffer + sizeof(buffer)).ptr;
+      return std::formatter<std::string_view, char>::format(
+          std::string_view(buffer, static_cast<std::size_t>(end - buffer)),
+          ctx);
+    } else {
+      return std::formatter<Underlying, char>::format(value.get(), ctx);
+    }
+  }
+};
+#endif // __cpp_lib_format
+
+// Overflow-tracking chains over any SafeInt (checked_expr)
+#include "checked_expr.hpp"
+
 #endif // PULGACPP_CORE_SAFE_INT_HPP
@@ -0,0 +1,598 @@
+// pulgacpp::detail::simd - Portable vector kernels with runtime CPU dispatch
+// SPDX-License-Identifier: MIT
+//
+// This is an internal implementation detail used by the bulk (span) APIs.
+// Kernels are written once against GCC/Clang vector extensions and compiled
+// for several instruction sets; the widest one supported by the running CPU
+// is picked at runtime. Compilers without vector extensions (MSVC) use the
+// scalar path, which every kernel must provide.
+
+#ifndef PULGACPP_CORE_SIMD_HPP
+#define PULGACPP_CORE_SIMD_HPP
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// Vector extensions (__attribute__((vector_size)))
+#if defined(__GNUC__) || defined(__clang__)
+#define PULGACPP_VECTOR_EXT 1
+#else
+#define PULGACPP_VECTOR_EXT 0
+#endif
+
+// x86: per-function target attributes, selected with __builtin_cpu_supports
+#if PULGACPP_VECTOR_EXT && (defined(__x86_64__) || defined(__i386__))
+#define PULGACPP_SIMD_X86 1
+#define PULGACPP_TARGET_AVX2 __attribute__((target("avx2")))
+#define PULGACPP_TARGET_SSE42 __attribute__((target("sse4.2")))
+#else
+#define PULGACPP_SIMD_X86 0
+#define PULGACPP_TARGET_AVX2
+#define PULGACPP_TARGET_SSE42
+#endif
+
+// ARM: NEON is part of the AArch64 baseline, so no dispatch is needed
+#if PULGACPP_VECTOR_EXT && (defined(__ARM_NEON) || defined(__aarch64__))
+#define PULGACPP_SIMD_NEON 1
+#else
+#define PULGACPP_SIMD_NEON 0
+#endif
+
+#if PULGACPP_VECTOR_EXT
+#define PULGACPP_ALWAYS_INLINE inline __attribute__((always_inline))
+// Written after a lambda's parameter list
+#define PULGACPP_INLINE_LAMBDA __attribute__((always_inline))
+#else
+#define PULGACPP_ALWAYS_INLINE inline
+#define PULGACPP_INLINE_LAMBDA
+#endif
+
+namespace pulgacpp::detail::simd {
+
+// ============================================================
+// Instruction set selection
+// ============================================================
+
+/// Instruction sets a kernel can be dispatched to, narrowest first.
+enum class Isa : std::uint8_t {
+  Scalar, // Plain loops, no vector types
+  Native, // 16-byte vectors with the compiler's baseline flags (SSE2/NEON)
+  Sse42,  // 16-byte vectors compiled for SSE4.2
+  Avx2,   // 32-byte vectors compiled for AVX2
+};
+
+/// Widest instruction set supported by the running CPU.
+[[nodiscard]] inline Isa detect_isa() noexcept {
+#if PULGACPP_SIMD_X86
+  if (__builtin_cpu_supports("avx2")) {
+    return Isa::Avx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return Isa::Sse42;
+  }
+  return Isa::Native;
+#elif PULGACPP_VECTOR_EXT
+  return Isa::Native;
+#else
+  return Isa::Scalar;
+#endif
+}
+
+namespace isa_state {
+inline std::atomic<Isa> &active() noexcept {
+  static std::atomic<Isa> isa{detect_isa()};
+  return isa;
+}
+} // namespace isa_state
+
+/// Instruction set currently used by the bulk APIs.
+[[nodiscard]] inline Isa active_isa() noexcept {
+  return isa_state::active().load(std::memory_order_relaxed);
+}
+
+/// Restricts dispatch to at most `isa` (clamped to what the CPU supports).
+/// Intended for tests and benchmarks that compare kernels against each other.
+/// Returns the instruction set actually selected.
+inline Isa set_active_isa(Isa isa) noexcept {
+  Isa best = detect_isa();
+  Isa chosen = static_cast<std::uint8_t>(isa) < static_cast<std::uint8_t>(best)
+                   ? isa
+                   : best;
+  isa_state::active().store(chosen, std::memory_order_relaxed);
+  return chosen;
+}
+
+// ============================================================
+// Raw storage access
+// ============================================================
+
+/// Views a contiguous range of single-member wrappers (SafeInt and friends)
+/// as their underlying primitive. The wrappers are standard-layout with the
+/// primitive as their only member, so the first element is
+/// pointer-interconvertible with its value.
+template <typename Raw, typename Wrapper>
+[[nodiscard]] inline const Raw *raw_ptr(const Wrapper *p) noexcept {
+  static_assert(sizeof(Wrapper) == sizeof(Raw) &&
+                    std::is_standard_layout_v<Wrapper> &&
+                    std::is_trivially_copyable_v<Wrapper>,
+                "wrapper must be layout-compatible with its raw value");
+  return reinterpret_cast<const Raw *>(p);
+}
+
+template <typename Raw, typename Wrapper>
+[[nodiscard]] inline Raw *raw_ptr(Wrapper *p) noexcept {
+  static_assert(sizeof(Wrapper) == sizeof(Raw) &&
+                    std::is_standard_layout_v<Wrapper> &&
+                    std::is_trivially_copyable_v<Wrapper>,
+                "wrapper must be layout-compatible with its raw value");
+  return reinterpret_cast<Raw *>(p);
+}
+
+#if PULGACPP_VECTOR_EXT
+
+// ============================================================
+// Vector types
+// ============================================================
+
+template <typename T, std::size_t Bytes> struct vector_of {
+  typedef T type __attribute__((vector_size(Bytes)));
+};
+
+/// A GCC/Clang vector of `Bytes / sizeof(T)` lanes of T.
+template <typename T, std::size_t Bytes>
+using vec = typename vector_of<T, Bytes>::type;
+
+/// Number of lanes of T in a `Bytes`-wide vector.
+template <typename T, std::size_t Bytes>
+inline constexpr std::size_t lanes = Bytes / sizeof(T);
+
+/// Lane type of the same width as T, used for comparison masks.
+template <typename T>
+using mask_lane = std::make_signed_t<T>;
+
+// Vectors are passed by reference so that 32-byte types never cross a
+// function boundary compiled without AVX (which would change the ABI).
+
+template <typename V, typename T>
+PULGACPP_ALWAYS_INLINE void load(V &out, const T *p) noexcept {
+  std::memcpy(&out, p, sizeof(V));
+}
+
+template <typename V, typename T>
+PULGACPP_ALWAYS_INLINE void store(T *p, const V &v) noexcept {
+  std::memcpy(p, &v, sizeof(V));
+}
+
+/// True if any lane of the mask is non-zero.
+template <typename V> PULGACPP_ALWAYS_INLINE bool any(const V &mask) noexcept {
+  using W = vec<std::uint64_t, sizeof(V)>;
+  W words;
+  std::memcpy(&words, &mask, sizeof(V));
+  std::uint64_t acc = 0;
+  for (std::size_t i = 0; i < sizeof(V) / 8; ++i) {
+    acc |= words[i];
+  }
+  return acc != 0;
+}
+
+/// Lane-wise `mask ? if_true : if_false` for an all-ones / all-zeros mask.
+template <typename V, typename M>
+PULGACPP_ALWAYS_INLINE void select(V &out, const M &mask, const V &if_true,
+                                   const V &if_false) noexcept {
+  out = (V)(((M)if_true & mask) | ((M)if_false & ~mask));
+}
+
+/// Full 64-bit product of the low 32 bits of each 64-bit lane. GCC does not
+/// turn a masked 64-bit multiply into pmuludq and emulates all 64x64 bits
+/// instead, so x86 emits the instruction itself. This is inline asm rather
+/// than an intrinsic because the intrinsics refuse to inline into kernels
+/// that are not themselves marked for AVX2; only the AVX2 dispatch path
+/// ever sees a 32-byte vector.
+template <typename V64>
+PULGACPP_ALWAYS_INLINE void mul_lo32(V64 &out, const V64 &a,
+                                     const V64 &b) noexcept {
+#if PULGACPP_SIMD_X86
+  if constexpr (sizeof(V64) == 32) {
+    asm("vpmuludq %2, %1, %0" : "=x"(out) : "x"(a), "xm"(b));
+  } else {
+#ifdef __AVX__
+    asm("vpmuludq %2, %1, %0" : "=x"(out) : "x"(a), "xm"(b));
+#else
+    out = a;
+    asm("pmuludq %1, %0" : "+x"(out) : "xm"(b));
+#endif
+  }
+#else
+  constexpr std::uint64_t LOW = 0xFFFFFFFFu;
+  out = (a & LOW) * (b & LOW);
+#endif
+}
+
+// ============================================================
+// Element-wise binary map with overflow tracking
+// ============================================================
+
+/// Applies `op` to `a[i], b[i]` for every i, writing `out[i]`.
+///
+/// `Op` provides (static or const member functions):
+///   void vector(const V& a, const V& b, V& out, M& mask);
+///   T    scalar(T a, T b, bool& flag);
+/// where V = vec<T, Bytes>, M = vec<mask_lane<T>, Bytes>, and a non-zero mask
+/// lane / a set flag marks an element the operation flagged (e.g. overflow).
+///
+/// Returns the index of the first flagged element, or `n` if none was.
+/// `out` may alias `a` or `b`.
+template <typename Op, typename T, std::size_t Bytes>
+PULGACPP_ALWAYS_INLINE std::size_t map2(const Op &op, const T *a, const T *b,
+                                        T *out, std::size_t n) noexcept {
+  using V = vec<T, Bytes>;
+  using M = vec<mask_lane<T>, Bytes>;
+  constexpr std::size_t L = lanes<T, Bytes>;
+
+  std::size_t first = n;
+  std::size_t i = 0;
+  for (; i + L <= n; i += L) {
+    V va, vb, vr;
+    M mask;
+    load(va, a + i);
+    load(vb, b + i);
+    op.vector(va, vb, vr, mask);
+    store(out + i, vr);
+    if (first == n && any(mask)) {
+      for (std::size_t k = 0; k < L; ++k) {
+        if (mask[k] != 0) {
+          first = i + k;
+          break;
+        }
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    bool flag = false;
+    out[i] = op.scalar(a[i], b[i], flag);
+    if (flag && first == n) {
+      first = i;
+    }
+  }
+  return first;
+}
+
+#if PULGACPP_SIMD_X86
+template <typename Op, typename T>
+PULGACPP_TARGET_AVX2 std::size_t map2_avx2(const Op &op, const T *a,
+                                           const T *b, T *out,
+                                           std::size_t n) noexcept {
+  return map2<Op, T, 32>(op, a, b, out, n);
+}
+
+template <typename Op, typename T>
+PULGACPP_TARGET_SSE42 std::size_t map2_sse42(const Op &op, const T *a,
+                                             const T *b, T *out,
+                                             std::size_t n) noexcept {
+  return map2<Op, T, 16>(op, a, b, out, n);
+}
+#endif
+
+template <typename Op, typename T>
+std::size_t map2_native(const Op &op, const T *a, const T *b, T *out,
+                        std::size_t n) noexcept {
+  return map2<Op, T, 16>(op, a, b, out, n);
+}
+
+/// Lane-wise square root of a float or double vector. Inline asm for the
+/// same reason as mul_lo32; other targets take the root of each lane.
+template <typename V>
+PULGACPP_ALWAYS_INLINE void sqrt(V &out, const V &v) noexcept {
+  using T = std::remove_cvref_t<decltype(v[0])>;
+  static_assert(std::is_floating_point_v<T>, "sqrt needs float lanes");
+#if PULGACPP_SIMD_X86
+  if constexpr (sizeof(V) == 32) {
+    if constexpr (sizeof(T) == 4) {
+      asm("vsqrtps %1, %0" : "=x"(out) : "xm"(v));
+    } else {
+      asm("vsqrtpd %1, %0" : "=x"(out) : "xm"(v));
+    }
+  } else {
+#ifdef __AVX__
+    if constexpr (sizeof(T) == 4) {
+      asm("vsqrtps %1, %0" : "=x"(out) : "xm"(v));
+    } else {
+      asm("vsqrtpd %1, %0" : "=x"(out) : "xm"(v));
+    }
+#else
+    if constexpr (sizeof(T) == 4) {
+      asm("sqrtps %1, %0" : "=x"(out) : "xm"(v));
+    } else {
+      asm("sqrtpd %1, %0" : "=x"(out) : "xm"(v));
+    }
+#endif
+  }
+#else
+  for (std::size_t k = 0; k < sizeof(V) / sizeof(T); ++k) {
+    out[k] = std::sqrt(v[k]);
+  }
+#endif
+}
+
+#endif // PULGACPP_VECTOR_EXT
+
+/// Scalar overloads, so one kernel body serves vectors and the scalar tail.
+PULGACPP_ALWAYS_INLINE void sqrt(float &out, float v) noexcept {
+  out = std::sqrt(v);
+}
+PULGACPP_ALWAYS_INLINE void sqrt(double &out, double v) noexcept {
+  out = std::sqrt(v);
+}
+
+/// Scalar reference loop for `map2` (same contract, no vector types).
+template <typename Op, typename T>
+std::size_t map2_scalar(const Op &op, const T *a, const T *b, T *out,
+                        std::size_t n) noexcept {
+  std::size_t first = n;
+  for (std::size_t i = 0; i < n; ++i) {
+    bool flag = false;
+    out[i] = op.scalar(a[i], b[i], flag);
+    if (flag && first == n) {
+      first = i;
+    }
+  }
+  return first;
+}
+
+/// Runs `map2` for `op` on the active instruction set.
+template <typename Op, typename T>
+std::size_t dispatch_map2(const Op &op, const T *a, const T *b, T *out,
+                          std::size_t n) noexcept {
+#if PULGACPP_VECTOR_EXT
+  switch (active_isa()) {
+#if PULGACPP_SIMD_X86
+  case Isa::Avx2:
+    return map2_avx2<Op, T>(op, a, b, out, n);
+  case Isa::Sse42:
+    return map2_sse42<Op, T>(op, a, b, out, n);
+#endif
+  case Isa::Scalar:
+    return map2_scalar<Op, T>(op, a, b, out, n);
+  default:
+    return map2_native<Op, T>(op, a, b, out, n);
+  }
+#else
+  return map2_scalar<Op, T>(op, a, b, out, n);
+#endif
+}
+
+/// Same, for an operation without state.
+template <typename Op, typename T>
+std::size_t dispatch_map2(const T *a, const T *b, T *out,
+                          std::size_t n) noexcept {
+  return dispatch_map2<Op, T>(Op{}, a, b, out, n);
+}
+
+// ============================================================
+// Element-wise unary map
+// ============================================================
+// Same contract as map2 with a single input. Operations usually carry
+// precomputed state (such as a Divider's magic numbers). `op` provides:
+//   void vector(const V& a, V& out, M& mask) const;
+//   T    scalar(T a, bool& flag) const;
+
+#if PULGACPP_VECTOR_EXT
+
+template <typename Op, typename T, std::size_t Bytes>
+PULGACPP_ALWAYS_INLINE std::size_t map1(const Op &op, const T *a, T *out,
+                                        std::size_t n) noexcept {
+  using V = vec<T, Bytes>;
+  using M = vec<mask_lane<T>, Bytes>;
+  constexpr std::size_t L = lanes<T, Bytes>;
+
+  std::size_t first = n;
+  std::size_t i = 0;
+  for (; i + L <= n; i += L) {
+    V va, vr;
+    M mask;
+    load(va, a + i);
+    op.vector(va, vr, mask);
+    store(out + i, vr);
+    if (first == n && any(mask)) {
+      for (std::size_t k = 0; k < L; ++k) {
+        if (mask[k] != 0) {
+          first = i + k;
+          break;
+        }
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    bool flag = false;
+    out[i] = op.scalar(a[i], flag);
+    if (flag && first == n) {
+      first = i;
+    }
+  }
+  return first;
+}
+
+#if PULGACPP_SIMD_X86
+template <typename Op, typename T>
+PULGACPP_TARGET_AVX2 std::size_t map1_avx2(const Op &op, const T *a, T *out,
+                                           std::size_t n) noexcept {
+  return map1<Op, T, 32>(op, a, out, n);
+}
+
+template <typename Op, typename T>
+PULGACPP_TARGET_SSE42 std::size_t map1_sse42(const Op &op, const T *a, T *out,
+                                             std::size_t n) noexcept {
+  return map1<Op, T, 16>(op, a, out, n);
+}
+#endif
+
+template <typename Op, typename T>
+std::size_t map1_native(const Op &op, const T *a, T *out,
+                        std::size_t n) noexcept {
+  return map1<Op, T, 16>(op, a, out, n);
+}
+
+#endif // PULGACPP_VECTOR_EXT
+
+/// Scalar reference loop for `map1` (same contract, no vector types).
+template <typename Op, typename T>
+std::size_t map1_scalar(const Op &op, const T *a, T *out,
+                        std::size_t n) noexcept {
+  std::size_t first = n;
+  for (std::size_t i = 0; i < n; ++i) {
+    bool flag = false;
+    out[i] = op.scalar(a[i], flag);
+    if (flag && first == n) {
+      first = i;
+    }
+  }
+  return first;
+}
+
+/// Runs `map1` for `op` on the active instruction set.
+template <typename Op, typename T>
+std::size_t dispatch_map1(const Op &op, const T *a, T *out,
+                          std::size_t n) noexcept {
+#if PULGACPP_VECTOR_EXT
+  switch (active_isa()) {
+#if PULGACPP_SIMD_X86
+  case Isa::Avx2:
+    return map1_avx2<Op, T>(op, a, out, n);
+  case Isa::Sse42:
+    return map1_sse42<Op, T>(op, a, out, n);
+#endif
+  case Isa::Scalar:
+    return map1_scalar<Op, T>(op, a, out, n);
+  default:
+    return map1_native<Op, T>(op, a, out, n);
+  }
+#else
+  return map1_scalar<Op, T>(op, a, out, n);
+#endif
+}
+
+// ============================================================
+// Floating-point map over parallel arrays
+// ============================================================
+// For structure-of-arrays data: `In` input streams and `Out` output streams
+// of n floats or doubles each. `op` provides
+//   template <typename V> void operator()(const V (&in)[In], V (&out)[Out]) const;
+// and is called with V = vec<T, Bytes> for whole vectors and with V = T for
+// the tail, so one body written with +, -, *, / and simd::sqrt serves both.
+// Scalar operands broadcast. An output may alias the input at the same
+// index. Nothing is flagged; the operation decides what NaN and zero mean.
+//
+// The operation and the stream pointers are copied to locals first: stores
+// go through memcpy, which may alias anything, and would otherwise force
+// them to be reloaded on every iteration.
+
+template <std::size_t Bytes, typename Op, typename T, std::size_t In,
+          std::size_t Out, std::size_t... I, std::size_t... O>
+PULGACPP_ALWAYS_INLINE void
+map_streams_impl(const Op &op, const std::array<const T *, In> &in,
+                 const std::array<T *, Out> &out, std::size_t n,
+                 std::index_sequence<I...>, std::index_sequence<O...>) noexcept {
+  const Op k = op;
+  const T *const src[In] = {in[I]...};
+  T *const dst[Out] = {out[O]...};
+
+  std::size_t i = 0;
+#if PULGACPP_VECTOR_EXT
+  if constexpr (Bytes > 0) {
+    using V = vec<T, Bytes>;
+    constexpr std::size_t L = lanes<T, Bytes>;
+    for (; i + L <= n; i += L) {
+      V a[In];
+      V r[Out];
+      (load(a[I], src[I] + i), ...);
+      k(a, r);
+      (store(dst[O] + i, r[O]), ...);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    const T a[In] = {src[I][i]...};
+    T r[Out];
+    k(a, r);
+    ((dst[O][i] = r[O]), ...);
+  }
+}
+
+/// Runs `op` over the streams with `Bytes`-wide vectors (0: scalar only).
+template <std::size_t Bytes, typename Op, typename T, std::size_t In,
+          std::size_t Out>
+PULGACPP_ALWAYS_INLINE void map_streams(const Op &op,
+                                        const std::array<const T *, In> &in,
+                                        const std::array<T *, Out> &out,
+                                        std::size_t n) noexcept {
+  map_streams_impl<Bytes>(op, in, out, n, std::make_index_sequence<In>{},
+                          std::make_index_sequence<Out>{});
+}
+
+/// Scalar reference loop for `map_streams` (same contract, no vector types).
+template <typename Op, typename T, std::size_t In, std::size_t Out>
+void map_streams_scalar(const Op &op, const std::array<const T *, In> &in,
+                        const std::array<T *, Out> &out,
+                        std::size_t n) noexcept {
+  map_streams<0>(op, in, out, n);
+}
+
+#if PULGACPP_VECTOR_EXT
+
+#if PULGACPP_SIMD_X86
+template <typename Op, typename T, std::size_t In, std::size_t Out>
+PULGACPP_TARGET_AVX2 void
+map_streams_avx2(const Op &op, const std::array<const T *, In> &in,
+                 const std::array<T *, Out> &out, std::size_t n) noexcept {
+  map_streams<32>(op, in, out, n);
+}
+
+template <typename Op, typename T, std::size_t In, std::size_t Out>
+PULGACPP_TARGET_SSE42 void
+map_streams_sse42(const Op &op, const std::array<const T *, In> &in,
+                  const std::array<T *, Out> &out, std::size_t n) noexcept {
+  map_streams<16>(op, in, out, n);
+}
+#endif
+
+template <typename Op, typename T, std::size_t In, std::size_t Out>
+void map_streams_native(const Op &op, const std::array<const T *, In> &in,
+                        const std::array<T *, Out> &out,
+                        std::size_t n) noexcept {
+  map_streams<16>(op, in, out, n);
+}
+
+#endif // PULGACPP_VECTOR_EXT
+
+/// Runs `map_streams` for `op` on the active instruction set.
+template <typename Op, typename T, std::size_t In, std::size_t Out>
+void dispatch_map_streams(const Op &op, const std::array<const T *, In> &in,
+                          const std::array<T *, Out> &out,
+                          std::size_t n) noexcept {
+#if PULGACPP_VECTOR_EXT
+  switch (active_isa()) {
+#if PULGACPP_SIMD_X86
+  case Isa::Avx2:
+    return map_streams_avx2(op, in, out, n);
+  case Isa::Sse42:
+    return map_streams_sse42(op, in, out, n);
+#endif
+  case Isa::Scalar:
+    return map_streams_scalar(op, in, out, n);
+  default:
+    return map_streams_native(op, in, out, n);
+  }
+#else
+  map_streams_scalar(op, in, out, n);
+#endif
+}
+
+} // namespace pulgacpp::detail::simd
+
+#endif // PULGACPP_CORE_SIMD_HPP
@@ -0,0 +1,91 @@
+// Benchmark: hardware division vs Divider (scalar and batch)
+// Compile: g++ -std=c++23 -O2 -I../.. bench_divider.cpp -o bench_divider
+//
+// The divisor is read from argv so the compiler cannot turn the hardware
+// division into a multiply by itself.
+
+#include "divider.hpp"
+#include "../batch/batch.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace pulgacpp;
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 20;
+constexpr int ROUNDS = 50;
+
+/// Keeps `value` alive without letting the compiler see through it.
+template <typename T> void keep(T &value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+template <typename F> void run(const char *name, F body) {
+    body(); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        body();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-36s %8.3f ns/element\n", name, ns / (double(ROUNDS) * COUNT));
+}
+
+template <typename S> void bench(const char *type_name, typename S::underlying_type d) {
+    using T = typename S::underlying_type;
+    std::vector<S> values(COUNT), out(COUNT);
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (auto &v : values) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        v = S(static_cast<T>(x));
+    }
+    auto divider = Divider<S>::from(S(d)).unwrap();
+
+    std::printf("\n--- %s / %llu ---\n", type_name, static_cast<unsigned long long>(d));
+    char label[64];
+
+    std::snprintf(label, sizeof label, "%s checked_div (hardware)", type_name);
+    run(label, [&] {
+        S divisor(d);
+        keep(divisor);
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            out[i] = values[i].checked_div(divisor).unwrap();
+        }
+        keep(out[0]);
+    });
+
+    std::snprintf(label, sizeof label, "%s Divider::checked_div", type_name);
+    run(label, [&] {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            out[i] = divider.checked_div(values[i]).unwrap();
+        }
+        keep(out[0]);
+    });
+
+    std::snprintf(label, sizeof label, "%s batch::checked_div", type_name);
+    run(label, [&] {
+        (void)batch::checked_div<S>(values, divider, out);
+        keep(out[0]);
+    });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned long long d = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 7;
+    if (d == 0) {
+        std::printf("divisor must be non-zero\n");
+        return 1;
+    }
+    std::printf("=== Division by a runtime-invariant divisor (%zu elements) ===\n", COUNT);
+    bench<u32>("u32", static_cast<std::uint32_t>(d));
+    bench<u64>("u64", static_cast<std::uint64_t>(d));
+    return 0;
+}
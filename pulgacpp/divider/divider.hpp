@@ -0,0 +1,257 @@
+// pulgacpp::Divider - Fast division by a divisor fixed at runtime
+// SPDX-License-Identifier: MIT
+//
+// Hardware division is 20-90 cycles. When the same divisor is used many
+// times (bucket counts, grid cell sizes), Divider<S> precomputes a magic
+// multiplier once so that every later division is a multiply-high, a
+// subtract and two shifts (Granlund & Montgomery, "Division by Invariant
+// Integers using Multiplication", 1994).
+//
+// For an N-bit unsigned divisor d with l = ceil(log2(d)):
+//   m  = floor(2^N * (2^l - d) / d) + 1        (fits in N bits)
+//   t  = mulhi(m, n)
+//   q  = (t + ((n - t) >> min(l, 1))) >> max(l - 1, 0)
+// This form needs no branch on d: powers of two get m = 1, and d = 1 gets
+// both shifts zero. Signed division runs the unsigned sequence on |n| with
+// |d| and fixes the sign afterwards.
+//
+// The multiply-high uses SafeInt's wider_type (u64 for u32, unsigned
+// __int128 for u64), with a portable fallback where no wider type exists.
+// Span versions live in batch.hpp.
+//
+// Usage:
+//   #include <pulgacpp/divider/divider.hpp>
+//
+//   auto per_cell = Divider<u32>::from(cell_size).expect("cell size");
+//   u32 cell = x / per_cell;                 // no div instruction
+//   auto q = per_cell.checked_div(y);        // Optional<u32>, same result
+
+#ifndef PULGACPP_DIVIDER_HPP
+#define PULGACPP_DIVIDER_HPP
+
+#include "../core/safe_int.hpp"
+#include "../nonzero/nonzero.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+namespace pulgacpp {
+
+namespace detail {
+
+/// Magic multiplier and shifts for dividing N-bit unsigned values by `d`.
+template <typename U> struct DividerMagic {
+  U multiplier;
+  std::uint8_t pre_shift;  // min(l, 1)
+  std::uint8_t post_shift; // max(l - 1, 0)
+};
+
+template <typename U, typename Wide>
+[[nodiscard]] constexpr DividerMagic<U> divider_magic(U d) noexcept {
+  constexpr unsigned bits = sizeof(U) * 8;
+  const unsigned l = static_cast<unsigned>(std::bit_width(static_cast<U>(d - 1)));
+  // 2^l - d, computed mod 2^N (l == N wraps correctly). Always < d.
+  const U excess = static_cast<U>(
+      (l == bits ? U(0) : static_cast<U>(U(1) << l)) - d);
+
+  // floor(excess * 2^N / d)
+  U quotient = 0;
+  using W = make_unsigned_int_t<Wide>;
+  if constexpr (sizeof(W) >= 2 * sizeof(U)) {
+    quotient = static_cast<U>((static_cast<W>(excess) << bits) / d);
+  } else {
+    // Long division one bit at a time (only without a 128-bit type)
+    U rem = excess;
+    for (unsigned i = 0; i < bits; ++i) {
+      bool carry = (rem >> (bits - 1)) != 0;
+      rem = static_cast<U>(rem << 1);
+      quotient = static_cast<U>(quotient << 1);
+      if (carry || rem >= d) {
+        rem = static_cast<U>(rem - d);
+        quotient |= 1;
+      }
+    }
+  }
+  return {static_cast<U>(quotient + 1), static_cast<std::uint8_t>(l < 1 ? l : 1),
+          static_cast<std::uint8_t>(l > 1 ? l - 1 : 0)};
+}
+
+/// Unsigned quotient n / d from precomputed magic.
+template <typename U, typename Wide>
+[[nodiscard]] constexpr U magic_divide(U n, const DividerMagic<U> &magic) noexcept {
+  U t = mul_high<U, Wide>(magic.multiplier, n);
+  return static_cast<U>(
+      static_cast<U>(t + static_cast<U>(static_cast<U>(n - t) >> magic.pre_shift)) >>
+      magic.post_shift);
+}
+
+} // namespace detail
+
+/// Precomputed division by a fixed non-zero divisor of type S.
+///
+/// Gives the same results as S::checked_div / checked_rem, without a
+/// hardware divide. Supports every SafeInt of up to 64 bits.
+template <detail::SafeInteger S>
+  requires(sizeof(typename S::underlying_type) <= 8)
+class Divider {
+public:
+  using value_type = S;
+  using underlying_type = typename S::underlying_type;
+  using unsigned_type = detail::make_unsigned_int_t<underlying_type>;
+  using wider_type = typename S::wider_type;
+
+  static constexpr bool is_signed = detail::is_signed_int_v<underlying_type>;
+  static constexpr unsigned BITS = sizeof(underlying_type) * 8;
+
+  // ==================== Construction ====================
+
+  /// Returns None if `divisor` is zero.
+  [[nodiscard]] static constexpr Optional<Divider> from(S divisor) noexcept {
+    if (divisor.get() == 0) {
+      return None;
+    }
+    return Some(Divider(divisor.get()));
+  }
+
+  /// A NonZero divisor cannot fail.
+  [[nodiscard]] static constexpr Divider from(NonZero<S> divisor) noexcept {
+    return Divider(divisor.get().get());
+  }
+
+  // ==================== Accessors ====================
+
+  [[nodiscard]] constexpr S divisor() const noexcept { return S(m_divisor); }
+
+  [[nodiscard]] constexpr const detail::DividerMagic<unsigned_type> &
+  magic() const noexcept {
+    return m_magic;
+  }
+
+  // ==================== Division ====================
+
+  /// Truncating quotient. None only for signed MIN / -1.
+  [[nodiscard]] constexpr Optional<S> checked_div(S n) const noexcept {
+    if (overflows(n.get())) {
+      return None;
+    }
+    return Some(S(quotient(n.get())));
+  }
+
+  /// Remainder with the sign of `n`. None only for signed MIN % -1.
+  [[nodiscard]] constexpr Optional<S> checked_rem(S n) const noexcept {
+    if (overflows(n.get())) {
+      return None;
+    }
+    return Some(S(remainder(n.get(), quotient(n.get()))));
+  }
+
+  /// Quotient rounded towards negative infinity. Same as checked_div for
+  /// unsigned types. None only for signed MIN / -1.
+  [[nodiscard]] constexpr Optional<S> div_floor(S n) const noexcept {
+    if (overflows(n.get())) {
+      return None;
+    }
+    return Some(S(floor_quotient(n.get())));
+  }
+
+  // ==================== Raw kernels ====================
+  // Used by the span versions in batch.hpp. Results wrap for MIN / -1.
+
+  /// Truncating quotient, wrapping for MIN / -1.
+  [[nodiscard]] constexpr underlying_type
+  quotient(underlying_type n) const noexcept {
+    if constexpr (is_signed) {
+      // |n| / |d| in unsigned arithmetic, then apply the combined sign
+      unsigned_type sign = n < 0 ? unsigned_type(~unsigned_type(0)) : 0;
+      unsigned_type magnitude = static_cast<unsigned_type>(
+          (static_cast<unsigned_type>(n) ^ sign) - sign);
+      unsigned_type q =
+          detail::magic_divide<unsigned_type, wider_type>(magnitude, m_magic);
+      unsigned_type negate = sign ^ m_sign;
+      return static_cast<underlying_type>(static_cast<unsigned_type>((q ^ negate) - negate));
+    } else {
+      return detail::magic_divide<unsigned_type, wider_type>(n, m_magic);
+    }
+  }
+
+  /// n - q * d, wrapping.
+  [[nodiscard]] constexpr underlying_type
+  remainder(underlying_type n, underlying_type q) const noexcept {
+    return static_cast<underlying_type>(
+        static_cast<unsigned_type>(n) -
+        static_cast<unsigned_type>(static_cast<unsigned_type>(q) *
+                                   static_cast<unsigned_type>(m_divisor)));
+  }
+
+  /// Floor quotient, wrapping for MIN / -1.
+  [[nodiscard]] constexpr underlying_type
+  floor_quotient(underlying_type n) const noexcept {
+    underlying_type q = quotient(n);
+    if constexpr (is_signed) {
+      underlying_type r = remainder(n, q);
+      // A non-zero remainder whose sign differs from d's rounds down
+      if (r != 0 && (r ^ m_divisor) < 0) {
+        --q;
+      }
+    }
+    return q;
+  }
+
+  /// True for the single signed case that overflows: MIN / -1.
+  [[nodiscard]] constexpr bool overflows(underlying_type n) const noexcept {
+    if constexpr (is_signed) {
+      return m_divisor == -1 && n == S::MIN;
+    } else {
+      (void)n;
+      return false;
+    }
+  }
+
+  // ==================== Comparison ====================
+
+  [[nodiscard]] constexpr bool operator==(const Divider &other) const noexcept {
+    return m_divisor == other.m_divisor;
+  }
+
+private:
+  constexpr explicit Divider(underlying_type divisor) noexcept
+      : m_divisor(divisor),
+        m_magic(detail::divider_magic<unsigned_type, wider_type>(
+            magnitude_of(divisor))),
+        m_sign(divisor < 0 ? unsigned_type(~unsigned_type(0)) : 0) {}
+
+  [[nodiscard]] static constexpr unsigned_type
+  magnitude_of(underlying_type d) noexcept {
+    if constexpr (is_signed) {
+      return d < 0 ? static_cast<unsigned_type>(unsigned_type(0) -
+                                                static_cast<unsigned_type>(d))
+                   : static_cast<unsigned_type>(d);
+    } else {
+      return d;
+    }
+  }
+
+  underlying_type m_divisor;
+  detail::DividerMagic<unsigned_type> m_magic;
+  unsigned_type m_sign; // all ones if the divisor is negative
+};
+
+// ==================== Operators ====================
+// Unsigned only, like NonZero: nothing can go wrong, so no Optional.
+
+template <detail::SafeInteger S>
+  requires(!detail::is_signed_int_v<typename S::underlying_type>)
+[[nodiscard]] constexpr S operator/(S lhs, const Divider<S> &rhs) noexcept {
+  return S(rhs.quotient(lhs.get()));
+}
+
+template <detail::SafeInteger S>
+  requires(!detail::is_signed_int_v<typename S::underlying_type>)
+[[nodiscard]] constexpr S operator%(S lhs, const Divider<S> &rhs) noexcept {
+  return S(rhs.remainder(lhs.get(), rhs.quotient(lhs.get())));
+}
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_DIVIDER_HPP
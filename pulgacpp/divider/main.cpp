@@ -0,0 +1,212 @@
+// Test program for pulgacpp::Divider
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_divider
+
+#include "divider.hpp"
+#include "../i16/i16.hpp"
+#include "../i32/i32.hpp"
+#include "../i64/i64.hpp"
+#include "../i8/i8.hpp"
+#include "../u16/u16.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include "../u8/u8.hpp"
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+/// Floor division reference built on checked_div / checked_rem.
+template <typename S> Optional<S> reference_floor(S n, S d) {
+    auto q = n.checked_div(d);
+    if (q.is_none()) {
+        return None;
+    }
+    auto r = n.checked_rem(d).unwrap();
+    if (r.get() != 0 && ((r.get() < 0) != (d.get() < 0))) {
+        return Some(S(static_cast<typename S::underlying_type>(q.unwrap().get() - 1)));
+    }
+    return q;
+}
+
+/// True if the Divider agrees with SafeInt's own division for `n`.
+template <typename S> bool agrees(const Divider<S> &divider, S n) {
+    S d = divider.divisor();
+    return divider.checked_div(n) == n.checked_div(d) &&
+           divider.checked_rem(n) == n.checked_rem(d) &&
+           divider.div_floor(n) == reference_floor(n, d);
+}
+
+/// Divisors and numerators at the edges of the range, where magic-number
+/// mistakes show up first.
+template <typename S> std::vector<typename S::underlying_type> edge_values() {
+    using T = typename S::underlying_type;
+    std::vector<T> values = {T(0), T(1), T(2), T(3), T(5), T(7), T(10), T(100),
+                             S::MAX, T(S::MAX - 1), T(S::MAX / 2), T(S::MAX / 2 + 1),
+                             T(S::MAX / 3), T(S::MAX / 7)};
+    for (unsigned bit = 0; bit < sizeof(T) * 8 - (S::MIN < 0 ? 1 : 0); ++bit) {
+        T p = static_cast<T>(T(1) << bit);
+        values.push_back(p);
+        values.push_back(static_cast<T>(p - 1));
+        values.push_back(static_cast<T>(p + 1));
+    }
+    if constexpr (S::MIN < 0) {
+        std::size_t count = values.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            values.push_back(static_cast<T>(-values[i]));
+        }
+        values.push_back(S::MIN);
+        values.push_back(static_cast<T>(S::MIN + 1));
+    }
+    return values;
+}
+
+/// Every divisor against every numerator (8-bit types).
+template <typename S> bool exhaustive() {
+    using T = typename S::underlying_type;
+    for (int d = S::MIN; d <= S::MAX; ++d) {
+        if (d == 0) {
+            continue;
+        }
+        auto divider = Divider<S>::from(S(static_cast<T>(d))).unwrap();
+        for (int n = S::MIN; n <= S::MAX; ++n) {
+            if (!agrees(divider, S(static_cast<T>(n)))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// Edge divisors plus `random_divisors` random ones, each against edge and
+/// random numerators.
+template <typename S> bool sampled(std::size_t random_divisors, unsigned seed) {
+    using T = typename S::underlying_type;
+    std::mt19937_64 rng(seed);
+    auto random_value = [&] {
+        // Random bit length so that small and large values are equally common
+        unsigned bits = static_cast<unsigned>(rng() % (sizeof(T) * 8)) + 1;
+        auto raw = rng();
+        if (bits < 64) {
+            raw &= (std::uint64_t(1) << bits) - 1;
+        }
+        T value = static_cast<T>(raw);
+        if constexpr (S::MIN < 0) {
+            if (rng() & 1) {
+                value = static_cast<T>(~value);
+            }
+        }
+        return value;
+    };
+
+    std::vector<T> divisors = edge_values<S>();
+    for (std::size_t i = 0; i < random_divisors; ++i) {
+        divisors.push_back(random_value());
+    }
+    std::vector<T> numerators = edge_values<S>();
+    for (int i = 0; i < 64; ++i) {
+        numerators.push_back(random_value());
+    }
+
+    for (T d : divisors) {
+        auto divider = Divider<S>::from(S(d));
+        if (d == 0) {
+            if (divider.is_some()) {
+                return false;
+            }
+            continue;
+        }
+        for (T n : numerators) {
+            if (!agrees(divider.unwrap(), S(n))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== pulgacpp::Divider Test Suite ===\n\n";
+
+    // --- Construction ---
+    std::cout << "--- Construction ---\n";
+    {
+        test(Divider<u32>::from(0_u32).is_none(), "from(0) is None");
+        auto seven = Divider<u32>::from(7_u32).unwrap();
+        test(seven.divisor() == 7_u32, "divisor() round trip");
+        auto from_nonzero = Divider<u32>::from(NonZero<u32>::constant<7>());
+        test(from_nonzero == seven, "from(NonZero) cannot fail");
+        test(Divider<u32>::from(1_u32).unwrap().magic().post_shift == 0,
+             "divide by one has no shift");
+        test(Divider<u64>::from(8_u64).unwrap().magic().multiplier == 1,
+             "power of two uses multiplier 1");
+    }
+
+    // --- Basic division ---
+    std::cout << "\n--- Division ---\n";
+    {
+        auto seven = Divider<u32>::from(7_u32).unwrap();
+        test(100_u32 / seven == 14_u32, "u32 / Divider");
+        test(100_u32 % seven == 2_u32, "u32 % Divider");
+        test(seven.checked_div(u32(u32::MAX)).unwrap() == u32(u32::MAX / 7), "MAX / 7");
+
+        auto minus_three = Divider<i32>::from(i32(-3)).unwrap();
+        test(minus_three.checked_div(i32(7)).unwrap() == i32(-2), "7 / -3 truncates");
+        test(minus_three.checked_rem(i32(7)).unwrap() == i32(1), "7 % -3 keeps the dividend's sign");
+        test(minus_three.div_floor(i32(7)).unwrap() == i32(-3), "div_floor(7, -3) rounds down");
+        test(minus_three.div_floor(i32(-9)).unwrap() == i32(3), "exact div_floor is unchanged");
+
+        auto minus_one = Divider<i64>::from(i64(std::int64_t{-1})).unwrap();
+        test(minus_one.checked_div(i64(i64::MIN)).is_none(), "MIN / -1 is None");
+        test(minus_one.checked_rem(i64(i64::MIN)).is_none(), "MIN % -1 is None");
+        test(minus_one.checked_div(i64(i64::MAX)).unwrap() == i64(-i64::MAX), "MAX / -1");
+
+        auto min_divisor = Divider<i32>::from(i32(i32::MIN)).unwrap();
+        test(min_divisor.checked_div(i32(i32::MIN)).unwrap() == 1_i32, "MIN / MIN");
+        test(min_divisor.checked_div(i32(i32::MAX)).unwrap() == 0_i32, "MAX / MIN");
+        test(min_divisor.div_floor(i32(-1)).unwrap() == 0_i32, "div_floor(-1, MIN)");
+        test(min_divisor.div_floor(1_i32).unwrap() == i32(-1), "div_floor(1, MIN)");
+
+        constexpr auto ten = Divider<u16>::from(10_u16).unwrap();
+        static_assert(ten.checked_div(12345_u16).unwrap() == 1234_u16);
+        test(true, "constexpr division");
+    }
+
+    // --- Against SafeInt's hardware division ---
+    std::cout << "\n--- Agreement with checked_div / checked_rem ---\n";
+    {
+        test(exhaustive<u8>(), "u8: every divisor, every numerator");
+        test(exhaustive<i8>(), "i8: every divisor, every numerator");
+        test(sampled<u16>(2000, 1), "u16: edge and random divisors");
+        test(sampled<i16>(2000, 2), "i16: edge and random divisors");
+        test(sampled<u32>(2000, 3), "u32: edge and random divisors");
+        test(sampled<i32>(2000, 4), "i32: edge and random divisors");
+        test(sampled<u64>(2000, 5), "u64: edge and random divisors");
+        test(sampled<i64>(2000, 6), "i64: edge and random divisors");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
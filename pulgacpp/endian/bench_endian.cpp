@@ -0,0 +1,74 @@
+// Benchmark: decoding big-endian columns one value at a time and in bulk
+// Compile: g++ -std=c++23 -O2 -I../.. bench_endian.cpp -o bench_endian
+
+#include "endian.hpp"
+#include "../geometry/endian_traits.hpp"
+#include "../u32/u32.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace pulgacpp;
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 20;
+constexpr int ROUNDS = 100;
+
+/// Keeps `value` alive without letting the compiler see through it.
+template <typename T> void keep(T &value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+template <typename F> void run(const char *name, F body) {
+    body(); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        body();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-36s %8.3f ns/value\n", name, ns / (double(ROUNDS) * COUNT));
+}
+
+template <typename E> void bench(const char *title) {
+    using T = typename E::value_type;
+    std::printf("\n--- %s ---\n", title);
+    std::vector<std::byte> bytes(COUNT * E::SIZE);
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (auto &b : bytes) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        b = static_cast<std::byte>(x);
+    }
+    auto view = RecordView<E>::from(bytes).unwrap();
+    std::vector<T> out(COUNT);
+
+    run("row by row (view[i].get())", [&] {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            out[i] = view[usize(static_cast<usize::underlying_type>(i))].get();
+        }
+        keep(out[0]);
+    });
+    detail::simd::set_active_isa(detail::simd::Isa::Scalar);
+    run("column<0>() scalar", [&] {
+        view.template column<0>(out);
+        keep(out[0]);
+    });
+    detail::simd::set_active_isa(detail::simd::Isa::Avx2);
+    run("column<0>() best instruction set", [&] {
+        view.template column<0>(out);
+        keep(out[0]);
+    });
+}
+
+} // namespace
+
+int main() {
+    std::printf("=== Endian decoding (%zu values) ===\n", COUNT);
+    bench<BigEndian<u32>>("BigEndian<u32>");
+    bench<BigEndian<Vector3<float>>>("BigEndian<Vector3<float>>");
+    bench<LittleEndian<Vector3<float>>>("LittleEndian<Vector3<float>> (host order)");
+    return 0;
+}
@@ -0,0 +1,577 @@
+// pulgacpp::Endian - Byte-order aware values and record views over raw bytes
+// SPDX-License-Identifier: MIT
+//
+// BigEndian<T> and LittleEndian<T> hold the encoded bytes of a T in a fixed
+// byte order. They have alignment 1 and no padding, so they describe file
+// and wire layouts exactly, and get() decodes on access on any host.
+//
+// RecordView<Fields...> reads fixed-size records of such fields straight
+// from a std::span<const std::byte> (typically a memory-mapped file) without
+// copying it first. Single values decode with one load and, if the byte
+// order differs from the host's, one bswap. column<I>() decodes a field of
+// every record at once; for a packed column it byte-swaps with vector
+// shuffles (pshufb on x86) chosen at runtime like the batch functions.
+//
+// T is any type with an endian_traits specialization: native integers,
+// float and double, every SafeInt, and (with geometry/endian_traits.hpp)
+// the geometry Point, Vector2 and Vector3 of those.
+//
+// Usage:
+//   #include <pulgacpp/endian/endian.hpp>
+//
+//   using Sample = RecordView<BigEndian<u32>, BigEndian<i16>, LittleEndian<Vector3<float>>>;
+//   auto view = Sample::from(mapped_bytes).expect("whole records");
+//   u32 id = view[0_usize].get<0>();
+//   Optional<Vector3<float>> p = view.get<2>(7_usize);
+//   std::vector<u32> ids(view.size().get());
+//   view.column<0>(ids);
+
+#ifndef PULGACPP_ENDIAN_HPP
+#define PULGACPP_ENDIAN_HPP
+
+#include "../core/safe_int.hpp"
+#include "../core/simd.hpp"
+#include "../usize/usize.hpp"
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace pulgacpp {
+
+static_assert(std::endian::native == std::endian::little ||
+                  std::endian::native == std::endian::big,
+              "mixed-endian hosts are not supported");
+
+/// Opt-in trait describing how a T is laid out in a byte order.
+///
+/// A specialization provides:
+///   static constexpr std::size_t SIZE;   // encoded bytes
+///   static constexpr std::size_t WORD;   // bytes per swapped word
+///   template <std::endian Order>
+///   static constexpr T load(const std::byte *p) noexcept;
+///   template <std::endian Order>
+///   static constexpr void store(std::byte *p, const T &value) noexcept;
+///
+/// The encoding is a sequence of WORD-byte words, each stored in `Order`.
+/// When T is trivially copyable and sizeof(T) == SIZE, its object
+/// representation must be the same words in host order (true for plain
+/// structs of such fields), which lets bulk decoding swap bytes in place of
+/// decoding one value at a time.
+template <typename T>
+struct endian_traits {};
+
+/// True if endian_traits<T> is specialized.
+template <typename T>
+concept EndianCodable = requires(const std::byte *in, std::byte *out, const T &value) {
+  { endian_traits<T>::SIZE } -> std::convertible_to<std::size_t>;
+  { endian_traits<T>::WORD } -> std::convertible_to<std::size_t>;
+  { endian_traits<T>::template load<std::endian::big>(in) } -> std::same_as<T>;
+  endian_traits<T>::template store<std::endian::big>(out, value);
+};
+
+namespace detail {
+
+template <std::size_t N> struct endian_word {};
+template <> struct endian_word<1> { using type = std::uint8_t; };
+template <> struct endian_word<2> { using type = std::uint16_t; };
+template <> struct endian_word<4> { using type = std::uint32_t; };
+template <> struct endian_word<8> { using type = std::uint64_t; };
+#if PULGACPP_HAS_INT128
+template <> struct endian_word<16> { using type = unsigned __int128; };
+#endif
+
+/// Unsigned integer of N bytes.
+template <std::size_t N>
+using endian_word_t = typename endian_word<N>::type;
+
+/// Reverses the bytes of an unsigned word.
+template <typename U>
+[[nodiscard]] constexpr U byteswap_word(U word) noexcept {
+  if constexpr (sizeof(U) == 1) {
+    return word;
+  } else if constexpr (sizeof(U) <= 8) {
+    return std::byteswap(word);
+  } else {
+    auto low = static_cast<std::uint64_t>(word);
+    auto high = static_cast<std::uint64_t>(word >> 64);
+    return (static_cast<U>(std::byteswap(low)) << 64) | std::byteswap(high);
+  }
+}
+
+/// Reads a word stored in `Order`: one load, plus a bswap when `Order` is
+/// not the host's. Byte by byte in constant evaluation.
+template <typename U, std::endian Order>
+[[nodiscard]] constexpr U load_word(const std::byte *p) noexcept {
+  U word = 0;
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i < sizeof(U); ++i) {
+      std::size_t at = Order == std::endian::little ? sizeof(U) - 1 - i : i;
+      word = static_cast<U>((word << 8) | static_cast<U>(std::to_integer<unsigned char>(p[at])));
+    }
+    return word;
+  }
+  std::memcpy(&word, p, sizeof(U));
+  return Order == std::endian::native ? word : byteswap_word(word);
+}
+
+/// Writes a word in `Order`.
+template <typename U, std::endian Order>
+constexpr void store_word(std::byte *p, U word) noexcept {
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i < sizeof(U); ++i) {
+      std::size_t at = Order == std::endian::little ? i : sizeof(U) - 1 - i;
+      p[at] = static_cast<std::byte>(word >> (8 * i));
+    }
+    return;
+  }
+  if (Order != std::endian::native) {
+    word = byteswap_word(word);
+  }
+  std::memcpy(p, &word, sizeof(U));
+}
+
+/// Native integers except bool, and IEEE float and double.
+template <typename T>
+concept EndianScalar =
+    (std::integral<T> && !std::same_as<T, bool>) ||
+    (std::floating_point<T> && std::numeric_limits<T>::is_iec559 &&
+     (sizeof(T) == 4 || sizeof(T) == 8));
+
+/// Types whose decoded object representation is their encoding with each
+/// word byte-swapped to host order, so arrays convert by swapping bytes.
+template <typename T>
+concept EndianBulk = EndianCodable<T> && std::is_trivially_copyable_v<T> &&
+                     sizeof(T) == endian_traits<T>::SIZE &&
+                     endian_traits<T>::WORD != 0 &&
+                     endian_traits<T>::SIZE % endian_traits<T>::WORD == 0;
+
+// ==================== Bulk byte swap ====================
+// Reverses the bytes of each W-byte word of `in` into `out`. A W-byte
+// reversal never crosses a 16-byte boundary, so it is one pshufb (vpshufb
+// for AVX2) per vector.
+
+#if PULGACPP_VECTOR_EXT
+
+template <std::size_t W, typename V, std::size_t... I>
+PULGACPP_ALWAYS_INLINE void reverse_words(V &v, std::index_sequence<I...>) noexcept {
+  v = __builtin_shufflevector(v, v, (I ^ (W - 1))...);
+}
+
+template <std::size_t W, std::size_t Bytes>
+PULGACPP_ALWAYS_INLINE std::size_t swap_words_vec(const std::byte *in, std::byte *out,
+                                                  std::size_t words) noexcept {
+  using V = simd::vec<std::uint8_t, Bytes>;
+  const std::size_t bytes = words * W;
+  std::size_t i = 0;
+  for (; i + Bytes <= bytes; i += Bytes) {
+    V v;
+    simd::load(v, in + i);
+    reverse_words<W>(v, std::make_index_sequence<Bytes>{});
+    simd::store(out + i, v);
+  }
+  return i / W;
+}
+
+#if PULGACPP_SIMD_X86
+template <std::size_t W>
+PULGACPP_TARGET_AVX2 std::size_t swap_words_avx2(const std::byte *in, std::byte *out,
+                                                 std::size_t words) noexcept {
+  return swap_words_vec<W, 32>(in, out, words);
+}
+
+template <std::size_t W>
+PULGACPP_TARGET_SSE42 std::size_t swap_words_sse42(const std::byte *in, std::byte *out,
+                                                   std::size_t words) noexcept {
+  return swap_words_vec<W, 16>(in, out, words);
+}
+#endif
+
+template <std::size_t W>
+std::size_t swap_words_native(const std::byte *in, std::byte *out, std::size_t words) noexcept {
+  return swap_words_vec<W, 16>(in, out, words);
+}
+
+#endif // PULGACPP_VECTOR_EXT
+
+/// Byte-swaps `words` W-byte words on the active instruction set.
+template <std::size_t W>
+void swap_words(const std::byte *in, std::byte *out, std::size_t words) noexcept {
+  using U = endian_word_t<W>;
+  std::size_t done = 0;
+#if PULGACPP_VECTOR_EXT
+  switch (simd::active_isa()) {
+#if PULGACPP_SIMD_X86
+  case simd::Isa::Avx2:
+    done = swap_words_avx2<W>(in, out, words);
+    break;
+  case simd::Isa::Sse42:
+    done = swap_words_sse42<W>(in, out, words);
+    break;
+#endif
+  case simd::Isa::Scalar:
+    break;
+  default:
+    done = swap_words_native<W>(in, out, words);
+    break;
+  }
+#endif
+  for (; done < words; ++done) {
+    store_word<U, std::endian::native>(out + done * W,
+                                       byteswap_word(load_word<U, std::endian::native>(in + done * W)));
+  }
+}
+
+} // namespace detail
+
+// ==================== Scalar traits ====================
+
+/// Native integers, float and double: one word of sizeof(T) bytes.
+template <detail::EndianScalar T>
+struct endian_traits<T> {
+  static constexpr std::size_t SIZE = sizeof(T);
+  static constexpr std::size_t WORD = sizeof(T);
+
+  template <std::endian Order>
+  [[nodiscard]] static constexpr T load(const std::byte *p) noexcept {
+    return std::bit_cast<T>(detail::load_word<detail::endian_word_t<SIZE>, Order>(p));
+  }
+
+  template <std::endian Order>
+  static constexpr void store(std::byte *p, const T &value) noexcept {
+    using U = detail::endian_word_t<SIZE>;
+    detail::store_word<U, Order>(p, std::bit_cast<U>(value));
+  }
+};
+
+/// Every SafeInt: the underlying integer. Every bit pattern is a valid
+/// value, so decoding needs no checks.
+template <detail::SafeInteger S>
+struct endian_traits<S> {
+  using underlying_type = typename S::underlying_type;
+  static_assert(S::BITS == 8 * sizeof(underlying_type),
+                "SafeInt must use its whole underlying integer");
+
+  static constexpr std::size_t SIZE = sizeof(underlying_type);
+  static constexpr std::size_t WORD = sizeof(underlying_type);
+
+  template <std::endian Order>
+  [[nodiscard]] static constexpr S load(const std::byte *p) noexcept {
+    return S(std::bit_cast<underlying_type>(
+        detail::load_word<detail::endian_word_t<SIZE>, Order>(p)));
+  }
+
+  template <std::endian Order>
+  static constexpr void store(std::byte *p, const S &value) noexcept {
+    using U = detail::endian_word_t<SIZE>;
+    detail::store_word<U, Order>(p, std::bit_cast<U>(value.get()));
+  }
+};
+
+// ==================== Endian ====================
+
+/// A T stored as its encoded bytes in byte order `Order`.
+///
+/// Endian is trivially copyable with sizeof == SIZE and alignment 1, so it
+/// can be placed anywhere in a record. Prefer the aliases BigEndian<T> and
+/// LittleEndian<T>.
+template <EndianCodable T, std::endian Order>
+  requires(Order == std::endian::big || Order == std::endian::little)
+class Endian {
+public:
+  using value_type = T;
+  static constexpr std::size_t SIZE = endian_traits<T>::SIZE;
+  static constexpr std::endian ORDER = Order;
+
+  /// All bytes zero.
+  constexpr Endian() noexcept = default;
+
+  /// Encodes `value`.
+  [[nodiscard]] static constexpr Endian from(const T &value) noexcept {
+    Endian result;
+    encode(result.m_bytes.data(), value);
+    return result;
+  }
+
+  /// Takes exactly SIZE encoded bytes.
+  [[nodiscard]] static constexpr Endian
+  from_bytes(std::span<const std::byte, SIZE> bytes) noexcept {
+    Endian result;
+    for (std::size_t i = 0; i < SIZE; ++i) {
+      result.m_bytes[i] = bytes[i];
+    }
+    return result;
+  }
+
+  /// Decodes the stored value.
+  [[nodiscard]] constexpr T get() const noexcept { return decode(m_bytes.data()); }
+
+  /// The encoded bytes. Not available on temporaries, whose bytes would be
+  /// gone before the span is used.
+  [[nodiscard]] constexpr std::span<const std::byte, SIZE> bytes() const & noexcept {
+    return std::span<const std::byte, SIZE>(m_bytes);
+  }
+  void bytes() const && = delete;
+
+  /// Decodes SIZE bytes at `p`, which need not be aligned.
+  [[nodiscard]] static constexpr T decode(const std::byte *p) noexcept {
+    return endian_traits<T>::template load<Order>(p);
+  }
+
+  /// Encodes `value` into SIZE bytes at `p`.
+  static constexpr void encode(std::byte *p, const T &value) noexcept {
+    endian_traits<T>::template store<Order>(p, value);
+  }
+
+  /// Compares the encoded bytes.
+  [[nodiscard]] friend constexpr bool operator==(const Endian &, const Endian &) noexcept = default;
+
+private:
+  std::array<std::byte, SIZE> m_bytes{};
+};
+
+template <EndianCodable T>
+using BigEndian = Endian<T, std::endian::big>;
+
+template <EndianCodable T>
+using LittleEndian = Endian<T, std::endian::little>;
+
+namespace detail {
+
+template <typename T>
+struct is_endian : std::false_type {};
+
+template <typename T, std::endian Order>
+struct is_endian<Endian<T, Order>> : std::true_type {};
+
+/// Any Endian<T, Order> instantiation.
+template <typename T>
+concept EndianField = is_endian<T>::value;
+
+} // namespace detail
+
+// ==================== RecordView ====================
+
+/// Read-only view of consecutive fixed-size records in a byte span.
+///
+/// Each record is the fields in order with no padding (RECORD_SIZE bytes),
+/// optionally followed by unused bytes up to the stride. The view does not
+/// own the bytes: they must outlive it. Fields are decoded on every access.
+///
+/// Indexing takes a usize and is bounds-checked: operator[] panics on a row
+/// past the end, get() returns None.
+template <detail::EndianField... Fields>
+  requires(sizeof...(Fields) > 0)
+class RecordView {
+  static constexpr std::array<std::size_t, sizeof...(Fields)> SIZES = {Fields::SIZE...};
+
+public:
+  /// Encoded bytes of one record.
+  static constexpr std::size_t RECORD_SIZE = (Fields::SIZE + ...);
+
+  /// Endian type of field I.
+  template <std::size_t I>
+  using field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+  /// Decoded type of field I.
+  template <std::size_t I>
+  using field_type = typename field<I>::value_type;
+
+  /// Byte offset of field I within a record.
+  template <std::size_t I>
+    requires(I < sizeof...(Fields))
+  static constexpr std::size_t OFFSET = [] {
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < I; ++i) {
+      offset += SIZES[i];
+    }
+    return offset;
+  }();
+
+  /// One record; decodes its fields on access.
+  class Row {
+  public:
+    template <std::size_t I>
+      requires(I < sizeof...(Fields))
+    [[nodiscard]] field_type<I> get() const noexcept {
+      return field<I>::decode(m_record + OFFSET<I>);
+    }
+
+    /// The only field of a single-field record.
+    [[nodiscard]] field_type<0> get() const noexcept
+      requires(sizeof...(Fields) == 1)
+    {
+      return get<0>();
+    }
+
+    /// The RECORD_SIZE encoded bytes.
+    [[nodiscard]] std::span<const std::byte, RECORD_SIZE> bytes() const noexcept {
+      return std::span<const std::byte, RECORD_SIZE>(m_record, RECORD_SIZE);
+    }
+
+  private:
+    friend class RecordView;
+
+    explicit Row(const std::byte *record) noexcept : m_record(record) {}
+
+    const std::byte *m_record;
+  };
+
+  /// Forward iterator over the rows.
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Row;
+    using difference_type = std::ptrdiff_t;
+
+    const_iterator() noexcept = default;
+
+    [[nodiscard]] Row operator*() const noexcept { return Row(m_record); }
+
+    const_iterator &operator++() noexcept {
+      m_record += m_stride;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator old = *this;
+      m_record += m_stride;
+      return old;
+    }
+
+    [[nodiscard]] bool operator==(const const_iterator &other) const noexcept {
+      return m_record == other.m_record;
+    }
+
+  private:
+    friend class RecordView;
+
+    const_iterator(const std::byte *record, std::size_t stride) noexcept
+        : m_record(record), m_stride(stride) {}
+
+    const std::byte *m_record = nullptr;
+    std::size_t m_stride = 0;
+  };
+
+  // ==================== Construction ====================
+
+  /// No records.
+  RecordView() noexcept = default;
+
+  /// Records packed back to back. None unless `bytes` holds a whole number
+  /// of records.
+  [[nodiscard]] static Optional<RecordView> from(std::span<const std::byte> bytes) noexcept {
+    return from(bytes, usize(static_cast<usize::underlying_type>(RECORD_SIZE)));
+  }
+
+  /// Records starting every `stride` bytes. None if `stride` is smaller than
+  /// RECORD_SIZE or `bytes` does not hold a whole number of strides.
+  [[nodiscard]] static Optional<RecordView> from(std::span<const std::byte> bytes,
+                                                 usize stride) noexcept {
+    std::size_t step = stride.get();
+    if (step < RECORD_SIZE || bytes.size() % step != 0) {
+      return None;
+    }
+    return Some(RecordView(bytes.data(), bytes.size() / step, step));
+  }
+
+  // ==================== Access ====================
+
+  /// Number of records.
+  [[nodiscard]] usize size() const noexcept {
+    return usize(static_cast<usize::underlying_type>(m_count));
+  }
+
+  [[nodiscard]] bool is_empty() const noexcept { return m_count == 0; }
+
+  /// Bytes from one record to the next.
+  [[nodiscard]] usize stride() const noexcept {
+    return usize(static_cast<usize::underlying_type>(m_stride));
+  }
+
+  /// The viewed bytes.
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+    return {m_data, m_count * m_stride};
+  }
+
+  /// Record `row`. Panics past the end.
+  [[nodiscard]] Row operator[](usize row) const noexcept {
+    if (row.get() >= m_count) {
+      panic("RecordView: row out of bounds");
+    }
+    return Row(m_data + row.get() * m_stride);
+  }
+
+  /// Field I of record `row`, or None past the end.
+  template <std::size_t I>
+    requires(I < sizeof...(Fields))
+  [[nodiscard]] Optional<field_type<I>> get(usize row) const noexcept {
+    if (row.get() >= m_count) {
+      return None;
+    }
+    return Some(field<I>::decode(m_data + row.get() * m_stride + OFFSET<I>));
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept { return {m_data, m_stride}; }
+  [[nodiscard]] const_iterator end() const noexcept {
+    return {m_data + m_count * m_stride, m_stride};
+  }
+
+  // ==================== Bulk decoding ====================
+
+  /// Decodes field I of every record into `out`. Panics unless `out` has
+  /// size() elements.
+  ///
+  /// A single packed field of plain words (integers, floats, and the
+  /// geometry types of those) is copied, or byte-swapped a vector at a time
+  /// when its order is not the host's. Anything else decodes record by
+  /// record.
+  template <std::size_t I>
+    requires(I < sizeof...(Fields))
+  void column(std::span<field_type<I>> out) const noexcept {
+    using F = field<I>;
+    using T = field_type<I>;
+    if (out.size() != m_count) {
+      panic("RecordView: column size differs from the record count");
+    }
+    if constexpr (detail::EndianBulk<T>) {
+      if (m_stride == F::SIZE) {
+        auto *dst = reinterpret_cast<std::byte *>(out.data());
+        constexpr std::size_t W = endian_traits<T>::WORD;
+        if constexpr (F::ORDER == std::endian::native || W == 1) {
+          if (m_count != 0) {
+            std::memcpy(dst, m_data, m_count * F::SIZE);
+          }
+        } else {
+          detail::swap_words<W>(m_data, dst, m_count * (F::SIZE / W));
+        }
+        return;
+      }
+    }
+    const std::byte *record = m_data + OFFSET<I>;
+    for (std::size_t i = 0; i < m_count; ++i, record += m_stride) {
+      out[i] = F::decode(record);
+    }
+  }
+
+private:
+  RecordView(const std::byte *data, std::size_t count, std::size_t stride) noexcept
+      : m_data(data), m_count(count), m_stride(stride) {}
+
+  const std::byte *m_data = nullptr;
+  std::size_t m_count = 0;
+  std::size_t m_stride = RECORD_SIZE;
+};
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_ENDIAN_HPP
@@ -0,0 +1,196 @@
+// Test program for pulgacpp::Endian and RecordView
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_endian
+
+#include "endian.hpp"
+#include "../geometry/endian_traits.hpp"
+#include "../i16/i16.hpp"
+#include "../i32/i32.hpp"
+#include "../i64/i64.hpp"
+#include "../u16/u16.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+using Bytes = std::vector<std::byte>;
+
+template <typename... Values> Bytes bytes_of(Values... values) {
+    return Bytes{static_cast<std::byte>(values)...};
+}
+
+template <typename E> void append(Bytes &out, const typename E::value_type &value) {
+    auto encoded = E::from(value);
+    out.insert(out.end(), encoded.bytes().begin(), encoded.bytes().end());
+}
+
+// Layout guarantees
+static_assert(sizeof(BigEndian<u32>) == 4 && alignof(BigEndian<u32>) == 1);
+static_assert(sizeof(LittleEndian<Vector3<float>>) == 12 && alignof(LittleEndian<Vector3<float>>) == 1);
+static_assert(std::is_trivially_copyable_v<BigEndian<i64>>);
+static_assert(!EndianCodable<bool> && !EndianCodable<std::string_view>);
+
+// Encoding and decoding are constexpr
+constexpr auto BE = BigEndian<u32>::from(0x01020304_u32);
+constexpr auto LE = LittleEndian<u32>::from(0x01020304_u32);
+static_assert(BE.bytes()[0] == std::byte{0x01} && LE.bytes()[0] == std::byte{0x04});
+static_assert(BigEndian<i16>::from(i16(std::int16_t{-2})).get() == i16(std::int16_t{-2}));
+static_assert(BigEndian<double>::from(1.5).get() == 1.5);
+
+/// column<0>() on random bytes must give back the same bytes when encoded
+/// again, for lengths that leave a scalar tail after the vector loop.
+template <typename E> bool column_matches(std::size_t count, unsigned seed) {
+    using T = typename E::value_type;
+    std::mt19937_64 rng(seed);
+    Bytes bytes(count * E::SIZE);
+    for (auto &b : bytes) {
+        b = static_cast<std::byte>(rng());
+    }
+    auto view = RecordView<E>::from(bytes).unwrap();
+    std::vector<T> out(count);
+    view.template column<0>(out);
+    for (std::size_t i = 0; i < count; ++i) {
+        // Compare re-encoded bytes: random floats include NaNs
+        auto again = E::from(out[i]);
+        if (!std::equal(again.bytes().begin(), again.bytes().end(), bytes.begin() + i * E::SIZE)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename E> bool column_matches_all_isas(unsigned seed) {
+    bool ok = true;
+    for (auto isa : {detail::simd::Isa::Scalar, detail::simd::Isa::Native, detail::simd::Isa::Sse42,
+                     detail::simd::Isa::Avx2}) {
+        detail::simd::set_active_isa(isa);
+        for (std::size_t count : {0u, 1u, 7u, 8u, 33u, 1000u}) {
+            ok &= column_matches<E>(count, seed);
+        }
+    }
+    detail::simd::set_active_isa(detail::simd::Isa::Avx2);
+    return ok;
+}
+
+int main() {
+    std::cout << "=== pulgacpp::Endian Test Suite ===\n\n";
+
+    // --- Scalars ---
+    std::cout << "--- Scalars ---\n";
+    {
+        auto be = BigEndian<u32>::from(0xDEADBEEF_u32);
+        auto le = LittleEndian<u32>::from(0xDEADBEEF_u32);
+        test(Bytes(be.bytes().begin(), be.bytes().end()) == bytes_of(0xDE, 0xAD, 0xBE, 0xEF), "big-endian u32 bytes");
+        test(Bytes(le.bytes().begin(), le.bytes().end()) == bytes_of(0xEF, 0xBE, 0xAD, 0xDE), "little-endian u32 bytes");
+        test(be.get() == 0xDEADBEEF_u32 && le.get() == 0xDEADBEEF_u32, "both decode to the same value");
+
+        auto raw = bytes_of(0xFF, 0xFE);
+        auto v = BigEndian<i16>::from_bytes(std::span<const std::byte, 2>(raw.data(), 2));
+        test(v.get() == i16(std::int16_t{-2}), "big-endian i16 from bytes");
+        auto native = LittleEndian<std::uint64_t>::from(0x0102030405060708u);
+        test(native.bytes()[7] == std::byte{0x01}, "native integers are codable");
+        auto zero = BigEndian<float>::from(-0.0f);
+        test(zero.bytes()[0] == std::byte{0x80}, "float sign bit comes first in big-endian");
+        test(BigEndian<i64>::from(i64(i64::MIN)).get() == i64(i64::MIN) &&
+                 LittleEndian<u64>::from(u64(u64::MAX)).get() == u64(u64::MAX),
+             "extremes round-trip");
+        test(BigEndian<u32>() == BigEndian<u32>::from(0_u32), "default is zero");
+    }
+
+    // --- Geometry ---
+    std::cout << "\n--- Geometry ---\n";
+    {
+        auto v = Vector3<float>::from(1.0f, -2.5f, 3.25f);
+        auto le = LittleEndian<Vector3<float>>::from(v);
+        test(le.get() == v, "Vector3<float> round-trips");
+        test(le.bytes()[3] == std::byte{0x3F} && le.bytes()[7] == std::byte{0xC0}, "components are consecutive floats");
+        auto be = BigEndian<Vector3<float>>::from(v);
+        test(be.bytes()[0] == std::byte{0x3F} && be.get() == v, "big-endian Vector3<float>");
+
+        auto p = Point<i32>::from(i32(-7), 9_i32);
+        test(BigEndian<Point<i32>>::from(p).get() == p, "Point<i32> round-trips");
+        auto d = Vector2<double>::from(0.5, 1e300);
+        test(LittleEndian<Vector2<double>>::from(d).get() == d, "Vector2<double> round-trips");
+    }
+
+    // --- RecordView ---
+    std::cout << "\n--- RecordView ---\n";
+    {
+        using Sample = RecordView<BigEndian<u32>, BigEndian<i16>, LittleEndian<Vector3<float>>>;
+        static_assert(Sample::RECORD_SIZE == 18);
+        static_assert(Sample::OFFSET<0> == 0 && Sample::OFFSET<1> == 4 && Sample::OFFSET<2> == 6);
+
+        Bytes file;
+        for (std::uint32_t i = 0; i < 5; ++i) {
+            append<BigEndian<u32>>(file, u32(1000 + i));
+            append<BigEndian<i16>>(file, i16(static_cast<std::int16_t>(-static_cast<int>(i))));
+            append<LittleEndian<Vector3<float>>>(file, Vector3<float>::from(float(i), 0.5f, -1.0f));
+        }
+        auto view = Sample::from(file).unwrap();
+        test(view.size() == 5_usize && view.stride() == 18_usize, "five 18-byte records");
+        test(view[3_usize].get<0>() == 1003_u32 && view[3_usize].get<1>() == i16(std::int16_t{-3}),
+             "fields decode on access");
+        test(view.get<2>(4_usize).unwrap() == Vector3<float>::from(4.0f, 0.5f, -1.0f), "get returns the field");
+        test(view.get<0>(5_usize).is_none(), "get past the end is None");
+
+        std::uint32_t sum = 0;
+        for (auto row : view) {
+            sum += row.get<0>().get();
+        }
+        test(sum == 5010, "iterates over every record");
+
+        std::vector<i16> column(5);
+        view.column<1>(column);
+        test(column[0] == 0_i16 && column[4] == i16(std::int16_t{-4}), "strided column");
+
+        test(Sample::from(std::span<const std::byte>(file).first(35)).is_none(), "partial record is rejected");
+        test(Sample::from(std::span<const std::byte>(file).first(0)).unwrap().is_empty(), "empty span has no records");
+
+        auto padded = RecordView<BigEndian<u32>>::from(file, 18_usize).unwrap();
+        test(padded.size() == 5_usize && padded[2_usize].get() == 1002_u32, "stride skips the other fields");
+        test(RecordView<BigEndian<u32>>::from(file, 3_usize).is_none(), "stride below the record size is rejected");
+        test(RecordView<BigEndian<u32>>::from(file, 7_usize).is_none(), "stride must divide the span");
+    }
+
+    // --- Bulk decoding ---
+    std::cout << "\n--- Bulk decoding ---\n";
+    {
+        test(column_matches_all_isas<BigEndian<u16>>(1) && column_matches_all_isas<BigEndian<u32>>(2) &&
+                 column_matches_all_isas<BigEndian<u64>>(3),
+             "big-endian SafeInt columns on every instruction set");
+        test(column_matches_all_isas<LittleEndian<u32>>(4) && column_matches_all_isas<BigEndian<std::uint8_t>>(5),
+             "native-order and byte columns copy");
+        test(column_matches_all_isas<BigEndian<Vector3<float>>>(6) &&
+                 column_matches_all_isas<BigEndian<Point<i16>>>(7),
+             "geometry columns swap per component");
+        test(column_matches_all_isas<BigEndian<double>>(8), "double columns");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,549 @@
+// pulgacpp::Fixed - Deterministic binary fixed-point numbers on SafeInt
+// SPDX-License-Identifier: MIT
+//
+// Fixed<S, FracBits> stores a real number x as the integer x * 2^FracBits in
+// a signed SafeInt S (i32 or i64). Every operation is integer arithmetic, so
+// results are bit-identical on every compiler, CPU and optimisation level,
+// which float and double cannot promise once FMA contraction, x87 excess
+// precision or a different libm are involved.
+//
+// Multiply and divide go through S::wider_type (i64 for i32, __int128 for
+// i64) and are checked or saturating like SafeInt. sqrt is exact (rounded
+// down); sin, cos and atan2 use CORDIC with enough iterations for the last
+// fractional bit. Fixed satisfies the geometry SafeNumeric concept, so
+// Point<Q16_16>, Circle<Q32_32>, ... work without floats.
+//
+// Usage:
+//   #include <pulgacpp/fixed/fixed.hpp>
+//
+//   using Q = Q16_16;                          // Fixed<i32, 16>
+//   Q speed = Q::from_ratio(3_i32, 2_i32).unwrap();   // 1.5
+//   Q step = speed.checked_mul(dt).expect("speed * dt");
+//   auto [s, c] = heading.sin_cos();
+
+#ifndef PULGACPP_FIXED_HPP
+#define PULGACPP_FIXED_HPP
+
+#include "../i32/i32.hpp"
+#include "../i64/i64.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace pulgacpp {
+
+namespace detail {
+
+/// Signed SafeInt of 32 or 64 bits with a wider_type twice its width.
+template <typename S>
+concept FixedBase =
+    SafeInteger<S> && is_signed_int_v<typename S::underlying_type> &&
+    (sizeof(typename S::underlying_type) == 4 ||
+     sizeof(typename S::underlying_type) == 8) &&
+    sizeof(typename S::wider_type) >= 2 * sizeof(typename S::underlying_type);
+
+// ==================== CORDIC ====================
+// Shared by every Fixed instantiation. Angles and coordinates are Q61 in an
+// int64 (|value| < 4), which is more precision than any Fixed can hold.
+
+namespace cordic {
+
+/// atan(2^-i) in Q61 for i = 0..20. From i = 21 on, atan(2^-i) rounds to
+/// exactly 2^-i at this precision.
+inline constexpr std::int64_t ATAN_TABLE[21] = {
+    0x1921FB54442D1847, 0x0ED63382B0DDA7B4, 0x07D6DD7E4B203759,
+    0x03FAB7535585EDB9, 0x01FF55BB72CFDE9C, 0x00FFEAADDD4BB125,
+    0x007FFD556EEDCA6B, 0x003FFFAAAB77752E, 0x001FFFF5555BBBB7,
+    0x000FFFFEAAAADDDE, 0x0007FFFFD55556EF, 0x0003FFFFFAAAAAB7,
+    0x0001FFFFFF555556, 0x0000FFFFFFEAAAAB, 0x00007FFFFFFD5555,
+    0x00003FFFFFFFAAAB, 0x00001FFFFFFFF555, 0x00000FFFFFFFFEAB,
+    0x000007FFFFFFFFD5, 0x000003FFFFFFFFFB, 0x000001FFFFFFFFFF,
+};
+
+/// 1 / prod(sqrt(1 + 2^-2i)) in Q61: the rotation gain, pre-applied to x.
+inline constexpr std::int64_t GAIN = 0x136E9DB5086BCB4D;
+
+/// pi/2 in Q125 as two 64-bit words; the high word alone is pi/2 in Q61.
+inline constexpr std::uint64_t HALF_PI_HIGH = 0x3243F6A8885A308D;
+inline constexpr std::uint64_t HALF_PI_LOW = 0x313198A2E0370734;
+
+/// 2/pi in Q30 and Q62, for quadrant reduction.
+inline constexpr std::uint64_t TWO_OVER_PI_Q30 = 0x28BE60DC;
+inline constexpr std::uint64_t TWO_OVER_PI_Q62 = 0x28BE60DB9391054A;
+
+inline constexpr unsigned MAX_ITERATIONS = 62;
+
+[[nodiscard]] constexpr std::int64_t atan_step(unsigned i) noexcept {
+  return i < 21 ? ATAN_TABLE[i] : std::int64_t(1) << (61 - i);
+}
+
+struct SinCos {
+  std::int64_t cos;
+  std::int64_t sin;
+};
+
+/// Rotation mode: cos and sin of `angle` (Q61, |angle| <= 1.74).
+[[nodiscard]] constexpr SinCos rotate(std::int64_t angle,
+                                      unsigned iterations) noexcept {
+  std::int64_t x = GAIN, y = 0, z = angle;
+  for (unsigned i = 0; i < iterations; ++i) {
+    std::int64_t dx = y >> i, dy = x >> i;
+    if (z >= 0) {
+      x -= dx;
+      y += dy;
+      z -= atan_step(i);
+    } else {
+      x += dx;
+      y -= dy;
+      z += atan_step(i);
+    }
+  }
+  return {x, y};
+}
+
+/// Vectoring mode: atan(y / x) in Q61 for x > 0, |x|, |y| < 2^60.
+[[nodiscard]] constexpr std::int64_t angle_of(std::int64_t x, std::int64_t y,
+                                              unsigned iterations) noexcept {
+  std::int64_t z = 0;
+  for (unsigned i = 0; i < iterations; ++i) {
+    std::int64_t dx = y >> i, dy = x >> i;
+    if (y < 0) {
+      x -= dx;
+      y += dy;
+      z -= atan_step(i);
+    } else {
+      x += dx;
+      y -= dy;
+      z += atan_step(i);
+    }
+  }
+  return z;
+}
+
+} // namespace cordic
+} // namespace detail
+
+// ============================================================
+// Fixed
+// ============================================================
+
+/// A signed binary fixed-point number: the real value is
+/// get() / 2^FracBits.
+///
+/// Like SafeInt there are no arithmetic operators; use checked_*,
+/// saturating_* or wrapping_*. Multiplication rounds to nearest (ties
+/// towards +infinity); division truncates towards zero.
+template <detail::FixedBase S, unsigned FracBits>
+  requires(FracBits >= 1 && FracBits <= S::BITS - 2)
+class Fixed {
+public:
+  using value_type = S;
+  using underlying_type = typename S::underlying_type;
+  using wider_type = typename S::wider_type;
+
+  static constexpr unsigned BITS = S::BITS;
+  static constexpr unsigned FRAC_BITS = FracBits;
+
+  /// Smallest and largest raw values. The represented range is
+  /// [MIN, MAX] / 2^FRAC_BITS.
+  static constexpr underlying_type MIN = S::MIN;
+  static constexpr underlying_type MAX = S::MAX;
+
+  // ==================== Construction ====================
+
+  /// Zero.
+  constexpr Fixed() noexcept : m_raw(0) {}
+
+  /// The number whose raw representation is `bits` (bits / 2^FRAC_BITS).
+  [[nodiscard]] static constexpr Fixed from_bits(underlying_type bits) noexcept {
+    return Fixed(bits);
+  }
+
+  /// An integer, or None if it is outside the representable range.
+  [[nodiscard]] static constexpr Optional<Fixed> from(S integer) noexcept {
+    return from_wide(static_cast<wider_type>(integer.get()) << FracBits);
+  }
+
+  template <std::integral T>
+  [[nodiscard]] static constexpr Optional<Fixed> from(T integer) noexcept {
+    auto value = S::from(integer);
+    if (value.is_none()) {
+      return None;
+    }
+    return from(value.unwrap());
+  }
+
+  /// numerator / denominator, truncated towards zero. None if the
+  /// denominator is zero or the quotient is out of range.
+  [[nodiscard]] static constexpr Optional<Fixed> from_ratio(S numerator,
+                                                            S denominator) noexcept {
+    if (denominator.get() == 0) {
+      return None;
+    }
+    return from_wide((static_cast<wider_type>(numerator.get()) << FracBits) /
+                     denominator.get());
+  }
+
+  /// The nearest representable value (ties away from zero). None for NaN
+  /// and for values out of range. Meant for constants and input; the
+  /// conversion itself is exact, so it stays deterministic.
+  [[nodiscard]] static constexpr Optional<Fixed> from_double(double value) noexcept {
+    constexpr double limit = static_cast<double>(std::uint64_t(1) << (BITS - 1));
+    double scaled = value * static_cast<double>(std::uint64_t(1) << FracBits);
+    if (!(scaled >= -limit && scaled < limit)) {
+      return None;
+    }
+    auto whole = static_cast<std::int64_t>(scaled);
+    double rest = scaled - static_cast<double>(whole);
+    if (rest >= 0.5) {
+      ++whole;
+    } else if (rest <= -0.5) {
+      --whole;
+    }
+    return from_wide(static_cast<wider_type>(whole));
+  }
+
+  /// 1.
+  [[nodiscard]] static constexpr Fixed one() noexcept {
+    return Fixed(static_cast<underlying_type>(underlying_type(1) << FracBits));
+  }
+
+  /// pi/2, pi and 2*pi, rounded to nearest.
+  [[nodiscard]] static constexpr Fixed half_pi() noexcept
+    requires(FracBits <= BITS - 2)
+  {
+    return Fixed(static_cast<underlying_type>(
+        round_shift(half_pi_wide(), 2 * BITS - 3 - FracBits)));
+  }
+
+  [[nodiscard]] static constexpr Fixed pi() noexcept
+    requires(FracBits <= BITS - 3)
+  {
+    return Fixed(static_cast<underlying_type>(
+        round_shift(half_pi_wide(), 2 * BITS - 4 - FracBits)));
+  }
+
+  [[nodiscard]] static constexpr Fixed tau() noexcept
+    requires(FracBits <= BITS - 4)
+  {
+    return Fixed(static_cast<underlying_type>(
+        round_shift(half_pi_wide(), 2 * BITS - 5 - FracBits)));
+  }
+
+  // ==================== Accessors ====================
+
+  /// The raw representation, value * 2^FRAC_BITS. Comparing raw values is
+  /// the same as comparing the numbers.
+  [[nodiscard]] constexpr underlying_type get() const noexcept { return m_raw; }
+
+  /// The integer part, rounded towards negative infinity.
+  [[nodiscard]] constexpr S to_int() const noexcept {
+    return S(static_cast<underlying_type>(m_raw >> FracBits));
+  }
+
+  /// The nearest double (exact for i32 and for i64 values of up to 53
+  /// significant bits).
+  [[nodiscard]] constexpr double to_double() const noexcept {
+    return static_cast<double>(m_raw) /
+           static_cast<double>(std::uint64_t(1) << FracBits);
+  }
+
+  /// Largest integer value not above this one. Never overflows.
+  [[nodiscard]] constexpr Fixed floor() const noexcept {
+    constexpr underlying_type mask = underlying_type(1) << FracBits;
+    return Fixed(static_cast<underlying_type>(m_raw & -mask));
+  }
+
+  // ==================== Checked Arithmetic ====================
+
+  [[nodiscard]] constexpr Optional<Fixed> checked_add(Fixed rhs) const noexcept {
+    return lift(S(m_raw).checked_add(S(rhs.m_raw)));
+  }
+
+  [[nodiscard]] constexpr Optional<Fixed> checked_sub(Fixed rhs) const noexcept {
+    return lift(S(m_raw).checked_sub(S(rhs.m_raw)));
+  }
+
+  [[nodiscard]] constexpr Optional<Fixed> checked_mul(Fixed rhs) const noexcept {
+    return from_wide(product(rhs));
+  }
+
+  /// None if rhs is zero or the quotient is out of range.
+  [[nodiscard]] constexpr Optional<Fixed> checked_div(Fixed rhs) const noexcept {
+    if (rhs.m_raw == 0) {
+      return None;
+    }
+    return from_wide(quotient(rhs));
+  }
+
+  [[nodiscard]] constexpr Optional<Fixed> checked_neg() const noexcept {
+    return lift(S(m_raw).checked_neg());
+  }
+
+  [[nodiscard]] constexpr Optional<Fixed> checked_abs() const noexcept {
+    return lift(S(m_raw).checked_abs());
+  }
+
+  // ==================== Saturating and Wrapping ====================
+
+  [[nodiscard]] constexpr Fixed saturating_add(Fixed rhs) const noexcept {
+    return Fixed(S(m_raw).saturating_add(S(rhs.m_raw)).get());
+  }
+
+  [[nodiscard]] constexpr Fixed saturating_sub(Fixed rhs) const noexcept {
+    return Fixed(S(m_raw).saturating_sub(S(rhs.m_raw)).get());
+  }
+
+  [[nodiscard]] constexpr Fixed saturating_mul(Fixed rhs) const noexcept {
+    return clamp_wide(product(rhs));
+  }
+
+  /// Division by zero saturates towards the sign of the dividend (zero
+  /// stays zero).
+  [[nodiscard]] constexpr Fixed saturating_div(Fixed rhs) const noexcept {
+    if (rhs.m_raw == 0) {
+      return m_raw > 0 ? Fixed(MAX) : m_raw < 0 ? Fixed(MIN) : Fixed();
+    }
+    return clamp_wide(quotient(rhs));
+  }
+
+  [[nodiscard]] constexpr Fixed wrapping_add(Fixed rhs) const noexcept {
+    return Fixed(S(m_raw).wrapping_add(S(rhs.m_raw)).get());
+  }
+
+  [[nodiscard]] constexpr Fixed wrapping_sub(Fixed rhs) const noexcept {
+    return Fixed(S(m_raw).wrapping_sub(S(rhs.m_raw)).get());
+  }
+
+  [[nodiscard]] constexpr Fixed wrapping_mul(Fixed rhs) const noexcept {
+    return Fixed(static_cast<underlying_type>(product(rhs)));
+  }
+
+  // ==================== Functions ====================
+
+  /// Square root rounded down, or None for negative values. The result
+  /// always fits.
+  [[nodiscard]] constexpr Optional<Fixed> sqrt() const noexcept {
+    if (m_raw < 0) {
+      return None;
+    }
+    // sqrt(raw * 2^F) is the raw square root; digit by digit, shifts and
+    // adds only
+    using U = detail::make_unsigned_int_t<wider_type>;
+    U n = static_cast<U>(m_raw) << FracBits;
+    U root = 0;
+    U bit = U(1) << (2 * BITS - 2);
+    while (bit > n) {
+      bit >>= 2;
+    }
+    while (bit != 0) {
+      if (n >= root + bit) {
+        n -= root + bit;
+        root = (root >> 1) + bit;
+      } else {
+        root >>= 1;
+      }
+      bit >>= 2;
+    }
+    return Some(Fixed(static_cast<underlying_type>(root)));
+  }
+
+  /// Sine and cosine of this angle in radians, from one CORDIC rotation.
+  [[nodiscard]] constexpr std::pair<Fixed, Fixed> sin_cos() const noexcept
+    requires(FracBits <= 61)
+  {
+    auto [c, s] = rotated();
+    return {from_q61(s), from_q61(c)};
+  }
+
+  [[nodiscard]] constexpr Fixed sin() const noexcept
+    requires(FracBits <= 61)
+  {
+    return from_q61(rotated().sin);
+  }
+
+  [[nodiscard]] constexpr Fixed cos() const noexcept
+    requires(FracBits <= 61)
+  {
+    return from_q61(rotated().cos);
+  }
+
+  /// Angle of the point (x, y) in radians, in [-pi, pi]. atan2(0, 0) is 0.
+  [[nodiscard]] static constexpr Fixed atan2(Fixed y, Fixed x) noexcept
+    requires(FracBits <= BITS - 3)
+  {
+    if (x.m_raw == 0) {
+      // The vertical axis exactly; CORDIC would only converge to it
+      underlying_type quarter = half_pi().m_raw;
+      return y.m_raw > 0 ? Fixed(quarter) : y.m_raw < 0 ? Fixed(-quarter) : Fixed();
+    }
+    // Scale |x| and |y| so the larger has its top bit at 59: CORDIC grows
+    // the vector by ~2.33 and the Q61 accumulators must not overflow
+    std::uint64_t ux = magnitude(x.m_raw), uy = magnitude(y.m_raw);
+    int shift = std::countl_zero(ux > uy ? ux : uy) - 4;
+    auto scale = [shift](std::uint64_t v) {
+      return static_cast<std::int64_t>(shift >= 0 ? v << shift : v >> -shift);
+    };
+    std::int64_t sy = y.m_raw < 0 ? -scale(uy) : scale(uy);
+    std::int64_t angle = detail::cordic::angle_of(scale(ux), sy, iterations());
+    if (x.m_raw < 0) {
+      constexpr auto pi_q61 =
+          static_cast<std::int64_t>(2 * detail::cordic::HALF_PI_HIGH);
+      angle = y.m_raw >= 0 ? pi_q61 - angle : -pi_q61 - angle;
+    }
+    return from_q61(angle);
+  }
+
+  // ==================== Comparison ====================
+
+  [[nodiscard]] constexpr auto operator<=>(const Fixed &other) const noexcept = default;
+  [[nodiscard]] constexpr bool operator==(const Fixed &other) const noexcept = default;
+
+  [[nodiscard]] constexpr bool is_zero() const noexcept { return m_raw == 0; }
+  [[nodiscard]] constexpr bool is_positive() const noexcept { return m_raw > 0; }
+  [[nodiscard]] constexpr bool is_negative() const noexcept { return m_raw < 0; }
+
+  [[nodiscard]] constexpr int signum() const noexcept {
+    return (m_raw > 0) - (m_raw < 0);
+  }
+
+  /// Prints the nearest double.
+  friend std::ostream &operator<<(std::ostream &os, Fixed value) {
+    return os << value.to_double();
+  }
+
+private:
+  constexpr explicit Fixed(underlying_type raw) noexcept : m_raw(raw) {}
+
+  [[nodiscard]] static constexpr Optional<Fixed> lift(Optional<S> raw) noexcept {
+    if (raw.is_none()) {
+      return None;
+    }
+    return Some(Fixed(raw.unwrap().get()));
+  }
+
+  [[nodiscard]] static constexpr Optional<Fixed> from_wide(wider_type raw) noexcept {
+    if (raw < static_cast<wider_type>(MIN) || raw > static_cast<wider_type>(MAX)) {
+      return None;
+    }
+    return Some(Fixed(static_cast<underlying_type>(raw)));
+  }
+
+  [[nodiscard]] static constexpr Fixed clamp_wide(wider_type raw) noexcept {
+    if (raw < static_cast<wider_type>(MIN)) {
+      return Fixed(MIN);
+    }
+    if (raw > static_cast<wider_type>(MAX)) {
+      return Fixed(MAX);
+    }
+    return Fixed(static_cast<underlying_type>(raw));
+  }
+
+  /// Raw product, rounded to nearest, before the range check.
+  [[nodiscard]] constexpr wider_type product(Fixed rhs) const noexcept {
+    wider_type full = static_cast<wider_type>(m_raw) * rhs.m_raw;
+    return round_shift(full, FracBits);
+  }
+
+  /// Raw quotient (rhs non-zero), truncated, before the range check.
+  [[nodiscard]] constexpr wider_type quotient(Fixed rhs) const noexcept {
+    return (static_cast<wider_type>(m_raw) << FracBits) / rhs.m_raw;
+  }
+
+  [[nodiscard]] static constexpr wider_type round_shift(wider_type value,
+                                                        unsigned shift) noexcept {
+    return (value + (wider_type(1) << (shift - 1))) >> shift;
+  }
+
+  /// pi/2 in Q(2 * BITS - 3), the most a wider_type holds.
+  [[nodiscard]] static constexpr wider_type half_pi_wide() noexcept {
+    if constexpr (BITS == 32) {
+      return static_cast<wider_type>(detail::cordic::HALF_PI_HIGH);
+    } else {
+      return (static_cast<wider_type>(detail::cordic::HALF_PI_HIGH) << 64) |
+             static_cast<wider_type>(detail::cordic::HALF_PI_LOW);
+    }
+  }
+
+  [[nodiscard]] static constexpr std::uint64_t magnitude(underlying_type raw) noexcept {
+    auto bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(raw));
+    return raw < 0 ? std::uint64_t(0) - bits : bits;
+  }
+
+  /// CORDIC steps for an error below the last fractional bit.
+  [[nodiscard]] static constexpr unsigned iterations() noexcept {
+    return FracBits + 2 < detail::cordic::MAX_ITERATIONS
+               ? FracBits + 2
+               : detail::cordic::MAX_ITERATIONS;
+  }
+
+  [[nodiscard]] static constexpr Fixed from_q61(std::int64_t value) noexcept {
+    constexpr unsigned shift = 61 - FracBits;
+    if constexpr (shift == 0) {
+      return Fixed(static_cast<underlying_type>(value));
+    } else {
+      return Fixed(static_cast<underlying_type>(
+          (value + (std::int64_t(1) << (shift - 1))) >> shift));
+    }
+  }
+
+  /// cos and sin (Q61) of this angle: reduce by the nearest multiple k of
+  /// pi/2, rotate the remainder, then swap and negate by k mod 4.
+  [[nodiscard]] constexpr detail::cordic::SinCos rotated() const noexcept {
+    // The remainder is kept with BITS - 2 extra fractional bits, so the
+    // error of k * pi/2 stays far below the last bit of the angle
+    constexpr unsigned extra = BITS - 2;
+    constexpr auto two_over_pi = static_cast<wider_type>(
+        BITS == 32 ? detail::cordic::TWO_OVER_PI_Q30
+                   : detail::cordic::TWO_OVER_PI_Q62);
+    wider_type k = round_shift(static_cast<wider_type>(m_raw) * two_over_pi,
+                               FracBits + extra);
+    wider_type half_pi = round_shift(half_pi_wide(), BITS - 1 - FracBits);
+    wider_type rest = (static_cast<wider_type>(m_raw) << extra) - k * half_pi;
+
+    std::int64_t angle;
+    if constexpr (FracBits + extra <= 61) {
+      angle = static_cast<std::int64_t>(rest << (61 - FracBits - extra));
+    } else {
+      angle = static_cast<std::int64_t>(rest >> (FracBits + extra - 61));
+    }
+    auto [c, s] = detail::cordic::rotate(angle, iterations());
+    switch (static_cast<unsigned>(k) & 3) {
+    case 1:
+      return {-s, c};
+    case 2:
+      return {-c, -s};
+    case 3:
+      return {s, -c};
+    default:
+      return {c, s};
+    }
+  }
+
+  underlying_type m_raw;
+};
+
+/// 16.16 and 32.32 formats. Q32_32 needs __int128 (not MSVC).
+using Q16_16 = Fixed<i32, 16>;
+#if PULGACPP_HAS_INT128
+using Q32_32 = Fixed<i64, 32>;
+#endif
+
+} // namespace pulgacpp
+
+// std::hash specialization for unordered containers
+template <pulgacpp::detail::FixedBase S, unsigned FracBits>
+struct std::hash<pulgacpp::Fixed<S, FracBits>> {
+  [[nodiscard]] std::size_t
+  operator()(pulgacpp::Fixed<S, FracBits> value) const noexcept {
+    return std::hash<typename S::underlying_type>{}(value.get());
+  }
+};
+
+#endif // PULGACPP_FIXED_HPP
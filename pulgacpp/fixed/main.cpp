@@ -0,0 +1,264 @@
+// Test program for pulgacpp::Fixed
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_fixed
+
+#include "fixed.hpp"
+#include "../geometry/circle.hpp"
+#include "../geometry/point.hpp"
+#include "../geometry/vector2.hpp"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+template <typename F> F q(double value) {
+    return F::from_double(value).unwrap();
+}
+
+/// Raw values spread over the whole range, plus the edges.
+template <typename F> std::vector<F> samples(unsigned seed) {
+    using T = typename F::underlying_type;
+    std::vector<F> values = {F(), F::one(), F::from_bits(1), F::from_bits(-1), F::from_bits(F::MAX),
+                             F::from_bits(F::MIN), F::from_bits(T(F::MIN + 1))};
+    std::mt19937_64 rng(seed);
+    for (int i = 0; i < 2000; ++i) {
+        unsigned bits = static_cast<unsigned>(rng() % F::BITS) + 1;
+        auto raw = static_cast<T>(rng() >> (64 - bits));
+        values.push_back(F::from_bits(rng() & 1 ? raw : T(-raw)));
+    }
+    return values;
+}
+
+/// checked_mul, saturating_mul and checked_div against wide references.
+template <typename F> bool arithmetic_matches(unsigned seed) {
+    using W = typename F::wider_type;
+    for (F a : samples<F>(seed)) {
+        for (F b : samples<F>(seed + 1)) {
+            W full = W(a.get()) * b.get();
+            W rounded = (full + (W(1) << (F::FRAC_BITS - 1))) >> F::FRAC_BITS;
+            bool fits = rounded >= F::MIN && rounded <= F::MAX;
+            auto product = a.checked_mul(b);
+            if (product.is_some() != fits || (fits && product.unwrap().get() != rounded)) {
+                return false;
+            }
+            if (a.saturating_mul(b).get() != (fits ? rounded : rounded < 0 ? F::MIN : F::MAX)) {
+                return false;
+            }
+            if (b.is_zero()) {
+                continue;
+            }
+            W quotient = (W(a.get()) << F::FRAC_BITS) / b.get();
+            fits = quotient >= F::MIN && quotient <= F::MAX;
+            auto result = a.checked_div(b);
+            if (result.is_some() != fits || (fits && result.unwrap().get() != quotient)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// sqrt(x) is the largest r with r^2 <= x, compared exactly in raw units.
+template <typename F> bool sqrt_exact(unsigned seed) {
+    using U = detail::make_unsigned_int_t<typename F::wider_type>;
+    for (F x : samples<F>(seed)) {
+        auto root = x.sqrt();
+        if (x.is_negative()) {
+            if (root.is_some()) {
+                return false;
+            }
+            continue;
+        }
+        U r = static_cast<U>(root.unwrap().get());
+        U n = static_cast<U>(x.get()) << F::FRAC_BITS;
+        if (r * r > n || (r + 1) * (r + 1) <= n) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Largest error of sin, cos and atan2 against <cmath>, in units of the
+/// last fractional bit.
+template <typename F> double trig_error(unsigned seed, double range) {
+    double ulp = std::ldexp(1.0, -int(F::FRAC_BITS));
+    double worst = 0;
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> angle(-range, range);
+    for (int i = 0; i < 20000; ++i) {
+        F a = q<F>(angle(rng));
+        long double x = static_cast<long double>(a.get()) / std::ldexp(1.0L, int(F::FRAC_BITS));
+        auto [s, c] = a.sin_cos();
+        worst = std::max(worst, double(std::fabs(s.to_double() - std::sin(x))) / ulp);
+        worst = std::max(worst, double(std::fabs(c.to_double() - std::cos(x))) / ulp);
+        if (s != a.sin() || c != a.cos()) {
+            return 1e9;
+        }
+        F y = q<F>(angle(rng)), z = q<F>(angle(rng));
+        if (!y.is_zero() || !z.is_zero()) {
+            double expected = std::atan2(y.to_double(), z.to_double());
+            worst = std::max(worst, std::fabs(F::atan2(y, z).to_double() - expected) / ulp);
+        }
+    }
+    return worst;
+}
+
+int main() {
+    std::cout << "=== pulgacpp::Fixed Test Suite ===\n\n";
+
+    // --- Construction ---
+    std::cout << "--- Construction ---\n";
+    {
+        test(Q16_16().get() == 0 && Q16_16::one().get() == 65536, "zero and one()");
+        test(Q16_16::from(3).unwrap().get() == 3 * 65536, "from(int)");
+        test(Q16_16::from(-32768).unwrap().get() == Q16_16::MIN, "from() at the bottom of the range");
+        test(Q16_16::from(32768).is_none(), "from() out of range is None");
+        test(Q16_16::from(std::int64_t{1} << 40).is_none(), "from() a value that does not fit in S");
+        test(Q16_16::from_ratio(3_i32, 2_i32).unwrap() == q<Q16_16>(1.5), "from_ratio(3, 2) = 1.5");
+        test(Q16_16::from_ratio(i32(-1), 3_i32).unwrap().get() == -21845, "from_ratio truncates towards zero");
+        test(Q16_16::from_ratio(1_i32, 0_i32).is_none(), "from_ratio by zero is None");
+        test(Q16_16::from_double(0.25).unwrap().get() == 16384, "from_double exact");
+        test(Q16_16::from_double(1.0 / 3).unwrap().get() == 21845 &&
+                 Q16_16::from_double(-2.0 / 3).unwrap().get() == -43691,
+             "from_double rounds to nearest");
+        test(Q16_16::from_double(32768.0).is_none() && Q16_16::from_double(NAN).is_none() &&
+                 Q16_16::from_double(INFINITY).is_none(),
+             "from_double rejects out of range and NaN");
+        test(Q16_16::from_double(-32768.0).unwrap().get() == Q16_16::MIN, "from_double(-32768)");
+
+        test(q<Q16_16>(-2.5).to_int() == i32(-3) && q<Q16_16>(2.5).to_int() == 2_i32, "to_int floors");
+        test(q<Q16_16>(-2.5).floor() == q<Q16_16>(-3.0), "floor()");
+        test(q<Q16_16>(1.75).to_double() == 1.75, "to_double");
+        test(Q16_16::pi().get() == 205887 && Q16_16::half_pi().get() == 102944 &&
+                 Q16_16::tau().get() == 411775,
+             "pi, pi/2 and tau rounded to nearest");
+        test(Q32_32::pi().get() == 13493037705ll, "Q32_32::pi()");
+        test(Fixed<i64, 61>::half_pi().get() == std::int64_t(detail::cordic::HALF_PI_HIGH),
+             "half_pi() with 61 fractional bits");
+    }
+
+    // --- Arithmetic ---
+    std::cout << "\n--- Arithmetic ---\n";
+    {
+        Q16_16 a = q<Q16_16>(1.5), b = q<Q16_16>(-2.25);
+        test(a.checked_add(b).unwrap() == q<Q16_16>(-0.75), "checked_add");
+        test(a.checked_sub(b).unwrap() == q<Q16_16>(3.75), "checked_sub");
+        test(a.checked_mul(b).unwrap() == q<Q16_16>(-3.375), "checked_mul");
+        test(b.checked_div(a).unwrap() == q<Q16_16>(-1.5), "checked_div");
+        test(a.checked_div(Q16_16()).is_none(), "checked_div by zero is None");
+        test(Q16_16::from_bits(1).checked_mul(q<Q16_16>(0.5)).unwrap().get() == 1 &&
+                 Q16_16::from_bits(-1).checked_mul(q<Q16_16>(0.5)).unwrap().get() == 0,
+             "checked_mul rounds half up");
+
+        Q16_16 big = q<Q16_16>(30000.0);
+        test(big.checked_add(big).is_none() && big.checked_mul(big).is_none(), "overflow is None");
+        test(big.saturating_add(big).get() == Q16_16::MAX && big.saturating_mul(b).get() == Q16_16::MIN,
+             "saturating add and mul");
+        test(big.saturating_div(Q16_16()).get() == Q16_16::MAX && Q16_16().saturating_div(Q16_16()).is_zero(),
+             "saturating_div by zero");
+        test(big.wrapping_add(big).get() == static_cast<std::int32_t>(2u * 30000u * 65536u), "wrapping_add");
+        test(Q16_16::from_bits(Q16_16::MIN).checked_neg().is_none() && b.checked_abs().unwrap() == q<Q16_16>(2.25),
+             "checked_neg and checked_abs");
+        test(b.signum() == -1 && a.is_positive() && Q16_16().is_zero(), "sign predicates");
+
+        test(arithmetic_matches<Q16_16>(1), "Q16_16 mul/div match the wide reference");
+        test(arithmetic_matches<Q32_32>(2), "Q32_32 mul/div match the wide reference");
+        test(arithmetic_matches<Fixed<i32, 30>>(3), "Fixed<i32, 30> mul/div match the wide reference");
+        test(arithmetic_matches<Fixed<i64, 1>>(4), "Fixed<i64, 1> mul/div match the wide reference");
+    }
+
+    // --- sqrt ---
+    std::cout << "\n--- sqrt ---\n";
+    {
+        test(q<Q16_16>(2.0).sqrt().unwrap().get() == 92681, "sqrt(2) rounded down");
+        test(q<Q16_16>(6.25).sqrt().unwrap() == q<Q16_16>(2.5), "sqrt of a perfect square is exact");
+        test(q<Q16_16>(-1.0).sqrt().is_none(), "sqrt of a negative value is None");
+        test(Q16_16::from_bits(Q16_16::MAX).sqrt().is_some(), "sqrt(MAX)");
+        test(sqrt_exact<Q16_16>(5), "Q16_16 sqrt is floor(sqrt(x))");
+        test(sqrt_exact<Q32_32>(6), "Q32_32 sqrt is floor(sqrt(x))");
+        test(sqrt_exact<Fixed<i64, 62>>(7), "Fixed<i64, 62> sqrt is floor(sqrt(x))");
+    }
+
+    // --- Trigonometry ---
+    std::cout << "\n--- Trigonometry ---\n";
+    {
+        test(Q16_16().sin().is_zero() && Q16_16().cos() == Q16_16::one(), "sin(0) = 0, cos(0) = 1");
+        test(Q16_16::half_pi().sin() == Q16_16::one() && Q16_16::half_pi().cos().get() == 0,
+             "sin and cos of pi/2");
+        test(Q16_16::atan2(Q16_16::one(), Q16_16()) == Q16_16::half_pi(), "atan2(1, 0) = pi/2");
+        test(Q16_16::atan2(Q16_16(), q<Q16_16>(-1.0)) == Q16_16::pi(), "atan2(0, -1) = pi");
+        test(Q16_16::atan2(Q16_16(), Q16_16()).is_zero(), "atan2(0, 0) = 0");
+        test(trig_error<Q16_16>(8, 32767.0) <= 2.0, "Q16_16 sin/cos/atan2 within 2 ulp over the full range");
+        test(trig_error<Fixed<i32, 28>>(9, 7.9) <= 2.0, "Fixed<i32, 28> sin/cos/atan2 within 2 ulp");
+        test(trig_error<Q32_32>(10, 1e6) <= 2.0, "Q32_32 sin/cos/atan2 within 2 ulp");
+        test(trig_error<Fixed<i64, 48>>(11, 1000.0) <= 16.0, "Fixed<i64, 48> sin/cos within 16 ulp");
+        constexpr auto sc = Q16_16::from_bits(65536).sin_cos();
+        static_assert(sc.first.get() == 55147 && sc.second.get() == 35409);
+        test(true, "constexpr sin_cos(1)");
+    }
+
+    // --- Geometry ---
+    std::cout << "\n--- Geometry ---\n";
+    {
+        auto p = Point<Q16_16>::from(q<Q16_16>(1.5), q<Q16_16>(-2.0));
+        auto moved = p.checked_translate(q<Q16_16>(0.25), q<Q16_16>(0.5)).unwrap();
+        test(moved == Point<Q16_16>::from(q<Q16_16>(1.75), q<Q16_16>(-1.5)), "Point<Q16_16> translate");
+        test(p.checked_scale(q<Q16_16>(2.0)).unwrap().x() == q<Q16_16>(3.0), "Point<Q16_16> scale");
+        test(Point<Q16_16>::from(q<Q16_16>(3.0), q<Q16_16>(4.0)).magnitude() == 5.0,
+             "Point<Q16_16> magnitude uses the real value");
+        test(Point<Q16_16>::from(Q16_16::from_bits(Q16_16::MAX), Q16_16())
+                 .checked_translate(Q16_16::one(), Q16_16())
+                 .is_none(),
+             "Point<Q16_16> translate overflow is None");
+
+        auto v = Vector2<Q32_32>::from(q<Q32_32>(0.5), q<Q32_32>(0.25));
+        test(v.checked_add(v).unwrap() == Vector2<Q32_32>::from(q<Q32_32>(1.0), q<Q32_32>(0.5)),
+             "Vector2<Q32_32> add");
+        test(v.dot(v) == 0.3125, "Vector2<Q32_32> dot");
+
+        auto c = Circle<Q16_16>::from(p, q<Q16_16>(2.0)).unwrap();
+        test(c.checked_scale(q<Q16_16>(1.5)).unwrap().radius() == q<Q16_16>(3.0), "Circle<Q16_16> scale");
+        test(Circle<Q16_16>::from(p, q<Q16_16>(-1.0)).is_none(), "Circle<Q16_16> rejects a negative radius");
+        test(c.checked_scale(q<Q16_16>(20000.0)).is_none(), "Circle<Q16_16> scale overflow is None");
+        test(!Integral<Q16_16> && Integral<i32>, "Fixed is not Integral");
+    }
+
+    // --- Traits ---
+    std::cout << "\n--- Traits ---\n";
+    {
+        test(sizeof(Q16_16) == 4 && sizeof(Q32_32) == 8, "Fixed is the size of its raw value");
+        std::unordered_set<Q16_16> seen{q<Q16_16>(0.5), Q16_16::from_bits(32768)};
+        test(seen.size() == 1, "unordered_set<Fixed>");
+        std::ostringstream os;
+        os << q<Q16_16>(-1.25);
+        test(os.str() == "-1.25", "operator<< prints the value");
+        test(q<Q16_16>(0.5) < q<Q16_16>(0.75) && q<Q16_16>(-1.0) < Q16_16(), "comparison");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
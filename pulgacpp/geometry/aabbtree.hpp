@@ -0,0 +1,519 @@
+// pulgacpp::DynamicAabbTree - Bounding volume hierarchy for moving boxes
+// SPDX-License-Identifier: MIT
+//
+// Testing every pair of n boxes with Box::intersects is O(n²).
+// DynamicAabbTree keeps Box<double> colliders as the leaves of a binary
+// tree whose inner nodes hold the union (Box::merged_with) of their
+// children, so overlap, point and ray queries skip every subtree whose box
+// they miss.
+//
+// Leaves store a "fat" box: the collider grown by a margin, plus the
+// displacement passed to update(). A move that stays inside the fat box
+// (Box::contains_box) only records the new box; one that escapes removes
+// the leaf and inserts it again. Queries and pairs test the exact boxes,
+// so fattening never adds results.
+//
+// Insertion picks the sibling that adds the least surface area to the
+// tree (Box::surface_area, the surface area heuristic) with a
+// branch-and-bound search. Every ancestor it refits is then rotated if
+// swapping a child with a grandchild shrinks the tree, which keeps it
+// shallow whatever order boxes arrive in.
+//
+// Usage:
+//   #include <pulgacpp/geometry/aabbtree.hpp>
+//
+//   auto tree = DynamicAabbTree::from(0.1).unwrap(); // margin
+//   auto id = tree.insert(collider);
+//   tree.update(id, moved, displacement);
+//   tree.for_each_overlapping_pair([](auto a, auto b) { resolve(a, b); });
+//   auto hit = tree.ray_cast(eye, direction, 100.0);
+
+#ifndef PULGACPP_GEOMETRY_AABBTREE_HPP
+#define PULGACPP_GEOMETRY_AABBTREE_HPP
+
+#include "box.hpp"
+#include "ray.hpp"
+#include "shape.hpp"
+#include "vector3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace pulgacpp {
+
+/// A set of boxes, each with a stable id, kept in a dynamic bounding volume
+/// hierarchy.
+class DynamicAabbTree {
+public:
+  using value_type = Box<double>;
+  /// Handle returned by insert(); reused after remove()
+  using Id = std::uint32_t;
+  static constexpr std::string_view NAME = "DynamicAabbTree";
+
+  /// A ray hitting a box: it enters at origin + t * direction
+  struct Hit {
+    Id id;
+    double t;
+
+    [[nodiscard]] constexpr bool operator==(const Hit &other) const noexcept = default;
+  };
+
+private:
+  static constexpr std::uint32_t NO_NODE = std::numeric_limits<std::uint32_t>::max();
+
+  /// One cache line per node
+  struct Node {
+    Box<double> box;      // Fat box for leaves, union of the children otherwise
+    std::uint32_t parent; // Next free node while on the free list
+    std::uint32_t left;   // NO_NODE for leaves
+    std::uint32_t right;
+    std::int32_t height; // 0 for leaves, -1 for free nodes
+  };
+
+  double m_margin;
+  std::uint32_t m_root = NO_NODE;
+  std::uint32_t m_free = NO_NODE; // Head of the free list, through Node::parent
+  std::size_t m_size = 0;
+  std::vector<Node> m_nodes;
+  std::vector<Box<double>> m_boxes; // Exact box of each leaf, by node index
+  std::vector<std::pair<double, std::uint32_t>> m_candidates; // insert() scratch
+
+  explicit DynamicAabbTree(double margin) noexcept : m_margin(margin) {}
+
+  [[nodiscard]] static Box<double> fatten(const Box<double> &box, Vector3<double> displacement,
+                                          double margin) noexcept {
+    // Grown by margin on every side and by the displacement on the side
+    // it points to
+    double dx = displacement.x(), dy = displacement.y(), dz = displacement.z();
+    return Box<double>::from_points(
+        Vec3d::from(box.min().x() - margin + std::min(dx, 0.0),
+                    box.min().y() - margin + std::min(dy, 0.0),
+                    box.min().z() - margin + std::min(dz, 0.0)),
+        Vec3d::from(box.max().x() + margin + std::max(dx, 0.0),
+                    box.max().y() + margin + std::max(dy, 0.0),
+                    box.max().z() + margin + std::max(dz, 0.0)));
+  }
+
+  [[nodiscard]] std::uint32_t allocate() {
+    if (m_free == NO_NODE) {
+      m_nodes.push_back(Node{Box<double>::unit(), NO_NODE, NO_NODE, NO_NODE, 0});
+      m_boxes.push_back(Box<double>::unit());
+      return std::uint32_t(m_nodes.size() - 1);
+    }
+    std::uint32_t node = m_free;
+    m_free = m_nodes[node].parent;
+    return node;
+  }
+
+  void release(std::uint32_t node) noexcept {
+    m_nodes[node].parent = m_free;
+    m_nodes[node].height = -1;
+    m_free = node;
+  }
+
+  void check_id(Id id) const noexcept {
+    if (!contains(id)) {
+      panic("aabb tree: unknown id");
+    }
+  }
+
+  /// Point parent (or the root, for NO_NODE) at `to` instead of `from`
+  void replace_child(std::uint32_t parent, std::uint32_t from, std::uint32_t to) noexcept {
+    if (parent == NO_NODE) {
+      m_root = to;
+    } else if (m_nodes[parent].left == from) {
+      m_nodes[parent].left = to;
+    } else {
+      m_nodes[parent].right = to;
+    }
+  }
+
+  void refit_node(std::uint32_t node) noexcept {
+    Node &n = m_nodes[node];
+    const Node &l = m_nodes[n.left];
+    const Node &r = m_nodes[n.right];
+    n.box = l.box.merged_with(r.box);
+    n.height = 1 + std::max(l.height, r.height);
+  }
+
+  /// Surface area that box adds to `node` by joining it
+  [[nodiscard]] double growth(const Box<double> &box, std::uint32_t node) const noexcept {
+    const Box<double> &b = m_nodes[node].box;
+    return box.merged_with(b).surface_area() - b.surface_area();
+  }
+
+  /// Branch and bound over the tree for the node whose union with box adds
+  /// the least surface area, counting the growth of every ancestor.
+  [[nodiscard]] std::uint32_t best_sibling(const Box<double> &box) {
+    const double box_area = box.surface_area();
+    std::uint32_t best = m_root;
+    double best_cost = std::numeric_limits<double>::infinity();
+    // (growth of the ancestors, node). Depth first with the child that
+    // grows least on top finds a good bound early, and is cheaper than a
+    // priority queue.
+    auto &stack = m_candidates;
+    stack.clear();
+    stack.emplace_back(0.0, m_root);
+    while (!stack.empty()) {
+      auto [inherited, node] = stack.back();
+      stack.pop_back();
+      if (inherited + box_area >= best_cost) {
+        continue; // Nothing below can beat best: it costs at least this much
+      }
+      const Node &n = m_nodes[node];
+      double merged = box.merged_with(n.box).surface_area();
+      if (merged + inherited < best_cost) {
+        best_cost = merged + inherited;
+        best = node;
+      }
+      double below = inherited + merged - n.box.surface_area();
+      if (n.height > 0 && below + box_area < best_cost) {
+        bool left_first = growth(box, n.left) < growth(box, n.right);
+        stack.emplace_back(below, left_first ? n.right : n.left);
+        stack.emplace_back(below, left_first ? n.left : n.right);
+      }
+    }
+    return best;
+  }
+
+  /// Swap a child of `node` with the grandchild on the other side if that
+  /// shrinks the child it moves into.
+  void rotate(std::uint32_t node) noexcept {
+    const Node &n = m_nodes[node];
+    double best_gain = 0.0;
+    std::uint32_t up = NO_NODE;   // Grandchild that moves up
+    std::uint32_t down = NO_NODE; // Child that takes its place
+    auto consider = [&](std::uint32_t child, std::uint32_t other) {
+      const Node &o = m_nodes[other];
+      if (o.height == 0) {
+        return;
+      }
+      const Box<double> &moved = m_nodes[child].box;
+      double area = o.box.surface_area();
+      double gain_left = area - moved.merged_with(m_nodes[o.right].box).surface_area();
+      double gain_right = area - moved.merged_with(m_nodes[o.left].box).surface_area();
+      if (gain_left > best_gain) {
+        best_gain = gain_left;
+        up = o.left;
+        down = child;
+      }
+      if (gain_right > best_gain) {
+        best_gain = gain_right;
+        up = o.right;
+        down = child;
+      }
+    };
+    consider(n.left, n.right);
+    consider(n.right, n.left);
+    if (up == NO_NODE) {
+      return;
+    }
+    std::uint32_t other = m_nodes[up].parent;
+    replace_child(node, down, up);
+    replace_child(other, up, down);
+    m_nodes[up].parent = node;
+    m_nodes[down].parent = other;
+    refit_node(other);
+  }
+
+  /// Rotate and refit node and its ancestors, up to the first one that
+  /// comes out unchanged: everything above it is unchanged too
+  void refit(std::uint32_t node) noexcept {
+    while (node != NO_NODE) {
+      rotate(node);
+      const Box<double> box = m_nodes[node].box;
+      const std::int32_t height = m_nodes[node].height;
+      refit_node(node);
+      if (m_nodes[node].box == box && m_nodes[node].height == height) {
+        return;
+      }
+      node = m_nodes[node].parent;
+    }
+  }
+
+  void insert_leaf(std::uint32_t leaf) {
+    if (m_root == NO_NODE) {
+      m_root = leaf;
+      m_nodes[leaf].parent = NO_NODE;
+      return;
+    }
+    const Box<double> box = m_nodes[leaf].box;
+    std::uint32_t sibling = best_sibling(box);
+    std::uint32_t parent = allocate();
+    std::uint32_t grandparent = m_nodes[sibling].parent;
+    m_nodes[parent] = Node{box, grandparent, sibling, leaf, 0};
+    replace_child(grandparent, sibling, parent);
+    m_nodes[sibling].parent = parent;
+    m_nodes[leaf].parent = parent;
+    refit(parent);
+  }
+
+  void remove_leaf(std::uint32_t leaf) noexcept {
+    if (leaf == m_root) {
+      m_root = NO_NODE;
+      return;
+    }
+    std::uint32_t parent = m_nodes[leaf].parent;
+    std::uint32_t grandparent = m_nodes[parent].parent;
+    const Node &p = m_nodes[parent];
+    std::uint32_t sibling = p.left == leaf ? p.right : p.left;
+    replace_child(grandparent, parent, sibling);
+    m_nodes[sibling].parent = grandparent;
+    release(parent);
+    refit(grandparent);
+  }
+
+  /// Call f(id) for every leaf whose fat box and exact box pass `hits`,
+  /// skipping subtrees whose box fails it
+  template <typename Hits, typename F> void descend(Hits &&hits, F &&f) const {
+    if (m_root == NO_NODE) {
+      return;
+    }
+    detail::TraversalStack stack;
+    stack.push(m_root);
+    while (!stack.is_empty()) {
+      std::uint32_t node = stack.pop();
+      const Node &n = m_nodes[node];
+      if (!hits(n.box)) {
+        continue;
+      }
+      if (n.height > 0) {
+        stack.push(n.left);
+        stack.push(n.right);
+      } else if (hits(m_boxes[node])) {
+        f(Id(node));
+      }
+    }
+  }
+
+public:
+  // ==================== Construction ====================
+
+  /// Factory: empty tree whose leaves are fattened by `margin` on every side
+  /// Returns None unless margin is finite and not negative
+  [[nodiscard]] static Optional<DynamicAabbTree> from(double margin) {
+    if (!(margin >= 0.0) || !std::isfinite(margin)) {
+      return None;
+    }
+    return Some(DynamicAabbTree(margin));
+  }
+
+  // ==================== Accessors ====================
+
+  [[nodiscard]] double margin() const noexcept { return m_margin; }
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+  [[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+
+  /// Edges from the root to the deepest leaf (0 for zero or one box)
+  [[nodiscard]] std::size_t height() const noexcept {
+    return m_root == NO_NODE ? 0 : std::size_t(m_nodes[m_root].height);
+  }
+
+  /// Whether id refers to a box currently in the tree
+  [[nodiscard]] bool contains(Id id) const noexcept {
+    return id < m_nodes.size() && m_nodes[id].height == 0;
+  }
+
+  /// The box stored under id (panics if id is not in the tree)
+  [[nodiscard]] Box<double> get(Id id) const noexcept {
+    check_id(id);
+    return m_boxes[id];
+  }
+
+  /// The fat box the tree keeps for id (panics if id is not in the tree)
+  [[nodiscard]] Box<double> fat_box(Id id) const noexcept {
+    check_id(id);
+    return m_nodes[id].box;
+  }
+
+  // ==================== Modification ====================
+
+  /// Add a box and return its id
+  Id insert(Box<double> box) {
+    std::uint32_t leaf = allocate();
+    m_nodes[leaf] = Node{fatten(box, Vec3d::zero(), m_margin), NO_NODE, NO_NODE, NO_NODE, 0};
+    m_boxes[leaf] = box;
+    insert_leaf(leaf);
+    ++m_size;
+    return Id(leaf);
+  }
+
+  /// Replace the box stored under id (panics if id is not in the tree).
+  /// `displacement` is how far the box is expected to move next, e.g.
+  /// velocity × a few frames: the fat box is stretched that way so the
+  /// following updates stay inside it. Returns whether the leaf had to be
+  /// reinserted.
+  bool update(Id id, Box<double> box, Vector3<double> displacement = Vec3d::zero()) {
+    check_id(id);
+    m_boxes[id] = box;
+    const Box<double> &fat = m_nodes[id].box;
+    // Keep the fat box while it holds the new box and is not far larger
+    // than a fresh one would be (a fast object that stopped)
+    if (fat.contains_box(box) && fatten(box, displacement, 5.0 * m_margin).contains_box(fat)) {
+      return false;
+    }
+    remove_leaf(id);
+    m_nodes[id].box = fatten(box, displacement, m_margin);
+    insert_leaf(id);
+    return true;
+  }
+
+  /// Remove the box stored under id (panics if id is not in the tree)
+  void remove(Id id) {
+    check_id(id);
+    remove_leaf(id);
+    release(id);
+    --m_size;
+  }
+
+  /// Remove every box and forget all ids
+  void clear() noexcept {
+    m_nodes.clear();
+    m_boxes.clear();
+    m_root = NO_NODE;
+    m_free = NO_NODE;
+    m_size = 0;
+  }
+
+  // ==================== Queries ====================
+
+  /// Call f(id) for every box that intersects `area` (Box::intersects)
+  template <typename F> void for_each_overlapping(const Box<double> &area, F &&f) const {
+    descend([&area](const Box<double> &box) { return box.intersects(area); }, f);
+  }
+
+  /// Ids of the boxes that intersect `area`
+  [[nodiscard]] std::vector<Id> overlapping(const Box<double> &area) const {
+    std::vector<Id> ids;
+    for_each_overlapping(area, [&ids](Id id) { ids.push_back(id); });
+    return ids;
+  }
+
+  /// Call f(id) for every box that contains `point` (Box::contains)
+  template <typename F> void for_each_containing(Vector3<double> point, F &&f) const {
+    descend([point](const Box<double> &box) { return box.contains(point); }, f);
+  }
+
+  /// Ids of the boxes that contain `point`
+  [[nodiscard]] std::vector<Id> containing(Vector3<double> point) const {
+    std::vector<Id> ids;
+    for_each_containing(point, [&ids](Id id) { ids.push_back(id); });
+    return ids;
+  }
+
+  /// Call f(id, t) for every box hit by origin + t * direction with t in
+  /// [0, max_t], where t is where the ray enters the box (0 if it starts
+  /// inside). Boxes come in no particular order.
+  template <typename F>
+  void for_each_ray_hit(Vector3<double> origin, Vector3<double> direction, double max_t,
+                        F &&f) const {
+    const detail::RaySegment segment(origin, direction, max_t);
+    double t = 0.0; // Set by the exact box test just before each f()
+    descend([&](const Box<double> &box) { return segment.enters(box, t); },
+            [&](Id id) { f(id, t); });
+  }
+
+  /// The first box hit by origin + t * direction with t in [0, max_t]
+  /// (None if nothing is hit)
+  [[nodiscard]] Optional<Hit> ray_cast(Vector3<double> origin, Vector3<double> direction,
+                                       double max_t) const {
+    if (m_root == NO_NODE) {
+      return None;
+    }
+    detail::RaySegment segment(origin, direction, max_t);
+    Optional<Hit> best = None;
+    detail::TraversalStack stack;
+    stack.push(m_root);
+    while (!stack.is_empty()) {
+      std::uint32_t node = stack.pop();
+      const Node &n = m_nodes[node];
+      double t;
+      // max_t shrinks to the nearest hit so far, pruning farther boxes
+      if (!segment.enters(n.box, t)) {
+        continue;
+      }
+      if (n.height == 0) {
+        if (segment.enters(m_boxes[node], t) && (best.is_none() || t < segment.max_t)) {
+          best = Some(Hit{Id(node), t});
+          segment.max_t = t;
+        }
+        continue;
+      }
+      // Nearer child on top, so its hits can prune the other
+      double t_left = 0.0, t_right = 0.0;
+      bool left = segment.enters(m_nodes[n.left].box, t_left);
+      bool right = segment.enters(m_nodes[n.right].box, t_right);
+      if (left && right && t_left < t_right) {
+        stack.push(n.right);
+        stack.push(n.left);
+      } else {
+        if (left) stack.push(n.left);
+        if (right) stack.push(n.right);
+      }
+    }
+    return best;
+  }
+
+  /// ray_cast() along a Ray
+  [[nodiscard]] Optional<Hit> ray_cast(const Rayd &ray, double max_t) const {
+    return ray_cast(ray.origin(), ray.direction(), max_t);
+  }
+
+  /// Call f(a, b) once for every pair of intersecting boxes, with a < b
+  template <typename F> void for_each_overlapping_pair(F &&f) const {
+    if (m_root == NO_NODE) {
+      return;
+    }
+    // A pair of equal nodes stands for the pairs within one subtree
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> stack = {{m_root, m_root}};
+    while (!stack.empty()) {
+      auto [a, b] = stack.back();
+      stack.pop_back();
+      const Node &na = m_nodes[a];
+      if (a == b) {
+        if (na.height > 0) {
+          stack.emplace_back(na.left, na.left);
+          stack.emplace_back(na.right, na.right);
+          stack.emplace_back(na.left, na.right);
+        }
+        continue;
+      }
+      const Node &nb = m_nodes[b];
+      if (!na.box.intersects(nb.box)) {
+        continue;
+      }
+      if (na.height == 0 && nb.height == 0) {
+        if (m_boxes[a].intersects(m_boxes[b])) {
+          f(Id(std::min(a, b)), Id(std::max(a, b)));
+        }
+        continue;
+      }
+      // Split the larger node; leaves cannot be split
+      if (nb.height == 0 || (na.height > 0 && na.box.surface_area() >= nb.box.surface_area())) {
+        stack.emplace_back(na.left, b);
+        stack.emplace_back(na.right, b);
+      } else {
+        stack.emplace_back(a, nb.left);
+        stack.emplace_back(a, nb.right);
+      }
+    }
+  }
+
+  /// Every pair of intersecting boxes, with a < b
+  [[nodiscard]] std::vector<SpatialPair> overlapping_pairs() const {
+    std::vector<SpatialPair> pairs;
+    for_each_overlapping_pair([&pairs](Id a, Id b) { pairs.push_back(SpatialPair{a, b}); });
+    return pairs;
+  }
+};
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_GEOMETRY_AABBTREE_HPP
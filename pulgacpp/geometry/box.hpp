@@ -9,7 +9,9 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <ostream>
+#include <vector>
 
 
 namespace pulgacpp {
@@ -391,6 +393,82 @@ bounding_box(const std::array<Vector3<T>, N> &points) noexcept {
                              Vector3<T>::from(max_x, max_y, max_z));
 }
 
+namespace detail {
+
+/// Depth-first traversal stack for box hierarchies: trees less than 64
+/// deep never allocate
+class TraversalStack {
+  std::array<std::uint32_t, 64> m_inline;
+  std::vector<std::uint32_t> m_spill;
+  std::size_t m_size = 0;
+
+public:
+  void push(std::uint32_t node) {
+    if (m_size < m_inline.size()) {
+      m_inline[m_size] = node;
+    } else {
+      m_spill.push_back(node);
+    }
+    ++m_size;
+  }
+
+  [[nodiscard]] std::uint32_t pop() noexcept {
+    --m_size;
+    if (m_size < m_inline.size()) {
+      return m_inline[m_size];
+    }
+    std::uint32_t node = m_spill.back();
+    m_spill.pop_back();
+    return node;
+  }
+
+  [[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+};
+
+/// The part of a ray from t = 0 to max_t, set up for slab tests against
+/// axis-aligned boxes (the ray queries of DynamicAabbTree and StaticBvh)
+struct RaySegment {
+  std::array<double, 3> origin;
+  std::array<double, 3> direction;
+  std::array<double, 3> inv_direction;
+  double max_t;
+
+  RaySegment(Vector3<double> o, Vector3<double> d, double t) noexcept
+      : origin{o.x(), o.y(), o.z()}, direction{d.x(), d.y(), d.z()},
+        inv_direction{1.0 / d.x(), 1.0 / d.y(), 1.0 / d.z()}, max_t(t) {}
+
+  /// Whether the segment meets the box lo..hi; t is where it enters (0 if
+  /// it starts inside). Rounding is monotonic, so a box that contains
+  /// another is entered no later than it.
+  [[nodiscard]] bool enters(const std::array<double, 3> &lo, const std::array<double, 3> &hi,
+                            double &t) const noexcept {
+    double t0 = 0.0;
+    double t1 = max_t;
+    for (std::size_t k = 0; k < 3; ++k) {
+      if (direction[k] == 0.0) {
+        // Parallel to this slab: inside it for every t or never
+        if (origin[k] < lo[k] || origin[k] > hi[k]) {
+          return false;
+        }
+        continue;
+      }
+      double a = (lo[k] - origin[k]) * inv_direction[k];
+      double b = (hi[k] - origin[k]) * inv_direction[k];
+      t0 = std::max(t0, std::min(a, b));
+      t1 = std::min(t1, std::max(a, b));
+    }
+    t = t0;
+    return t0 <= t1;
+  }
+
+  [[nodiscard]] bool enters(const Box<double> &box, double &t) const noexcept {
+    return enters({box.min().x(), box.min().y(), box.min().z()},
+                  {box.max().x(), box.max().y(), box.max().z()}, t);
+  }
+};
+
+} // namespace detail
+
 // Type aliases
 using Boxi = Box<int>;
 using Boxf = Box<float>;
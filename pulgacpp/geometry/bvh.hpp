@@ -0,0 +1,1100 @@
+// pulgacpp::StaticBvh - Bounding volume hierarchy built once for static scenes
+// SPDX-License-Identifier: MIT
+//
+// DynamicAabbTree inserts boxes one at a time, which suits moving objects
+// but takes far too long for millions of static ones. StaticBvh<Width> is
+// built from all of them in one pass:
+//
+// - Binned SAH: each node drops its primitives' centroids into 16 bins per
+//   axis and takes the split between bins with the lowest surface area
+//   cost (Box::surface_area of each side times its primitive count), which
+//   is O(n) per level instead of a sort.
+// - Parallel: the top levels build their two halves on separate threads,
+//   and split their bounds and binning passes across the threads they
+//   own. The result is the same for any thread count.
+// - Flat: nodes sit depth first in one array, bounds as floats rounded
+//   outwards. Binary nodes (Width 2, BvhNode) are 32 bytes, two per cache
+//   line, and a node's first child is the next node. Width 4 and 8 collapse
+//   the binary tree into WideBvhNode, which keeps the bounds of 4 or 8
+//   children side by side so one step tests them all in a loop the
+//   compiler can vectorize.
+//
+// A StaticBvh is one contiguous byte image: header, nodes, the primitive
+// boxes in leaf order and their ids. to_bytes() returns it for writing to a
+// file; from_bytes() checks an image, typically a memory-mapped file, and
+// queries it in place without copying.
+//
+// Rays can also be cast a RayPacket at a time: the packet walks the tree
+// together, testing each node once for all of its rays.
+//
+// Usage:
+//   #include <pulgacpp/geometry/bvh.hpp>
+//
+//   auto bvh = Bvh4::from(boxes); // std::span<const Box<double>>
+//   auto hit = bvh.ray_cast(eye, direction, 1e9);
+//   auto hits = bvh.ray_cast(RayPacket<double, 4>::from(rays), max_t);
+//   file.write(bvh.to_bytes());
+//   ...
+//   auto loaded = Bvh4::from_bytes(mapped_bytes).expect("a Bvh4 image");
+
+#ifndef PULGACPP_GEOMETRY_BVH_HPP
+#define PULGACPP_GEOMETRY_BVH_HPP
+
+#include "box.hpp"
+#include "ray.hpp"
+#include "shape.hpp"
+#include "sphere.hpp"
+#include "vector3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pulgacpp {
+
+/// How StaticBvh::from() builds. Out-of-range values are clamped.
+struct BvhBuildOptions {
+  /// Threads to build on; 0 uses std::thread::hardware_concurrency()
+  unsigned threads = 0;
+  /// Most primitives in a leaf (1-255)
+  unsigned max_leaf_size = 4;
+  /// Centroid bins per axis for the SAH (2-64)
+  unsigned bins = 16;
+};
+
+/// A node of a binary StaticBvh: 32 bytes, two per cache line.
+struct BvhNode {
+  std::array<float, 3> min; // Bounds, rounded outwards
+  std::array<float, 3> max;
+  std::uint32_t index; // Leaf: first primitive. Inner: second child (the first is the next node)
+  std::uint16_t count; // Primitives in a leaf; 0 for inner nodes
+  std::uint8_t axis;   // Inner: axis of the split, for front-to-back ray order
+  std::uint8_t reserved;
+};
+static_assert(sizeof(BvhNode) == 32);
+
+/// A node of a 4- or 8-wide StaticBvh: the bounds of every child, one lane
+/// per child.
+template <std::size_t Width> struct WideBvhNode {
+  static constexpr std::uint32_t EMPTY = std::numeric_limits<std::uint32_t>::max();
+
+  std::array<float, Width> min_x, min_y, min_z; // Bounds, rounded outwards
+  std::array<float, Width> max_x, max_y, max_z;
+  std::array<std::uint32_t, Width> index; // Inner child: node. Leaf: first primitive. Unused: EMPTY
+  std::array<std::uint32_t, Width> count; // Primitives in a leaf child; 0 otherwise
+};
+static_assert(sizeof(WideBvhNode<4>) == 128 && sizeof(WideBvhNode<8>) == 256);
+
+namespace detail {
+
+/// Bounds of a primitive as stored in a StaticBvh image
+struct BvhBounds {
+  std::array<double, 3> min;
+  std::array<double, 3> max;
+};
+
+/// Start of a StaticBvh image, padded to BVH_HEADER_SIZE bytes
+struct BvhHeader {
+  std::array<char, 8> magic;
+  std::uint32_t byte_order; // BVH_BYTE_ORDER as the writer stored it
+  std::uint32_t version;
+  std::uint32_t width;
+  std::uint32_t node_size;
+  std::uint64_t node_count;
+  std::uint64_t primitive_count;
+  BvhBounds bounds; // Of every primitive
+};
+
+inline constexpr std::array<char, 8> BVH_MAGIC = {'P', 'U', 'L', 'G', 'B', 'V', 'H', '\0'};
+inline constexpr std::uint32_t BVH_BYTE_ORDER = 0x01020304;
+inline constexpr std::uint32_t BVH_VERSION = 1;
+inline constexpr std::size_t BVH_HEADER_SIZE = 128;
+static_assert(sizeof(BvhHeader) <= BVH_HEADER_SIZE);
+
+/// Largest float <= v
+[[nodiscard]] inline float round_down(double v) noexcept {
+  float f = static_cast<float>(v);
+  return double(f) > v ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+}
+
+/// Smallest float >= v
+[[nodiscard]] inline float round_up(double v) noexcept {
+  float f = static_cast<float>(v);
+  return double(f) < v ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+}
+
+/// Builds the binary hierarchy: nodes depth first, and the order the
+/// primitives take in the leaves.
+class BvhBuilder {
+public:
+  BvhBuilder(std::span<const BvhBounds> bounds, BvhBuildOptions options)
+      : m_threads(std::clamp(options.threads == 0 ? std::thread::hardware_concurrency()
+                                                  : options.threads,
+                             1u, 256u)),
+        m_max_leaf(std::clamp(options.max_leaf_size, 1u, 255u)),
+        m_bins(std::clamp(options.bins, 2u, unsigned(MAX_BINS))) {
+    m_items.reserve(bounds.size());
+    for (std::size_t i = 0; i < bounds.size(); ++i) {
+      m_items.push_back(Item{bounds[i].min, bounds[i].max, std::uint32_t(i)});
+    }
+  }
+
+  [[nodiscard]] std::vector<BvhNode> build() {
+    std::vector<BvhNode> nodes;
+    if (!m_items.empty()) {
+      nodes.reserve(2 * m_items.size() / std::min<std::size_t>(m_max_leaf, 2) + 1);
+      build(nodes, 0, m_items.size(), 0);
+    }
+    return nodes;
+  }
+
+  /// Ids of the primitives in leaf order (after build())
+  [[nodiscard]] std::vector<std::uint32_t> order() const {
+    std::vector<std::uint32_t> ids(m_items.size());
+    for (std::size_t i = 0; i < m_items.size(); ++i) {
+      ids[i] = m_items[i].id;
+    }
+    return ids;
+  }
+
+private:
+  static constexpr std::size_t MAX_BINS = 64;
+  /// Ranges smaller than this are not worth a thread
+  static constexpr std::size_t PARALLEL_MIN = 1 << 14;
+
+  /// A primitive's bounds, copied so partitions move them with the id
+  struct Item {
+    std::array<double, 3> min;
+    std::array<double, 3> max;
+    std::uint32_t id;
+
+    /// Twice the centroid
+    [[nodiscard]] double centre(std::size_t axis) const noexcept { return min[axis] + max[axis]; }
+  };
+
+  struct Extent {
+    std::array<double, 3> lo = {INF, INF, INF};
+    std::array<double, 3> hi = {-INF, -INF, -INF};
+
+    static constexpr double INF = std::numeric_limits<double>::infinity();
+
+    void grow(const std::array<double, 3> &min, const std::array<double, 3> &max) noexcept {
+      for (std::size_t k = 0; k < 3; ++k) {
+        lo[k] = std::min(lo[k], min[k]);
+        hi[k] = std::max(hi[k], max[k]);
+      }
+    }
+
+    void grow(const Extent &other) noexcept { grow(other.lo, other.hi); }
+
+    [[nodiscard]] double area() const noexcept {
+      double w = hi[0] - lo[0], h = hi[1] - lo[1], d = hi[2] - lo[2];
+      return 2.0 * (w * h + h * d + d * w);
+    }
+  };
+
+  struct Bin {
+    Extent bounds;
+    std::size_t count = 0;
+  };
+
+  /// Split after bin `bin` of `bins` on `axis`; axis 3 if the SAH found none
+  struct Split {
+    std::size_t axis = 3;
+    std::size_t bin = 0;
+    std::size_t bins = 0;
+    double cost = Extent::INF;
+  };
+
+  std::vector<Item> m_items;
+  unsigned m_threads;
+  unsigned m_max_leaf;
+  unsigned m_bins;
+
+  /// Run f(begin, end, chunk) over `chunks` slices of [begin, end), each on
+  /// its own thread but the last
+  template <typename F>
+  static void for_each_chunk(std::size_t begin, std::size_t end, unsigned chunks, F &&f) {
+    std::vector<std::thread> workers;
+    std::size_t step = (end - begin + chunks - 1) / chunks;
+    for (unsigned c = 0; c + 1 < chunks; ++c) {
+      std::size_t from = std::min(end, begin + c * step);
+      workers.emplace_back([&f, from, to = std::min(end, from + step), c] { f(from, to, c); });
+    }
+    f(std::min(end, begin + (chunks - 1) * step), end, chunks - 1);
+    for (auto &w : workers) {
+      w.join();
+    }
+  }
+
+  /// Bounds of the primitives in [begin, end), and of their centres
+  [[nodiscard]] std::pair<Extent, Extent> extents(std::size_t begin, std::size_t end,
+                                                  unsigned threads) const {
+    std::vector<std::pair<Extent, Extent>> parts(threads);
+    for_each_chunk(begin, end, threads, [&](std::size_t from, std::size_t to, unsigned c) {
+      auto &[box, centres] = parts[c];
+      for (std::size_t i = from; i < to; ++i) {
+        const Item &item = m_items[i];
+        const std::array<double, 3> centre = {item.centre(0), item.centre(1), item.centre(2)};
+        box.grow(item.min, item.max);
+        centres.grow(centre, centre);
+      }
+    });
+    for (std::size_t c = 1; c < parts.size(); ++c) {
+      parts[0].first.grow(parts[c].first);
+      parts[0].second.grow(parts[c].second);
+    }
+    return parts[0];
+  }
+
+  /// Maps centres along one axis to bins
+  struct Binner {
+    std::size_t axis;
+    double lo;
+    double scale;
+    std::size_t last;
+
+    [[nodiscard]] std::size_t operator()(const Item &item) const noexcept {
+      auto b = static_cast<std::size_t>((item.centre(axis) - lo) * scale);
+      return std::min(b, last);
+    }
+  };
+
+  [[nodiscard]] static Binner binner(std::size_t axis, const Extent &centres,
+                                     std::size_t bins) noexcept {
+    return Binner{axis, centres.lo[axis], double(bins) / (centres.hi[axis] - centres.lo[axis]),
+                  bins - 1};
+  }
+
+  /// Cheapest split by the SAH (in units of one primitive test per unit of
+  /// the node's area), over every axis the centres spread along. A node with
+  /// no area (collinear points, say) has no such unit and gets no split.
+  [[nodiscard]] Split find_split(std::size_t begin, std::size_t end, const Extent &box,
+                                 const Extent &centres, unsigned threads) const {
+    const double area = box.area();
+    if (!(area > 0.0)) {
+      return Split{};
+    }
+    // Small nodes have no use for more bins than primitives. Bin b of
+    // `axis` counted by chunk c is bins[(c * 3 + axis) * count + b]
+    const std::size_t count = std::min<std::size_t>(m_bins, end - begin);
+    std::vector<Bin> bins(std::size_t(threads) * 3 * count);
+    for_each_chunk(begin, end, threads, [&](std::size_t from, std::size_t to, unsigned c) {
+      for (std::size_t axis = 0; axis < 3; ++axis) {
+        if (!(centres.hi[axis] > centres.lo[axis])) {
+          continue;
+        }
+        Bin *part = &bins[(c * 3 + axis) * count];
+        const Binner bin_of = binner(axis, centres, count);
+        for (std::size_t i = from; i < to; ++i) {
+          const Item &item = m_items[i];
+          Bin &bin = part[bin_of(item)];
+          bin.bounds.grow(item.min, item.max);
+          ++bin.count;
+        }
+      }
+    });
+
+    Split best;
+    std::array<double, MAX_BINS> right_cost;
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      if (!(centres.hi[axis] > centres.lo[axis])) {
+        continue;
+      }
+      Bin *merged = &bins[axis * count];
+      for (unsigned c = 1; c < threads; ++c) {
+        const Bin *part = &bins[(c * 3 + axis) * count];
+        for (std::size_t b = 0; b < count; ++b) {
+          merged[b].bounds.grow(part[b].bounds);
+          merged[b].count += part[b].count;
+        }
+      }
+      // Sweep from the right for the area and count above each split
+      Extent right;
+      std::size_t right_count = 0;
+      for (std::size_t b = count - 1; b > 0; --b) {
+        right.grow(merged[b].bounds);
+        right_count += merged[b].count;
+        right_cost[b - 1] = right_count == 0 ? -1.0 : right.area() * double(right_count);
+      }
+      Extent left;
+      std::size_t left_count = 0;
+      for (std::size_t b = 0; b + 1 < count; ++b) {
+        left.grow(merged[b].bounds);
+        left_count += merged[b].count;
+        if (left_count == 0 || right_cost[b] < 0.0) {
+          continue;
+        }
+        double cost = 1.0 + (left.area() * double(left_count) + right_cost[b]) / area;
+        if (cost < best.cost) {
+          best = Split{axis, b, count, cost};
+        }
+      }
+    }
+    return best;
+  }
+
+  void build(std::vector<BvhNode> &out, std::size_t begin, std::size_t end, unsigned depth) {
+    const std::size_t n = end - begin;
+    // This subtree owns m_threads >> depth threads
+    const unsigned threads = n >= PARALLEL_MIN ? std::max(1u, m_threads >> depth) : 1u;
+    auto [box, centres] = extents(begin, end, threads);
+
+    const auto node = std::uint32_t(out.size());
+    out.push_back(BvhNode{{round_down(box.lo[0]), round_down(box.lo[1]), round_down(box.lo[2])},
+                          {round_up(box.hi[0]), round_up(box.hi[1]), round_up(box.hi[2])},
+                          std::uint32_t(begin),
+                          std::uint16_t(n),
+                          0,
+                          0});
+    if (n == 1) {
+      return;
+    }
+
+    Split split = find_split(begin, end, box, centres, threads);
+    if (n <= m_max_leaf && (split.axis == 3 || double(n) <= split.cost)) {
+      return; // Leaf
+    }
+    std::size_t mid;
+    if (split.axis == 3) {
+      // No SAH split: halve at the median centre along the axis the centres
+      // spread most (any halves do if every centre is the same)
+      split.axis = 0;
+      for (std::size_t axis = 1; axis < 3; ++axis) {
+        if (centres.hi[axis] - centres.lo[axis] > centres.hi[split.axis] - centres.lo[split.axis]) {
+          split.axis = axis;
+        }
+      }
+      mid = begin + n / 2;
+      std::nth_element(m_items.begin() + std::ptrdiff_t(begin), m_items.begin() + std::ptrdiff_t(mid),
+                       m_items.begin() + std::ptrdiff_t(end), [&](const Item &a, const Item &b) {
+                         return a.centre(split.axis) < b.centre(split.axis);
+                       });
+    } else {
+      const Binner bin_of = binner(split.axis, centres, split.bins);
+      auto it = std::partition(m_items.begin() + std::ptrdiff_t(begin),
+                               m_items.begin() + std::ptrdiff_t(end),
+                               [&](const Item &item) { return bin_of(item) <= split.bin; });
+      mid = std::size_t(it - m_items.begin());
+    }
+    out[node].count = 0;
+    out[node].axis = std::uint8_t(split.axis);
+
+    if (threads > 1) {
+      std::vector<BvhNode> right;
+      std::thread worker([&] { build(right, mid, end, depth + 1); });
+      build(out, begin, mid, depth + 1);
+      worker.join();
+      const auto base = std::uint32_t(out.size());
+      out[node].index = base;
+      for (BvhNode child : right) {
+        if (child.count == 0) {
+          child.index += base;
+        }
+        out.push_back(child);
+      }
+    } else {
+      build(out, begin, mid, depth + 1);
+      out[node].index = std::uint32_t(out.size());
+      build(out, mid, end, depth + 1);
+    }
+  }
+};
+
+/// Collapse a binary hierarchy into Width-wide nodes, opening the child
+/// with the largest surface area until a node has Width children.
+template <std::size_t Width> class BvhCollapser {
+public:
+  explicit BvhCollapser(const std::vector<BvhNode> &binary) noexcept : m_binary(binary) {}
+
+  [[nodiscard]] std::vector<WideBvhNode<Width>> collapse() {
+    if (!m_binary.empty()) {
+      (void)collapse(0);
+    }
+    return std::move(m_wide);
+  }
+
+private:
+  const std::vector<BvhNode> &m_binary;
+  std::vector<WideBvhNode<Width>> m_wide;
+
+  [[nodiscard]] double area(std::uint32_t node) const noexcept {
+    const BvhNode &n = m_binary[node];
+    double w = double(n.max[0]) - n.min[0], h = double(n.max[1]) - n.min[1],
+           d = double(n.max[2]) - n.min[2];
+    return w * h + h * d + d * w;
+  }
+
+  std::uint32_t collapse(std::uint32_t root) {
+    std::array<std::uint32_t, Width> lanes{};
+    std::size_t used = 0;
+    if (m_binary[root].count > 0) {
+      lanes[used++] = root; // A tree that is a single leaf
+    } else {
+      lanes[used++] = root + 1;
+      lanes[used++] = m_binary[root].index;
+    }
+    while (used < Width) {
+      std::size_t widest = Width;
+      for (std::size_t i = 0; i < used; ++i) {
+        if (m_binary[lanes[i]].count == 0 && (widest == Width || area(lanes[i]) > area(lanes[widest]))) {
+          widest = i;
+        }
+      }
+      if (widest == Width) {
+        break; // Only leaves left
+      }
+      std::uint32_t opened = lanes[widest];
+      lanes[widest] = opened + 1;
+      lanes[used++] = m_binary[opened].index;
+    }
+
+    const auto node = std::uint32_t(m_wide.size());
+    WideBvhNode<Width> wide;
+    wide.min_x.fill(std::numeric_limits<float>::infinity());
+    wide.min_y = wide.min_z = wide.min_x;
+    wide.max_x.fill(-std::numeric_limits<float>::infinity());
+    wide.max_y = wide.max_z = wide.max_x;
+    wide.index.fill(WideBvhNode<Width>::EMPTY);
+    wide.count.fill(0);
+    for (std::size_t i = 0; i < used; ++i) {
+      const BvhNode &child = m_binary[lanes[i]];
+      wide.min_x[i] = child.min[0];
+      wide.min_y[i] = child.min[1];
+      wide.min_z[i] = child.min[2];
+      wide.max_x[i] = child.max[0];
+      wide.max_y[i] = child.max[1];
+      wide.max_z[i] = child.max[2];
+      wide.index[i] = child.index;
+      wide.count[i] = child.count;
+    }
+    m_wide.push_back(wide);
+    for (std::size_t i = 0; i < used; ++i) {
+      if (m_binary[lanes[i]].count == 0) {
+        std::uint32_t child = collapse(lanes[i]);
+        m_wide[node].index[i] = child;
+      }
+    }
+    return node;
+  }
+};
+
+} // namespace detail
+
+/// A bounding volume hierarchy over a fixed set of primitive boxes, built
+/// once. Width 2 is a binary tree of 32-byte nodes; 4 and 8 are wide trees.
+template <std::size_t Width> class StaticBvh {
+  static_assert(Width == 2 || Width == 4 || Width == 8, "StaticBvh is 2, 4 or 8 wide");
+
+public:
+  using Node = std::conditional_t<Width == 2, BvhNode, WideBvhNode<Width>>;
+  /// Index of a primitive in the span the hierarchy was built from
+  using Id = std::uint32_t;
+  static constexpr std::string_view NAME = "StaticBvh";
+  static constexpr std::size_t WIDTH = Width;
+
+  /// A ray hitting a primitive: it enters at origin + t * direction
+  struct Hit {
+    Id id;
+    double t;
+
+    [[nodiscard]] constexpr bool operator==(const Hit &other) const noexcept = default;
+  };
+
+private:
+  using Bounds = detail::BvhBounds;
+
+  std::vector<std::byte> m_owned;    // The image, if built by from()
+  std::span<const std::byte> m_view; // The image, if from from_bytes()
+  std::size_t m_node_count = 0;
+  std::size_t m_size = 0;
+
+  StaticBvh(std::vector<std::byte> owned, std::span<const std::byte> view,
+            const detail::BvhHeader &header) noexcept
+      : m_owned(std::move(owned)), m_view(view), m_node_count(header.node_count),
+        m_size(header.primitive_count) {}
+
+  [[nodiscard]] static constexpr std::size_t image_size(std::size_t nodes,
+                                                        std::size_t primitives) noexcept {
+    return detail::BVH_HEADER_SIZE + nodes * sizeof(Node) +
+           primitives * (sizeof(Bounds) + sizeof(Id));
+  }
+
+  [[nodiscard]] std::span<const std::byte> image() const noexcept {
+    return m_owned.empty() ? m_view : std::span<const std::byte>(m_owned);
+  }
+
+  // The image is laid out for these to be aligned: from() builds it in a
+  // std::vector<std::byte> and from_bytes() checks the alignment
+  [[nodiscard]] const Node *nodes() const noexcept {
+    return reinterpret_cast<const Node *>(image().data() + detail::BVH_HEADER_SIZE);
+  }
+  [[nodiscard]] const Bounds *boxes() const noexcept {
+    return reinterpret_cast<const Bounds *>(image().data() + detail::BVH_HEADER_SIZE +
+                                            m_node_count * sizeof(Node));
+  }
+  [[nodiscard]] const Id *ids() const noexcept {
+    return reinterpret_cast<const Id *>(boxes() + m_size);
+  }
+
+  [[nodiscard]] static StaticBvh build(std::span<const Bounds> bounds, BvhBuildOptions options) {
+    if (bounds.size() >= std::numeric_limits<Id>::max()) {
+      panic("bvh: too many primitives");
+    }
+    detail::BvhBuilder builder(bounds, options);
+    std::vector<BvhNode> binary = builder.build();
+    std::vector<std::uint32_t> order = builder.order();
+    std::vector<Node> tree;
+    if constexpr (Width == 2) {
+      tree = std::move(binary);
+    } else {
+      tree = detail::BvhCollapser<Width>(binary).collapse();
+    }
+
+    detail::BvhHeader header{detail::BVH_MAGIC, detail::BVH_BYTE_ORDER, detail::BVH_VERSION,
+                             std::uint32_t(Width), std::uint32_t(sizeof(Node)), tree.size(),
+                             bounds.size(), Bounds{}};
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    header.bounds = Bounds{{inf, inf, inf}, {-inf, -inf, -inf}};
+    for (const Bounds &b : bounds) {
+      for (std::size_t k = 0; k < 3; ++k) {
+        header.bounds.min[k] = std::min(header.bounds.min[k], b.min[k]);
+        header.bounds.max[k] = std::max(header.bounds.max[k], b.max[k]);
+      }
+    }
+
+    std::vector<std::byte> image(image_size(tree.size(), bounds.size()));
+    std::byte *p = image.data();
+    std::memcpy(p, &header, sizeof(header));
+    p += detail::BVH_HEADER_SIZE;
+    if (!tree.empty()) {
+      std::memcpy(p, tree.data(), tree.size() * sizeof(Node));
+      p += tree.size() * sizeof(Node);
+    }
+    for (std::uint32_t id : order) {
+      std::memcpy(p, &bounds[id], sizeof(Bounds));
+      p += sizeof(Bounds);
+    }
+    if (!order.empty()) {
+      std::memcpy(p, order.data(), order.size() * sizeof(Id));
+    }
+    return StaticBvh(std::move(image), {}, header);
+  }
+
+  /// Whether the nodes of an image form a tree over its primitives: every
+  /// child after its parent and referenced once, every range in bounds,
+  /// every split axis 0-2
+  [[nodiscard]] bool is_well_formed() const {
+    const Node *tree = nodes();
+    std::vector<std::uint8_t> parents(m_node_count, 0);
+    auto child = [&](std::size_t parent, std::uint32_t index) {
+      return index > parent && index < m_node_count && ++parents[index] == 1;
+    };
+    auto leaf = [&](std::uint32_t first, std::uint32_t count) {
+      return first <= m_size && count <= m_size - first;
+    };
+    for (std::size_t i = 0; i < m_node_count; ++i) {
+      const Node &n = tree[i];
+      if constexpr (Width == 2) {
+        if (n.count > 0 ? !leaf(n.index, n.count)
+                        : n.axis > 2 || !child(i, std::uint32_t(i + 1)) || !child(i, n.index)) {
+          return false;
+        }
+      } else {
+        for (std::size_t k = 0; k < Width; ++k) {
+          if (n.index[k] == Node::EMPTY ? n.count[k] != 0
+              : n.count[k] > 0          ? !leaf(n.index[k], n.count[k])
+                                        : !child(i, n.index[k])) {
+            return false;
+          }
+        }
+      }
+    }
+    const Id *id = ids();
+    return std::all_of(id, id + m_size, [this](Id x) { return x < m_size; });
+  }
+
+  [[nodiscard]] static std::array<double, 3> lo_of(const BvhNode &n) noexcept {
+    return {n.min[0], n.min[1], n.min[2]};
+  }
+  [[nodiscard]] static std::array<double, 3> hi_of(const BvhNode &n) noexcept {
+    return {n.max[0], n.max[1], n.max[2]};
+  }
+  [[nodiscard]] static std::array<double, 3> lo_of(const Node &n, std::size_t k) noexcept {
+    return {n.min_x[k], n.min_y[k], n.min_z[k]};
+  }
+  [[nodiscard]] static std::array<double, 3> hi_of(const Node &n, std::size_t k) noexcept {
+    return {n.max_x[k], n.max_y[k], n.max_z[k]};
+  }
+
+  /// Call f(id) for every primitive whose box passes `hits(lo, hi)`,
+  /// skipping subtrees whose bounds fail it
+  template <typename Hits, typename F> void descend(Hits &&hits, F &&f) const {
+    if (m_node_count == 0) {
+      return;
+    }
+    const Node *tree = nodes();
+    const Bounds *prims = boxes();
+    const Id *id = ids();
+    auto leaf = [&](std::uint32_t first, std::uint32_t count) {
+      for (std::uint32_t p = first; p < first + count; ++p) {
+        if (hits(prims[p].min, prims[p].max)) {
+          f(id[p]);
+        }
+      }
+    };
+    detail::TraversalStack stack;
+    stack.push(0);
+    while (!stack.is_empty()) {
+      std::uint32_t node = stack.pop();
+      const Node &n = tree[node];
+      if constexpr (Width == 2) {
+        if (!hits(lo_of(n), hi_of(n))) {
+          continue;
+        }
+        if (n.count > 0) {
+          leaf(n.index, n.count);
+        } else {
+          stack.push(n.index);
+          stack.push(node + 1);
+        }
+      } else {
+        for (std::size_t k = 0; k < Width; ++k) {
+          if (n.index[k] == Node::EMPTY || !hits(lo_of(n, k), hi_of(n, k))) {
+            continue;
+          }
+          if (n.count[k] > 0) {
+            leaf(n.index[k], n.count[k]);
+          } else {
+            stack.push(n.index[k]);
+          }
+        }
+      }
+    }
+  }
+
+  /// Slab test of every lane of a wide node at once; t0[k] is where the
+  /// segment enters lane k, which it hits if t0[k] <= t1[k]
+  static void enter_lanes(const detail::RaySegment &s, const Node &n,
+                          std::array<double, Width> &t0,
+                          std::array<double, Width> &t1) noexcept {
+    t0.fill(0.0);
+    t1.fill(s.max_t);
+    const std::array<const std::array<float, Width> *, 3> lo = {&n.min_x, &n.min_y, &n.min_z};
+    const std::array<const std::array<float, Width> *, 3> hi = {&n.max_x, &n.max_y, &n.max_z};
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      const double o = s.origin[axis];
+      const double inv = s.inv_direction[axis];
+      if (s.direction[axis] == 0.0) {
+        for (std::size_t k = 0; k < Width; ++k) {
+          bool inside = o >= double((*lo[axis])[k]) && o <= double((*hi[axis])[k]);
+          t1[k] = inside ? t1[k] : -1.0;
+        }
+        continue;
+      }
+      for (std::size_t k = 0; k < Width; ++k) {
+        double a = (double((*lo[axis])[k]) - o) * inv;
+        double b = (double((*hi[axis])[k]) - o) * inv;
+        t0[k] = std::max(t0[k], std::min(a, b));
+        t1[k] = std::min(t1[k], std::max(a, b));
+      }
+    }
+  }
+
+  /// Nearest primitive for which intersect(slot, max_t) gives a t within
+  /// the segment, visiting nearer subtrees first and pruning farther ones
+  template <typename Intersect>
+  [[nodiscard]] Optional<Hit> nearest(Vector3<double> origin, Vector3<double> direction,
+                                      double max_t, Intersect &&intersect) const {
+    if (m_node_count == 0) {
+      return None;
+    }
+    detail::RaySegment segment(origin, direction, max_t);
+    Optional<Hit> best = None;
+    const Node *tree = nodes();
+    const Id *id = ids();
+    auto leaf = [&](std::uint32_t first, std::uint32_t count) {
+      for (std::uint32_t p = first; p < first + count; ++p) {
+        auto t = intersect(p, segment.max_t);
+        if (t.is_some() && t.unwrap() <= segment.max_t &&
+            (best.is_none() || t.unwrap() < segment.max_t)) {
+          best = Some(Hit{id[p], t.unwrap()});
+          segment.max_t = t.unwrap();
+        }
+      }
+    };
+    detail::TraversalStack stack;
+    stack.push(0);
+    while (!stack.is_empty()) {
+      std::uint32_t node = stack.pop();
+      const Node &n = tree[node];
+      if constexpr (Width == 2) {
+        double t;
+        if (!segment.enters(lo_of(n), hi_of(n), t)) {
+          continue;
+        }
+        if (n.count > 0) {
+          leaf(n.index, n.count);
+        } else if (segment.direction[n.axis] < 0.0) {
+          // The second child lies further along the axis: visit it first
+          stack.push(node + 1);
+          stack.push(n.index);
+        } else {
+          stack.push(n.index);
+          stack.push(node + 1);
+        }
+      } else {
+        std::array<double, Width> t0, t1;
+        enter_lanes(segment, n, t0, t1);
+        // Leaves now, then inner children nearest on top
+        std::array<std::pair<double, std::uint32_t>, Width> inner;
+        std::size_t inner_count = 0;
+        for (std::size_t k = 0; k < Width; ++k) {
+          if (n.index[k] == Node::EMPTY || !(t0[k] <= t1[k])) {
+            continue;
+          }
+          if (n.count[k] > 0) {
+            leaf(n.index[k], n.count[k]);
+          } else {
+            inner[inner_count++] = {t0[k], n.index[k]};
+          }
+        }
+        // Farthest first; at most Width entries, so insertion sort
+        for (std::size_t i = 1; i < inner_count; ++i) {
+          for (std::size_t j = i; j > 0 && inner[j - 1].first < inner[j].first; --j) {
+            std::swap(inner[j - 1], inner[j]);
+          }
+        }
+        for (std::size_t i = 0; i < inner_count; ++i) {
+          if (inner[i].first <= segment.max_t) {
+            stack.push(inner[i].second);
+          }
+        }
+      }
+    }
+    return best;
+  }
+
+  /// Nearest primitive for each lane of a packet, where intersect(slot, t)
+  /// lowers t[k] for the lanes that hit nearer and returns their bits. A
+  /// node is visited once for every lane that enters it.
+  template <std::size_t N, typename Intersect>
+  [[nodiscard]] std::array<Optional<Hit>, N> nearest(const RayPacket<double, N> &rays,
+                                                     const std::array<double, N> &max_t,
+                                                     Intersect &&intersect) const {
+    std::array<Optional<Hit>, N> result;
+    if (m_node_count == 0) {
+      return result;
+    }
+    std::array<double, N> best = max_t;
+    std::array<double, N> t;
+    std::array<Id, N> hit{};
+    unsigned found = 0;
+    const Node *tree = nodes();
+    const Id *id = ids();
+    auto leaf = [&](std::uint32_t first, std::uint32_t count) {
+      for (std::uint32_t p = first; p < first + count; ++p) {
+        unsigned bits = intersect(p, best);
+        found |= bits;
+        for (; bits != 0; bits &= bits - 1) {
+          hit[std::size_t(std::countr_zero(bits))] = id[p];
+        }
+      }
+    };
+    detail::TraversalStack stack;
+    stack.push(0);
+    while (!stack.is_empty()) {
+      std::uint32_t node = stack.pop();
+      const Node &n = tree[node];
+      if constexpr (Width == 2) {
+        unsigned lanes = rays.enters(lo_of(n), hi_of(n), best, t);
+        if (lanes == 0) {
+          continue;
+        }
+        if (n.count > 0) {
+          leaf(n.index, n.count);
+        } else if (rays.directions(n.axis)[std::size_t(std::countr_zero(lanes))] < 0.0) {
+          // Coherent rays mostly agree with their first lane on which
+          // child is nearer
+          stack.push(node + 1);
+          stack.push(n.index);
+        } else {
+          stack.push(n.index);
+          stack.push(node + 1);
+        }
+      } else {
+        std::array<std::pair<double, std::uint32_t>, Width> inner;
+        std::size_t inner_count = 0;
+        for (std::size_t k = 0; k < Width; ++k) {
+          if (n.index[k] == Node::EMPTY) {
+            continue;
+          }
+          unsigned lanes = rays.enters(lo_of(n, k), hi_of(n, k), best, t);
+          if (lanes == 0) {
+            continue;
+          }
+          if (n.count[k] > 0) {
+            leaf(n.index[k], n.count[k]);
+            continue;
+          }
+          double nearest_t = std::numeric_limits<double>::infinity();
+          for (; lanes != 0; lanes &= lanes - 1) {
+            nearest_t = std::min(nearest_t, t[std::size_t(std::countr_zero(lanes))]);
+          }
+          inner[inner_count++] = {nearest_t, n.index[k]};
+        }
+        // Farthest first, so the nearest is on top
+        for (std::size_t i = 1; i < inner_count; ++i) {
+          for (std::size_t j = i; j > 0 && inner[j - 1].first < inner[j].first; --j) {
+            std::swap(inner[j - 1], inner[j]);
+          }
+        }
+        for (std::size_t i = 0; i < inner_count; ++i) {
+          stack.push(inner[i].second);
+        }
+      }
+    }
+    for (std::size_t k = 0; k < N; ++k) {
+      if (found >> k & 1u) {
+        result[k] = Some(Hit{hit[k], best[k]});
+      }
+    }
+    return result;
+  }
+
+public:
+  // ==================== Construction ====================
+
+  /// Build over boxes; ids are their indices
+  [[nodiscard]] static StaticBvh from(std::span<const Box<double>> boxes,
+                                      BvhBuildOptions options = {}) {
+    std::vector<Bounds> bounds;
+    bounds.reserve(boxes.size());
+    for (const Box<double> &b : boxes) {
+      bounds.push_back(Bounds{{b.min().x(), b.min().y(), b.min().z()},
+                              {b.max().x(), b.max().y(), b.max().z()}});
+    }
+    return build(bounds, options);
+  }
+
+  /// Build over the bounding boxes of spheres; ids are their indices.
+  /// Queries report the spheres whose boxes match: finish with the
+  /// Sphere tests, or pass ray_cast() a sphere intersection.
+  [[nodiscard]] static StaticBvh from(std::span<const Sphere<double>> spheres,
+                                      BvhBuildOptions options = {}) {
+    std::vector<Bounds> bounds;
+    bounds.reserve(spheres.size());
+    for (const Sphere<double> &s : spheres) {
+      double r = s.radius();
+      bounds.push_back(Bounds{{s.x() - r, s.y() - r, s.z() - r}, {s.x() + r, s.y() + r, s.z() + r}});
+    }
+    return build(bounds, options);
+  }
+
+  /// Use an image from to_bytes() in place, e.g. a memory-mapped file; the
+  /// bytes must outlive the StaticBvh and its copies. None unless the
+  /// image is for this Width and byte order, 8-byte aligned, exactly the
+  /// right size, and its nodes form a tree.
+  [[nodiscard]] static Optional<StaticBvh> from_bytes(std::span<const std::byte> bytes) {
+    detail::BvhHeader header;
+    if (bytes.size() < detail::BVH_HEADER_SIZE ||
+        reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(double) != 0) {
+      return None;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    constexpr std::size_t most = std::numeric_limits<Id>::max();
+    if (header.magic != detail::BVH_MAGIC || header.byte_order != detail::BVH_BYTE_ORDER ||
+        header.version != detail::BVH_VERSION || header.width != Width ||
+        header.node_size != sizeof(Node) || header.node_count > most ||
+        header.primitive_count >= most ||
+        bytes.size() != image_size(header.node_count, header.primitive_count)) {
+      return None;
+    }
+    StaticBvh bvh({}, bytes, header);
+    if (!bvh.is_well_formed()) {
+      return None;
+    }
+    return Some(std::move(bvh));
+  }
+
+  /// The image, for writing to a file and loading with from_bytes()
+  [[nodiscard]] std::span<const std::byte> to_bytes() const noexcept { return image(); }
+
+  // ==================== Accessors ====================
+
+  /// Number of primitives
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+  [[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+  [[nodiscard]] std::size_t node_count() const noexcept { return m_node_count; }
+
+  /// Box around every primitive (None if there are none)
+  [[nodiscard]] Optional<Box<double>> bounds() const noexcept {
+    if (m_size == 0) {
+      return None;
+    }
+    detail::BvhHeader header;
+    std::memcpy(&header, image().data(), sizeof(header));
+    const Bounds &b = header.bounds;
+    return Box<double>::from_corners(Vec3d::from(b.min[0], b.min[1], b.min[2]),
+                                     Vec3d::from(b.max[0], b.max[1], b.max[2]));
+  }
+
+  // ==================== Queries ====================
+
+  /// Call f(id) for every primitive box that intersects `area`
+  /// (Box::intersects)
+  template <typename F> void for_each_overlapping(const Box<double> &area, F &&f) const {
+    const std::array<double, 3> lo = {area.min().x(), area.min().y(), area.min().z()};
+    const std::array<double, 3> hi = {area.max().x(), area.max().y(), area.max().z()};
+    descend(
+        [&](const std::array<double, 3> &min, const std::array<double, 3> &max) {
+          return min[0] <= hi[0] && max[0] >= lo[0] && min[1] <= hi[1] && max[1] >= lo[1] &&
+                 min[2] <= hi[2] && max[2] >= lo[2];
+        },
+        f);
+  }
+
+  /// Ids of the primitive boxes that intersect `area`
+  [[nodiscard]] std::vector<Id> overlapping(const Box<double> &area) const {
+    std::vector<Id> found;
+    for_each_overlapping(area, [&found](Id id) { found.push_back(id); });
+    return found;
+  }
+
+  /// Call f(id) for every primitive box that contains `point`
+  /// (Box::contains)
+  template <typename F> void for_each_containing(Vector3<double> point, F &&f) const {
+    const std::array<double, 3> p = {point.x(), point.y(), point.z()};
+    descend(
+        [&](const std::array<double, 3> &min, const std::array<double, 3> &max) {
+          return p[0] >= min[0] && p[0] <= max[0] && p[1] >= min[1] && p[1] <= max[1] &&
+                 p[2] >= min[2] && p[2] <= max[2];
+        },
+        f);
+  }
+
+  /// Ids of the primitive boxes that contain `point`
+  [[nodiscard]] std::vector<Id> containing(Vector3<double> point) const {
+    std::vector<Id> found;
+    for_each_containing(point, [&found](Id id) { found.push_back(id); });
+    return found;
+  }
+
+  /// Call f(id, t) for every primitive box hit by origin + t * direction
+  /// with t in [0, max_t], where t is where the ray enters the box (0 if it
+  /// starts inside). Boxes come in no particular order.
+  template <typename F>
+  void for_each_ray_hit(Vector3<double> origin, Vector3<double> direction, double max_t,
+                        F &&f) const {
+    const detail::RaySegment segment(origin, direction, max_t);
+    double t = 0.0; // Set by the primitive box test just before each f()
+    descend(
+        [&](const std::array<double, 3> &min, const std::array<double, 3> &max) {
+          return segment.enters(min, max, t);
+        },
+        [&](Id id) { f(id, t); });
+  }
+
+  /// The first primitive box hit by origin + t * direction with t in
+  /// [0, max_t] (None if nothing is hit)
+  [[nodiscard]] Optional<Hit> ray_cast(Vector3<double> origin, Vector3<double> direction,
+                                       double max_t) const {
+    const Bounds *prims = boxes();
+    const detail::RaySegment segment(origin, direction, max_t);
+    return nearest(origin, direction, max_t, [&](std::uint32_t p, double) -> Optional<double> {
+      double t;
+      if (segment.enters(prims[p].min, prims[p].max, t)) {
+        return Some(t);
+      }
+      return None;
+    });
+  }
+
+  /// The first primitive hit, where intersect(id, max_t) returns the t at
+  /// which the ray hits primitive id, or None if it misses it before max_t.
+  /// It is only called for primitives whose box the ray enters.
+  template <typename Intersect>
+  [[nodiscard]] Optional<Hit> ray_cast(Vector3<double> origin, Vector3<double> direction,
+                                       double max_t, Intersect &&intersect) const {
+    const Bounds *prims = boxes();
+    const Id *id = ids();
+    detail::RaySegment segment(origin, direction, max_t);
+    return nearest(origin, direction, max_t,
+                   [&](std::uint32_t p, double limit) -> Optional<double> {
+                     double t;
+                     segment.max_t = limit;
+                     if (!segment.enters(prims[p].min, prims[p].max, t)) {
+                       return None;
+                     }
+                     return intersect(id[p], limit);
+                   });
+  }
+
+  /// ray_cast() along a Ray
+  [[nodiscard]] Optional<Hit> ray_cast(const Rayd &ray, double max_t) const {
+    return ray_cast(ray.origin(), ray.direction(), max_t);
+  }
+
+  /// ray_cast() along a Ray with an exact intersection test
+  template <typename Intersect>
+  [[nodiscard]] Optional<Hit> ray_cast(const Rayd &ray, double max_t,
+                                       Intersect &&intersect) const {
+    return ray_cast(ray.origin(), ray.direction(), max_t, std::forward<Intersect>(intersect));
+  }
+
+  /// The first primitive box hit by each ray of a packet, lane k within
+  /// [0, max_t[k]]. The packet walks the tree together, so coherent rays
+  /// share the node tests that single casts would repeat.
+  template <std::size_t N>
+  [[nodiscard]] std::array<Optional<Hit>, N> ray_cast(const RayPacket<double, N> &rays,
+                                                      const std::array<double, N> &max_t) const {
+    const Bounds *prims = boxes();
+    std::array<double, N> entry;
+    return nearest(rays, max_t, [&](std::uint32_t p, std::array<double, N> &t) {
+      unsigned lanes = rays.enters(prims[p].min, prims[p].max, t, entry);
+      for (unsigned bits = lanes; bits != 0; bits &= bits - 1) {
+        auto k = std::size_t(std::countr_zero(bits));
+        t[k] = entry[k];
+      }
+      return lanes;
+    });
+  }
+
+  /// The first primitive hit by each ray of a packet, where
+  /// intersect(id, t) lowers t[k] for the lanes that hit primitive id
+  /// nearer than t[k] and returns their bits, like the RayPacket tests. It
+  /// is only called for primitives whose box some lane enters.
+  template <std::size_t N, typename Intersect>
+  [[nodiscard]] std::array<Optional<Hit>, N> ray_cast(const RayPacket<double, N> &rays,
+                                                      const std::array<double, N> &max_t,
+                                                      Intersect &&intersect) const {
+    const Bounds *prims = boxes();
+    const Id *id = ids();
+    std::array<double, N> entry;
+    return nearest(rays, max_t, [&](std::uint32_t p, std::array<double, N> &t) -> unsigned {
+      if (rays.enters(prims[p].min, prims[p].max, t, entry) == 0) {
+        return 0;
+      }
+      return intersect(id[p], t);
+    });
+  }
+};
+
+using Bvh2 = StaticBvh<2>;
+using Bvh4 = StaticBvh<4>;
+using Bvh8 = StaticBvh<8>;
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_GEOMETRY_BVH_HPP
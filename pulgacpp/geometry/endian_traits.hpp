@@ -0,0 +1,102 @@
+// pulgacpp::endian_traits for geometry - Byte-order encodings of points and vectors
+// SPDX-License-Identifier: MIT
+//
+// Point<T>, Vector2<T> and Vector3<T> of any EndianCodable T are encoded as
+// their components in order (x, y, z), each as a T in the field's byte
+// order. They live here rather than in the geometry headers so that only
+// code storing geometry in BigEndian / LittleEndian fields pays for
+// endian.hpp.
+//
+// Usage:
+//   #include <pulgacpp/geometry/endian_traits.hpp>
+//
+//   using Sample = RecordView<BigEndian<u32>, LittleEndian<Vector3<float>>>;
+
+#ifndef PULGACPP_GEOMETRY_ENDIAN_TRAITS_HPP
+#define PULGACPP_GEOMETRY_ENDIAN_TRAITS_HPP
+
+#include "../endian/endian.hpp"
+#include "point.hpp"
+#include "vector2.hpp"
+#include "vector3.hpp"
+
+#include <bit>
+#include <cstddef>
+
+namespace pulgacpp {
+
+/// Point<T> is encoded as x and y, each as a T.
+template <Numeric T>
+  requires EndianCodable<T>
+struct endian_traits<Point<T>> {
+  static constexpr std::size_t SIZE = 2 * endian_traits<T>::SIZE;
+  static constexpr std::size_t WORD = endian_traits<T>::WORD;
+
+  template <std::endian Order>
+  [[nodiscard]] static constexpr Point<T> load(const std::byte *p) noexcept {
+    using E = endian_traits<T>;
+    constexpr std::size_t N = E::SIZE;
+    return Point<T>::from(E::template load<Order>(p), E::template load<Order>(p + N));
+  }
+
+  template <std::endian Order>
+  static constexpr void store(std::byte *p, const Point<T> &v) noexcept {
+    using E = endian_traits<T>;
+    constexpr std::size_t N = E::SIZE;
+    E::template store<Order>(p, v.x());
+    E::template store<Order>(p + N, v.y());
+  }
+};
+
+/// Vector2<T> is encoded as x and y, each as a T.
+template <Numeric T>
+  requires EndianCodable<T>
+struct endian_traits<Vector2<T>> {
+  static constexpr std::size_t SIZE = 2 * endian_traits<T>::SIZE;
+  static constexpr std::size_t WORD = endian_traits<T>::WORD;
+
+  template <std::endian Order>
+  [[nodiscard]] static constexpr Vector2<T> load(const std::byte *p) noexcept {
+    using E = endian_traits<T>;
+    constexpr std::size_t N = E::SIZE;
+    return Vector2<T>::from(E::template load<Order>(p), E::template load<Order>(p + N));
+  }
+
+  template <std::endian Order>
+  static constexpr void store(std::byte *p, const Vector2<T> &v) noexcept {
+    using E = endian_traits<T>;
+    constexpr std::size_t N = E::SIZE;
+    E::template store<Order>(p, v.x());
+    E::template store<Order>(p + N, v.y());
+  }
+};
+
+/// Vector3<T> is encoded as x, y and z, each as a T.
+template <Numeric T>
+  requires EndianCodable<T>
+struct endian_traits<Vector3<T>> {
+  static constexpr std::size_t SIZE = 3 * endian_traits<T>::SIZE;
+  static constexpr std::size_t WORD = endian_traits<T>::WORD;
+
+  template <std::endian Order>
+  [[nodiscard]] static constexpr Vector3<T> load(const std::byte *p) noexcept {
+    using E = endian_traits<T>;
+    constexpr std::size_t N = E::SIZE;
+    return Vector3<T>::from(E::template load<Order>(p),
+                            E::template load<Order>(p + N),
+                            E::template load<Order>(p + 2 * N));
+  }
+
+  template <std::endian Order>
+  static constexpr void store(std::byte *p, const Vector3<T> &v) noexcept {
+    using E = endian_traits<T>;
+    constexpr std::size_t N = E::SIZE;
+    E::template store<Order>(p, v.x());
+    E::template store<Order>(p + N, v.y());
+    E::template store<Order>(p + 2 * N, v.z());
+  }
+};
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_GEOMETRY_ENDIAN_TRAITS_HPP
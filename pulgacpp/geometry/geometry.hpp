@@ -21,9 +21,18 @@
 
 // 3D types
 #include "box.hpp"
+#include "ray.hpp"
 #include "sphere.hpp"
 #include "vector3.hpp"
 
+// Structure-of-arrays containers
+#include "pointcloud.hpp"
+
+// Spatial indexes
+#include "aabbtree.hpp"
+#include "bvh.hpp"
+#include "spatialhash.hpp"
+
 
 // Angular types
 #include "angle.hpp"
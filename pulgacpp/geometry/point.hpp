@@ -182,6 +182,22 @@ public:
     }
 };
 
+/// Optional<Point<float/double>> uses a reserved NaN in x as None, so it is
+/// the same size as the point itself. That NaN survives arithmetic, so Some()
+/// replaces it in x with the default quiet NaN.
+template <std::floating_point T>
+struct niche_traits<Point<T>> {
+    [[nodiscard]] static constexpr Point<T> none() noexcept {
+        return Point<T>::from(detail::niche_nan<T>(), detail::niche_nan<T>());
+    }
+    [[nodiscard]] static constexpr bool is_none(const Point<T>& p) noexcept {
+        return detail::is_niche_nan(p.x());
+    }
+    [[nodiscard]] static constexpr Point<T> to_some(const Point<T>& p) noexcept {
+        return Point<T>::from(detail::some_nan(p.x()), p.y());
+    }
+};
+
 // Type aliases for common use cases
 using Point32 = Point<std::int32_t>;
 using Point64 = Point<std::int64_t>;
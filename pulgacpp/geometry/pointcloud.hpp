@@ -0,0 +1,653 @@
+// pulgacpp::PointCloud2 / PointCloud3 - Structure-of-arrays point containers
+// SPDX-License-Identifier: MIT
+//
+// A `std::vector<Point<T>>` interleaves x and y, so a loop over it calls
+// `distance_to` once per point and the compiler sees one point at a time.
+// PointCloud2 and PointCloud3 store each coordinate in its own 64-byte
+// aligned array and provide the common per-point operations for the whole
+// cloud at once. The loops run on float or double vectors (AVX2 / SSE4.2 /
+// NEON, picked at runtime like the batch module) with a scalar fallback.
+//
+// Results are computed in T: a float cloud does float arithmetic, where
+// Point<float>::distance_to converts to double first. Operations that
+// produce a value per point write it to a caller-provided span of the same
+// length, so repeated queries do not allocate.
+//
+// Usage:
+//   #include <pulgacpp/geometry/pointcloud.hpp>
+//
+//   std::vector<PointF> entities = ...;
+//   auto cloud = PointCloud2F::from(entities);
+//   std::vector<float> dist(cloud.size());
+//   cloud.distances_to(player, dist);
+//
+//   auto turned = cloud.rotate(std::numbers::pi / 2);
+//   std::vector<PointF> back = turned.to_points();
+
+#ifndef PULGACPP_GEOMETRY_POINTCLOUD_HPP
+#define PULGACPP_GEOMETRY_POINTCLOUD_HPP
+
+#include "../core/simd.hpp"
+#include "../result/result.hpp"
+#include "point.hpp"
+#include "vector3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace pulgacpp {
+
+/// Error of PointCloud3::normalized: the first vector of length zero.
+struct ZeroVector {
+  std::size_t index;
+
+  [[nodiscard]] constexpr bool
+  operator==(const ZeroVector &other) const noexcept = default;
+};
+
+namespace detail {
+
+/// Cache-line alignment of every coordinate array, so vector loads never
+/// straddle lines and AVX-512 code could use aligned loads.
+inline constexpr std::size_t CLOUD_ALIGN = 64;
+
+/// std::allocator with an over-aligned address.
+template <typename T> struct AlignedAllocator {
+  using value_type = T;
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  constexpr AlignedAllocator(const AlignedAllocator<U> &) noexcept {}
+
+  [[nodiscard]] T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{CLOUD_ALIGN}));
+  }
+
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t{CLOUD_ALIGN});
+  }
+
+  template <typename U>
+  [[nodiscard]] constexpr bool
+  operator==(const AlignedAllocator<U> &) const noexcept {
+    return true;
+  }
+};
+
+template <typename T>
+using cloud_array = std::vector<T, AlignedAllocator<T>>;
+
+inline void check_cloud_size(std::size_t expected, std::size_t actual) noexcept {
+  if (expected != actual) {
+    panic("pointcloud: sizes differ");
+  }
+}
+
+// ==================== Kernels ====================
+// Each kernel is called once per vector of points and once per tail point;
+// see simd::map_streams. Stream order is x, y(, z) of this cloud, then of
+// the other cloud.
+
+template <typename T> struct DistanceSquaredToPoint2 {
+  T px, py;
+
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[2],
+                                         V (&out)[1]) const noexcept {
+    V dx = in[0] - px;
+    V dy = in[1] - py;
+    out[0] = dx * dx + dy * dy;
+  }
+};
+
+template <typename T> struct DistanceToPoint2 {
+  T px, py;
+
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[2],
+                                         V (&out)[1]) const noexcept {
+    V dx = in[0] - px;
+    V dy = in[1] - py;
+    simd::sqrt(out[0], dx * dx + dy * dy);
+  }
+};
+
+struct DistanceBetween2 {
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[4],
+                                         V (&out)[1]) const noexcept {
+    V dx = in[0] - in[2];
+    V dy = in[1] - in[3];
+    simd::sqrt(out[0], dx * dx + dy * dy);
+  }
+};
+
+template <typename T> struct Lerp2 {
+  T t;
+
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[4],
+                                         V (&out)[2]) const noexcept {
+    out[0] = in[0] + t * (in[2] - in[0]);
+    out[1] = in[1] + t * (in[3] - in[1]);
+  }
+};
+
+template <typename T> struct Rotate2 {
+  T cos_a, sin_a;
+
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[2],
+                                         V (&out)[2]) const noexcept {
+    out[0] = in[0] * cos_a - in[1] * sin_a;
+    out[1] = in[0] * sin_a + in[1] * cos_a;
+  }
+};
+
+struct Magnitude3 {
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[3],
+                                         V (&out)[1]) const noexcept {
+    simd::sqrt(out[0], in[0] * in[0] + in[1] * in[1] + in[2] * in[2]);
+  }
+};
+
+template <typename T> struct DistanceToPoint3 {
+  T px, py, pz;
+
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[3],
+                                         V (&out)[1]) const noexcept {
+    V dx = in[0] - px;
+    V dy = in[1] - py;
+    V dz = in[2] - pz;
+    simd::sqrt(out[0], dx * dx + dy * dy + dz * dz);
+  }
+};
+
+template <typename T> struct DotVector3 {
+  T vx, vy, vz;
+
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[3],
+                                         V (&out)[1]) const noexcept {
+    out[0] = in[0] * vx + in[1] * vy + in[2] * vz;
+  }
+};
+
+struct DotBetween3 {
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[6],
+                                         V (&out)[1]) const noexcept {
+    out[0] = in[0] * in[3] + in[1] * in[4] + in[2] * in[5];
+  }
+};
+
+template <typename T> struct CrossVector3 {
+  T bx, by, bz;
+
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[3],
+                                         V (&out)[3]) const noexcept {
+    out[0] = in[1] * bz - in[2] * by;
+    out[1] = in[2] * bx - in[0] * bz;
+    out[2] = in[0] * by - in[1] * bx;
+  }
+};
+
+struct CrossBetween3 {
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[6],
+                                         V (&out)[3]) const noexcept {
+    out[0] = in[1] * in[5] - in[2] * in[4];
+    out[1] = in[2] * in[3] - in[0] * in[5];
+    out[2] = in[0] * in[4] - in[1] * in[3];
+  }
+};
+
+// One division and three multiplies: within an ulp of dividing each
+// component, and divisions are the slowest instructions here. The squares
+// must neither overflow nor fall into subnormals; PointCloud3::normalized
+// rescales the vectors for which they would.
+template <typename T> struct Normalize3 {
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[3],
+                                         V (&out)[3]) const noexcept {
+    V mag;
+    simd::sqrt(mag, in[0] * in[0] + in[1] * in[1] + in[2] * in[2]);
+    V inv = T(1) / mag;
+    out[0] = in[0] * inv;
+    out[1] = in[1] * inv;
+    out[2] = in[2] * inv;
+  }
+};
+
+template <typename T> struct Lerp3 {
+  T t;
+
+  template <typename V>
+  PULGACPP_ALWAYS_INLINE void operator()(const V (&in)[6],
+                                         V (&out)[3]) const noexcept {
+    out[0] = in[0] + t * (in[3] - in[0]);
+    out[1] = in[1] + t * (in[4] - in[1]);
+    out[2] = in[2] + t * (in[5] - in[2]);
+  }
+};
+
+} // namespace detail
+
+// ============================================================
+// PointCloud2
+// ============================================================
+
+/// A sequence of 2D points stored as separate x and y arrays.
+template <std::floating_point T> class PointCloud2 {
+public:
+  using value_type = T;
+  using point_type = Point<T>;
+  static constexpr std::string_view NAME = "PointCloud2";
+  static constexpr unsigned DIMENSIONS = 2;
+
+private:
+  detail::cloud_array<T> m_x;
+  detail::cloud_array<T> m_y;
+
+  explicit PointCloud2(std::size_t n) : m_x(n), m_y(n) {}
+
+public:
+  // ==================== Construction ====================
+
+  /// Default: empty cloud
+  PointCloud2() = default;
+
+  /// Factory: copy points from an array of Point<T>
+  [[nodiscard]] static PointCloud2 from(std::span<const Point<T>> points) {
+    PointCloud2 cloud(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      cloud.m_x[i] = points[i].x();
+      cloud.m_y[i] = points[i].y();
+    }
+    return cloud;
+  }
+
+  /// Factory: copy coordinates from separate arrays (None if sizes differ)
+  [[nodiscard]] static Optional<PointCloud2> from_coordinates(std::span<const T> xs,
+                                                              std::span<const T> ys) {
+    if (xs.size() != ys.size()) {
+      return None;
+    }
+    PointCloud2 cloud;
+    cloud.m_x.assign(xs.begin(), xs.end());
+    cloud.m_y.assign(ys.begin(), ys.end());
+    return Some(std::move(cloud));
+  }
+
+  /// Copy back to an array of Point<T>
+  [[nodiscard]] std::vector<Point<T>> to_points() const {
+    std::vector<Point<T>> points;
+    points.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+      points.push_back(Point<T>::from(m_x[i], m_y[i]));
+    }
+    return points;
+  }
+
+  // ==================== Size and Elements ====================
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_x.size(); }
+  [[nodiscard]] bool is_empty() const noexcept { return m_x.empty(); }
+
+  void reserve(std::size_t n) {
+    m_x.reserve(n);
+    m_y.reserve(n);
+  }
+
+  void clear() noexcept {
+    m_x.clear();
+    m_y.clear();
+  }
+
+  void push_back(Point<T> p) {
+    m_x.push_back(p.x());
+    m_y.push_back(p.y());
+  }
+
+  /// Point at index i (panics if out of range)
+  [[nodiscard]] Point<T> operator[](std::size_t i) const noexcept {
+    if (i >= size()) {
+      panic("pointcloud: index out of range");
+    }
+    return Point<T>::from(m_x[i], m_y[i]);
+  }
+
+  /// Replace the point at index i (panics if out of range)
+  void set(std::size_t i, Point<T> p) noexcept {
+    if (i >= size()) {
+      panic("pointcloud: index out of range");
+    }
+    m_x[i] = p.x();
+    m_y[i] = p.y();
+  }
+
+  /// Coordinate arrays, 64-byte aligned
+  [[nodiscard]] std::span<const T> xs() const noexcept { return m_x; }
+  [[nodiscard]] std::span<const T> ys() const noexcept { return m_y; }
+  [[nodiscard]] std::span<T> xs() noexcept { return m_x; }
+  [[nodiscard]] std::span<T> ys() noexcept { return m_y; }
+
+  // ==================== Distance ====================
+  // `out` must have size() elements (panics otherwise)
+
+  /// out[i] = (*this)[i].distance_to(p)
+  void distances_to(Point<T> p, std::span<T> out) const noexcept {
+    detail::check_cloud_size(size(), out.size());
+    detail::simd::dispatch_map_streams(
+        detail::DistanceToPoint2<T>{p.x(), p.y()},
+        std::array<const T *, 2>{m_x.data(), m_y.data()},
+        std::array<T *, 1>{out.data()}, size());
+  }
+
+  /// out[i] = (*this)[i].distance_squared(p)
+  void distances_squared_to(Point<T> p, std::span<T> out) const noexcept {
+    detail::check_cloud_size(size(), out.size());
+    detail::simd::dispatch_map_streams(
+        detail::DistanceSquaredToPoint2<T>{p.x(), p.y()},
+        std::array<const T *, 2>{m_x.data(), m_y.data()},
+        std::array<T *, 1>{out.data()}, size());
+  }
+
+  /// out[i] = (*this)[i].distance_to(other[i])
+  void distances_to(const PointCloud2 &other, std::span<T> out) const noexcept {
+    detail::check_cloud_size(size(), other.size());
+    detail::check_cloud_size(size(), out.size());
+    detail::simd::dispatch_map_streams(
+        detail::DistanceBetween2{},
+        std::array<const T *, 4>{m_x.data(), m_y.data(), other.m_x.data(),
+                                 other.m_y.data()},
+        std::array<T *, 1>{out.data()}, size());
+  }
+
+  // ==================== Geometry ====================
+
+  /// Point-wise linear interpolation: this[i] + t * (other[i] - this[i])
+  /// (panics if sizes differ)
+  [[nodiscard]] PointCloud2 lerp(const PointCloud2 &other, T t) const {
+    detail::check_cloud_size(size(), other.size());
+    PointCloud2 result(size());
+    detail::simd::dispatch_map_streams(
+        detail::Lerp2<T>{t},
+        std::array<const T *, 4>{m_x.data(), m_y.data(), other.m_x.data(),
+                                 other.m_y.data()},
+        std::array<T *, 2>{result.m_x.data(), result.m_y.data()}, size());
+    return result;
+  }
+
+  /// Rotate every point around the origin by angle (radians)
+  [[nodiscard]] PointCloud2 rotate(double angle) const {
+    PointCloud2 result(size());
+    detail::simd::dispatch_map_streams(
+        detail::Rotate2<T>{static_cast<T>(std::cos(angle)),
+                           static_cast<T>(std::sin(angle))},
+        std::array<const T *, 2>{m_x.data(), m_y.data()},
+        std::array<T *, 2>{result.m_x.data(), result.m_y.data()}, size());
+    return result;
+  }
+
+  // ==================== Comparison ====================
+
+  [[nodiscard]] bool operator==(const PointCloud2 &other) const noexcept {
+    return m_x == other.m_x && m_y == other.m_y;
+  }
+};
+
+// ============================================================
+// PointCloud3
+// ============================================================
+
+/// A sequence of 3D vectors stored as separate x, y and z arrays.
+template <std::floating_point T> class PointCloud3 {
+public:
+  using value_type = T;
+  using point_type = Vector3<T>;
+  static constexpr std::string_view NAME = "PointCloud3";
+  static constexpr unsigned DIMENSIONS = 3;
+
+private:
+  detail::cloud_array<T> m_x;
+  detail::cloud_array<T> m_y;
+  detail::cloud_array<T> m_z;
+
+  explicit PointCloud3(std::size_t n) : m_x(n), m_y(n), m_z(n) {}
+
+  [[nodiscard]] std::array<const T *, 3> streams() const noexcept {
+    return {m_x.data(), m_y.data(), m_z.data()};
+  }
+  [[nodiscard]] std::array<T *, 3> streams() noexcept {
+    return {m_x.data(), m_y.data(), m_z.data()};
+  }
+  [[nodiscard]] std::array<const T *, 6>
+  streams_with(const PointCloud3 &other) const noexcept {
+    return {m_x.data(),       m_y.data(),       m_z.data(),
+            other.m_x.data(), other.m_y.data(), other.m_z.data()};
+  }
+
+public:
+  // ==================== Construction ====================
+
+  /// Default: empty cloud
+  PointCloud3() = default;
+
+  /// Factory: copy vectors from an array of Vector3<T>
+  [[nodiscard]] static PointCloud3 from(std::span<const Vector3<T>> vectors) {
+    PointCloud3 cloud(vectors.size());
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+      cloud.m_x[i] = vectors[i].x();
+      cloud.m_y[i] = vectors[i].y();
+      cloud.m_z[i] = vectors[i].z();
+    }
+    return cloud;
+  }
+
+  /// Factory: copy coordinates from separate arrays (None if sizes differ)
+  [[nodiscard]] static Optional<PointCloud3>
+  from_coordinates(std::span<const T> xs, std::span<const T> ys,
+                   std::span<const T> zs) {
+    if (xs.size() != ys.size() || xs.size() != zs.size()) {
+      return None;
+    }
+    PointCloud3 cloud;
+    cloud.m_x.assign(xs.begin(), xs.end());
+    cloud.m_y.assign(ys.begin(), ys.end());
+    cloud.m_z.assign(zs.begin(), zs.end());
+    return Some(std::move(cloud));
+  }
+
+  /// Copy back to an array of Vector3<T>
+  [[nodiscard]] std::vector<Vector3<T>> to_vectors() const {
+    std::vector<Vector3<T>> vectors;
+    vectors.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+      vectors.push_back(Vector3<T>::from(m_x[i], m_y[i], m_z[i]));
+    }
+    return vectors;
+  }
+
+  // ==================== Size and Elements ====================
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_x.size(); }
+  [[nodiscard]] bool is_empty() const noexcept { return m_x.empty(); }
+
+  void reserve(std::size_t n) {
+    m_x.reserve(n);
+    m_y.reserve(n);
+    m_z.reserve(n);
+  }
+
+  void clear() noexcept {
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+  }
+
+  void push_back(Vector3<T> v) {
+    m_x.push_back(v.x());
+    m_y.push_back(v.y());
+    m_z.push_back(v.z());
+  }
+
+  /// Vector at index i (panics if out of range)
+  [[nodiscard]] Vector3<T> operator[](std::size_t i) const noexcept {
+    if (i >= size()) {
+      panic("pointcloud: index out of range");
+    }
+    return Vector3<T>::from(m_x[i], m_y[i], m_z[i]);
+  }
+
+  /// Replace the vector at index i (panics if out of range)
+  void set(std::size_t i, Vector3<T> v) noexcept {
+    if (i >= size()) {
+      panic("pointcloud: index out of range");
+    }
+    m_x[i] = v.x();
+    m_y[i] = v.y();
+    m_z[i] = v.z();
+  }
+
+  /// Coordinate arrays, 64-byte aligned
+  [[nodiscard]] std::span<const T> xs() const noexcept { return m_x; }
+  [[nodiscard]] std::span<const T> ys() const noexcept { return m_y; }
+  [[nodiscard]] std::span<const T> zs() const noexcept { return m_z; }
+  [[nodiscard]] std::span<T> xs() noexcept { return m_x; }
+  [[nodiscard]] std::span<T> ys() noexcept { return m_y; }
+  [[nodiscard]] std::span<T> zs() noexcept { return m_z; }
+
+  // ==================== Per-vector Values ====================
+  // `out` must have size() elements (panics otherwise)
+
+  /// out[i] = (*this)[i].magnitude()
+  void magnitudes(std::span<T> out) const noexcept {
+    detail::check_cloud_size(size(), out.size());
+    detail::simd::dispatch_map_streams(detail::Magnitude3{}, streams(),
+                                       std::array<T *, 1>{out.data()}, size());
+  }
+
+  /// out[i] = (*this)[i].distance_to(p)
+  void distances_to(Vector3<T> p, std::span<T> out) const noexcept {
+    detail::check_cloud_size(size(), out.size());
+    detail::simd::dispatch_map_streams(
+        detail::DistanceToPoint3<T>{p.x(), p.y(), p.z()}, streams(),
+        std::array<T *, 1>{out.data()}, size());
+  }
+
+  /// out[i] = (*this)[i].dot(v)
+  void dot(Vector3<T> v, std::span<T> out) const noexcept {
+    detail::check_cloud_size(size(), out.size());
+    detail::simd::dispatch_map_streams(
+        detail::DotVector3<T>{v.x(), v.y(), v.z()}, streams(),
+        std::array<T *, 1>{out.data()}, size());
+  }
+
+  /// out[i] = (*this)[i].dot(other[i])
+  void dot(const PointCloud3 &other, std::span<T> out) const noexcept {
+    detail::check_cloud_size(size(), other.size());
+    detail::check_cloud_size(size(), out.size());
+    detail::simd::dispatch_map_streams(detail::DotBetween3{},
+                                       streams_with(other),
+                                       std::array<T *, 1>{out.data()}, size());
+  }
+
+  // ==================== Vector Operations ====================
+
+  /// Cross product of every vector with v
+  [[nodiscard]] PointCloud3 cross(Vector3<T> v) const {
+    PointCloud3 result(size());
+    detail::simd::dispatch_map_streams(
+        detail::CrossVector3<T>{v.x(), v.y(), v.z()}, streams(),
+        result.streams(), size());
+    return result;
+  }
+
+  /// Element-wise cross product: this[i] × other[i] (panics if sizes differ)
+  [[nodiscard]] PointCloud3 cross(const PointCloud3 &other) const {
+    detail::check_cloud_size(size(), other.size());
+    PointCloud3 result(size());
+    detail::simd::dispatch_map_streams(detail::CrossBetween3{},
+                                       streams_with(other), result.streams(),
+                                       size());
+    return result;
+  }
+
+  /// Every vector scaled to unit length, like vec3_normalized. Err holds
+  /// the index of the first zero vector.
+  [[nodiscard]] Result<PointCloud3, ZeroVector> normalized() const {
+    // Below `small` a largest component's square loses bits to subnormals
+    // (smaller components lose less than an ulp of the sum); above `large`
+    // the sum of squares can overflow
+    using limits = std::numeric_limits<T>;
+    const T small = std::sqrt(limits::min() / limits::epsilon());
+    const T large = std::sqrt(limits::max()) / T(2);
+    auto largest_of = [this](std::size_t i) {
+      return std::max({std::abs(m_x[i]), std::abs(m_y[i]), std::abs(m_z[i])});
+    };
+    std::vector<std::size_t> rescale;
+    for (std::size_t i = 0; i < size(); ++i) {
+      const T largest = largest_of(i);
+      if (largest == T(0)) {
+        return Err(ZeroVector{i});
+      }
+      if (!(largest >= small && largest <= large)) {
+        rescale.push_back(i);
+      }
+    }
+    PointCloud3 result(size());
+    detail::simd::dispatch_map_streams(detail::Normalize3<T>{}, streams(),
+                                       result.streams(), size());
+    // Dividing by the largest component first brings the squares near 1
+    for (std::size_t i : rescale) {
+      const T largest = largest_of(i);
+      const T x = m_x[i] / largest;
+      const T y = m_y[i] / largest;
+      const T z = m_z[i] / largest;
+      const T mag = std::sqrt(x * x + y * y + z * z);
+      result.m_x[i] = x / mag;
+      result.m_y[i] = y / mag;
+      result.m_z[i] = z / mag;
+    }
+    return Ok(std::move(result));
+  }
+
+  /// Element-wise linear interpolation: this[i] + t * (other[i] - this[i])
+  /// (panics if sizes differ)
+  [[nodiscard]] PointCloud3 lerp(const PointCloud3 &other, T t) const {
+    detail::check_cloud_size(size(), other.size());
+    PointCloud3 result(size());
+    detail::simd::dispatch_map_streams(detail::Lerp3<T>{t},
+                                       streams_with(other), result.streams(),
+                                       size());
+    return result;
+  }
+
+  // ==================== Comparison ====================
+
+  [[nodiscard]] bool operator==(const PointCloud3 &other) const noexcept {
+    return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z;
+  }
+};
+
+// Type aliases
+using PointCloud2F = PointCloud2<float>;
+using PointCloud2D = PointCloud2<double>;
+using PointCloud3F = PointCloud3<float>;
+using PointCloud3D = PointCloud3<double>;
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_GEOMETRY_POINTCLOUD_HPP
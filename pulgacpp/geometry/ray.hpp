@@ -0,0 +1,470 @@
+// pulgacpp::Ray - Rays and their intersections with boxes, spheres and triangles
+// SPDX-License-Identifier: MIT
+//
+// Ray<T> is an origin and a direction: its points are origin + t *
+// direction for t >= 0, so t is measured in lengths of the direction. Each
+// intersection takes the farthest t the caller cares about (max_t) and
+// returns the first t at which the ray meets the primitive:
+//
+// - Box: slab test, multiplying by the inverse direction the ray keeps.
+//   t is where the ray enters (0 if it starts inside).
+// - Sphere: the nearer root of the quadratic (0 if it starts inside).
+// - Triangle: Möller–Trumbore, which also gives the barycentric u and v
+//   of the hit. Both faces count.
+//
+// RayPacket<T, N> holds 4 or 8 rays as structure of arrays and tests all
+// of them against one primitive at once, on GCC/Clang vector types (one
+// lane at a time elsewhere). The vectors are as wide as the translation
+// unit's target: -mavx2 tests 4 doubles or 8 floats per instruction. Each
+// lane keeps its own distance: a test lowers t[k] for every lane k that
+// hits nearer and returns a bit per such lane, so running a packet over a
+// list of primitives leaves each ray's nearest hit in t. StaticBvh walks a
+// packet of coherent rays (from neighbouring pixels, or shadow rays to one
+// light) down the tree together.
+//
+// Usage:
+//   #include <pulgacpp/geometry/ray.hpp>
+//
+//   auto ray = Rayd::from(eye, direction).unwrap();
+//   auto t = ray.intersect(sphere, 100.0);             // Optional<double>
+//   auto hit = ray.intersect_triangle(a, b, c, 100.0); // Optional<TriangleHit<double>>
+//
+//   auto packet = RayPacket<float, 8>::from(rays);     // 8 Rayf
+//   std::array<float, 8> t;
+//   t.fill(100.0f);
+//   unsigned hits = packet.intersect_triangle(a, b, c, t);
+
+#ifndef PULGACPP_GEOMETRY_RAY_HPP
+#define PULGACPP_GEOMETRY_RAY_HPP
+
+#include "../core/simd.hpp"
+#include "box.hpp"
+#include "shape.hpp"
+#include "sphere.hpp"
+#include "vector3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace pulgacpp {
+
+/// Where a ray meets a triangle a, b, c: at origin + t * direction, which
+/// is (1 - u - v) * a + u * b + v * c.
+template <std::floating_point T> struct TriangleHit {
+  T t;
+  T u;
+  T v;
+
+  [[nodiscard]] constexpr bool operator==(const TriangleHit &other) const noexcept = default;
+};
+
+/// A half-line from an origin along a direction.
+template <std::floating_point T> class Ray {
+public:
+  using value_type = T;
+  static constexpr std::string_view NAME = "Ray";
+  static constexpr unsigned DIMENSIONS = 3;
+
+private:
+  Vector3<T> m_origin;
+  Vector3<T> m_direction;
+  Vector3<T> m_inv_direction; // 1 / direction per axis, infinite where it is 0
+
+  Ray(Vector3<T> origin, Vector3<T> direction) noexcept
+      : m_origin(origin), m_direction(direction),
+        m_inv_direction(Vector3<T>::from(T(1) / direction.x(), T(1) / direction.y(),
+                                         T(1) / direction.z())) {}
+
+  [[nodiscard]] static bool is_finite(Vector3<T> v) noexcept {
+    return std::isfinite(v.x()) && std::isfinite(v.y()) && std::isfinite(v.z());
+  }
+
+public:
+  // ==================== Construction ====================
+
+  /// Ray from origin along direction (None unless both are finite and the
+  /// direction is not zero). The direction need not be a unit vector.
+  [[nodiscard]] static Optional<Ray> from(Vector3<T> origin, Vector3<T> direction) noexcept {
+    if (!is_finite(origin) || !is_finite(direction) ||
+        (direction.x() == T(0) && direction.y() == T(0) && direction.z() == T(0))) {
+      return None;
+    }
+    return Some(Ray(origin, direction));
+  }
+
+  /// Ray from origin through target, reaching it at t = 1 (None if they
+  /// are the same point or not finite)
+  [[nodiscard]] static Optional<Ray> through(Vector3<T> origin, Vector3<T> target) noexcept {
+    return from(origin, Vector3<T>::from(target.x() - origin.x(), target.y() - origin.y(),
+                                         target.z() - origin.z()));
+  }
+
+  // ==================== Accessors ====================
+
+  [[nodiscard]] constexpr Vector3<T> origin() const noexcept { return m_origin; }
+  [[nodiscard]] constexpr Vector3<T> direction() const noexcept { return m_direction; }
+
+  /// 1 / direction per axis (infinite where the direction is 0)
+  [[nodiscard]] constexpr Vector3<T> inv_direction() const noexcept { return m_inv_direction; }
+
+  /// The point origin + t * direction
+  [[nodiscard]] constexpr Vector3<T> at(T t) const noexcept {
+    return Vector3<T>::from(m_origin.x() + t * m_direction.x(), m_origin.y() + t * m_direction.y(),
+                            m_origin.z() + t * m_direction.z());
+  }
+
+  // ==================== Intersection ====================
+
+  /// Where the ray enters the box, for t in [0, max_t] (0 if it starts
+  /// inside; None if it misses). Boxes are closed, like Box::contains.
+  [[nodiscard]] Optional<T> intersect(const Box<T> &box, T max_t) const noexcept {
+    const std::array<T, 3> o = {m_origin.x(), m_origin.y(), m_origin.z()};
+    const std::array<T, 3> d = {m_direction.x(), m_direction.y(), m_direction.z()};
+    const std::array<T, 3> inv = {m_inv_direction.x(), m_inv_direction.y(), m_inv_direction.z()};
+    const std::array<T, 3> lo = {box.min().x(), box.min().y(), box.min().z()};
+    const std::array<T, 3> hi = {box.max().x(), box.max().y(), box.max().z()};
+    T t0 = T(0);
+    T t1 = max_t;
+    for (std::size_t k = 0; k < 3; ++k) {
+      if (d[k] == T(0)) {
+        // Parallel to this slab: inside it for every t or never
+        if (o[k] < lo[k] || o[k] > hi[k]) {
+          return None;
+        }
+        continue;
+      }
+      T a = (lo[k] - o[k]) * inv[k];
+      T b = (hi[k] - o[k]) * inv[k];
+      t0 = std::max(t0, std::min(a, b));
+      t1 = std::min(t1, std::max(a, b));
+    }
+    if (!(t0 <= t1)) {
+      return None;
+    }
+    return Some(t0);
+  }
+
+  /// Where the ray enters the sphere, for t in [0, max_t] (0 if it starts
+  /// inside; None if it misses)
+  [[nodiscard]] Optional<T> intersect(const Sphere<T> &sphere, T max_t) const noexcept {
+    const T ox = m_origin.x() - sphere.x();
+    const T oy = m_origin.y() - sphere.y();
+    const T oz = m_origin.z() - sphere.z();
+    const T dx = m_direction.x(), dy = m_direction.y(), dz = m_direction.z();
+    const T a = dx * dx + dy * dy + dz * dz;
+    const T b = ox * dx + oy * dy + oz * dz;
+    const T c = ox * ox + oy * oy + oz * oz - sphere.radius() * sphere.radius();
+    const T disc = b * b - a * c;
+    if (!(disc >= T(0))) {
+      return None;
+    }
+    T t = c <= T(0) ? T(0) : (-b - std::sqrt(disc)) / a;
+    if (!(t >= T(0) && t <= max_t)) {
+      return None;
+    }
+    return Some(t);
+  }
+
+  /// Where the ray crosses the triangle a, b, c, for t in [0, max_t], from
+  /// either side (None if it misses or runs parallel to its plane)
+  [[nodiscard]] Optional<TriangleHit<T>> intersect_triangle(Vector3<T> a, Vector3<T> b,
+                                                           Vector3<T> c,
+                                                           T max_t) const noexcept {
+    const T e1x = b.x() - a.x(), e1y = b.y() - a.y(), e1z = b.z() - a.z();
+    const T e2x = c.x() - a.x(), e2y = c.y() - a.y(), e2z = c.z() - a.z();
+    const T dx = m_direction.x(), dy = m_direction.y(), dz = m_direction.z();
+    const T px = dy * e2z - dz * e2y;
+    const T py = dz * e2x - dx * e2z;
+    const T pz = dx * e2y - dy * e2x;
+    const T inv = T(1) / (e1x * px + e1y * py + e1z * pz);
+    const T sx = m_origin.x() - a.x(), sy = m_origin.y() - a.y(), sz = m_origin.z() - a.z();
+    const T u = (sx * px + sy * py + sz * pz) * inv;
+    const T qx = sy * e1z - sz * e1y;
+    const T qy = sz * e1x - sx * e1z;
+    const T qz = sx * e1y - sy * e1x;
+    const T v = (dx * qx + dy * qy + dz * qz) * inv;
+    const T t = (e2x * qx + e2y * qy + e2z * qz) * inv;
+    // A parallel ray divides by zero; the NaN or infinity fails these
+    if (!(u >= T(0) && v >= T(0) && u + v <= T(1) && t >= T(0) && t <= max_t)) {
+      return None;
+    }
+    return Some(TriangleHit<T>{t, u, v});
+  }
+
+  // ==================== Comparison ====================
+
+  [[nodiscard]] constexpr bool operator==(const Ray &other) const noexcept {
+    return m_origin == other.m_origin && m_direction == other.m_direction;
+  }
+};
+
+namespace detail {
+
+// A packet kernel is a generic lambda called as kernel.template
+// operator()<V>(lane): with V a vector of the lanes from `lane` on, or with
+// V = T for one lane at a time. It returns the bits of the lanes that hit.
+// The vectors stay inside the kernel, so no vector type crosses a function
+// boundary.
+
+/// Widest vector the translation unit is compiled for; wider packets run
+/// in several chunks
+#if defined(__AVX__)
+inline constexpr std::size_t PACKET_BYTES = 32;
+#else
+inline constexpr std::size_t PACKET_BYTES = 16;
+#endif
+
+template <typename V, typename T, std::size_t N>
+PULGACPP_ALWAYS_INLINE void packet_load(V &out, const std::array<T, N> &from,
+                                        std::size_t lane) noexcept {
+  if constexpr (std::is_same_v<V, T>) {
+    out = from[lane];
+  } else {
+    simd::load(out, from.data() + lane);
+  }
+}
+
+template <typename V, typename T, std::size_t N>
+PULGACPP_ALWAYS_INLINE void packet_store(std::array<T, N> &to, const V &v,
+                                         std::size_t lane) noexcept {
+  if constexpr (std::is_same_v<V, T>) {
+    to[lane] = v;
+  } else {
+    simd::store(to.data() + lane, v);
+  }
+}
+
+/// Bit per lane set in a comparison mask whose first lane is `lane`
+template <typename M> PULGACPP_ALWAYS_INLINE unsigned packet_bits(const M &mask, std::size_t lane) noexcept {
+  if constexpr (std::is_arithmetic_v<M>) {
+    return mask ? 1u << lane : 0u;
+  } else {
+    unsigned bits = 0;
+    // Lanes are 0 or all ones; shifting their low bit keeps hits from
+    // turning into branches
+    for (std::size_t k = 0; k < sizeof(M) / sizeof(mask[0]); ++k) {
+      bits |= (unsigned(mask[k]) & 1u) << k;
+    }
+    return bits << lane;
+  }
+}
+
+template <typename T, std::size_t N, typename Kernel>
+PULGACPP_ALWAYS_INLINE unsigned run_packet(const Kernel &kernel) noexcept {
+  unsigned bits = 0;
+#if PULGACPP_VECTOR_EXT
+  constexpr std::size_t bytes = std::min(N * sizeof(T), PACKET_BYTES);
+  constexpr std::size_t width = bytes / sizeof(T);
+  for (std::size_t lane = 0; lane < N; lane += width) {
+    bits |= kernel.template operator()<simd::vec<T, bytes>>(lane);
+  }
+#else
+  for (std::size_t lane = 0; lane < N; ++lane) {
+    bits |= kernel.template operator()<T>(lane);
+  }
+#endif
+  return bits;
+}
+
+} // namespace detail
+
+/// N rays (4 or 8) stored as structure of arrays, tested together.
+template <std::floating_point T, std::size_t N> class RayPacket {
+  static_assert(N == 4 || N == 8, "a RayPacket holds 4 or 8 rays");
+
+public:
+  using value_type = T;
+  using Lanes = std::array<T, N>;
+  static constexpr std::size_t SIZE = N;
+  /// Bits of every lane
+  static constexpr unsigned ALL = (1u << N) - 1;
+
+private:
+  // [axis][lane], each array aligned for one vector load
+  alignas(sizeof(Lanes)) std::array<Lanes, 3> m_origin;
+  alignas(sizeof(Lanes)) std::array<Lanes, 3> m_direction;
+  alignas(sizeof(Lanes)) std::array<Lanes, 3> m_inv_direction;
+  std::array<bool, 3> m_parallel; // Whether some lane's direction is 0 on each axis
+
+  RayPacket() noexcept = default;
+
+public:
+  // ==================== Construction ====================
+
+  /// Packet of N rays; lane k is rays[k]
+  [[nodiscard]] static RayPacket from(std::span<const Ray<T>, N> rays) noexcept {
+    RayPacket packet;
+    packet.m_parallel = {false, false, false};
+    for (std::size_t k = 0; k < N; ++k) {
+      const Ray<T> &ray = rays[k];
+      const std::array<T, 3> o = {ray.origin().x(), ray.origin().y(), ray.origin().z()};
+      const std::array<T, 3> d = {ray.direction().x(), ray.direction().y(), ray.direction().z()};
+      const std::array<T, 3> inv = {ray.inv_direction().x(), ray.inv_direction().y(),
+                                    ray.inv_direction().z()};
+      for (std::size_t axis = 0; axis < 3; ++axis) {
+        packet.m_origin[axis][k] = o[axis];
+        packet.m_direction[axis][k] = d[axis];
+        packet.m_inv_direction[axis][k] = inv[axis];
+        packet.m_parallel[axis] = packet.m_parallel[axis] || d[axis] == T(0);
+      }
+    }
+    return packet;
+  }
+
+  // ==================== Accessors ====================
+
+  /// The ray in lane k
+  [[nodiscard]] Ray<T> ray(std::size_t k) const noexcept {
+    return Ray<T>::from(Vector3<T>::from(m_origin[0][k], m_origin[1][k], m_origin[2][k]),
+                        Vector3<T>::from(m_direction[0][k], m_direction[1][k], m_direction[2][k]))
+        .unwrap();
+  }
+
+  /// Origin coordinate `axis` (0-2) of every lane
+  [[nodiscard]] const Lanes &origins(std::size_t axis) const noexcept { return m_origin[axis]; }
+
+  /// Direction coordinate `axis` (0-2) of every lane
+  [[nodiscard]] const Lanes &directions(std::size_t axis) const noexcept {
+    return m_direction[axis];
+  }
+
+  // ==================== Intersection ====================
+
+  /// Lanes whose segment [0, max_t[k]] meets the box lo..hi; t[k] is
+  /// where lane k enters it (for lanes that hit). This is the test
+  /// hierarchies run on their nodes.
+  [[nodiscard]] unsigned enters(const std::array<T, 3> &lo, const std::array<T, 3> &hi,
+                                const Lanes &max_t, Lanes &t) const noexcept {
+    return detail::run_packet<T, N>([&]<typename V>(std::size_t lane) PULGACPP_INLINE_LAMBDA -> unsigned {
+      constexpr T inf = std::numeric_limits<T>::infinity();
+      V t0 = V{};
+      V t1;
+      detail::packet_load(t1, max_t, lane);
+      for (std::size_t axis = 0; axis < 3; ++axis) {
+        V o, inv;
+        detail::packet_load(o, m_origin[axis], lane);
+        detail::packet_load(inv, m_inv_direction[axis], lane);
+        V a = (lo[axis] - o) * inv;
+        V b = (hi[axis] - o) * inv;
+        V near = b < a ? b : a;
+        V far = a < b ? b : a;
+        if (m_parallel[axis]) {
+          // Lanes parallel to this slab are inside it for every t or never
+          V d;
+          detail::packet_load(d, m_direction[axis], lane);
+          V inside = ((o >= lo[axis]) & (o <= hi[axis])) ? V{} - inf : V{} + inf;
+          near = d == T(0) ? inside : near;
+          far = d == T(0) ? -inside : far;
+        }
+        t0 = t0 < near ? near : t0;
+        t1 = far < t1 ? far : t1;
+      }
+      detail::packet_store(t, t0, lane);
+      return detail::packet_bits(t0 <= t1, lane);
+    });
+  }
+
+  /// Lanes entering the box nearer than t[k]; their t[k] becomes where
+  /// they enter (0 if they start inside)
+  unsigned intersect(const Box<T> &box, Lanes &t) const noexcept {
+    Lanes entry;
+    unsigned hits = enters({box.min().x(), box.min().y(), box.min().z()},
+                           {box.max().x(), box.max().y(), box.max().z()}, t, entry);
+    for (std::size_t k = 0; k < N; ++k) {
+      t[k] = hits >> k & 1u ? entry[k] : t[k];
+    }
+    return hits;
+  }
+
+  /// Lanes entering the sphere nearer than t[k]; their t[k] becomes where
+  /// they enter (0 if they start inside)
+  unsigned intersect(const Sphere<T> &sphere, Lanes &t) const noexcept {
+    const T cx = sphere.x(), cy = sphere.y(), cz = sphere.z();
+    const T r2 = sphere.radius() * sphere.radius();
+    return detail::run_packet<T, N>([&]<typename V>(std::size_t lane) PULGACPP_INLINE_LAMBDA -> unsigned {
+      V ox, oy, oz, dx, dy, dz, limit;
+      detail::packet_load(ox, m_origin[0], lane);
+      detail::packet_load(oy, m_origin[1], lane);
+      detail::packet_load(oz, m_origin[2], lane);
+      detail::packet_load(dx, m_direction[0], lane);
+      detail::packet_load(dy, m_direction[1], lane);
+      detail::packet_load(dz, m_direction[2], lane);
+      detail::packet_load(limit, t, lane);
+      ox -= cx;
+      oy -= cy;
+      oz -= cz;
+      V a = dx * dx + dy * dy + dz * dz;
+      V b = ox * dx + oy * dy + oz * dz;
+      V c = ox * ox + oy * oy + oz * oz - r2;
+      V disc = b * b - a * c;
+      V root;
+      detail::simd::sqrt(root, disc < T(0) ? V{} : disc);
+      V hit_t = c <= T(0) ? V{} : (-b - root) / a;
+      auto hit = (disc >= T(0)) & (hit_t >= T(0)) & (hit_t <= limit);
+      detail::packet_store(t, hit ? hit_t : limit, lane);
+      return detail::packet_bits(hit, lane);
+    });
+  }
+
+  /// Lanes crossing the triangle a, b, c nearer than t[k], from either
+  /// side; their t[k] becomes the hit and u[k], v[k] its barycentrics
+  unsigned intersect_triangle(Vector3<T> a, Vector3<T> b, Vector3<T> c, Lanes &t, Lanes &u,
+                              Lanes &v) const noexcept {
+    const T e1x = b.x() - a.x(), e1y = b.y() - a.y(), e1z = b.z() - a.z();
+    const T e2x = c.x() - a.x(), e2y = c.y() - a.y(), e2z = c.z() - a.z();
+    const T ax = a.x(), ay = a.y(), az = a.z();
+    return detail::run_packet<T, N>([&]<typename V>(std::size_t lane) PULGACPP_INLINE_LAMBDA -> unsigned {
+      V dx, dy, dz, sx, sy, sz, limit;
+      detail::packet_load(dx, m_direction[0], lane);
+      detail::packet_load(dy, m_direction[1], lane);
+      detail::packet_load(dz, m_direction[2], lane);
+      detail::packet_load(sx, m_origin[0], lane);
+      detail::packet_load(sy, m_origin[1], lane);
+      detail::packet_load(sz, m_origin[2], lane);
+      detail::packet_load(limit, t, lane);
+      V px = dy * e2z - dz * e2y;
+      V py = dz * e2x - dx * e2z;
+      V pz = dx * e2y - dy * e2x;
+      V inv = T(1) / (e1x * px + e1y * py + e1z * pz);
+      sx -= ax;
+      sy -= ay;
+      sz -= az;
+      V hit_u = (sx * px + sy * py + sz * pz) * inv;
+      V qx = sy * e1z - sz * e1y;
+      V qy = sz * e1x - sx * e1z;
+      V qz = sx * e1y - sy * e1x;
+      V hit_v = (dx * qx + dy * qy + dz * qz) * inv;
+      V hit_t = (e2x * qx + e2y * qy + e2z * qz) * inv;
+      auto hit = (hit_u >= T(0)) & (hit_v >= T(0)) & (hit_u + hit_v <= T(1)) &
+                 (hit_t >= T(0)) & (hit_t <= limit);
+      V old_u, old_v;
+      detail::packet_load(old_u, u, lane);
+      detail::packet_load(old_v, v, lane);
+      detail::packet_store(t, hit ? hit_t : limit, lane);
+      detail::packet_store(u, hit ? hit_u : old_u, lane);
+      detail::packet_store(v, hit ? hit_v : old_v, lane);
+      return detail::packet_bits(hit, lane);
+    });
+  }
+
+  /// intersect_triangle() without the barycentrics
+  unsigned intersect_triangle(Vector3<T> a, Vector3<T> b, Vector3<T> c, Lanes &t) const noexcept {
+    Lanes u{}, v{};
+    return intersect_triangle(a, b, c, t, u, v);
+  }
+};
+
+// Type aliases
+using Rayf = Ray<float>;
+using Rayd = Ray<double>;
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_GEOMETRY_RAY_HPP
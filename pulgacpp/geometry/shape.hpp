@@ -4,10 +4,13 @@
 #ifndef PULGACPP_GEOMETRY_SHAPE_HPP
 #define PULGACPP_GEOMETRY_SHAPE_HPP
 
+#include "../core/overflow.hpp"
 #include "../optional/optional.hpp"
 
 #include <cmath>
 #include <concepts>
+#include <cstdint>
+#include <limits>
 #include <type_traits>
 #include <numbers>
 
@@ -24,6 +27,14 @@ concept SafeNumeric = requires {
     { std::declval<T>().get() } -> std::convertible_to<typename T::underlying_type>;
 };
 
+/// Concept for pulgacpp fixed-point types (Fixed<S, FracBits>): get() is the
+/// raw value scaled by 2^FRAC_BITS
+template <typename T>
+concept FixedPointNumeric = SafeNumeric<T> && requires {
+    { T::FRAC_BITS } -> std::convertible_to<unsigned>;
+    { std::declval<T>().to_double() } -> std::convertible_to<double>;
+};
+
 /// Concept for any numeric type usable in geometry
 template <typename T>
 concept Numeric = std::is_arithmetic_v<T> || SafeNumeric<T>;
@@ -34,11 +45,13 @@ concept FloatingPoint = std::floating_point<T>;
 
 /// Concept for integral types (native or pulgacpp)
 template <typename T>
-concept Integral = std::integral<T> || (SafeNumeric<T> && std::integral<typename T::underlying_type>);
+concept Integral = std::integral<T> ||
+    (SafeNumeric<T> && !FixedPointNumeric<T> && std::integral<typename T::underlying_type>);
 
 // ==================== Helper Functions ====================
 
-/// Extract raw numeric value from pulgacpp or native type
+/// Extract raw numeric value from pulgacpp or native type. For fixed-point
+/// types this is the scaled integer, which orders and compares the same way
 template <Numeric T>
 [[nodiscard]] constexpr auto raw(T value) noexcept {
     if constexpr (SafeNumeric<T>) {
@@ -51,7 +64,11 @@ template <Numeric T>
 /// Convert to double for calculations
 template <Numeric T>
 [[nodiscard]] constexpr double to_double(T value) noexcept {
-    return static_cast<double>(raw(value));
+    if constexpr (FixedPointNumeric<T>) {
+        return value.to_double();
+    } else {
+        return static_cast<double>(raw(value));
+    }
 }
 
 /// Mathematical constants
@@ -109,13 +126,16 @@ template <Numeric T>
     } else if constexpr (std::floating_point<T>) {
         return Some(a * b);
     } else {
-        // Simplified overflow check for native integers
-        if (a == 0 || b == 0) return Some(static_cast<T>(0));
-        T result = a * b;
-        if (a != 0 && result / a != b) {
+        // Multiply in 64 bits so the product itself cannot overflow (that
+        // would be UB for signed T), then range-check
+        using Wide = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+        auto [result, overflow] =
+            detail::checked_mul_native<Wide>(static_cast<Wide>(a), static_cast<Wide>(b));
+        if (overflow || result < static_cast<Wide>(std::numeric_limits<T>::min()) ||
+            result > static_cast<Wide>(std::numeric_limits<T>::max())) {
             return Optional<T>{None};  // Overflow occurred
         }
-        return Some(result);
+        return Some(static_cast<T>(result));
     }
 }
 
@@ -180,6 +200,17 @@ concept IsShape = requires {
 template <typename T>
 concept IsShape2D = IsShape<T> && T::DIMENSIONS == 2;
 
+// ==================== Spatial Indexes ====================
+
+/// Two objects of a spatial index (SpatialHashGrid, DynamicAabbTree) that
+/// overlap, by id, with a < b
+struct SpatialPair {
+    std::uint32_t a;
+    std::uint32_t b;
+
+    [[nodiscard]] constexpr bool operator==(const SpatialPair& other) const noexcept = default;
+};
+
 } // namespace pulgacpp
 
 #endif // PULGACPP_GEOMETRY_SHAPE_HPP
@@ -0,0 +1,409 @@
+// pulgacpp::SpatialHashGrid - Uniform grid for broad-phase circle queries
+// SPDX-License-Identifier: MIT
+//
+// Finding which of n circles overlap by calling Circle::overlaps on every
+// pair is O(n²). SpatialHashGrid buckets circles by the grid cell of their
+// center, so a query only looks at the cells its area can reach and the
+// all-pairs pass only compares circles in neighbouring cells.
+//
+// Each cell stores its circles inline (center, radius, id) in one array, so
+// a query scans contiguous memory, and pairs come out cell by cell. Moving
+// a circle within its cell rewrites it in place; crossing into another
+// cell is a swap-remove and an append.
+//
+// Pick a cell size around the largest diameter: much smaller and every
+// query visits many cells, much larger and each cell holds many circles.
+//
+// Usage:
+//   #include <pulgacpp/geometry/spatialhash.hpp>
+//
+//   auto grid = SpatialHashGrid<CircleD>::from(32.0).unwrap();
+//   auto id = grid.insert(CircleD::from(PointD::from(10, 10), 8).unwrap());
+//   grid.update(id, moved);
+//   for (auto other : grid.query_radius(player_pos, 50.0)) { ... }
+//   grid.for_each_overlapping_pair([](auto a, auto b) { resolve(a, b); });
+
+#ifndef PULGACPP_GEOMETRY_SPATIALHASH_HPP
+#define PULGACPP_GEOMETRY_SPATIALHASH_HPP
+
+#include "circle.hpp"
+#include "point.hpp"
+#include "shape.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace pulgacpp {
+
+/// Uniform spatial hash grid. Only SpatialHashGrid<Circle<T>> is provided.
+template <typename Shape> class SpatialHashGrid;
+
+/// A set of circles, each with a stable id, bucketed by a uniform grid.
+template <Numeric T> class SpatialHashGrid<Circle<T>> {
+public:
+  using value_type = Circle<T>;
+  /// Handle returned by insert(); reused after remove()
+  using Id = std::uint32_t;
+  static constexpr std::string_view NAME = "SpatialHashGrid";
+
+private:
+  static constexpr std::uint32_t NO_CELL = std::numeric_limits<std::uint32_t>::max();
+
+  /// A circle as stored in its cell: 32 bytes, two per cache line
+  struct Entry {
+    double x;
+    double y;
+    double r;
+    Id id;
+  };
+
+  /// Neighbours "after" a cell, so each neighbouring pair is visited once
+  static constexpr std::int32_t FORWARD[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+  struct Cell {
+    std::int32_t cx;
+    std::int32_t cy;
+    std::vector<Entry> entries;
+    /// Indices of the FORWARD neighbours (NO_CELL if absent). Cells are
+    /// never deleted before clear(), so links are made once, on creation.
+    std::array<std::uint32_t, 4> forward;
+  };
+
+  /// Where an id lives: cell index and position in that cell
+  struct Location {
+    std::uint32_t cell;
+    std::uint32_t slot;
+  };
+
+  double m_cell_size;
+  double m_inv_cell_size;
+  double m_max_radius = 0.0; // Never shrinks until clear()
+  std::size_t m_size = 0;
+  std::vector<Cell> m_cells;
+  std::unordered_map<std::uint64_t, std::uint32_t> m_cell_index;
+  std::vector<Location> m_locations; // Indexed by id
+  std::vector<Id> m_free_ids;
+  std::vector<Circle<T>> m_circles; // Indexed by id, exactly as inserted
+
+  explicit SpatialHashGrid(double cell_size) noexcept
+      : m_cell_size(cell_size), m_inv_cell_size(1.0 / cell_size) {}
+
+  [[nodiscard]] std::int32_t cell_coord(double v) const noexcept {
+    // Clamped so that far-away coordinates share the outermost cells
+    double c = std::floor(v * m_inv_cell_size);
+    if (std::isnan(c)) {
+      return 0; // A NaN centre overlaps nothing, so any cell will do
+    }
+    c = std::clamp(c, double(std::numeric_limits<std::int32_t>::min()),
+                   double(std::numeric_limits<std::int32_t>::max()));
+    return static_cast<std::int32_t>(c);
+  }
+
+  [[nodiscard]] static std::uint64_t key(std::int32_t cx, std::int32_t cy) noexcept {
+    return (std::uint64_t(std::uint32_t(cx)) << 32) | std::uint32_t(cy);
+  }
+
+  [[nodiscard]] const Cell *find_cell(std::int32_t cx, std::int32_t cy) const noexcept {
+    auto it = m_cell_index.find(key(cx, cy));
+    return it == m_cell_index.end() ? nullptr : &m_cells[it->second];
+  }
+
+  [[nodiscard]] std::uint32_t find_index(std::int64_t cx, std::int64_t cy) const noexcept {
+    if (cx != std::int32_t(cx) || cy != std::int32_t(cy)) {
+      return NO_CELL; // Past the clamped edge of the grid
+    }
+    auto it = m_cell_index.find(key(std::int32_t(cx), std::int32_t(cy)));
+    return it == m_cell_index.end() ? NO_CELL : it->second;
+  }
+
+  [[nodiscard]] std::uint32_t cell_for(std::int32_t cx, std::int32_t cy) {
+    auto [it, inserted] = m_cell_index.try_emplace(key(cx, cy), std::uint32_t(m_cells.size()));
+    if (!inserted) {
+      return it->second;
+    }
+    const std::uint32_t index = it->second;
+    Cell cell{cx, cy, {}, {}};
+    for (std::size_t j = 0; j < 4; ++j) {
+      auto [dx, dy] = FORWARD[j];
+      cell.forward[j] = find_index(std::int64_t(cx) + dx, std::int64_t(cy) + dy);
+      std::uint32_t before = find_index(std::int64_t(cx) - dx, std::int64_t(cy) - dy);
+      if (before != NO_CELL) {
+        m_cells[before].forward[j] = index;
+      }
+    }
+    m_cells.push_back(std::move(cell));
+    return index;
+  }
+
+  [[nodiscard]] static Entry entry_of(const Circle<T> &c, Id id) noexcept {
+    return Entry{to_double(c.center().x()), to_double(c.center().y()), to_double(c.radius()), id};
+  }
+
+  void append(std::uint32_t cell, const Entry &e) {
+    auto &entries = m_cells[cell].entries;
+    m_locations[e.id] = Location{cell, std::uint32_t(entries.size())};
+    entries.push_back(e);
+  }
+
+  void unlink(Location loc) noexcept {
+    auto &entries = m_cells[loc.cell].entries;
+    if (loc.slot + 1 != entries.size()) {
+      entries[loc.slot] = entries.back();
+      m_locations[entries[loc.slot].id].slot = loc.slot;
+    }
+    entries.pop_back();
+  }
+
+  void check_id(Id id) const noexcept {
+    if (!contains(id)) {
+      panic("spatial hash: unknown id");
+    }
+  }
+
+  [[nodiscard]] static bool overlap(const Entry &a, const Entry &b) noexcept {
+    // Circle::overlaps (distance < r1 + r2), compared squared
+    double dx = a.x - b.x;
+    double dy = a.y - b.y;
+    double r = a.r + b.r;
+    return dx * dx + dy * dy < r * r;
+  }
+
+  /// Number of cells a pair of circles can be apart and still overlap
+  /// (infinite if a circle is)
+  [[nodiscard]] double pair_reach() const noexcept {
+    return std::ceil(2.0 * m_max_radius * m_inv_cell_size);
+  }
+
+  /// Call f(id) for every circle overlapping the query circle q.
+  template <typename F> void for_each_near(const Entry &q, F &&f) const {
+    double reach = q.r + m_max_radius;
+    std::int32_t x0 = cell_coord(q.x - reach), x1 = cell_coord(q.x + reach);
+    std::int32_t y0 = cell_coord(q.y - reach), y1 = cell_coord(q.y + reach);
+    auto visit = [&](const Cell &cell) {
+      for (const Entry &e : cell.entries) {
+        if (overlap(q, e)) {
+          f(e.id);
+        }
+      }
+    };
+    double span = (double(x1) - x0 + 1) * (double(y1) - y0 + 1);
+    if (span > double(m_cells.size())) {
+      // The area covers more grid squares than there are cells: scan them
+      for (const Cell &cell : m_cells) {
+        if (cell.cx >= x0 && cell.cx <= x1 && cell.cy >= y0 && cell.cy <= y1) {
+          visit(cell);
+        }
+      }
+      return;
+    }
+    for (std::int32_t cx = x0;; ++cx) {
+      for (std::int32_t cy = y0;; ++cy) {
+        if (const Cell *cell = find_cell(cx, cy)) {
+          visit(*cell);
+        }
+        if (cy == y1) break;
+      }
+      if (cx == x1) break;
+    }
+  }
+
+public:
+  // ==================== Construction ====================
+
+  /// Factory: empty grid with square cells of the given size
+  /// Returns None unless cell_size is positive and finite
+  [[nodiscard]] static Optional<SpatialHashGrid> from(double cell_size) {
+    if (!(cell_size > 0.0) || !std::isfinite(cell_size) || !std::isfinite(1.0 / cell_size)) {
+      return None;
+    }
+    return Some(SpatialHashGrid(cell_size));
+  }
+
+  // ==================== Accessors ====================
+
+  [[nodiscard]] double cell_size() const noexcept { return m_cell_size; }
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+  [[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+
+  /// Number of cells that have held a circle since the last clear()
+  [[nodiscard]] std::size_t cell_count() const noexcept { return m_cells.size(); }
+
+  /// Whether id refers to a circle currently in the grid
+  [[nodiscard]] bool contains(Id id) const noexcept {
+    return id < m_locations.size() && m_locations[id].cell != NO_CELL;
+  }
+
+  /// The circle stored under id (panics if id is not in the grid)
+  [[nodiscard]] Circle<T> get(Id id) const noexcept {
+    check_id(id);
+    return m_circles[id];
+  }
+
+  // ==================== Modification ====================
+
+  /// Add a circle and return its id
+  Id insert(Circle<T> circle) {
+    Id id;
+    if (m_free_ids.empty()) {
+      id = Id(m_locations.size());
+      m_locations.push_back(Location{NO_CELL, 0});
+      m_circles.push_back(circle);
+    } else {
+      id = m_free_ids.back();
+      m_free_ids.pop_back();
+      m_circles[id] = circle;
+    }
+    Entry e = entry_of(circle, id);
+    m_max_radius = std::max(m_max_radius, e.r);
+    append(cell_for(cell_coord(e.x), cell_coord(e.y)), e);
+    ++m_size;
+    return id;
+  }
+
+  /// Replace the circle stored under id (panics if id is not in the grid)
+  void update(Id id, Circle<T> circle) {
+    check_id(id);
+    m_circles[id] = circle;
+    Entry e = entry_of(circle, id);
+    m_max_radius = std::max(m_max_radius, e.r);
+    Location loc = m_locations[id];
+    const Cell &cell = m_cells[loc.cell];
+    std::int32_t cx = cell_coord(e.x);
+    std::int32_t cy = cell_coord(e.y);
+    if (cx == cell.cx && cy == cell.cy) {
+      m_cells[loc.cell].entries[loc.slot] = e;
+      return;
+    }
+    unlink(loc);
+    append(cell_for(cx, cy), e);
+  }
+
+  /// Remove the circle stored under id (panics if id is not in the grid)
+  void remove(Id id) {
+    check_id(id);
+    unlink(m_locations[id]);
+    m_locations[id].cell = NO_CELL;
+    m_free_ids.push_back(id);
+    --m_size;
+  }
+
+  /// Remove every circle and forget all cells and ids
+  void clear() noexcept {
+    m_cells.clear();
+    m_cell_index.clear();
+    m_locations.clear();
+    m_free_ids.clear();
+    m_circles.clear();
+    m_size = 0;
+    m_max_radius = 0.0;
+  }
+
+  // ==================== Queries ====================
+
+  /// Call f(id) for every circle that overlaps `area` (Circle::overlaps)
+  template <typename F> void for_each_overlapping(Circle<T> area, F &&f) const {
+    for_each_near(entry_of(area, 0), f);
+  }
+
+  /// Ids of the circles that overlap `area`
+  [[nodiscard]] std::vector<Id> overlapping(Circle<T> area) const {
+    std::vector<Id> ids;
+    for_each_overlapping(area, [&ids](Id id) { ids.push_back(id); });
+    return ids;
+  }
+
+  /// Ids of the circles that overlap the disc of `radius` around `center`
+  /// (none for a negative radius)
+  [[nodiscard]] std::vector<Id> query_radius(Point<T> center, double radius) const {
+    std::vector<Id> ids;
+    if (radius >= 0.0) {
+      for_each_near(Entry{to_double(center.x()), to_double(center.y()), radius, 0},
+                    [&ids](Id id) { ids.push_back(id); });
+    }
+    return ids;
+  }
+
+  /// Call f(a, b) once for every pair of overlapping circles, with a < b.
+  /// Pairs come out cell by cell, in the order the cells were created.
+  template <typename F> void for_each_overlapping_pair(F &&f) const {
+    const double reach = pair_reach();
+    // Each cell looks at (reach + 1) * (2 * reach + 1) - reach neighbours;
+    // past the number of cells, comparing cells directly is cheaper
+    const bool scan =
+        !((reach + 1.0) * (2.0 * reach + 1.0) - reach <= double(m_cells.size()));
+    const auto k = scan ? 0 : static_cast<std::int32_t>(reach);
+    auto emit = [&f](const Entry &a, const Entry &b) {
+      if (!overlap(a, b)) {
+        return;
+      }
+      if (a.id < b.id) {
+        f(a.id, b.id);
+      } else {
+        f(b.id, a.id);
+      }
+    };
+    for (std::size_t c = 0; c < m_cells.size(); ++c) {
+      const Cell &cell = m_cells[c];
+      const auto &own = cell.entries;
+      for (std::size_t i = 0; i < own.size(); ++i) {
+        for (std::size_t j = i + 1; j < own.size(); ++j) {
+          emit(own[i], own[j]);
+        }
+      }
+      if (own.empty()) {
+        continue;
+      }
+      auto with_cell = [&](std::uint32_t other) {
+        if (other == NO_CELL) {
+          return;
+        }
+        for (const Entry &a : own) {
+          for (const Entry &b : m_cells[other].entries) {
+            emit(a, b);
+          }
+        }
+      };
+      if (scan) {
+        // Each pair of cells once: only cells created after this one
+        for (std::size_t other = c + 1; other < m_cells.size(); ++other) {
+          const Cell &next = m_cells[other];
+          if (std::abs(double(next.cx) - cell.cx) <= reach &&
+              std::abs(double(next.cy) - cell.cy) <= reach) {
+            with_cell(std::uint32_t(other));
+          }
+        }
+        continue;
+      }
+      if (reach <= 1.0) {
+        // Circles no larger than a cell: the linked neighbours suffice
+        for (std::uint32_t other : cell.forward) {
+          with_cell(other);
+        }
+        continue;
+      }
+      // Each neighbour pair once: only cells "after" this one
+      for (std::int32_t dy = 0; dy <= k; ++dy) {
+        for (std::int32_t dx = dy == 0 ? 1 : -k; dx <= k; ++dx) {
+          with_cell(find_index(std::int64_t(cell.cx) + dx, std::int64_t(cell.cy) + dy));
+        }
+      }
+    }
+  }
+
+  /// Every pair of overlapping circles, with a < b, in cell order
+  [[nodiscard]] std::vector<SpatialPair> overlapping_pairs() const {
+    std::vector<SpatialPair> pairs;
+    for_each_overlapping_pair([&pairs](Id a, Id b) { pairs.push_back(SpatialPair{a, b}); });
+    return pairs;
+  }
+};
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_GEOMETRY_SPATIALHASH_HPP
@@ -0,0 +1,282 @@
+// Test suite for pulgacpp DynamicAabbTree
+// Compile: g++ -std=c++23 -O2 -I. test_aabbtree.cpp
+
+#include "pulgacpp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace pulgacpp;
+using Tree = DynamicAabbTree;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const char *name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+AABB box(double x, double y, double z, double size) {
+  return AABB::from_points(Vec3d::from(x, y, z), Vec3d::from(x + size, y + size, z + size));
+}
+
+std::vector<SpatialPair> sorted(std::vector<SpatialPair> pairs) {
+  std::sort(pairs.begin(), pairs.end(), [](SpatialPair p, SpatialPair q) {
+    return p.a != q.a ? p.a < q.a : p.b < q.b;
+  });
+  return pairs;
+}
+
+std::vector<Tree::Id> sorted(std::vector<Tree::Id> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+/// Where origin + t * direction enters b for t in [0, max_t], by clipping
+/// one axis at a time (None if it misses)
+Optional<double> ray_enters(const AABB &b, Vec3d origin, Vec3d direction, double max_t) {
+  double t0 = 0.0, t1 = max_t;
+  double o[3] = {origin.x(), origin.y(), origin.z()};
+  double d[3] = {direction.x(), direction.y(), direction.z()};
+  double lo[3] = {b.min().x(), b.min().y(), b.min().z()};
+  double hi[3] = {b.max().x(), b.max().y(), b.max().z()};
+  for (int k = 0; k < 3; ++k) {
+    if (d[k] == 0.0) {
+      if (o[k] < lo[k] || o[k] > hi[k]) return None;
+      continue;
+    }
+    double a = (lo[k] - o[k]) / d[k], c = (hi[k] - o[k]) / d[k];
+    t0 = std::max(t0, std::min(a, c));
+    t1 = std::min(t1, std::max(a, c));
+  }
+  if (t0 > t1) return None;
+  return Some(t0);
+}
+
+// The tree multiplies by 1 / direction where ray_enters() divides
+bool close(double a, double b) { return std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(b)); }
+
+/// Shadow copy of the tree's contents, checked by brute force.
+struct Reference {
+  std::vector<Optional<AABB>> boxes; // Indexed by id
+
+  void set(Tree::Id id, AABB b) {
+    if (boxes.size() <= id) {
+      boxes.resize(id + 1);
+    }
+    boxes[id] = b;
+  }
+
+  template <typename Pred> std::vector<Tree::Id> matching(Pred pred) const {
+    std::vector<Tree::Id> out;
+    for (Tree::Id id = 0; id < boxes.size(); ++id) {
+      if (boxes[id].is_some() && pred(boxes[id].unwrap())) {
+        out.push_back(id);
+      }
+    }
+    return out;
+  }
+
+  std::vector<SpatialPair> pairs() const {
+    std::vector<SpatialPair> out;
+    for (Tree::Id a = 0; a < boxes.size(); ++a) {
+      for (Tree::Id b = a + 1; b < boxes.size(); ++b) {
+        if (boxes[a].is_some() && boxes[b].is_some() &&
+            boxes[a].unwrap().intersects(boxes[b].unwrap())) {
+          out.push_back({a, b});
+        }
+      }
+    }
+    return out;
+  }
+};
+
+/// Random inserts, moves (small and across the world) and removes,
+/// compared against brute force after every round.
+bool matches_brute_force(double margin, unsigned seed) {
+  auto tree = Tree::from(margin).unwrap();
+  Reference ref;
+  std::vector<Tree::Id> live;
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(-100.0, 100.0);
+  std::uniform_real_distribution<double> step(-2.0, 2.0);
+  std::uniform_real_distribution<double> size(0.0, 15.0);
+  std::uniform_int_distribution<int> action(0, 9);
+
+  bool ok = true;
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 50; ++i) {
+      int a = action(rng);
+      if (a < 4 || live.empty()) {
+        auto b = box(coord(rng), coord(rng), coord(rng), size(rng));
+        auto id = tree.insert(b);
+        ref.set(id, b);
+        live.push_back(id);
+      } else if (a < 8) {
+        auto id = live[rng() % live.size()];
+        auto old = tree.get(id).min();
+        double dx = step(rng), dy = step(rng), dz = step(rng);
+        auto b = a < 7 ? box(old.x() + dx, old.y() + dy, old.z() + dz, tree.get(id).width())
+                       : box(coord(rng), coord(rng), coord(rng), size(rng));
+        tree.update(id, b, Vec3d::from(dx, dy, dz));
+        ref.set(id, b);
+      } else {
+        std::size_t k = rng() % live.size();
+        tree.remove(live[k]);
+        ref.boxes[live[k]] = None;
+        live.erase(live.begin() + static_cast<std::ptrdiff_t>(k));
+      }
+    }
+    ok &= tree.size() == live.size();
+    ok &= sorted(tree.overlapping_pairs()) == ref.pairs();
+
+    auto area = box(coord(rng), coord(rng), coord(rng), size(rng) * 3);
+    ok &= sorted(tree.overlapping(area)) ==
+          ref.matching([&](const AABB &b) { return b.intersects(area); });
+
+    auto point = Vec3d::from(coord(rng), coord(rng), coord(rng));
+    ok &= sorted(tree.containing(point)) ==
+          ref.matching([&](const AABB &b) { return b.contains(point); });
+
+    // Rays from outside the world towards a random point, with one axis
+    // sometimes zero
+    auto origin = Vec3d::from(coord(rng), coord(rng), -150.0);
+    auto direction = Vec3d::from(round % 3 == 0 ? 0.0 : step(rng), step(rng), 1.0);
+    double max_t = 250.0;
+    std::vector<Tree::Id> hits;
+    bool same_t = true;
+    tree.for_each_ray_hit(origin, direction, max_t, [&](Tree::Id id, double t) {
+      hits.push_back(id);
+      same_t &= close(t, ray_enters(ref.boxes[id].unwrap(), origin, direction, max_t).unwrap());
+    });
+    ok &= same_t;
+    ok &= sorted(hits) == ref.matching([&](const AABB &b) {
+      return ray_enters(b, origin, direction, max_t).is_some();
+    });
+
+    double nearest = std::numeric_limits<double>::infinity();
+    for (auto id : hits) {
+      nearest = std::min(nearest, ray_enters(ref.boxes[id].unwrap(), origin, direction, max_t).unwrap());
+    }
+    auto first = tree.ray_cast(origin, direction, max_t);
+    ok &= hits.empty() ? first.is_none() : first.is_some() && close(first.unwrap().t, nearest);
+  }
+  return ok;
+}
+
+int main() {
+  std::cout << "=== DynamicAabbTree Test Suite ===\n\n";
+
+  // ==================== Construction ====================
+  std::cout << "--- Construction ---\n";
+
+  test(Tree::from(0.0).is_some() && Tree::from(0.5).is_some(), "from() accepts margins >= 0");
+  test(Tree::from(-1.0).is_none(), "from() rejects a negative margin");
+  test(Tree::from(std::numeric_limits<double>::infinity()).is_none() &&
+           Tree::from(std::numeric_limits<double>::quiet_NaN()).is_none(),
+       "from() rejects non-finite margins");
+
+  auto tree = Tree::from(1.0).unwrap();
+  test(tree.is_empty() && tree.height() == 0, "new tree is empty");
+  test(tree.overlapping_pairs().empty() && tree.ray_cast(Vec3d::zero(), Vec3d::unit_x(), 10).is_none(),
+       "queries on an empty tree find nothing");
+
+  // ==================== Insert, Update, Remove ====================
+  std::cout << "\n--- Modification ---\n";
+
+  auto a = tree.insert(box(0, 0, 0, 2));
+  auto b = tree.insert(box(1, 1, 1, 2));
+  auto c = tree.insert(box(10, 10, 10, 2));
+  test(tree.size() == 3 && tree.contains(a) && tree.contains(c), "insert() returns live ids");
+  test(tree.get(b) == box(1, 1, 1, 2), "get() returns the exact box");
+  test(tree.fat_box(a) == box(-1, -1, -1, 4), "fat_box() adds the margin");
+  test(tree.overlapping_pairs() == std::vector<SpatialPair>{{a, b}}, "one intersecting pair");
+
+  test(!tree.update(c, box(10.5, 10, 10, 2)), "a move inside the fat box keeps the leaf");
+  test(tree.get(c) == box(10.5, 10, 10, 2), "... but records the new box");
+  test(tree.update(c, box(2.5, 2.5, 2.5, 2)), "a move out of the fat box reinserts");
+  test(sorted(tree.overlapping_pairs()) == std::vector<SpatialPair>{{a, b}, {b, c}},
+       "pairs follow the moved box");
+
+  test(tree.update(a, box(3, 0, 0, 2), Vec3d::from(50, 0, 0)) &&
+           tree.fat_box(a) == AABB::from_points(Vec3d::from(2, -1, -1), Vec3d::from(56, 3, 3)),
+       "displacement stretches the fat box ahead");
+  test(!tree.update(a, box(5, 0, 0, 2), Vec3d::from(50, 0, 0)), "... so the next move stays inside");
+  test(tree.update(a, box(5, 0, 0, 2)) && tree.fat_box(a) == box(4, -1, -1, 4),
+       "a stopped box gets a tight fat box again");
+
+  tree.remove(b);
+  test(!tree.contains(b) && tree.size() == 2, "remove() forgets the id");
+  test(tree.overlapping_pairs().empty(), "removed boxes no longer pair");
+  test(tree.insert(box(50, 50, 50, 1)) == b, "remove()d ids are reused");
+
+  // Touching boxes intersect, like Box::intersects
+  auto touching = Tree::from(0.0).unwrap();
+  (void)touching.insert(box(0, 0, 0, 1));
+  (void)touching.insert(box(1, 0, 0, 1));
+  test(touching.overlapping_pairs().size() == 1, "touching boxes are a pair");
+
+  tree.clear();
+  test(tree.is_empty() && !tree.contains(a) && tree.overlapping_pairs().empty(),
+       "clear() empties the tree");
+
+  // Boxes in sorted order are the worst case for insertion without rotations
+  auto line = Tree::from(0.0).unwrap();
+  for (int i = 0; i < 1024; ++i) {
+    (void)line.insert(box(i * 2.0, 0, 0, 1));
+  }
+  test(line.height() <= 20, "1024 boxes inserted in order stay shallow");
+
+  // ==================== Queries ====================
+  std::cout << "\n--- Queries ---\n";
+
+  auto world = Tree::from(0.5).unwrap();
+  auto wall = world.insert(AABB::from_points(Vec3d::from(5, -5, -5), Vec3d::from(6, 5, 5)));
+  auto crate = world.insert(box(10, -1, -1, 2));
+  auto floor = world.insert(AABB::from_points(Vec3d::from(-20, -6, -20), Vec3d::from(20, -5, 20)));
+
+  test(sorted(world.containing(Vec3d::from(5.5, -5, 0))) == std::vector<Tree::Id>{wall, floor},
+       "containing() includes boxes touching the point");
+  test(world.overlapping(box(9, -0.5, -0.5, 1)) == std::vector<Tree::Id>{crate},
+       "overlapping() finds the crate");
+
+  auto hit = world.ray_cast(Vec3d::zero(), Vec3d::unit_x(), 100.0);
+  test(hit.is_some() && hit.unwrap() == Tree::Hit{wall, 5.0}, "ray_cast() stops at the wall");
+  test(world.ray_cast(Vec3d::zero(), Vec3d::unit_x(), 4.0).is_none(), "max_t cuts the ray short");
+  hit = world.ray_cast(Vec3d::from(5.5, 0, 0), Vec3d::unit_x(), 100.0);
+  test(hit.is_some() && hit.unwrap().t == 0.0, "a ray starting inside a box hits it at t = 0");
+  hit = world.ray_cast(Vec3d::from(7, 0, 0), Vec3d::from(0.5, 0, 0), 100.0);
+  test(hit.is_some() && hit.unwrap() == Tree::Hit{crate, 6.0}, "t is in units of direction");
+  test(world.ray_cast(Vec3d::from(7, 0, 0), Vec3d::unit_y(), 100.0).is_none(),
+       "a ray parallel to a face misses beside it");
+  test(world.ray_cast(Rayd::from(Vec3d::zero(), Vec3d::unit_x()).unwrap(), 100.0) ==
+           Some(Tree::Hit{wall, 5.0}),
+       "ray_cast() takes a Ray");
+
+  std::size_t hits = 0;
+  world.for_each_ray_hit(Vec3d::from(0, 0, 0), Vec3d::unit_x(), 100.0, [&](auto, auto) { ++hits; });
+  test(hits == 2, "for_each_ray_hit() reports every box on the ray");
+
+  // ==================== Brute-force Comparison ====================
+  std::cout << "\n--- Brute Force ---\n";
+
+  test(matches_brute_force(0.0, 1), "no margin");
+  test(matches_brute_force(0.5, 2), "small margin");
+  test(matches_brute_force(10.0, 3), "margin larger than the moves");
+
+  // ==================== Summary ====================
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
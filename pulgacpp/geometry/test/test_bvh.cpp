@@ -0,0 +1,376 @@
+// Test suite for pulgacpp StaticBvh
+// Compile: g++ -std=c++23 -O2 -pthread -I. test_bvh.cpp
+
+#include "pulgacpp.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace pulgacpp;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const char *name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+AABB box(double x, double y, double z, double size) {
+  return AABB::from_points(Vec3d::from(x, y, z), Vec3d::from(x + size, y + size, z + size));
+}
+
+std::vector<std::uint32_t> sorted(std::vector<std::uint32_t> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+/// Where origin + t * direction enters b for t in [0, max_t], by clipping
+/// one axis at a time (None if it misses)
+Optional<double> ray_enters(const AABB &b, Vec3d origin, Vec3d direction, double max_t) {
+  double t0 = 0.0, t1 = max_t;
+  double o[3] = {origin.x(), origin.y(), origin.z()};
+  double d[3] = {direction.x(), direction.y(), direction.z()};
+  double lo[3] = {b.min().x(), b.min().y(), b.min().z()};
+  double hi[3] = {b.max().x(), b.max().y(), b.max().z()};
+  for (int k = 0; k < 3; ++k) {
+    if (d[k] == 0.0) {
+      if (o[k] < lo[k] || o[k] > hi[k]) return None;
+      continue;
+    }
+    double a = (lo[k] - o[k]) / d[k], c = (hi[k] - o[k]) / d[k];
+    t0 = std::max(t0, std::min(a, c));
+    t1 = std::min(t1, std::max(a, c));
+  }
+  if (t0 > t1) return None;
+  return Some(t0);
+}
+
+// The hierarchy multiplies by 1 / direction where ray_enters() divides
+bool close(double a, double b) { return std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(b)); }
+
+/// Random boxes of mixed sizes, some of them clustered on one spot
+std::vector<AABB> scene(std::size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(-100.0, 100.0);
+  std::uniform_real_distribution<double> size(0.0, 8.0);
+  std::vector<AABB> boxes;
+  for (std::size_t i = 0; i < n; ++i) {
+    boxes.push_back(i % 10 == 0 ? box(5, 5, 5, 1) : box(coord(rng), coord(rng), coord(rng), size(rng)));
+  }
+  return boxes;
+}
+
+/// Box, point and ray queries against brute force
+template <std::size_t Width> bool matches_brute_force(std::size_t n, unsigned seed) {
+  auto boxes = scene(n, seed);
+  auto bvh = StaticBvh<Width>::from(std::span<const AABB>(boxes), {.max_leaf_size = 3, .bins = 8});
+  std::mt19937 rng(seed + 100);
+  std::uniform_real_distribution<double> coord(-120.0, 120.0);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+  bool ok = bvh.size() == n;
+  for (int q = 0; q < 50; ++q) {
+    auto area = box(coord(rng), coord(rng), coord(rng), 30.0);
+    auto point = Vec3d::from(coord(rng) / 2, coord(rng) / 2, coord(rng) / 2);
+    std::vector<std::uint32_t> overlapping, containing;
+    for (std::uint32_t id = 0; id < n; ++id) {
+      if (boxes[id].intersects(area)) overlapping.push_back(id);
+      if (boxes[id].contains(point)) containing.push_back(id);
+    }
+    ok &= sorted(bvh.overlapping(area)) == overlapping;
+    ok &= sorted(bvh.containing(point)) == containing;
+
+    // Every fourth ray runs along an axis, to cover the zero-direction slabs
+    auto origin = Vec3d::from(coord(rng), coord(rng), coord(rng));
+    auto direction = q % 4 == 0 ? Vec3d::from(0, 0, unit(rng) < 0 ? -1 : 1)
+                                : Vec3d::from(unit(rng), unit(rng), unit(rng));
+    Optional<double> nearest = None;
+    std::vector<std::uint32_t> hits;
+    for (std::uint32_t id = 0; id < n; ++id) {
+      auto t = ray_enters(boxes[id], origin, direction, 500.0);
+      if (t.is_some()) {
+        hits.push_back(id);
+        if (nearest.is_none() || t.unwrap() < nearest.unwrap()) nearest = t;
+      }
+    }
+    std::vector<std::uint32_t> found;
+    bvh.for_each_ray_hit(origin, direction, 500.0, [&](std::uint32_t id, double t) {
+      found.push_back(id);
+      ok &= close(t, ray_enters(boxes[id], origin, direction, 500.0).unwrap_or(-1.0));
+    });
+    ok &= sorted(found) == hits;
+
+    auto hit = bvh.ray_cast(origin, direction, 500.0);
+    ok &= hit.is_some() == nearest.is_some();
+    if (hit.is_some() && nearest.is_some()) {
+      // Ties may pick either box; the one picked must be entered at t
+      ok &= close(hit.unwrap().t, nearest.unwrap());
+      ok &= close(ray_enters(boxes[hit.unwrap().id], origin, direction, 500.0).unwrap_or(-1.0),
+                  hit.unwrap().t);
+    }
+  }
+  return ok;
+}
+
+/// Packet casts, lane by lane, against the same rays cast one at a time:
+/// boxes on the box scene and exact spheres on a sphere scene. Even packets
+/// are coherent (one origin, nearby directions), odd ones random.
+template <std::size_t Width, std::size_t N> bool packets_match_single_casts(unsigned seed) {
+  auto boxes = scene(3000, seed);
+  auto bvh = StaticBvh<Width>::from(std::span<const AABB>(boxes));
+  std::mt19937 rng(seed + 200);
+  std::uniform_real_distribution<double> coord(-120.0, 120.0);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  std::uniform_real_distribution<double> radius(0.5, 4.0);
+  std::vector<Sphered> spheres;
+  for (int i = 0; i < 1000; ++i) {
+    spheres.push_back(Sphered::from(Vec3d::from(coord(rng), coord(rng), coord(rng)), radius(rng)).unwrap());
+  }
+  auto balls = StaticBvh<Width>::from(std::span<const Sphered>(spheres));
+
+  bool ok = true;
+  for (int q = 0; q < 100; ++q) {
+    auto origin = Vec3d::from(coord(rng), coord(rng), coord(rng));
+    auto aim = Vec3d::from(unit(rng), unit(rng), unit(rng));
+    std::vector<Rayd> rays;
+    std::array<double, N> max_t;
+    for (std::size_t k = 0; k < N; ++k) {
+      auto from = q % 2 == 0 ? origin : Vec3d::from(coord(rng), coord(rng), coord(rng));
+      auto direction = q % 2 == 0 ? Vec3d::from(aim.x() + unit(rng) / 20, aim.y() + unit(rng) / 20,
+                                                aim.z() + unit(rng) / 20)
+                                  : Vec3d::from(unit(rng), unit(rng), unit(rng));
+      direction = k == 1 ? Vec3d::from(0, unit(rng) < 0 ? -1 : 1, 0) : direction;
+      rays.push_back(Rayd::from(from, direction).unwrap_or(Rayd::from(from, Vec3d::unit_x()).unwrap()));
+      max_t[k] = k == 2 ? 20.0 : 500.0;
+    }
+    auto packet = RayPacket<double, N>::from(std::span<const Rayd, N>(rays.data(), N));
+
+    auto hits = bvh.ray_cast(packet, max_t);
+    auto sphere_hits = balls.ray_cast(packet, max_t, [&](std::uint32_t id, std::array<double, N> &t) {
+      return packet.intersect(spheres[id], t);
+    });
+    for (std::size_t k = 0; k < N; ++k) {
+      auto single = bvh.ray_cast(rays[k], max_t[k]);
+      ok &= hits[k].is_some() == single.is_some();
+      if (hits[k].is_some() && single.is_some()) {
+        // Ties may pick either box; the one picked must be entered at t
+        ok &= close(hits[k].unwrap().t, single.unwrap().t);
+        ok &= close(ray_enters(boxes[hits[k].unwrap().id], rays[k].origin(), rays[k].direction(),
+                               max_t[k])
+                        .unwrap_or(-1.0),
+                    hits[k].unwrap().t);
+      }
+      auto single_sphere = balls.ray_cast(rays[k], max_t[k], [&](std::uint32_t id, double limit) {
+        return rays[k].intersect(spheres[id], limit);
+      });
+      ok &= sphere_hits[k] == single_sphere;
+    }
+  }
+  return ok;
+}
+
+/// An image copied into 8-byte-aligned storage, as a mapped file would be
+std::vector<double> copy_image(std::span<const std::byte> bytes) {
+  std::vector<double> storage((bytes.size() + 7) / 8);
+  std::memcpy(storage.data(), bytes.data(), bytes.size());
+  return storage;
+}
+
+std::span<const std::byte> view(const std::vector<double> &storage, std::size_t size) {
+  return {reinterpret_cast<const std::byte *>(storage.data()), size};
+}
+
+bool same_image(std::span<const std::byte> a, std::span<const std::byte> b) {
+  return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+}
+
+int main() {
+  std::cout << "=== StaticBvh Test Suite ===\n\n";
+
+  // ==================== Construction ====================
+  std::cout << "--- Construction ---\n";
+
+  auto empty = Bvh4::from(std::span<const AABB>());
+  test(empty.is_empty() && empty.node_count() == 0 && empty.bounds().is_none(),
+       "empty hierarchy");
+  test(empty.overlapping(box(0, 0, 0, 1e9)).empty() &&
+           empty.ray_cast(Vec3d::zero(), Vec3d::unit_x(), 1e9).is_none(),
+       "queries on an empty hierarchy find nothing");
+
+  std::vector<AABB> one = {box(1, 2, 3, 1)};
+  auto single = Bvh8::from(std::span<const AABB>(one));
+  test(single.size() == 1 && single.node_count() == 1, "one box is one node");
+  test(single.bounds() == Some(box(1, 2, 3, 1)), "bounds() of one box");
+  test(single.containing(Vec3d::from(1.5, 2.5, 3.5)) == std::vector<std::uint32_t>{0},
+       "containing() finds the box");
+
+  std::vector<AABB> row;
+  for (int i = 0; i < 10; ++i) {
+    row.push_back(box(i * 10.0, 0, 0, 1));
+  }
+  auto binary = Bvh2::from(std::span<const AABB>(row), {.max_leaf_size = 1});
+  test(binary.node_count() == 19, "one box per leaf: 2n - 1 binary nodes");
+  test(binary.bounds() == AABB::from_corners(Vec3d::zero(), Vec3d::from(91, 1, 1)),
+       "bounds() covers every box");
+  auto wide = Bvh4::from(std::span<const AABB>(row), {.max_leaf_size = 1});
+  test(wide.node_count() < binary.node_count() / 2, "wide nodes collapse the binary tree");
+
+  auto hit = binary.ray_cast(Vec3d::from(-5, 0.5, 0.5), Vec3d::unit_x(), 1000.0);
+  test(hit == Some(Bvh2::Hit{0, 5.0}), "ray_cast() finds the nearest box");
+  auto wide_hit = wide.ray_cast(Vec3d::from(200, 0.5, 0.5), Vec3d::from(-1, 0, 0), 1000.0);
+  test(wide_hit == Some(Bvh4::Hit{9, 109.0}), "ray_cast() against the axis order");
+  test(wide.ray_cast(Vec3d::from(-5, 0.5, 0.5), Vec3d::unit_x(), 4.0).is_none(),
+       "ray_cast() stops at max_t");
+
+  // Identical boxes cannot be split by centroid but still respect the leaf size
+  std::vector<AABB> stacked(20, box(0, 0, 0, 1));
+  auto pile = Bvh2::from(std::span<const AABB>(stacked), {.max_leaf_size = 4});
+  test(pile.containing(Vec3d::from(0.5, 0.5, 0.5)).size() == 20, "identical boxes all found");
+  test(pile.node_count() >= 9, "identical boxes are still split into small leaves");
+
+  // Point boxes on a line: every node has zero area, so the SAH is 0 / 0
+  std::vector<AABB> line;
+  for (int i = 0; i < 4096; ++i) {
+    auto p = Vec3d::from(1000.0 * i / 4095, 0, 0);
+    line.push_back(AABB::from_points(p, p));
+  }
+  std::shuffle(line.begin(), line.end(), std::mt19937(7));
+  auto beads = Bvh2::from(std::span<const AABB>(line));
+  auto line_bytes = beads.to_bytes();
+  auto line_image = copy_image(line_bytes);
+  const auto *line_nodes = reinterpret_cast<const BvhNode *>(reinterpret_cast<const std::byte *>(line_image.data()) + 128);
+  double widest_leaf = 0.0;
+  for (std::size_t i = 0; i < beads.node_count(); ++i) {
+    if (line_nodes[i].count > 0) {
+      widest_leaf = std::max(widest_leaf, double(line_nodes[i].max[0] - line_nodes[i].min[0]));
+    }
+  }
+  test(widest_leaf < 2.0, "collinear boxes are split at the median into short leaves");
+  auto bead = Vec3d::from(1000.0 * 7 / 4095, 0, 0);
+  test(beads.containing(bead).size() == 1 && line[beads.containing(bead)[0]].contains(bead),
+       "collinear boxes are found");
+
+  // ==================== Spheres ====================
+  std::cout << "\n--- Spheres ---\n";
+
+  std::vector<Sphered> spheres = {Sphered::from(Vec3d::from(0, 0, 0), 1).unwrap(),
+                                  Sphered::from(Vec3d::from(10, 0, 0), 2).unwrap()};
+  auto balls = Bvh4::from(std::span<const Sphered>(spheres));
+  test(balls.bounds() == AABB::from_corners(Vec3d::from(-1, -2, -2), Vec3d::from(12, 2, 2)),
+       "spheres are bounded by their boxes");
+  // Passes the corner of the first sphere's box, then through the second
+  auto sphere_hit = balls.ray_cast(Vec3d::from(-5, 0.95, 0.95), Vec3d::unit_x(), 100.0,
+                                   [&](std::uint32_t id, double max_t) -> Optional<double> {
+                                     const Sphered &s = spheres[id];
+                                     double dy = 0.95 - s.y(), dz = 0.95 - s.z();
+                                     double h2 = s.radius() * s.radius() - dy * dy - dz * dz;
+                                     if (h2 < 0) return None;
+                                     double t = s.x() - std::sqrt(h2) + 5.0;
+                                     return t <= max_t ? Some(t) : None;
+                                   });
+  test(sphere_hit.is_some() && sphere_hit.unwrap().id == 1,
+       "ray_cast() with an exact test skips a box the ray only clips");
+
+  // ==================== Brute-force Comparison ====================
+  std::cout << "\n--- Brute Force ---\n";
+
+  test(matches_brute_force<2>(2000, 1), "binary queries match brute force");
+  test(matches_brute_force<4>(2000, 2), "4-wide queries match brute force");
+  test(matches_brute_force<8>(2000, 3), "8-wide queries match brute force");
+  test(matches_brute_force<4>(37, 4), "a small scene");
+
+  // ==================== Ray Packets ====================
+  std::cout << "\n--- Ray Packets ---\n";
+
+  auto along = Rayd::from(Vec3d::from(-5, 0.5, 0.5), Vec3d::unit_x()).unwrap();
+  test(binary.ray_cast(along, 1000.0) == binary.ray_cast(along.origin(), along.direction(), 1000.0),
+       "ray_cast() takes a Ray");
+  test(packets_match_single_casts<2, 4>(6), "binary packets of 4 match single casts");
+  test(packets_match_single_casts<4, 4>(7), "4-wide packets of 4 match single casts");
+  test(packets_match_single_casts<4, 8>(8), "4-wide packets of 8 match single casts");
+  test(packets_match_single_casts<8, 8>(9), "8-wide packets of 8 match single casts");
+
+  // ==================== Parallel Build ====================
+  std::cout << "\n--- Parallel Build ---\n";
+
+  auto big = scene(50000, 5);
+  auto serial = Bvh4::from(std::span<const AABB>(big), {.threads = 1});
+  auto parallel = Bvh4::from(std::span<const AABB>(big), {.threads = 4});
+  auto many = Bvh4::from(std::span<const AABB>(big), {.threads = 7});
+  test(same_image(serial.to_bytes(), parallel.to_bytes()) &&
+           same_image(serial.to_bytes(), many.to_bytes()),
+       "the image does not depend on the thread count");
+  test(parallel.containing(Vec3d::from(5.5, 5.5, 5.5)).size() >= 5000,
+       "parallel build finds every box");
+
+  // ==================== Byte Images ====================
+  std::cout << "\n--- Byte Images ---\n";
+
+  auto boxes = scene(3000, 6);
+  auto built = Bvh8::from(std::span<const AABB>(boxes));
+  auto bytes = built.to_bytes();
+  auto storage = copy_image(bytes);
+  auto loaded = Bvh8::from_bytes(view(storage, bytes.size()));
+  test(loaded.is_some(), "from_bytes() accepts a built image");
+  test(loaded.is_some() && loaded.unwrap().to_bytes().data() == view(storage, bytes.size()).data(),
+       "from_bytes() views the bytes without copying");
+  auto probe = box(0, 0, 0, 20);
+  test(loaded.is_some() && sorted(loaded.unwrap().overlapping(probe)) == sorted(built.overlapping(probe)) &&
+           loaded.unwrap().bounds() == built.bounds(),
+       "a loaded image answers like the original");
+
+  test(Bvh4::from_bytes(view(storage, bytes.size())).is_none(), "from_bytes() rejects another width");
+  test(Bvh8::from_bytes(view(storage, bytes.size() - 8)).is_none(), "from_bytes() rejects a truncated image");
+  test(Bvh8::from_bytes(std::span<const std::byte>()).is_none(), "from_bytes() rejects no bytes");
+
+  std::vector<std::byte> shifted(bytes.size() + 1);
+  std::memcpy(shifted.data() + 1, bytes.data(), bytes.size());
+  test(Bvh8::from_bytes(std::span<const std::byte>(shifted).subspan(1)).is_none(),
+       "from_bytes() rejects misaligned bytes");
+
+  auto corrupt = copy_image(bytes);
+  reinterpret_cast<std::byte *>(corrupt.data())[0] = std::byte{'X'};
+  test(Bvh8::from_bytes(view(corrupt, bytes.size())).is_none(), "from_bytes() rejects a bad magic");
+
+  // Point the root's first lane back at the root: a cycle
+  corrupt = copy_image(bytes);
+  auto *root = reinterpret_cast<WideBvhNode<8> *>(reinterpret_cast<std::byte *>(corrupt.data()) + 128);
+  root->index[0] = 0;
+  root->count[0] = 0;
+  test(Bvh8::from_bytes(view(corrupt, bytes.size())).is_none(), "from_bytes() rejects a cycle");
+
+  corrupt = copy_image(bytes);
+  root = reinterpret_cast<WideBvhNode<8> *>(reinterpret_cast<std::byte *>(corrupt.data()) + 128);
+  root->index[0] = 2990;
+  root->count[0] = 20;
+  test(Bvh8::from_bytes(view(corrupt, bytes.size())).is_none(),
+       "from_bytes() rejects a leaf past the primitives");
+
+  // Ray casts index the direction by a binary node's axis
+  auto binary_bytes = Bvh2::from(std::span<const AABB>(boxes)).to_bytes();
+  corrupt = copy_image(binary_bytes);
+  auto *binary_root = reinterpret_cast<BvhNode *>(reinterpret_cast<std::byte *>(corrupt.data()) + 128);
+  test(binary_root->count == 0 && Bvh2::from_bytes(view(corrupt, binary_bytes.size())).is_some(),
+       "from_bytes() accepts a binary image");
+  binary_root->axis = 200;
+  test(Bvh2::from_bytes(view(corrupt, binary_bytes.size())).is_none(),
+       "from_bytes() rejects a bad split axis");
+
+  // ==================== Summary ====================
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
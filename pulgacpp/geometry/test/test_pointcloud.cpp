@@ -0,0 +1,269 @@
+// Test suite for pulgacpp PointCloud2<T> / PointCloud3<T>
+// Compile: g++ -std=c++23 -O2 -I. test_pointcloud.cpp
+
+#include "pulgacpp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace pulgacpp;
+using detail::simd::Isa;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const char *name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+// Relative tolerance: float clouds compute in float, the AoS methods in
+// double
+template <typename T> bool approx_eq(double a, double b) {
+  double tol = sizeof(T) == 4 ? 1e-5 : 1e-12;
+  return std::abs(a - b) <= tol * std::max(1.0, std::abs(b));
+}
+
+template <typename T> std::vector<Point<T>> random_points(std::size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(-100.0, 100.0);
+  std::vector<Point<T>> points;
+  for (std::size_t i = 0; i < n; ++i) {
+    points.push_back(Point<T>::from(static_cast<T>(coord(rng)), static_cast<T>(coord(rng))));
+  }
+  return points;
+}
+
+template <typename T> std::vector<Vector3<T>> random_vectors(std::size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(-100.0, 100.0);
+  std::vector<Vector3<T>> vectors;
+  for (std::size_t i = 0; i < n; ++i) {
+    vectors.push_back(Vector3<T>::from(static_cast<T>(coord(rng)), static_cast<T>(coord(rng)),
+                                       static_cast<T>(coord(rng))));
+  }
+  return vectors;
+}
+
+template <typename T> bool same_point(Point<T> got, Point<double> want) {
+  return approx_eq<T>(got.x(), want.x()) && approx_eq<T>(got.y(), want.y());
+}
+
+template <typename T> bool same_vector(Vector3<T> got, Vector3<double> want) {
+  return approx_eq<T>(got.x(), want.x()) && approx_eq<T>(got.y(), want.y()) &&
+         approx_eq<T>(got.z(), want.z());
+}
+
+// Dot and cross products cancel, so their error is relative to the
+// magnitudes that went in rather than to the result
+template <typename T> bool close(double got, double want, double scale) {
+  return std::abs(got - want) <= (sizeof(T) == 4 ? 1e-5 : 1e-12) * std::max(1.0, scale);
+}
+
+template <typename T> bool close_vector(Vector3<T> got, Vector3<double> want, double scale) {
+  return close<T>(got.x(), want.x(), scale) && close<T>(got.y(), want.y(), scale) &&
+         close<T>(got.z(), want.z(), scale);
+}
+
+/// Every PointCloud2 operation agrees with the Point method, for n points.
+template <typename T> bool cloud2_matches(std::size_t n) {
+  auto points = random_points<T>(n, 1);
+  auto others = random_points<T>(n, 2);
+  auto a = PointCloud2<T>::from(points);
+  auto b = PointCloud2<T>::from(others);
+  auto p = Point<T>::from(T(3), T(-4));
+  std::vector<T> out(n);
+  bool ok = a.size() == n;
+
+  a.distances_to(p, out);
+  for (std::size_t i = 0; i < n; ++i) {
+    ok &= approx_eq<T>(out[i], points[i].distance_to(p));
+  }
+  a.distances_squared_to(p, out);
+  for (std::size_t i = 0; i < n; ++i) {
+    ok &= approx_eq<T>(out[i], points[i].distance_squared(p));
+  }
+  a.distances_to(b, out);
+  for (std::size_t i = 0; i < n; ++i) {
+    ok &= approx_eq<T>(out[i], points[i].distance_to(others[i]));
+  }
+
+  auto lerped = a.lerp(b, T(0.25));
+  auto rotated = a.rotate(0.5);
+  for (std::size_t i = 0; i < n; ++i) {
+    ok &= same_point(lerped[i], points[i].lerp(others[i], 0.25));
+    ok &= same_point(rotated[i], points[i].rotate(0.5));
+  }
+  return ok;
+}
+
+/// Every PointCloud3 operation agrees with Vector3, for n vectors.
+template <typename T> bool cloud3_matches(std::size_t n) {
+  auto vectors = random_vectors<T>(n, 3);
+  auto others = random_vectors<T>(n, 4);
+  auto a = PointCloud3<T>::from(vectors);
+  auto b = PointCloud3<T>::from(others);
+  auto v = Vector3<T>::from(T(1), T(-2), T(0.5));
+  std::vector<T> out(n);
+  bool ok = a.size() == n;
+
+  a.magnitudes(out);
+  for (std::size_t i = 0; i < n; ++i) {
+    ok &= approx_eq<T>(out[i], vectors[i].magnitude());
+  }
+  a.distances_to(v, out);
+  for (std::size_t i = 0; i < n; ++i) {
+    ok &= approx_eq<T>(out[i], vectors[i].distance_to(v));
+  }
+  a.dot(v, out);
+  for (std::size_t i = 0; i < n; ++i) {
+    ok &= close<T>(out[i], vectors[i].dot(v), vectors[i].magnitude() * v.magnitude());
+  }
+  a.dot(b, out);
+  for (std::size_t i = 0; i < n; ++i) {
+    ok &= close<T>(out[i], vectors[i].dot(others[i]),
+                   vectors[i].magnitude() * others[i].magnitude());
+  }
+
+  auto crossed = a.cross(b);
+  auto crossed_v = a.cross(v);
+  auto lerped = a.lerp(b, T(0.75));
+  auto normalized = a.normalized().unwrap();
+  for (std::size_t i = 0; i < n; ++i) {
+    ok &= close_vector<T>(crossed[i], vectors[i].cross(others[i]),
+                          vectors[i].magnitude() * others[i].magnitude());
+    ok &= close_vector<T>(crossed_v[i], vectors[i].cross(v),
+                          vectors[i].magnitude() * v.magnitude());
+    ok &= same_vector(lerped[i], vectors[i].lerp(others[i], 0.75));
+    ok &= same_vector(normalized[i], vec3_normalized(vectors[i]).unwrap());
+  }
+  return ok;
+}
+
+/// Runs `check` for sizes around every vector width, on every instruction set.
+template <typename Check> bool on_all_isas(Check check) {
+  bool ok = true;
+  for (auto isa : {Isa::Scalar, Isa::Native, Isa::Sse42, Isa::Avx2}) {
+    detail::simd::set_active_isa(isa);
+    for (std::size_t n : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 17u, 1000u}) {
+      ok &= check(n);
+    }
+  }
+  detail::simd::set_active_isa(Isa::Avx2);
+  return ok;
+}
+
+int main() {
+  std::cout << "=== PointCloud2<T> / PointCloud3<T> Test Suite ===\n\n";
+
+  // ==================== Construction ====================
+  std::cout << "--- Construction ---\n";
+
+  PointCloud2D empty;
+  test(empty.is_empty() && empty.size() == 0, "default cloud is empty");
+
+  std::vector<PointD> points = {PointD::from(1.0, 2.0), PointD::from(3.0, 4.0),
+                                PointD::from(-5.0, 6.0)};
+  auto cloud = PointCloud2D::from(points);
+  test(cloud.size() == 3, "from() copies every point");
+  test(cloud[1] == PointD::from(3.0, 4.0), "operator[] rebuilds the point");
+  test(cloud.to_points() == points, "to_points() round-trips");
+  test(cloud.xs()[2] == -5.0 && cloud.ys()[2] == 6.0, "xs()/ys() expose the coordinate arrays");
+
+  test(reinterpret_cast<std::uintptr_t>(cloud.xs().data()) % 64 == 0 &&
+           reinterpret_cast<std::uintptr_t>(cloud.ys().data()) % 64 == 0,
+       "coordinate arrays are 64-byte aligned");
+
+  cloud.push_back(PointD::from(7.0, 8.0));
+  cloud.set(0, PointD::origin());
+  test(cloud.size() == 4 && cloud[3] == PointD::from(7.0, 8.0) && cloud[0] == PointD::origin(),
+       "push_back() and set()");
+
+  std::vector<double> xs = {1.0, 2.0}, ys = {3.0, 4.0}, short_ys = {3.0};
+  test(PointCloud2D::from_coordinates(xs, ys).unwrap()[1] == PointD::from(2.0, 4.0),
+       "from_coordinates() copies the arrays");
+  test(PointCloud2D::from_coordinates(xs, short_ys).is_none(),
+       "from_coordinates() rejects arrays of different sizes");
+
+  std::vector<Vec3f> vectors = {Vec3f::from(1, 0, 0), Vec3f::from(0, 2, 0), Vec3f::from(0, 0, 3)};
+  auto cloud3 = PointCloud3F::from(vectors);
+  test(cloud3.size() == 3 && cloud3.to_vectors() == vectors, "PointCloud3 round-trips Vector3");
+  test(reinterpret_cast<std::uintptr_t>(cloud3.zs().data()) % 64 == 0,
+       "PointCloud3 arrays are 64-byte aligned");
+
+  // ==================== 2D Operations ====================
+  std::cout << "\n--- PointCloud2 ---\n";
+
+  std::vector<double> dist(cloud.size());
+  cloud.distances_to(PointD::origin(), dist);
+  test(dist[0] == 0.0 && dist[1] == 5.0, "distances_to(point) gives exact 3-4-5");
+
+  auto quarter = PointCloud2D::from(std::vector{PointD::from(1.0, 0.0)})
+                     .rotate(std::numbers::pi / 2);
+  test(std::abs(quarter[0].x()) < 1e-12 && std::abs(quarter[0].y() - 1.0) < 1e-12,
+       "rotate() by 90 degrees");
+
+  test(on_all_isas(cloud2_matches<double>), "PointCloud2<double> matches Point on every ISA");
+  test(on_all_isas(cloud2_matches<float>), "PointCloud2<float> matches Point on every ISA");
+
+  // ==================== 3D Operations ====================
+  std::cout << "\n--- PointCloud3 ---\n";
+
+  std::vector<float> mags(cloud3.size());
+  cloud3.magnitudes(mags);
+  test(mags[0] == 1.0f && mags[1] == 2.0f && mags[2] == 3.0f, "magnitudes() of axis vectors");
+
+  auto z = PointCloud3F::from(std::vector{Vec3f::unit_x()}).cross(Vec3f::unit_y());
+  test(z[0] == Vec3f::unit_z(), "cross(vector): x × y = z");
+
+  auto units = cloud3.normalized();
+  test(units.is_ok() && units.unwrap()[2] == Vec3f::unit_z(), "normalized() of axis vectors");
+
+  // Squares that underflow or overflow float, next to an ordinary vector
+  auto extremes = PointCloud3F::from(std::vector{
+                                         Vec3f::from(1e-25f, 0, 0),
+                                         Vec3f::from(1e20f, 0, 0),
+                                         Vec3f::from(3e-30f, -4e-30f, 0),
+                                         Vec3f::from(0, 3e25f, 4e25f),
+                                         Vec3f::from(1e-40f, 0, 0),
+                                         Vec3f::from(3, 0, 4),
+                                     })
+                      .normalized();
+  test(extremes.is_ok() && extremes.unwrap()[0] == Vec3f::unit_x() &&
+           extremes.unwrap()[1] == Vec3f::unit_x() && extremes.unwrap()[4] == Vec3f::unit_x(),
+       "normalized() of tiny, huge and subnormal float components");
+  test(extremes.is_ok() &&
+           same_vector(extremes.unwrap()[2], Vector3<double>::from(0.6, -0.8, 0)) &&
+           same_vector(extremes.unwrap()[3], Vector3<double>::from(0, 0.6, 0.8)) &&
+           same_vector(extremes.unwrap()[5], Vector3<double>::from(0.6, 0, 0.8)),
+       "normalized() keeps the direction of tiny and huge vectors");
+  std::vector<Vec3d> far = {Vec3d::from(1e-300, 1e-300, 0), Vec3d::from(0, 0, 1e300)};
+  auto tiny = PointCloud3D::from(far).normalized();
+  const double half = std::sqrt(0.5);
+  test(tiny.is_ok() && same_vector(tiny.unwrap()[0], Vector3<double>::from(half, half, 0)) &&
+           tiny.unwrap()[1] == Vec3d::unit_z(),
+       "normalized() of tiny and huge double components");
+
+  cloud3.push_back(Vec3f::zero());
+  auto err = cloud3.normalized();
+  test(err.is_err() && err.unwrap_err() == ZeroVector{3}, "normalized() reports the zero vector");
+
+  test(on_all_isas(cloud3_matches<double>), "PointCloud3<double> matches Vector3 on every ISA");
+  test(on_all_isas(cloud3_matches<float>), "PointCloud3<float> matches Vector3 on every ISA");
+
+  // ==================== Summary ====================
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+// Test suite for pulgacpp Ray<T> and RayPacket<T, N>
+// Compile: g++ -std=c++23 -O2 -I. test_ray.cpp
+
+#include "pulgacpp.hpp"
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace pulgacpp;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const char *name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+template <typename T> bool close(T a, T b) {
+  constexpr T tolerance = std::is_same_v<T, float> ? T(1e-5) : T(1e-12);
+  return std::abs(a - b) <= tolerance * std::max(T(1), std::abs(b));
+}
+
+template <typename T> Vector3<T> vec(T x, T y, T z) { return Vector3<T>::from(x, y, z); }
+
+/// Random rays (every third along an axis, for the parallel slab case)
+/// against random boxes, spheres and triangles: every lane of a packet must
+/// agree with the same ray on its own.
+template <typename T, std::size_t N> bool packets_match_single_rays(unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<T> coord(T(-10), T(10));
+  std::uniform_real_distribution<T> size(T(0.5), T(6));
+  bool ok = true;
+  for (int round = 0; round < 200; ++round) {
+    std::vector<Ray<T>> rays;
+    for (std::size_t k = 0; k < N; ++k) {
+      auto origin = vec(coord(rng), coord(rng), coord(rng));
+      auto direction = (k + round) % 3 == 0 ? vec(T(0), T(0), coord(rng) < 0 ? T(-1) : T(1))
+                                            : vec(coord(rng), coord(rng), coord(rng));
+      rays.push_back(Ray<T>::from(origin, direction).unwrap_or(Ray<T>::from(origin, vec(T(1), T(0), T(0))).unwrap()));
+    }
+    auto packet = RayPacket<T, N>::from(std::span<const Ray<T>, N>(rays.data(), N));
+    const T max_t = T(5);
+
+    auto lo = vec(coord(rng), coord(rng), coord(rng));
+    auto box = Box<T>::from_points(lo, vec(lo.x() + size(rng), lo.y() + size(rng), lo.z() + size(rng)));
+    auto sphere = Sphere<T>::from(vec(coord(rng), coord(rng), coord(rng)), size(rng)).unwrap();
+    auto a = vec(coord(rng), coord(rng), coord(rng));
+    auto b = vec(coord(rng), coord(rng), coord(rng));
+    auto c = vec(coord(rng), coord(rng), coord(rng));
+
+    std::array<T, N> box_t, sphere_t, tri_t, u, v;
+    box_t.fill(max_t);
+    sphere_t.fill(max_t);
+    tri_t.fill(max_t);
+    u.fill(T(-1));
+    v.fill(T(-1));
+    unsigned box_hits = packet.intersect(box, box_t);
+    unsigned sphere_hits = packet.intersect(sphere, sphere_t);
+    unsigned tri_hits = packet.intersect_triangle(a, b, c, tri_t, u, v);
+
+    for (std::size_t k = 0; k < N; ++k) {
+      auto expect_box = rays[k].intersect(box, max_t);
+      ok &= bool(box_hits >> k & 1u) == expect_box.is_some();
+      ok &= close(box_t[k], expect_box.unwrap_or(max_t));
+
+      auto expect_sphere = rays[k].intersect(sphere, max_t);
+      ok &= bool(sphere_hits >> k & 1u) == expect_sphere.is_some();
+      ok &= close(sphere_t[k], expect_sphere.unwrap_or(max_t));
+
+      auto expect_tri = rays[k].intersect_triangle(a, b, c, max_t);
+      ok &= bool(tri_hits >> k & 1u) == expect_tri.is_some();
+      auto hit = expect_tri.unwrap_or(TriangleHit<T>{max_t, T(-1), T(-1)});
+      ok &= close(tri_t[k], hit.t) && close(u[k], hit.u) && close(v[k], hit.v);
+    }
+  }
+  return ok;
+}
+
+int main() {
+  std::cout << "=== Ray<T> / RayPacket<T, N> Test Suite ===\n\n";
+
+  // ==================== Construction ====================
+  std::cout << "--- Construction ---\n";
+
+  test(Rayd::from(Vec3d::zero(), Vec3d::unit_x()).is_some(), "from() accepts a direction");
+  test(Rayd::from(Vec3d::zero(), Vec3d::zero()).is_none(), "from() rejects a zero direction");
+  test(Rayd::from(Vec3d::from(std::numeric_limits<double>::quiet_NaN(), 0, 0), Vec3d::unit_x())
+               .is_none() &&
+           Rayd::from(Vec3d::zero(), Vec3d::from(std::numeric_limits<double>::infinity(), 0, 0))
+               .is_none(),
+       "from() rejects non-finite rays");
+
+  auto ray = Rayd::through(Vec3d::from(1, 2, 3), Vec3d::from(3, 2, 3)).unwrap();
+  test(ray.direction() == Vec3d::from(2, 0, 0), "through() points at the target");
+  test(ray.at(1.0) == Vec3d::from(3, 2, 3) && ray.at(0.5) == Vec3d::from(2, 2, 3),
+       "at() walks along the direction");
+  test(Rayd::through(Vec3d::unit_y(), Vec3d::unit_y()).is_none(), "through() the origin itself");
+  test(ray.inv_direction().x() == 0.5 && std::isinf(ray.inv_direction().y()),
+       "inv_direction() is infinite on unused axes");
+
+  // ==================== Box ====================
+  std::cout << "\n--- Box ---\n";
+
+  auto unit = Boxd::from_points(Vec3d::zero(), Vec3d::from(1, 1, 1));
+  auto toward = Rayd::from(Vec3d::from(-2, 0.5, 0.5), Vec3d::unit_x()).unwrap();
+  test(toward.intersect(unit, 10.0) == Some(2.0), "enters at the near face");
+  test(toward.intersect(unit, 1.5).is_none(), "max_t stops short of the box");
+  test(Rayd::from(Vec3d::from(0.5, 0.5, 0.5), Vec3d::unit_z()).unwrap().intersect(unit, 10.0) ==
+           Some(0.0),
+       "starting inside enters at 0");
+  test(Rayd::from(Vec3d::from(-2, 0.5, 0.5), Vec3d::from(-1, 0, 0)).unwrap().intersect(unit, 10.0)
+           .is_none(),
+       "a box behind the ray is missed");
+  test(Rayd::from(Vec3d::from(-2, 1.0, 0.5), Vec3d::unit_x()).unwrap().intersect(unit, 10.0) ==
+           Some(2.0),
+       "a ray along a face hits (boxes are closed)");
+  test(Rayd::from(Vec3d::from(-2, 1.5, 0.5), Vec3d::unit_x()).unwrap().intersect(unit, 10.0)
+           .is_none(),
+       "a parallel ray outside the slab misses");
+  test(Rayd::from(Vec3d::from(2, 2, 2), Vec3d::from(-1, -1, -1)).unwrap().intersect(unit, 10.0) ==
+           Some(1.0),
+       "diagonal ray enters at the corner");
+
+  // ==================== Sphere ====================
+  std::cout << "\n--- Sphere ---\n";
+
+  auto ball = Sphered::from(Vec3d::from(5, 0, 0), 1.0).unwrap();
+  auto axis = Rayd::from(Vec3d::zero(), Vec3d::unit_x()).unwrap();
+  test(axis.intersect(ball, 10.0) == Some(4.0), "hits the near surface");
+  test(Rayd::from(Vec3d::zero(), Vec3d::from(2, 0, 0)).unwrap().intersect(ball, 10.0) == Some(2.0),
+       "t is in lengths of the direction");
+  test(axis.intersect(ball, 3.0).is_none(), "max_t stops short of the sphere");
+  test(Rayd::from(Vec3d::from(5, 0.5, 0), Vec3d::unit_y()).unwrap().intersect(ball, 10.0) ==
+           Some(0.0),
+       "starting inside enters at 0");
+  test(Rayd::from(Vec3d::zero(), Vec3d::from(-1, 0, 0)).unwrap().intersect(ball, 10.0).is_none(),
+       "a sphere behind the ray is missed");
+  test(Rayd::from(Vec3d::from(0, 1, 0), Vec3d::unit_x()).unwrap().intersect(ball, 10.0) ==
+           Some(5.0),
+       "a tangent ray touches once");
+  test(Rayd::from(Vec3d::from(0, 1.01, 0), Vec3d::unit_x()).unwrap().intersect(ball, 10.0).is_none(),
+       "a ray passing by misses");
+
+  // ==================== Triangle ====================
+  std::cout << "\n--- Triangle ---\n";
+
+  auto a = Vec3d::from(0, 0, 5), b = Vec3d::from(4, 0, 5), c = Vec3d::from(0, 4, 5);
+  auto down = Rayd::from(Vec3d::from(1, 2, 0), Vec3d::unit_z()).unwrap();
+  auto hit = down.intersect_triangle(a, b, c, 10.0);
+  test(hit == Some(TriangleHit<double>{5.0, 0.25, 0.5}), "hit with barycentrics");
+  test(Rayd::from(Vec3d::from(1, 2, 10), Vec3d::from(0, 0, -1)).unwrap()
+           .intersect_triangle(a, b, c, 10.0)
+           .map([](auto h) { return h.t; }) == Some(5.0),
+       "the back face counts too");
+  test(down.intersect_triangle(a, b, c, 4.0).is_none(), "max_t stops short of the triangle");
+  test(Rayd::from(Vec3d::from(3, 3, 0), Vec3d::unit_z()).unwrap().intersect_triangle(a, b, c, 10.0)
+           .is_none(),
+       "outside the triangle misses");
+  test(Rayd::from(Vec3d::from(0, 0, 5), Vec3d::unit_x()).unwrap().intersect_triangle(a, b, c, 10.0)
+           .is_none(),
+       "a ray in the triangle's plane misses");
+  test(Rayd::from(Vec3d::from(1, 2, 6), Vec3d::unit_z()).unwrap().intersect_triangle(a, b, c, 10.0)
+           .is_none(),
+       "a triangle behind the ray is missed");
+  auto flat = Rayf::from(Vec3f::from(1, 1, -1), Vec3f::from(0, 0, 1)).unwrap();
+  test(flat.intersect_triangle(Vec3f::zero(), Vec3f::from(2, 0, 0), Vec3f::from(0, 2, 0), 5.0f) ==
+           Some(TriangleHit<float>{1.0f, 0.5f, 0.5f}),
+       "float rays");
+
+  // ==================== Packets ====================
+  std::cout << "\n--- Packets ---\n";
+
+  std::array<Rayd, 4> quad = {Rayd::from(Vec3d::from(-2, 0.5, 0.5), Vec3d::unit_x()).unwrap(),
+                              Rayd::from(Vec3d::from(-2, 5, 0.5), Vec3d::unit_x()).unwrap(),
+                              Rayd::from(Vec3d::from(0.5, 0.5, 0.5), Vec3d::unit_y()).unwrap(),
+                              Rayd::from(Vec3d::from(-4, 0.5, 0.5), Vec3d::unit_x()).unwrap()};
+  auto packet = RayPacket<double, 4>::from(quad);
+  test(packet.ray(1) == quad[1], "ray() returns each lane");
+  std::array<double, 4> t = {10.0, 10.0, 10.0, 3.0};
+  test(packet.intersect(unit, t) == 0b0101u, "intersect() returns the lanes that hit");
+  test(t == std::array<double, 4>{2.0, 10.0, 0.0, 3.0}, "hit lanes lower t, others keep it");
+  std::array<double, 4> nearer = {1.0, 10.0, 10.0, 10.0};
+  test(packet.intersect(unit, nearer) == 0b1100u && nearer[0] == 1.0,
+       "a lane with a nearer hit keeps it");
+
+  test(packets_match_single_rays<double, 4>(1), "double x4 matches single rays");
+  test(packets_match_single_rays<double, 8>(2), "double x8 matches single rays");
+  test(packets_match_single_rays<float, 4>(3), "float x4 matches single rays");
+  test(packets_match_single_rays<float, 8>(4), "float x8 matches single rays");
+
+  // ==================== Summary ====================
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,216 @@
+// Test suite for pulgacpp SpatialHashGrid<Circle<T>>
+// Compile: g++ -std=c++23 -O2 -I. test_spatialhash.cpp
+
+#include "pulgacpp.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace pulgacpp;
+using Grid = SpatialHashGrid<CircleD>;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const char *name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+CircleD circle(double x, double y, double r) {
+  return CircleD::from(PointD::from(x, y), r).unwrap();
+}
+
+std::vector<SpatialPair> sorted(std::vector<SpatialPair> pairs) {
+  std::sort(pairs.begin(), pairs.end(), [](SpatialPair p, SpatialPair q) {
+    return p.a != q.a ? p.a < q.a : p.b < q.b;
+  });
+  return pairs;
+}
+
+/// Shadow copy of the grid's contents, checked by brute force.
+struct Reference {
+  std::vector<Optional<CircleD>> circles; // Indexed by id
+
+  void set(Grid::Id id, CircleD c) {
+    if (circles.size() <= id) {
+      circles.resize(id + 1);
+    }
+    circles[id] = c;
+  }
+
+  std::vector<SpatialPair> pairs() const {
+    std::vector<SpatialPair> out;
+    for (Grid::Id a = 0; a < circles.size(); ++a) {
+      for (Grid::Id b = a + 1; b < circles.size(); ++b) {
+        if (circles[a].is_some() && circles[b].is_some() &&
+            circles[a].unwrap().overlaps(circles[b].unwrap())) {
+          out.push_back({a, b});
+        }
+      }
+    }
+    return out;
+  }
+
+  std::vector<Grid::Id> overlapping(CircleD area) const {
+    std::vector<Grid::Id> out;
+    for (Grid::Id id = 0; id < circles.size(); ++id) {
+      if (circles[id].is_some() && area.overlaps(circles[id].unwrap())) {
+        out.push_back(id);
+      }
+    }
+    return out;
+  }
+};
+
+/// Random inserts, moves (small and across the world) and removes, with
+/// radii up to max_radius, compared against brute force after every round.
+bool matches_brute_force(double cell_size, double max_radius, unsigned seed) {
+  auto grid = Grid::from(cell_size).unwrap();
+  Reference ref;
+  std::vector<Grid::Id> live;
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> coord(-200.0, 200.0);
+  std::uniform_real_distribution<double> step(-5.0, 5.0);
+  std::uniform_real_distribution<double> radius(0.0, max_radius);
+  std::uniform_int_distribution<int> action(0, 9);
+
+  bool ok = true;
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 50; ++i) {
+      int a = action(rng);
+      if (a < 4 || live.empty()) {
+        auto c = circle(coord(rng), coord(rng), radius(rng));
+        auto id = grid.insert(c);
+        ref.set(id, c);
+        live.push_back(id);
+      } else if (a < 8) {
+        auto id = live[rng() % live.size()];
+        auto old = grid.get(id);
+        auto c = a < 7 ? circle(old.center().x() + step(rng), old.center().y() + step(rng), old.radius())
+                       : circle(coord(rng), coord(rng), radius(rng));
+        grid.update(id, c);
+        ref.set(id, c);
+      } else {
+        std::size_t k = rng() % live.size();
+        grid.remove(live[k]);
+        ref.circles[live[k]] = None;
+        live.erase(live.begin() + static_cast<std::ptrdiff_t>(k));
+      }
+    }
+    ok &= grid.size() == live.size();
+    ok &= sorted(grid.overlapping_pairs()) == ref.pairs();
+
+    auto area = circle(coord(rng), coord(rng), radius(rng) * 3);
+    auto found = grid.overlapping(area);
+    std::sort(found.begin(), found.end());
+    ok &= found == ref.overlapping(area);
+  }
+  return ok;
+}
+
+int main() {
+  std::cout << "=== SpatialHashGrid<Circle<T>> Test Suite ===\n\n";
+
+  // ==================== Construction ====================
+  std::cout << "--- Construction ---\n";
+
+  test(Grid::from(10.0).is_some(), "from() accepts a positive cell size");
+  test(Grid::from(0.0).is_none() && Grid::from(-1.0).is_none(), "from() rejects cell size <= 0");
+  test(Grid::from(std::numeric_limits<double>::infinity()).is_none() &&
+           Grid::from(std::numeric_limits<double>::quiet_NaN()).is_none(),
+       "from() rejects non-finite cell sizes");
+
+  auto grid = Grid::from(10.0).unwrap();
+  test(grid.is_empty() && grid.cell_size() == 10.0, "new grid is empty");
+
+  // ==================== Insert, Update, Remove ====================
+  std::cout << "\n--- Modification ---\n";
+
+  auto a = grid.insert(circle(0, 0, 3));
+  auto b = grid.insert(circle(5, 0, 3));
+  auto c = grid.insert(circle(50, 50, 3));
+  test(grid.size() == 3 && grid.contains(a) && grid.contains(c), "insert() returns live ids");
+  test(grid.get(b) == circle(5, 0, 3), "get() returns the inserted circle");
+
+  test(grid.overlapping_pairs() == std::vector<SpatialPair>{{a, b}}, "one overlapping pair");
+
+  grid.update(c, circle(7, 4, 3));
+  test(sorted(grid.overlapping_pairs()) == std::vector<SpatialPair>{{a, b}, {b, c}},
+       "update() moves a circle into another cell");
+
+  grid.update(a, circle(1, 1, 3));
+  test(grid.get(a) == circle(1, 1, 3), "update() within a cell");
+
+  grid.remove(b);
+  test(!grid.contains(b) && grid.size() == 2, "remove() forgets the id");
+  test(grid.overlapping_pairs().empty(), "removed circles no longer pair");
+
+  auto reused = grid.insert(circle(100, 100, 1));
+  test(reused == b, "remove()d ids are reused");
+
+  // Tangent circles do not overlap, like Circle::overlaps
+  auto tangent = Grid::from(4.0).unwrap();
+  (void)tangent.insert(circle(0, 0, 2));
+  (void)tangent.insert(circle(4, 0, 2));
+  test(tangent.overlapping_pairs().empty(), "touching circles are not a pair");
+
+  grid.clear();
+  test(grid.is_empty() && grid.cell_count() == 0 && !grid.contains(a), "clear() empties the grid");
+
+  // ==================== Queries ====================
+  std::cout << "\n--- Queries ---\n";
+
+  auto world = Grid::from(20.0).unwrap();
+  auto player = world.insert(circle(400, 300, 20));
+  auto enemy1 = world.insert(circle(430, 300, 15));
+  (void)world.insert(circle(600, 100, 15));
+
+  auto nearby = world.query_radius(PointD::from(400, 300), 50.0);
+  std::sort(nearby.begin(), nearby.end());
+  test(nearby == std::vector<Grid::Id>{player, enemy1}, "query_radius() finds nearby circles");
+  test(world.query_radius(PointD::from(0, 0), -1.0).empty(), "negative radius finds nothing");
+  test(world.overlapping(circle(0, 0, 1e9)).size() == 3, "huge query area finds everything");
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  auto lost = world.insert(circle(nan, 300, 20));
+  test(world.contains(lost) && world.query_radius(PointD::from(400, 300), 50.0).size() == 2 &&
+           world.query_radius(PointD::from(nan, nan), 50.0).empty(),
+       "a NaN centre overlaps nothing");
+  world.update(lost, circle(std::numeric_limits<double>::infinity(), nan, 5));
+  world.remove(lost);
+  test(world.size() == 3 && world.overlapping_pairs().size() == 1, "NaN circles update and remove");
+
+  // ==================== Brute-force Comparison ====================
+  std::cout << "\n--- Brute Force ---\n";
+
+  test(matches_brute_force(10.0, 5.0, 1), "cell size = largest diameter");
+  test(matches_brute_force(2.0, 5.0, 2), "cells smaller than the circles");
+  test(matches_brute_force(100.0, 5.0, 3), "cells much larger than the circles");
+  test(matches_brute_force(7.0, 30.0, 4), "mixed radii");
+  test(matches_brute_force(1.0, 150.0, 5), "circles hundreds of cells across");
+
+  // One circle covering 50 small ones, larger than int32_t cells across
+  for (double r : {300.0, 1e10, std::numeric_limits<double>::infinity()}) {
+    auto sky = Grid::from(1.0).unwrap();
+    for (int i = 0; i < 50; ++i) {
+      (void)sky.insert(circle(3.0 * i, 2.0 * (i % 7), 0.5));
+    }
+    (void)sky.insert(circle(0, 0, r));
+    test(sky.overlapping_pairs().size() == 50, "an oversized circle pairs with every circle");
+  }
+
+  // ==================== Summary ====================
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
@@ -153,6 +153,22 @@ public:
     }
 };
 
+/// Optional<Vector2<float/double>> uses a reserved NaN in x as None, so it is
+/// the same size as the vector itself. That NaN survives arithmetic, so Some()
+/// replaces it in x with the default quiet NaN.
+template <std::floating_point T>
+struct niche_traits<Vector2<T>> {
+    [[nodiscard]] static constexpr Vector2<T> none() noexcept {
+        return Vector2<T>::from(detail::niche_nan<T>(), detail::niche_nan<T>());
+    }
+    [[nodiscard]] static constexpr bool is_none(const Vector2<T>& v) noexcept {
+        return detail::is_niche_nan(v.x());
+    }
+    [[nodiscard]] static constexpr Vector2<T> to_some(const Vector2<T>& v) noexcept {
+        return Vector2<T>::from(detail::some_nan(v.x()), v.y());
+    }
+};
+
 // ==================== Free Functions ====================
 
 /// Normalize vector (returns Optional)
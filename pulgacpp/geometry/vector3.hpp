@@ -265,6 +265,23 @@ public:
   }
 };
 
+/// Optional<Vector3<float/double>> uses a reserved NaN in x as None, so it is
+/// the same size as the vector itself. That NaN survives arithmetic, so Some()
+/// replaces it in x with the default quiet NaN.
+template <std::floating_point T>
+struct niche_traits<Vector3<T>> {
+  [[nodiscard]] static constexpr Vector3<T> none() noexcept {
+    T nan = detail::niche_nan<T>();
+    return Vector3<T>::from(nan, nan, nan);
+  }
+  [[nodiscard]] static constexpr bool is_none(const Vector3<T> &v) noexcept {
+    return detail::is_niche_nan(v.x());
+  }
+  [[nodiscard]] static constexpr Vector3<T> to_some(const Vector3<T> &v) noexcept {
+    return Vector3<T>::from(detail::some_nan(v.x()), v.y(), v.z());
+  }
+};
+
 // ==================== Free Functions ====================
 
 /// Normalize vector (returns Optional)
@@ -0,0 +1,108 @@
+// Benchmark: 128-bit SafeInt arithmetic vs the 64-bit path and raw __int128
+// Compile: g++ -std=c++23 -O2 -I../.. bench_i128.cpp -o bench_i128
+//
+// Each loop runs a dependent chain of checked operations (so the compiler
+// cannot vectorize or hoist them) and reports nanoseconds per operation.
+
+#include "i128.hpp"
+#include "../i64/i64.hpp"
+#include "../u128/u128.hpp"
+#include "../u64/u64.hpp"
+#include <chrono>
+#include <cstdio>
+
+using namespace pulgacpp;
+
+namespace {
+
+constexpr int ITERATIONS = 20'000'000;
+
+/// Keeps `value` alive without letting the compiler see through it.
+template <typename T> void keep(T &value) {
+    asm volatile("" : "+r,m"(value) : : "memory");
+}
+
+template <typename F> void run(const char *name, F body) {
+    body(ITERATIONS / 10); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    body(ITERATIONS);
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-32s %8.3f ns/op\n", name, ns / ITERATIONS);
+}
+
+template <typename S> void bench_checked_add(const char *name) {
+    run(name, [](int n) {
+        S acc(static_cast<typename S::underlying_type>(1));
+        S step(static_cast<typename S::underlying_type>(3));
+        int overflows = 0;
+        for (int i = 0; i < n; ++i) {
+            keep(step);
+            auto r = acc.checked_add(step);
+            if (r.is_some()) {
+                acc = r.unwrap();
+            } else {
+                acc = S(static_cast<typename S::underlying_type>(1));
+                ++overflows;
+            }
+        }
+        keep(acc);
+        keep(overflows);
+    });
+}
+
+template <typename S> void bench_checked_mul(const char *name) {
+    run(name, [](int n) {
+        S acc(static_cast<typename S::underlying_type>(1));
+        S factor(static_cast<typename S::underlying_type>(3));
+        int overflows = 0;
+        for (int i = 0; i < n; ++i) {
+            keep(factor);
+            auto r = acc.checked_mul(factor);
+            if (r.is_some()) {
+                acc = r.unwrap();
+            } else {
+                acc = S(static_cast<typename S::underlying_type>(1));
+                ++overflows;
+            }
+        }
+        keep(acc);
+        keep(overflows);
+    });
+}
+
+template <typename T> void bench_raw_mul(const char *name) {
+    run(name, [](int n) {
+        T acc = 1;
+        T factor = 3;
+        for (int i = 0; i < n; ++i) {
+            keep(factor);
+            acc = acc * factor + 1;
+        }
+        keep(acc);
+    });
+}
+
+} // namespace
+
+int main() {
+    std::printf("=== 128-bit arithmetic benchmark (%d ops) ===\n\n", ITERATIONS);
+
+    std::printf("--- checked_add ---\n");
+    bench_checked_add<i64>("i64::checked_add");
+    bench_checked_add<i128>("i128::checked_add");
+    bench_checked_add<u64>("u64::checked_add");
+    bench_checked_add<u128>("u128::checked_add");
+
+    std::printf("\n--- checked_mul ---\n");
+    bench_checked_mul<i64>("i64::checked_mul");
+    bench_checked_mul<i128>("i128::checked_mul");
+    bench_checked_mul<u64>("u64::checked_mul");
+    bench_checked_mul<u128>("u128::checked_mul");
+
+    std::printf("\n--- unchecked baseline ---\n");
+    bench_raw_mul<__int128>("raw __int128 mul-add");
+    bench_raw_mul<std::int64_t>("raw int64_t mul-add");
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+// pulgacpp::i128 - Type-safe signed 128-bit integer
+// SPDX-License-Identifier: MIT
+
+#ifndef PULGACPP_I128_HPP
+#define PULGACPP_I128_HPP
+
+#include "../core/safe_int.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#if PULGACPP_HAS_INT128
+
+namespace pulgacpp {
+
+/// Type-safe signed 128-bit integer with Rust-like semantics.
+/// No implicit conversions. Checked arithmetic returns Optional<i128>.
+/// Note: There is no wider type, so overflow is detected with the compiler
+/// builtins (or a two-limb fallback). Requires __int128 (GCC/Clang, 64-bit).
+using i128 = detail::SafeInt<__int128, __int128, 128, true>;
+
+// Literal suffix for i128 (e.g., 170141183460469231731687303715884105727_i128)
+// This is a raw literal operator, so values beyond unsigned long long work.
+namespace literals {
+    template <char... Chars>
+    [[nodiscard]] constexpr i128 operator""_i128() {
+        auto [value, overflow] = detail::parse_u128_literal<Chars...>();
+        if (overflow || value > static_cast<unsigned __int128>(i128::MAX)) {
+            panic("i128 literal out of range");
+        }
+        return i128(static_cast<i128::underlying_type>(value));
+    }
+} // namespace literals
+
+} // namespace pulgacpp
+
+// std::hash specialization for unordered containers
+template <>
+struct std::hash<pulgacpp::i128> {
+    [[nodiscard]] std::size_t operator()(pulgacpp::i128 value) const noexcept {
+        auto bits = static_cast<unsigned __int128>(value.get());
+        auto low = static_cast<std::uint64_t>(bits);
+        auto high = static_cast<std::uint64_t>(bits >> 64);
+        return std::hash<std::uint64_t>{}(low ^ (high * 0x9E3779B97F4A7C15ULL));
+    }
+};
+
+#endif // PULGACPP_HAS_INT128
+
+#endif // PULGACPP_I128_HPP
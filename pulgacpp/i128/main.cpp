@@ -0,0 +1,179 @@
+// Test program for pulgacpp::i128 and pulgacpp::u128
+// Compile: g++ -std=c++23 -Wall -I../.. main.cpp -o test_i128
+//      or: clang++ -std=c++23 -Wall -I../.. main.cpp -o test_i128
+// (MSVC has no __int128, so these types are not available there.)
+
+#include "i128.hpp"
+#include "../i64/i64.hpp"
+#include "../u128/u128.hpp"
+#include "../u64/u64.hpp"
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <unordered_set>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+// Builds 128-bit values from 64-bit constants (the constructors are explicit
+// about the exact primitive type)
+i128 I(std::int64_t value) { return i128(static_cast<__int128>(value)); }
+u128 U(std::uint64_t value) { return u128(static_cast<unsigned __int128>(value)); }
+
+template <typename T>
+std::string to_string(T value) {
+    std::ostringstream os;
+    os << value;
+    return os.str();
+}
+
+int main() {
+    std::cout << "=== pulgacpp::i128 / u128 Test Suite ===\n\n";
+
+    // --- Construction ---
+    std::cout << "--- Construction ---\n";
+    {
+        test(i128::BITS == 128 && u128::BITS == 128, "BITS is 128");
+        test(sizeof(i128) == 16 && sizeof(u128) == 16, "no size overhead");
+        test(to_string(i128(i128::MAX)) == "170141183460469231731687303715884105727",
+             "i128::MAX prints all 39 digits");
+        test(to_string(i128(i128::MIN)) == "-170141183460469231731687303715884105728",
+             "i128::MIN prints with sign");
+        test(to_string(u128(u128::MAX)) == "340282366920938463463374607431768211455",
+             "u128::MAX prints all 39 digits");
+        test(to_string(0_u128) == "0", "zero prints as 0");
+
+        auto big = 100000000000000000000_i128; // > unsigned long long
+        test(big.get() == static_cast<__int128>(10000000000ULL) * 10000000000LL,
+             "literal beyond 64 bits");
+        test((0xFFFF'FFFF'FFFF'FFFF'FFFF_u128).get() ==
+                 ((static_cast<unsigned __int128>(0xFFFF) << 64) | ~0ULL),
+             "hex literal with separators");
+        test(0b1010_u128 == 10_u128 && 017_i128 == 15_i128, "binary and octal literals");
+
+        test(u128::from(-1).is_none(), "u128::from(-1) is None");
+        test(u128::saturating_from(-5) == 0_u128, "u128::saturating_from(-5) is 0");
+        test(i128::from(INT64_MIN).is_some(), "i128::from(INT64_MIN) fits");
+    }
+
+    // --- Checked arithmetic ---
+    std::cout << "\n--- Checked Arithmetic ---\n";
+    {
+        auto max = i128(i128::MAX);
+        auto min = i128(i128::MIN);
+        test(max.checked_add(1_i128).is_none(), "i128::MAX + 1 overflows");
+        test(min.checked_sub(1_i128).is_none(), "i128::MIN - 1 overflows");
+        test(max.checked_sub(1_i128).is_some(), "i128::MAX - 1 is fine");
+        test(min.checked_mul(I(-1)).is_none(), "i128::MIN * -1 overflows");
+        test(min.checked_div(I(-1)).is_none(), "i128::MIN / -1 overflows");
+        test(min.checked_neg().is_none(), "-i128::MIN overflows");
+
+        auto two64 = i128(static_cast<__int128>(1) << 64);
+        test(two64.checked_mul(two64).is_none(), "2^64 * 2^64 overflows i128");
+        auto two63 = i128(static_cast<__int128>(1) << 63);
+        test(two63.checked_mul(two63.checked_mul(I(-2)).unwrap()).unwrap() == min,
+             "2^63 * -2^64 == i128::MIN exactly");
+
+        auto umax = u128(u128::MAX);
+        test(umax.checked_add(1_u128).is_none(), "u128::MAX + 1 overflows");
+        test(0_u128 .checked_sub(1_u128).is_none(), "0 - 1 underflows u128");
+        auto u64max = u128(static_cast<unsigned __int128>(UINT64_MAX));
+        auto square = u64max.checked_mul(u64max);
+        test(square.is_some() &&
+                 square.unwrap().get() == static_cast<unsigned __int128>(UINT64_MAX) * UINT64_MAX,
+             "u64::MAX^2 fits in u128");
+        test(square.unwrap().checked_mul(3_u128).is_none(), "u64::MAX^2 * 3 overflows");
+    }
+
+    // --- Saturating / wrapping / overflowing ---
+    std::cout << "\n--- Saturating, Wrapping, Overflowing ---\n";
+    {
+        test(i128(i128::MAX).saturating_add(5_i128) == i128(i128::MAX), "i128 saturating_add clamps");
+        test(i128(i128::MIN).saturating_sub(5_i128) == i128(i128::MIN), "i128 saturating_sub clamps");
+        test(i128(i128::MIN).saturating_mul(2_i128) == i128(i128::MIN), "i128 saturating_mul clamps low");
+        test(3_u128 .saturating_sub(5_u128) == 0_u128, "u128 saturating_sub clamps to 0");
+        test(u128(u128::MAX).wrapping_add(2_u128) == 1_u128, "u128 wrapping_add wraps");
+        auto [wrapped, overflow] = i128(i128::MAX).overflowing_add(1_i128);
+        test(overflow && wrapped == i128(i128::MIN), "i128 overflowing_add wraps to MIN");
+        test(!(checked_expr(1_i128) * 1000_i128 + 7_i128).is_overflowed(),
+             "checked_expr works with i128");
+    }
+
+    // --- Agreement with 64-bit types ---
+    std::cout << "\n--- Agreement with i64 / u64 ---\n";
+    {
+        bool agree = true;
+        const std::int64_t lhs[] = {0, 1, -1, 3037000499, -3037000500, INT64_MAX, INT64_MIN};
+        const std::int64_t rhs[] = {0, 2, -2, 3037000499, INT64_MAX, INT64_MIN};
+        for (std::int64_t a : lhs) {
+            for (std::int64_t b : rhs) {
+                // The 128-bit product must narrow exactly when the i64 product is Some
+                auto narrow = I(a).checked_mul(I(b)).unwrap().narrow<i64>();
+                auto direct = i64(a).checked_mul(i64(b));
+                agree = agree && narrow.is_some() == direct.is_some();
+                if (narrow.is_some() && direct.is_some()) {
+                    agree = agree && narrow.unwrap() == direct.unwrap();
+                }
+            }
+        }
+        test(agree, "i128 products narrow to i64 exactly when i64 doesn't overflow");
+
+        test(u64(u64::MAX).widen<u128>().get() == UINT64_MAX, "u64 widens to u128");
+        test(I(-1).narrow<u64>().is_none(), "negative i128 does not narrow to u64");
+        test(u128(u128::MAX).narrow<u64>().is_none(), "u128::MAX does not narrow to u64");
+        test(u128(u128::MAX).narrow<i128>().is_none(), "u128::MAX does not narrow to i128");
+        test(I(5).to<std::int32_t>().unwrap() == 5, "to<int32_t> in range");
+        test(U(5).to<std::int8_t>().unwrap() == 5, "unsigned to<int8_t> in range");
+    }
+
+    // --- Bit utilities ---
+    std::cout << "\n--- Bit Utilities ---\n";
+    {
+        test(u128(u128::MAX).count_ones() == 128, "count_ones of MAX");
+        test(1_u128 .leading_zeros() == 127, "leading_zeros of 1");
+        test(u128(static_cast<unsigned __int128>(1) << 100).trailing_zeros() == 100,
+             "trailing_zeros in the high half");
+        test(I(-1).count_zeros() == 0, "count_zeros of -1");
+    }
+
+    // --- STL ---
+    std::cout << "\n--- STL Compatibility ---\n";
+    {
+        std::unordered_set<u128> seen;
+        seen.insert(1_u128);
+        seen.insert(u128(static_cast<unsigned __int128>(1) << 64));
+        seen.insert(1_u128);
+        test(seen.size() == 2, "unordered_set<u128> distinguishes high/low halves");
+        test(I(-5) < 3_i128 && 3_u128 < u128(u128::MAX), "ordering");
+    }
+
+    // --- constexpr ---
+    {
+        constexpr auto product = (1000000000000_u128).checked_mul(1000000000000_u128);
+        static_assert(product.is_some());
+        constexpr bool overflowed = i128(i128::MAX).checked_add(1_i128).is_none();
+        static_assert(overflowed);
+        test(true, "128-bit checked ops are constexpr");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
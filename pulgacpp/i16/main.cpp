@@ -109,24 +109,24 @@ int main() {
         test(sub_underflow.is_none(), "-30000 - 10000 underflows (returns None)");
 
         // checked_mul
-        auto mul_ok = 100_i16.checked_mul(100_i16);
+        auto mul_ok = (100_i16).checked_mul(100_i16);
         test(mul_ok.is_some() && mul_ok.unwrap().get() == 10000, "100 * 100 = 10000");
 
-        auto mul_overflow = 1000_i16.checked_mul(100_i16);
+        auto mul_overflow = (1000_i16).checked_mul(100_i16);
         test(mul_overflow.is_none(), "1000 * 100 overflows (returns None)");
 
         // checked_div
-        auto div_ok = 10000_i16.checked_div(100_i16);
+        auto div_ok = (10000_i16).checked_div(100_i16);
         test(div_ok.is_some() && div_ok.unwrap().get() == 100, "10000 / 100 = 100");
 
-        auto div_by_zero = 10000_i16.checked_div(0_i16);
+        auto div_by_zero = (10000_i16).checked_div(0_i16);
         test(div_by_zero.is_none(), "10000 / 0 returns None");
 
         auto div_min = i16(i16::MIN).checked_div(i16(static_cast<std::int16_t>(-1)));
         test(div_min.is_none(), "MIN / -1 overflows (returns None)");
 
         // checked_neg
-        auto neg_ok = 1000_i16.checked_neg();
+        auto neg_ok = (1000_i16).checked_neg();
         test(neg_ok.is_some() && neg_ok.unwrap().get() == -1000, "negation works");
 
         auto neg_min = i16(i16::MIN).checked_neg();
@@ -152,7 +152,7 @@ int main() {
         auto sat_sub = neg.saturating_sub(30000_i16);
         test(sat_sub.get() == i16::MIN, "-30000 saturating_sub 30000 = MIN");
 
-        auto sat_mul = 1000_i16.saturating_mul(1000_i16);
+        auto sat_mul = (1000_i16).saturating_mul(1000_i16);
         test(sat_mul.get() == i16::MAX, "1000 saturating_mul 1000 = MAX");
     }
 
@@ -175,7 +175,7 @@ int main() {
         test(overflow == true, "MAX + 1 sets overflow flag");
         test(result.get() == i16::MIN, "MAX + 1 wraps to MIN");
 
-        auto [result2, no_overflow] = 1000_i16.overflowing_add(1000_i16);
+        auto [result2, no_overflow] = (1000_i16).overflowing_add(1000_i16);
         test(no_overflow == false, "1000 + 1000 does not overflow");
         test(result2.get() == 2000, "1000 + 1000 = 2000");
     }
@@ -100,31 +100,31 @@ int main() {
         test(sub_underflow.is_none(), "-100 - 50 underflows (returns None)");
 
         // checked_mul
-        auto mul_ok = 10_i8.checked_mul(10_i8);
+        auto mul_ok = (10_i8).checked_mul(10_i8);
         test(mul_ok.is_some() && mul_ok.unwrap().get() == 100, "10 * 10 = 100");
 
-        auto mul_overflow = 50_i8.checked_mul(10_i8);
+        auto mul_overflow = (50_i8).checked_mul(10_i8);
         test(mul_overflow.is_none(), "50 * 10 overflows (returns None)");
 
         // checked_div
-        auto div_ok = 100_i8.checked_div(10_i8);
+        auto div_ok = (100_i8).checked_div(10_i8);
         test(div_ok.is_some() && div_ok.unwrap().get() == 10, "100 / 10 = 10");
 
-        auto div_by_zero = 100_i8.checked_div(0_i8);
+        auto div_by_zero = (100_i8).checked_div(0_i8);
         test(div_by_zero.is_none(), "100 / 0 returns None");
 
         auto div_min = i8(i8::MIN).checked_div(i8(static_cast<std::int8_t>(-1)));
         test(div_min.is_none(), "MIN / -1 overflows (returns None)");
 
         // checked_rem
-        auto rem_ok = 100_i8.checked_rem(30_i8);
+        auto rem_ok = (100_i8).checked_rem(30_i8);
         test(rem_ok.is_some() && rem_ok.unwrap().get() == 10, "100 % 30 = 10");
 
-        auto rem_by_zero = 100_i8.checked_rem(0_i8);
+        auto rem_by_zero = (100_i8).checked_rem(0_i8);
         test(rem_by_zero.is_none(), "100 % 0 returns None");
 
         // checked_neg
-        auto neg_ok = 50_i8.checked_neg();
+        auto neg_ok = (50_i8).checked_neg();
         test(neg_ok.is_some() && neg_ok.unwrap().get() == -50, "-50 negation works");
 
         auto neg_min = i8(i8::MIN).checked_neg();
@@ -150,7 +150,7 @@ int main() {
         auto sat_sub = neg.saturating_sub(100_i8);
         test(sat_sub.get() == i8::MIN, "-100 saturating_sub 100 = MIN");
 
-        auto sat_mul = 50_i8.saturating_mul(10_i8);
+        auto sat_mul = (50_i8).saturating_mul(10_i8);
         test(sat_mul.get() == i8::MAX, "50 saturating_mul 10 = MAX");
     }
 
@@ -173,7 +173,7 @@ int main() {
         test(overflow == true, "MAX + 1 sets overflow flag");
         test(result.get() == i8::MIN, "MAX + 1 wraps to MIN");
 
-        auto [result2, no_overflow] = 50_i8.overflowing_add(10_i8);
+        auto [result2, no_overflow] = (50_i8).overflowing_add(10_i8);
         test(no_overflow == false, "50 + 10 does not overflow");
         test(result2.get() == 60, "50 + 10 = 60");
     }
@@ -237,13 +237,13 @@ int main() {
     // --- Optional Methods ---
     std::cout << "\n--- Optional Methods ---\n";
     {
-        auto some_val = 50_i8.checked_add(10_i8);
+        auto some_val = (50_i8).checked_add(10_i8);
         test(some_val.expect("should work").get() == 60, "expect() returns value");
 
         auto default_val = i8::from(999).unwrap_or(0_i8);
         test(default_val.get() == 0, "unwrap_or returns default on None");
 
-        auto mapped = 50_i8.checked_add(10_i8).map([](i8 v) { return v.get() * 2; });
+        auto mapped = (50_i8).checked_add(10_i8).map([](i8 v) { return v.get() * 2; });
         test(mapped.is_some() && mapped.unwrap() == 120, "map() transforms value");
     }
 
@@ -0,0 +1,114 @@
+// Benchmark: 128-bit % vs Montgomery vs Barrett (scalar and batch)
+// Compile: g++ -std=c++23 -O2 -I../.. bench_modint.cpp -o bench_modint
+//
+// The modulus is read from argv so the compiler cannot strength-reduce the
+// % baseline by itself.
+
+#include "modint.hpp"
+#include "../batch/batch.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace pulgacpp;
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 20;
+constexpr int ROUNDS = 20;
+
+/// Keeps `value` alive without letting the compiler see through it.
+template <typename T> void keep(T &value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+template <typename F> void run(const char *name, F body) {
+    body(); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        body();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-36s %8.3f ns/element\n", name, ns / (double(ROUNDS) * COUNT));
+}
+
+template <typename S> void bench(const char *type_name, typename S::underlying_type m) {
+    using T = typename S::underlying_type;
+    std::vector<S> a(COUNT), b(COUNT), out(COUNT);
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        a[i] = S(static_cast<T>(x));
+        b[i] = S(static_cast<T>(x >> 17));
+    }
+    auto mont = Montgomery<S>::from(S(m)).unwrap();
+    auto barrett = Barrett<S>::from(S(m)).unwrap();
+
+    std::printf("\n--- %s mod %llu ---\n", type_name, static_cast<unsigned long long>(m));
+    char label[64];
+
+    std::snprintf(label, sizeof label, "%s a * b %% m (wide)", type_name);
+    run(label, [&] {
+        using W = detail::make_unsigned_int_t<typename S::wider_type>;
+        T modulus = m;
+        keep(modulus);
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            out[i] = S(static_cast<T>(static_cast<W>(a[i].get()) * b[i].get() % modulus));
+        }
+        keep(out[0]);
+    });
+
+    std::snprintf(label, sizeof label, "%s Montgomery::mul_mod", type_name);
+    run(label, [&] {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            out[i] = mont.mul_mod(a[i], b[i]);
+        }
+        keep(out[0]);
+    });
+
+    std::snprintf(label, sizeof label, "%s Barrett::mul_mod", type_name);
+    run(label, [&] {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            out[i] = barrett.mul_mod(a[i], b[i]);
+        }
+        keep(out[0]);
+    });
+
+    std::snprintf(label, sizeof label, "%s batch::mul_mod (Montgomery)", type_name);
+    run(label, [&] {
+        batch::mul_mod<S>(a, b, mont, out);
+        keep(out[0]);
+    });
+
+    std::snprintf(label, sizeof label, "%s batch::mul_mod (Barrett)", type_name);
+    run(label, [&] {
+        batch::mul_mod<S>(a, b, barrett, out);
+        keep(out[0]);
+    });
+
+    std::snprintf(label, sizeof label, "%s batch::pow_mod e=65537", type_name);
+    run(label, [&] {
+        batch::pow_mod<S>(a, 65537, mont, out);
+        keep(out[0]);
+    });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned long long m = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000007;
+    if (m % 2 == 0) {
+        std::printf("modulus must be odd (Montgomery)\n");
+        return 1;
+    }
+    std::printf("=== Modular multiplication (%zu elements) ===\n", COUNT);
+    bench<u32>("u32", static_cast<std::uint32_t>(m));
+    bench<u64>("u64", static_cast<std::uint64_t>(m));
+    return 0;
+}
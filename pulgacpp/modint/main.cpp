@@ -0,0 +1,214 @@
+// Test program for pulgacpp::ModInt, Montgomery and Barrett
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_modint
+
+#include "modint.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+/// Reference a * b mod m through a 128-bit remainder.
+std::uint64_t reference_mul(std::uint64_t a, std::uint64_t b, std::uint64_t m) {
+    return static_cast<std::uint64_t>(static_cast<unsigned __int128>(a) * b % m);
+}
+
+std::uint64_t reference_pow(std::uint64_t a, std::uint64_t e, std::uint64_t m) {
+    std::uint64_t result = 1 % m;
+    a %= m;
+    while (e != 0) {
+        if (e & 1) {
+            result = reference_mul(result, a, m);
+        }
+        a = reference_mul(a, a, m);
+        e >>= 1;
+    }
+    return result;
+}
+
+/// Moduli at the edges of the range plus random ones; `odd` keeps only odd.
+template <typename S> std::vector<typename S::underlying_type> moduli(bool odd, unsigned seed) {
+    using T = typename S::underlying_type;
+    std::vector<T> values = {T(1), T(2), T(3), T(7), T(1000000007), S::MAX, T(S::MAX - 1),
+                             T(S::MAX - 58), T(S::MAX / 2), T(S::MAX / 2 + 1), T(T(1) << (sizeof(T) * 8 - 1))};
+    std::mt19937_64 rng(seed);
+    for (int i = 0; i < 200; ++i) {
+        unsigned bits = static_cast<unsigned>(rng() % (sizeof(T) * 8)) + 1;
+        auto raw = rng();
+        if (bits < 64) {
+            raw &= (std::uint64_t(1) << bits) - 1;
+        }
+        values.push_back(static_cast<T>(raw | 1));
+        values.push_back(static_cast<T>(raw));
+    }
+    std::vector<T> out;
+    for (T m : values) {
+        if (m != 0 && (!odd || (m & 1))) {
+            out.push_back(m);
+        }
+    }
+    return out;
+}
+
+template <typename S> std::vector<typename S::underlying_type> operands(unsigned seed) {
+    using T = typename S::underlying_type;
+    std::vector<T> values = {T(0), T(1), T(2), S::MAX, T(S::MAX - 1), T(S::MAX / 2)};
+    std::mt19937_64 rng(seed);
+    for (int i = 0; i < 30; ++i) {
+        values.push_back(static_cast<T>(rng()));
+    }
+    return values;
+}
+
+template <typename S> bool montgomery_matches(unsigned seed) {
+    for (auto m : moduli<S>(true, seed)) {
+        auto mont = Montgomery<S>::from(S(m)).unwrap();
+        for (auto a : operands<S>(seed + 1)) {
+            S ma = mont.to_montgomery(S(a));
+            if (mont.from_montgomery(ma).get() != a % m) {
+                return false;
+            }
+            for (auto b : operands<S>(seed + 2)) {
+                S mb = mont.to_montgomery(S(b));
+                if (mont.mul_mod(S(a), S(b)).get() != reference_mul(a, b, m) ||
+                    mont.from_montgomery(mont.mul(ma, mb)).get() != reference_mul(a, b, m) ||
+                    mont.from_montgomery(mont.add(ma, mb)).get() !=
+                        static_cast<std::uint64_t>((static_cast<unsigned __int128>(a % m) + b % m) % m) ||
+                    mont.from_montgomery(mont.sub(ma, mb)).get() !=
+                        static_cast<std::uint64_t>((static_cast<unsigned __int128>(a % m) + m - b % m) % m)) {
+                    return false;
+                }
+            }
+            if (mont.pow_mod(S(a), 1000003).get() != reference_pow(a, 1000003, m) ||
+                mont.pow_mod(S(a), 0).get() != 1 % m) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename S> bool barrett_matches(unsigned seed) {
+    for (auto m : moduli<S>(false, seed)) {
+        auto barrett = Barrett<S>::from(S(m)).unwrap();
+        for (auto a : operands<S>(seed + 1)) {
+            if (barrett.reduce(S(a)).get() != a % m) {
+                return false;
+            }
+            for (auto b : operands<S>(seed + 2)) {
+                if (barrett.mul_mod(S(a), S(b)).get() != reference_mul(a, b, m)) {
+                    return false;
+                }
+                auto ra = barrett.reduce(S(a)), rb = barrett.reduce(S(b));
+                if (barrett.add_mod(ra, rb).get() !=
+                        static_cast<std::uint64_t>((static_cast<unsigned __int128>(a % m) + b % m) % m) ||
+                    barrett.sub_mod(ra, rb).get() !=
+                        static_cast<std::uint64_t>((static_cast<unsigned __int128>(a % m) + m - b % m) % m)) {
+                    return false;
+                }
+            }
+            if (barrett.pow_mod(S(a), 65537).get() != reference_pow(a, 65537, m)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+using F7 = ModInt<u32, 7>;
+using P61 = ModInt<u64, (std::uint64_t(1) << 61) - 1>;
+using Goldilocks = ModInt<u64, 0xFFFFFFFF00000001ull>;
+using Even = ModInt<u64, 1000000000000ull>;
+using Pow32 = ModInt<u64, std::uint64_t(1) << 32>;
+
+int main() {
+    std::cout << "=== pulgacpp::ModInt Test Suite ===\n\n";
+
+    // --- Reducers against 128-bit remainders ---
+    std::cout << "--- Montgomery and Barrett ---\n";
+    {
+        test(Montgomery<u64>::from(10_u64).is_none(), "Montgomery rejects an even modulus");
+        test(Montgomery<u64>::from(0_u64).is_none(), "Montgomery rejects zero");
+        test(Barrett<u64>::from(0_u64).is_none(), "Barrett rejects zero");
+        auto mont = Montgomery<u64>::from(u64(std::uint64_t{1000000007})).unwrap();
+        test(static_cast<std::uint64_t>(mont.inverse() * 1000000007ull) == 1, "inverse() is m^-1 mod 2^64");
+        test(mont.from_montgomery(mont.one()) == 1_u64, "one() is 1 in Montgomery form");
+
+        test(montgomery_matches<u32>(1), "Montgomery<u32> matches % (mul, add, sub, pow)");
+        test(montgomery_matches<u64>(2), "Montgomery<u64> matches % (mul, add, sub, pow)");
+        test(barrett_matches<u32>(3), "Barrett<u32> matches % (reduce, mul, add, sub, pow)");
+        test(barrett_matches<u64>(4), "Barrett<u64> matches % (reduce, mul, add, sub, pow)");
+    }
+
+    // --- ModInt ---
+    std::cout << "\n--- ModInt ---\n";
+    {
+        test(F7::from(10).get() == 3_u32, "from() reduces");
+        test(F7::from(-1).get() == 6_u32, "negative values wrap");
+        test(F7::from(std::int64_t(INT64_MIN)).get() == u32(static_cast<std::uint32_t>(
+                 (7 - static_cast<std::uint64_t>(1ull << 63) % 7) % 7)),
+             "from(INT64_MIN)");
+        test((F7::from(5) + F7::from(4)).get() == 2_u32, "addition wraps around M");
+        test((F7::from(2) - F7::from(5)).get() == 4_u32, "subtraction wraps around M");
+        test((F7::from(3) * F7::from(5)).get() == 1_u32, "multiplication");
+        test((-F7::from(3)).get() == 4_u32 && (-F7()).get() == 0_u32, "negation");
+        test(F7::from(3).pow(6) == F7::from(1), "Fermat: 3^6 = 1 mod 7");
+
+        auto big = P61::from(u64(u64::MAX));
+        test(big.get() == u64(u64::MAX % ((std::uint64_t(1) << 61) - 1)), "P61 from(MAX)");
+        auto x = Goldilocks::from(u64(std::uint64_t{0x123456789ABCDEF}));
+        auto y = Goldilocks::from(u64(std::uint64_t{0xFEDCBA987654321}));
+        test((x * y).get() == u64(reference_mul(0x123456789ABCDEFull, 0xFEDCBA987654321ull,
+                                                0xFFFFFFFF00000001ull)),
+             "Goldilocks multiply");
+        test(x.checked_inverse().unwrap() * x == Goldilocks::from(1), "inverse modulo a prime");
+        test(Goldilocks().checked_inverse().is_none(), "zero has no inverse");
+
+        test(!Even::USES_MONTGOMERY && Pow32::from(u64(u64::MAX)).get() == u64(std::uint64_t{0xFFFFFFFF}),
+             "even modulus uses Barrett");
+        auto e = Even::from(u64(std::uint64_t{999999999999}));
+        test((e * e).get() == 1_u64, "even modulus multiply: (-1)^2 = 1");
+        test(Even::from(2).checked_inverse().is_none(), "2 has no inverse mod 10^12");
+        test((Even::from(7).checked_inverse().unwrap() * Even::from(7)).get() == 1_u64,
+             "inverse modulo a composite");
+
+        test(sizeof(P61) == 8 && sizeof(F7) == 4, "ModInt is the size of its residue");
+        constexpr auto c = ModInt<u64, 1000000007>::from(2).pow(30);
+        static_assert(c.get() == 73741817_u64);
+        test(true, "constexpr pow");
+
+        std::unordered_set<F7> seen{F7::from(1), F7::from(8)};
+        test(seen.size() == 1, "unordered_set<ModInt> (1 == 8 mod 7)");
+        std::ostringstream os;
+        os << F7::from(12);
+        test(os.str() == "5", "operator<< prints the residue");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
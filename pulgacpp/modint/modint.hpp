@@ -0,0 +1,501 @@
+// pulgacpp::ModInt - Modular arithmetic with Montgomery and Barrett reduction
+// SPDX-License-Identifier: MIT
+//
+// `(a * b) % m` on u64 needs the full 128-bit product, and a 128-by-64-bit
+// remainder is one of the slowest instructions there is (or a library call).
+// The reducers here replace it with multiplications:
+//
+//   Montgomery<S>  odd modulus. Values live in Montgomery form (x * 2^N mod m)
+//                  and a product is reduced with two multiply-highs and a
+//                  subtraction (REDC).
+//   Barrett<S>     any non-zero modulus. A precomputed reciprocal turns the
+//                  remainder into a multiply-high and at most two
+//                  subtractions; values stay plain.
+//   ModInt<S, M>   value type with a compile-time modulus. Picks Montgomery
+//                  for odd M and Barrett otherwise; + - * never overflow.
+//
+// S is u32 or u64. Multiply-high comes from core/overflow.hpp (__int128 or
+// __umulh). Span versions of the multiply and power live in batch.hpp.
+//
+// Usage:
+//   #include <pulgacpp/modint/modint.hpp>
+//
+//   using Fp = ModInt<u64, 0xFFFFFFFF00000001>;   // 2^64 - 2^32 + 1
+//   Fp h = Fp::from(seed);
+//   for (u64 c : data) h = h * Fp::from(31) + Fp::from(c);
+//
+//   auto mod = Montgomery<u64>::from(runtime_prime).expect("odd modulus");
+//   u64 r = mod.pow_mod(base, exponent);
+
+#ifndef PULGACPP_MODINT_HPP
+#define PULGACPP_MODINT_HPP
+
+#include "../core/safe_int.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+
+namespace pulgacpp {
+
+namespace detail {
+
+/// Unsigned SafeInt of 32 or 64 bits: the widths the reducers support.
+template <typename S>
+concept ModularBase =
+    SafeInteger<S> && !is_signed_int_v<typename S::underlying_type> &&
+    (sizeof(typename S::underlying_type) == 4 ||
+     sizeof(typename S::underlying_type) == 8);
+
+/// True if S has a wider_type twice its width (Barrett needs it).
+template <typename S>
+constexpr bool has_double_width_v =
+    sizeof(typename S::wider_type) >= 2 * sizeof(typename S::underlying_type);
+
+/// Upper 2N bits of the 4N-bit product of two 2N-bit values W, computed
+/// from N-bit halves so only W-sized multiplies are needed.
+template <typename U, typename W>
+[[nodiscard]] constexpr W mul_high_double(W x, W y) noexcept {
+  constexpr unsigned bits = sizeof(U) * 8;
+  W x0 = static_cast<U>(x), x1 = x >> bits;
+  W y0 = static_cast<U>(y), y1 = y >> bits;
+  W p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+  W middle = (p00 >> bits) + static_cast<U>(p01) + static_cast<U>(p10);
+  return p11 + (p01 >> bits) + (p10 >> bits) + (middle >> bits);
+}
+
+} // namespace detail
+
+// ============================================================
+// Montgomery reduction (odd runtime modulus)
+// ============================================================
+
+/// Modular arithmetic for an odd modulus fixed at runtime.
+///
+/// mul/add/sub/pow take and return values in Montgomery form, which are
+/// always less than the modulus. mul_mod/pow_mod take plain values of any
+/// size and return plain residues.
+template <detail::ModularBase S> class Montgomery {
+public:
+  using value_type = S;
+  using underlying_type = typename S::underlying_type;
+  using wider_type = typename S::wider_type;
+
+  static constexpr unsigned BITS = sizeof(underlying_type) * 8;
+
+  /// Returns None if `modulus` is even (including zero).
+  [[nodiscard]] static constexpr Optional<Montgomery> from(S modulus) noexcept {
+    if ((modulus.get() & 1) == 0) {
+      return None;
+    }
+    return Some(Montgomery(modulus.get()));
+  }
+
+  [[nodiscard]] constexpr S modulus() const noexcept { return S(m_modulus); }
+
+  // ==================== Montgomery form ====================
+
+  /// x * 2^N mod m, for any x.
+  [[nodiscard]] constexpr S to_montgomery(S x) const noexcept {
+    return S(multiply(x.get(), m_r2));
+  }
+
+  /// Plain residue of a Montgomery-form value.
+  [[nodiscard]] constexpr S from_montgomery(S x) const noexcept {
+    return S(reduce(0, x.get()));
+  }
+
+  /// Montgomery form of 1.
+  [[nodiscard]] constexpr S one() const noexcept { return S(m_r1); }
+
+  /// Product of two Montgomery-form values.
+  [[nodiscard]] constexpr S mul(S x, S y) const noexcept {
+    return S(multiply(x.get(), y.get()));
+  }
+
+  [[nodiscard]] constexpr S add(S x, S y) const noexcept {
+    return S(add_raw(x.get(), y.get()));
+  }
+
+  [[nodiscard]] constexpr S sub(S x, S y) const noexcept {
+    return S(sub_raw(x.get(), y.get()));
+  }
+
+  /// x^e of a Montgomery-form value, by square and multiply.
+  [[nodiscard]] constexpr S pow(S x, std::uint64_t e) const noexcept {
+    return S(pow_raw(x.get(), e));
+  }
+
+  // ==================== Plain values ====================
+
+  /// a * b mod m for any a and b.
+  [[nodiscard]] constexpr S mul_mod(S a, S b) const noexcept {
+    return S(multiply(multiply(a.get(), m_r2), b.get()));
+  }
+
+  /// a^e mod m for any a.
+  [[nodiscard]] constexpr S pow_mod(S a, std::uint64_t e) const noexcept {
+    return S(reduce(0, pow_raw(multiply(a.get(), m_r2), e)));
+  }
+
+  // ==================== Raw kernels ====================
+  // Used by ModInt and the span versions in batch.hpp.
+
+  /// REDC: (hi * 2^N + lo) / 2^N mod m. Requires hi < m.
+  [[nodiscard]] constexpr underlying_type
+  reduce(underlying_type hi, underlying_type lo) const noexcept {
+    // q * m has the same low half as the input, so only the high halves
+    // need subtracting
+    underlying_type q = static_cast<underlying_type>(lo * m_inverse);
+    underlying_type h = detail::mul_high<underlying_type, wider_type>(q, m_modulus);
+    underlying_type r = static_cast<underlying_type>(hi - h);
+    return hi < h ? static_cast<underlying_type>(r + m_modulus) : r;
+  }
+
+  /// REDC(x * y). Requires x * y < m * 2^N (true if either is below m).
+  [[nodiscard]] constexpr underlying_type
+  multiply(underlying_type x, underlying_type y) const noexcept {
+    return reduce(detail::mul_high<underlying_type, wider_type>(x, y),
+                  static_cast<underlying_type>(x * y));
+  }
+
+  [[nodiscard]] constexpr underlying_type
+  add_raw(underlying_type x, underlying_type y) const noexcept {
+    underlying_type sum = static_cast<underlying_type>(x + y);
+    // sum < x catches the carry out of the top bit
+    return (sum < x || sum >= m_modulus) ? static_cast<underlying_type>(sum - m_modulus)
+                                         : sum;
+  }
+
+  [[nodiscard]] constexpr underlying_type
+  sub_raw(underlying_type x, underlying_type y) const noexcept {
+    underlying_type diff = static_cast<underlying_type>(x - y);
+    return x < y ? static_cast<underlying_type>(diff + m_modulus) : diff;
+  }
+
+  [[nodiscard]] constexpr underlying_type
+  pow_raw(underlying_type x, std::uint64_t e) const noexcept {
+    underlying_type result = m_r1;
+    while (e != 0) {
+      if (e & 1) {
+        result = multiply(result, x);
+      }
+      x = multiply(x, x);
+      e >>= 1;
+    }
+    return result;
+  }
+
+  /// m^-1 mod 2^N.
+  [[nodiscard]] constexpr underlying_type inverse() const noexcept {
+    return m_inverse;
+  }
+
+  /// 2^2N mod m; multiply(x, r2()) puts x into Montgomery form.
+  [[nodiscard]] constexpr underlying_type r2() const noexcept { return m_r2; }
+
+  [[nodiscard]] constexpr bool operator==(const Montgomery &other) const noexcept {
+    return m_modulus == other.m_modulus;
+  }
+
+private:
+  constexpr explicit Montgomery(underlying_type modulus) noexcept
+      : m_modulus(modulus), m_inverse(inverse_of(modulus)),
+        m_r1(static_cast<underlying_type>(underlying_type(0) - modulus) % modulus),
+        m_r2(square_shift(m_r1, modulus)) {}
+
+  /// Newton iteration: each step doubles the number of correct low bits,
+  /// starting from 3 (m * m == 1 mod 8 for odd m).
+  [[nodiscard]] static constexpr underlying_type
+  inverse_of(underlying_type m) noexcept {
+    underlying_type inv = m;
+    for (int i = 0; i < 5; ++i) {
+      inv = static_cast<underlying_type>(inv * static_cast<underlying_type>(2 - m * inv));
+    }
+    return inv;
+  }
+
+  /// r1 * 2^N mod m (= 2^2N mod m), by N modular doublings.
+  [[nodiscard]] static constexpr underlying_type
+  square_shift(underlying_type r1, underlying_type m) noexcept {
+    underlying_type x = r1;
+    for (unsigned i = 0; i < BITS; ++i) {
+      // 2x mod m without overflowing: x >= m - x means 2x >= m
+      x = x >= static_cast<underlying_type>(m - x)
+              ? static_cast<underlying_type>(x - (m - x))
+              : static_cast<underlying_type>(x + x);
+    }
+    return x;
+  }
+
+  underlying_type m_modulus;
+  underlying_type m_inverse; // m^-1 mod 2^N
+  underlying_type m_r1;      // 2^N mod m (Montgomery one)
+  underlying_type m_r2;      // 2^2N mod m (converts into Montgomery form)
+};
+
+// ============================================================
+// Barrett reduction (any non-zero runtime modulus)
+// ============================================================
+
+/// Modular arithmetic for any non-zero modulus fixed at runtime. Values are
+/// plain residues. Needs a wider_type twice the width of S (u64 for u32,
+/// unsigned __int128 for u64).
+template <detail::ModularBase S>
+  requires detail::has_double_width_v<S>
+class Barrett {
+public:
+  using value_type = S;
+  using underlying_type = typename S::underlying_type;
+  using wide_type = detail::make_unsigned_int_t<typename S::wider_type>;
+
+  static constexpr unsigned BITS = sizeof(underlying_type) * 8;
+
+  /// Returns None if `modulus` is zero.
+  [[nodiscard]] static constexpr Optional<Barrett> from(S modulus) noexcept {
+    if (modulus.get() == 0) {
+      return None;
+    }
+    return Some(Barrett(modulus.get()));
+  }
+
+  [[nodiscard]] constexpr S modulus() const noexcept { return S(m_modulus); }
+
+  /// x mod m.
+  [[nodiscard]] constexpr S reduce(S x) const noexcept {
+    return S(reduce_wide(x.get()));
+  }
+
+  /// a * b mod m for any a and b.
+  [[nodiscard]] constexpr S mul_mod(S a, S b) const noexcept {
+    return S(multiply(a.get(), b.get()));
+  }
+
+  /// a^e mod m for any a.
+  [[nodiscard]] constexpr S pow_mod(S a, std::uint64_t e) const noexcept {
+    return S(pow_raw(reduce_wide(a.get()), e));
+  }
+
+  /// (a + b) mod m for residues a, b < m.
+  [[nodiscard]] constexpr S add_mod(S a, S b) const noexcept {
+    return S(add_raw(a.get(), b.get()));
+  }
+
+  /// (a - b) mod m for residues a, b < m.
+  [[nodiscard]] constexpr S sub_mod(S a, S b) const noexcept {
+    return S(sub_raw(a.get(), b.get()));
+  }
+
+  // ==================== Raw kernels ====================
+
+  /// x mod m for any double-width x.
+  [[nodiscard]] constexpr underlying_type reduce_wide(wide_type x) const noexcept {
+    // q undershoots x / m by at most 2
+    wide_type q = detail::mul_high_double<underlying_type>(x, m_factor);
+    wide_type r = x - q * m_modulus;
+    if (r >= m_modulus) {
+      r -= m_modulus;
+    }
+    if (r >= m_modulus) {
+      r -= m_modulus;
+    }
+    return static_cast<underlying_type>(r);
+  }
+
+  [[nodiscard]] constexpr underlying_type
+  multiply(underlying_type a, underlying_type b) const noexcept {
+    return reduce_wide(static_cast<wide_type>(a) * b);
+  }
+
+  [[nodiscard]] constexpr underlying_type
+  add_raw(underlying_type a, underlying_type b) const noexcept {
+    underlying_type sum = static_cast<underlying_type>(a + b);
+    return (sum < a || sum >= m_modulus) ? static_cast<underlying_type>(sum - m_modulus)
+                                         : sum;
+  }
+
+  [[nodiscard]] constexpr underlying_type
+  sub_raw(underlying_type a, underlying_type b) const noexcept {
+    underlying_type diff = static_cast<underlying_type>(a - b);
+    return a < b ? static_cast<underlying_type>(diff + m_modulus) : diff;
+  }
+
+  [[nodiscard]] constexpr underlying_type
+  pow_raw(underlying_type x, std::uint64_t e) const noexcept {
+    underlying_type result = reduce_wide(1);
+    while (e != 0) {
+      if (e & 1) {
+        result = multiply(result, x);
+      }
+      x = multiply(x, x);
+      e >>= 1;
+    }
+    return result;
+  }
+
+  [[nodiscard]] constexpr bool operator==(const Barrett &other) const noexcept {
+    return m_modulus == other.m_modulus;
+  }
+
+private:
+  constexpr explicit Barrett(underlying_type modulus) noexcept
+      : m_modulus(modulus), m_factor(~wide_type(0) / modulus) {}
+
+  underlying_type m_modulus;
+  wide_type m_factor; // floor((2^2N - 1) / m)
+};
+
+// ============================================================
+// ModInt (compile-time modulus)
+// ============================================================
+
+/// An integer modulo M. Arithmetic wraps around M and never fails.
+///
+/// Odd M is stored in Montgomery form; even M uses Barrett reduction (and
+/// needs a double-width wider_type). get() always returns the plain residue.
+template <detail::ModularBase S, typename S::underlying_type M>
+  requires(M != 0 && (M % 2 == 1 || detail::has_double_width_v<S>))
+class ModInt {
+public:
+  using value_type = S;
+  using underlying_type = typename S::underlying_type;
+
+  static constexpr underlying_type MODULUS = M;
+  static constexpr bool USES_MONTGOMERY = M % 2 == 1;
+
+  // ==================== Construction ====================
+
+  /// Zero.
+  constexpr ModInt() noexcept : m_value(0) {}
+
+  /// value mod M.
+  [[nodiscard]] static constexpr ModInt from(S value) noexcept {
+    if constexpr (USES_MONTGOMERY) {
+      return ModInt(REDUCER.to_montgomery(value).get());
+    } else {
+      return ModInt(REDUCER.reduce(value).get());
+    }
+  }
+
+  /// value mod M for any built-in integer; negative values wrap around.
+  template <std::integral T>
+  [[nodiscard]] static constexpr ModInt from(T value) noexcept {
+    if constexpr (std::is_signed_v<T>) {
+      // Magnitude as unsigned so that T's MIN does not overflow
+      std::uint64_t magnitude =
+          value < 0 ? std::uint64_t(0) - static_cast<std::uint64_t>(value)
+                    : static_cast<std::uint64_t>(value);
+      ModInt result = from_u64(magnitude);
+      return value < 0 ? -result : result;
+    } else {
+      return from_u64(static_cast<std::uint64_t>(value));
+    }
+  }
+
+  // ==================== Accessors ====================
+
+  /// The residue in [0, M).
+  [[nodiscard]] constexpr S get() const noexcept {
+    if constexpr (USES_MONTGOMERY) {
+      return REDUCER.from_montgomery(S(m_value));
+    } else {
+      return S(m_value);
+    }
+  }
+
+  /// The stored representation (Montgomery form for odd M).
+  [[nodiscard]] constexpr underlying_type raw() const noexcept { return m_value; }
+
+  /// The reducer for M: Montgomery<S> for odd M, Barrett<S> otherwise.
+  [[nodiscard]] static constexpr const auto &reducer() noexcept { return REDUCER; }
+
+  // ==================== Arithmetic ====================
+
+  [[nodiscard]] constexpr ModInt pow(std::uint64_t exponent) const noexcept {
+    return ModInt(REDUCER.pow_raw(m_value, exponent));
+  }
+
+  /// Multiplicative inverse; None if gcd(value, M) != 1.
+  [[nodiscard]] constexpr Optional<ModInt> checked_inverse() const noexcept {
+    // Extended Euclid, keeping the Bezout coefficient as a ModInt
+    underlying_type a = get().get();
+    underlying_type b = M;
+    ModInt x0 = from(S(underlying_type{1}));
+    ModInt x1;
+    while (b != 0) {
+      underlying_type q = a / b;
+      underlying_type next = static_cast<underlying_type>(a - q * b);
+      a = b;
+      b = next;
+      ModInt x2 = x0 - from(S(q)) * x1;
+      x0 = x1;
+      x1 = x2;
+    }
+    if (a != 1) {
+      return None;
+    }
+    return Some(x0);
+  }
+
+  [[nodiscard]] constexpr ModInt operator+(ModInt rhs) const noexcept {
+    return ModInt(REDUCER.add_raw(m_value, rhs.m_value));
+  }
+  [[nodiscard]] constexpr ModInt operator-(ModInt rhs) const noexcept {
+    return ModInt(REDUCER.sub_raw(m_value, rhs.m_value));
+  }
+  [[nodiscard]] constexpr ModInt operator*(ModInt rhs) const noexcept {
+    return ModInt(REDUCER.multiply(m_value, rhs.m_value));
+  }
+  [[nodiscard]] constexpr ModInt operator-() const noexcept {
+    return ModInt() - *this;
+  }
+
+  constexpr ModInt &operator+=(ModInt rhs) noexcept { return *this = *this + rhs; }
+  constexpr ModInt &operator-=(ModInt rhs) noexcept { return *this = *this - rhs; }
+  constexpr ModInt &operator*=(ModInt rhs) noexcept { return *this = *this * rhs; }
+
+  // ==================== Comparison ====================
+  // Equality only: residues have no meaningful order.
+
+  [[nodiscard]] constexpr bool operator==(const ModInt &other) const noexcept = default;
+
+  friend std::ostream &operator<<(std::ostream &os, ModInt value) {
+    return os << value.get();
+  }
+
+private:
+  [[nodiscard]] static constexpr auto make_reducer() noexcept {
+    if constexpr (USES_MONTGOMERY) {
+      return Montgomery<S>::from(S(M)).unwrap();
+    } else {
+      return Barrett<S>::from(S(M)).unwrap();
+    }
+  }
+
+  static constexpr auto REDUCER = make_reducer();
+
+  constexpr explicit ModInt(underlying_type raw) noexcept : m_value(raw) {}
+
+  [[nodiscard]] static constexpr ModInt from_u64(std::uint64_t value) noexcept {
+    // M is a constant, so this % is strength-reduced by the compiler
+    return from(S(static_cast<underlying_type>(value % M)));
+  }
+
+  underlying_type m_value;
+};
+
+} // namespace pulgacpp
+
+// std::hash specialization for unordered containers
+template <pulgacpp::detail::ModularBase S, typename S::underlying_type M>
+struct std::hash<pulgacpp::ModInt<S, M>> {
+  [[nodiscard]] std::size_t
+  operator()(pulgacpp::ModInt<S, M> value) const noexcept {
+    return std::hash<typename S::underlying_type>{}(value.raw());
+  }
+};
+
+#endif // PULGACPP_MODINT_HPP
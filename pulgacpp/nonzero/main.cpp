@@ -0,0 +1,107 @@
+// Test program for pulgacpp::NonZero
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_nonzero
+
+#include "nonzero.hpp"
+#include "../i32/i32.hpp"
+#include "../i64/i64.hpp"
+#include "../u32/u32.hpp"
+#include "../u8/u8.hpp"
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <unordered_set>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+int main() {
+    std::cout << "=== pulgacpp::NonZero Test Suite ===\n\n";
+
+    // --- Construction ---
+    std::cout << "--- Construction ---\n";
+    {
+        test(NonZero<i32>::from(0_i32).is_none(), "from(0) is None");
+        test(NonZero<i32>::from(i32(-5)).unwrap().get() == i32(-5), "from(-5) keeps the value");
+        test(NonZero<u8>::from(300).is_none(), "from(300) does not fit u8");
+        test(NonZero<u8>::from(0).is_none(), "from(int 0) is None");
+        test(NonZero<u32>::constant<16>().get() == 16_u32, "constant<16>()");
+        test(static_cast<u32>(NonZero<u32>::constant<3>()) == 3_u32, "explicit conversion to S");
+    }
+
+    // --- Division ---
+    std::cout << "\n--- Division ---\n";
+    {
+        auto d = NonZero<u32>::constant<7>();
+        test(100_u32 / d == 14_u32, "u32 / NonZero<u32>");
+        test(100_u32 % d == 2_u32, "u32 % NonZero<u32>");
+        test(u32(u32::MAX) / NonZero<u32>::constant<1>() == u32(u32::MAX), "divide by one");
+
+        auto minus_one = NonZero<i32>::from(i32(-1)).unwrap();
+        test(i32(i32::MIN).checked_div(minus_one.get()).is_none(),
+             "signed MIN / -1 is still caught");
+        test(i32(i32::MIN).checked_rem(minus_one.get()).is_none(),
+             "signed MIN % -1 is None instead of trapping");
+        test(i32(-7).checked_rem(NonZero<i32>::constant<2>().get()).unwrap() == i32(-1),
+             "signed remainder keeps the dividend's sign");
+    }
+
+    // --- Arithmetic ---
+    std::cout << "\n--- Arithmetic ---\n";
+    {
+        auto a = NonZero<i64>::constant<3>();
+        test(a.checked_mul(a).unwrap().get() == 9_i64, "checked_mul");
+        auto big = NonZero<i64>::from(i64(i64::MAX)).unwrap();
+        test(big.checked_mul(a).is_none(), "checked_mul overflow is None");
+        test(NonZero<i64>::from(std::int64_t{-4}).unwrap().checked_abs().unwrap().get() == 4_i64,
+             "checked_abs");
+        test(NonZero<i64>::from(i64(i64::MIN)).unwrap().checked_abs().is_none(),
+             "checked_abs of MIN is None");
+    }
+
+    // --- Optional niche ---
+    std::cout << "\n--- Compact Optional ---\n";
+    {
+        test(sizeof(Optional<NonZero<u8>>) == 1, "Optional<NonZero<u8>> is 1 byte");
+        test(sizeof(Optional<NonZero<i64>>) == 8, "Optional<NonZero<i64>> is 8 bytes");
+        Optional<NonZero<u32>> none;
+        test(none.is_none(), "default Optional is None");
+        auto some = NonZero<u32>::from(42_u32);
+        test(some.is_some() && some.unwrap().get() == 42_u32, "Some round trip");
+        test(some != none && none == Optional<NonZero<u32>>(None), "Optional comparison");
+    }
+
+    // --- STL / comparison ---
+    std::cout << "\n--- Comparison and STL ---\n";
+    {
+        auto two = NonZero<i32>::constant<2>();
+        auto three = NonZero<i32>::constant<3>();
+        test(two < three && two == NonZero<i32>::constant<2>(), "ordering");
+        std::unordered_set<NonZero<i32>> seen{two, three, two};
+        test(seen.size() == 2, "unordered_set<NonZero<i32>>");
+        std::ostringstream os;
+        os << NonZero<u8>::constant<200>();
+        test(os.str() == "200", "operator<< prints the number");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+// pulgacpp::NonZero - Integer that is never zero
+// SPDX-License-Identifier: MIT
+//
+// The zero check happens once, in NonZero::from(). After that the invariant
+// travels with the type:
+//   - unsigned `a / n` and `a % n` need no check at all and return S
+//   - signed division still goes through checked_div (MIN / -1 can
+//     overflow), but get() tells the optimizer the divisor is non-zero, so
+//     the zero test inside checked_div compiles away
+//   - Optional<NonZero<S>> uses 0 as None and is the same size as S
+//
+// Usage:
+//   #include <pulgacpp/nonzero/nonzero.hpp>
+//
+//   auto bucket_count = NonZero<u32>::from(config.buckets).expect("buckets");
+//   u32 bucket = hash % bucket_count;            // no zero check
+//   auto avg = total.checked_div(count.get());   // only the MIN/-1 check
+
+#ifndef PULGACPP_NONZERO_HPP
+#define PULGACPP_NONZERO_HPP
+
+#include "../core/safe_int.hpp"
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
+namespace pulgacpp {
+
+/// A SafeInt value that is known to be non-zero.
+template <detail::SafeInteger S> class NonZero {
+public:
+  using value_type = S;
+  using underlying_type = typename S::underlying_type;
+
+  // ==================== Construction ====================
+
+  /// Returns None if `value` is zero.
+  [[nodiscard]] static constexpr Optional<NonZero> from(S value) noexcept {
+    if (value.get() == 0) {
+      return None;
+    }
+    return Some(NonZero(value));
+  }
+
+  /// Returns None if `value` is zero or does not fit in S.
+  template <std::integral T>
+  [[nodiscard]] static constexpr Optional<NonZero> from(T value) noexcept {
+    auto converted = S::from(value);
+    if (converted.is_none()) {
+      return None;
+    }
+    return from(converted.unwrap());
+  }
+
+  /// Compile-time constant: `NonZero<u32>::constant<16>()`.
+  template <underlying_type Value>
+    requires(Value != 0)
+  [[nodiscard]] static constexpr NonZero constant() noexcept {
+    return NonZero(S(Value));
+  }
+
+  // ==================== Accessors ====================
+
+  /// The value. Also tells the optimizer it is non-zero.
+  [[nodiscard]] constexpr S get() const noexcept {
+    PULGACPP_ASSUME(m_value.get() != 0);
+    return m_value;
+  }
+
+  [[nodiscard]] constexpr explicit operator S() const noexcept { return get(); }
+
+  // ==================== Arithmetic ====================
+
+  /// Product of two non-zero values; None on overflow (never zero otherwise).
+  [[nodiscard]] constexpr Optional<NonZero>
+  checked_mul(NonZero rhs) const noexcept {
+    auto product = get().checked_mul(rhs.get());
+    if (product.is_none()) {
+      return None;
+    }
+    return Some(NonZero(product.unwrap()));
+  }
+
+  /// Absolute value; None for MIN of a signed type.
+  [[nodiscard]] constexpr Optional<NonZero> checked_abs() const noexcept
+    requires detail::is_signed_int_v<underlying_type>
+  {
+    auto magnitude = get().checked_abs();
+    if (magnitude.is_none()) {
+      return None;
+    }
+    return Some(NonZero(magnitude.unwrap()));
+  }
+
+  // ==================== Comparison ====================
+
+  [[nodiscard]] constexpr auto
+  operator<=>(const NonZero &other) const noexcept = default;
+  [[nodiscard]] constexpr bool
+  operator==(const NonZero &other) const noexcept = default;
+
+  friend std::ostream &operator<<(std::ostream &os, NonZero value) {
+    return os << value.m_value;
+  }
+
+private:
+  constexpr explicit NonZero(S value) noexcept : m_value(value) {}
+
+  friend struct niche_traits<NonZero>;
+
+  S m_value;
+};
+
+// ==================== Unchecked division ====================
+// Only for unsigned types: with a non-zero divisor nothing can go wrong.
+// Signed types keep checked_div/checked_rem because MIN / -1 overflows.
+
+template <detail::SafeInteger S>
+  requires(!detail::is_signed_int_v<typename S::underlying_type>)
+[[nodiscard]] constexpr S operator/(S lhs, NonZero<S> rhs) noexcept {
+  return S(static_cast<typename S::underlying_type>(lhs.get() /
+                                                    rhs.get().get()));
+}
+
+template <detail::SafeInteger S>
+  requires(!detail::is_signed_int_v<typename S::underlying_type>)
+[[nodiscard]] constexpr S operator%(S lhs, NonZero<S> rhs) noexcept {
+  return S(static_cast<typename S::underlying_type>(lhs.get() %
+                                                    rhs.get().get()));
+}
+
+/// Optional<NonZero<S>> stores None as 0.
+template <detail::SafeInteger S> struct niche_traits<NonZero<S>> {
+  [[nodiscard]] static constexpr NonZero<S> none() noexcept {
+    return NonZero<S>(S());
+  }
+  [[nodiscard]] static constexpr bool is_none(const NonZero<S> &value) noexcept {
+    return value.m_value.get() == 0;
+  }
+};
+
+} // namespace pulgacpp
+
+// std::hash specialization for unordered containers
+template <pulgacpp::detail::SafeInteger S>
+struct std::hash<pulgacpp::NonZero<S>> {
+  [[nodiscard]] std::size_t
+  operator()(pulgacpp::NonZero<S> value) const noexcept {
+    return std::hash<S>{}(value.get());
+  }
+};
+
+#endif // PULGACPP_NONZERO_HPP
@@ -0,0 +1,120 @@
+// Benchmark: niche-optimized Optional<PointD> vs a flagged std::optional
+// Compile: g++ -std=c++23 -O2 -I../.. bench_optional.cpp -o bench_optional
+//
+// Optional<PointD> is 16 bytes (two doubles), so the x86-64 SysV ABI returns
+// it in xmm0/xmm1. std::optional<PointD> is 24 bytes and goes through a
+// hidden pointer to caller memory. The first pair of loops calls a
+// non-inlined function returning the optional; the second scans a large
+// array of optionals, where the smaller element is a third less memory
+// traffic.
+
+#include "../geometry/point.hpp"
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <vector>
+
+using namespace pulgacpp;
+
+namespace {
+
+constexpr int ITERATIONS = 50'000'000;
+constexpr int ARRAY_SIZE = 4'000'000;
+constexpr int SCANS = 20;
+
+/// Keeps `value` alive without letting the compiler see through it.
+template <typename T> void keep(T &value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+template <typename F> void run(const char *name, F body) {
+    body(ITERATIONS / 10); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    body(ITERATIONS);
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-36s %8.3f ns/call\n", name, ns / ITERATIONS);
+}
+
+double x_of(const Optional<PointD> &v) { return v.unwrap().x(); }
+double x_of(const std::optional<PointD> &v) { return v->x(); }
+
+/// Sums the x of every Some in `values`; reports nanoseconds per element.
+template <typename Opt> void scan(const char *name, const std::vector<Opt> &values) {
+    double sum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < SCANS; ++s) {
+        for (const Opt &v : values) {
+            if (v.has_value()) {
+                sum += x_of(v);
+            }
+        }
+        keep(sum);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-36s %8.3f ns/element\n", name, ns / (double(SCANS) * ARRAY_SIZE));
+}
+
+// Same body, two return types
+[[gnu::noinline]] Optional<PointD> halve_niche(double x, double y) {
+    if (y == 0.0) {
+        return None;
+    }
+    return Some(PointD::from(x * 0.5, y * 0.5));
+}
+
+[[gnu::noinline]] std::optional<PointD> halve_flagged(double x, double y) {
+    if (y == 0.0) {
+        return std::nullopt;
+    }
+    return PointD::from(x * 0.5, y * 0.5);
+}
+
+} // namespace
+
+int main() {
+    std::printf("=== Optional<PointD> return benchmark (%d calls) ===\n\n", ITERATIONS);
+    std::printf("sizeof(Optional<PointD>)      = %zu\n", sizeof(Optional<PointD>));
+    std::printf("sizeof(std::optional<PointD>) = %zu\n\n", sizeof(std::optional<PointD>));
+
+    run("Optional<PointD> (niche)", [](int n) {
+        double sum = 0.0;
+        double x = 1.0;
+        for (int i = 0; i < n; ++i) {
+            keep(x);
+            auto r = halve_niche(x, static_cast<double>(i & 7));
+            if (r.is_some()) {
+                sum += r.unwrap().x();
+            }
+        }
+        keep(sum);
+    });
+
+    run("std::optional<PointD> (flag)", [](int n) {
+        double sum = 0.0;
+        double x = 1.0;
+        for (int i = 0; i < n; ++i) {
+            keep(x);
+            auto r = halve_flagged(x, static_cast<double>(i & 7));
+            if (r.has_value()) {
+                sum += r->x();
+            }
+        }
+        keep(sum);
+    });
+
+    std::printf("\n--- scan of %d optionals ---\n", ARRAY_SIZE);
+    std::vector<Optional<PointD>> niche(ARRAY_SIZE);
+    std::vector<std::optional<PointD>> flagged(ARRAY_SIZE);
+    for (int i = 0; i < ARRAY_SIZE; ++i) {
+        if (i % 3 != 0) {
+            niche[i] = Some(PointD::from(i, i));
+            flagged[i] = PointD::from(i, i);
+        }
+    }
+    scan("Optional<PointD> (niche)", niche);
+    scan("std::optional<PointD> (flag)", flagged);
+
+    return 0;
+}
@@ -9,8 +9,14 @@
 #include <functional>
 #include <concepts>
 #include <utility>
+#include <bit>
+#include <cstdint>
 #include <cstdlib>
 #include <cstdio>
+#include <limits>
+#include <type_traits>
+
+#include "../core/instrument.hpp"
 
 namespace pulgacpp {
 
@@ -20,7 +26,116 @@ namespace pulgacpp {
     std::abort();
 }
 
+// ==================== Niche optimization ====================
+
+/// Opt-in trait declaring a value of T that is never a real value (a
+/// "niche"). When it is specialized, Optional<T> stores None as that value
+/// and is exactly sizeof(T); otherwise it wraps std::optional<T>.
+///
+/// A specialization provides:
+///   static constexpr T none() noexcept;              // the reserved value
+///   static constexpr bool is_none(const T&) noexcept;
+/// and, if the type can hold a value is_none() matches, also:
+///   static constexpr T to_some(T) noexcept;         // an equivalent value
+///                                                    // is_none() rejects
+///
+/// Some(x) passes x through to_some() when it is provided. Without it, Some
+/// of a value is_none() matches would read back as None; debug builds panic
+/// instead, so only reserve a value the type cannot otherwise hold.
+template <typename T>
+struct niche_traits {};
+
+/// True if niche_traits<T> is specialized.
+template <typename T>
+concept HasNiche = requires(const T& value) {
+    { niche_traits<T>::none() } -> std::same_as<T>;
+    { niche_traits<T>::is_none(value) } -> std::same_as<bool>;
+};
+
+namespace detail {
+
+/// NaN with a payload the library never produces, for floating-point
+/// niches. Arithmetic does not create it, but it does pass it on: on x86 an
+/// operation with a NaN operand returns that NaN, payload included, and the
+/// pattern can also be read back from memory. Niches built on it therefore
+/// provide to_some() with some_nan() below.
+template <std::floating_point F>
+[[nodiscard]] constexpr F niche_nan() noexcept {
+    if constexpr (sizeof(F) == 4) {
+        return std::bit_cast<F>(std::uint32_t{0x7FC0'5A5Au});
+    } else {
+        static_assert(sizeof(F) == 8, "niche_nan supports float and double");
+        return std::bit_cast<F>(std::uint64_t{0x7FF8'0000'5A5A'5A5Aull});
+    }
+}
+
+/// True only for the exact bit pattern returned by niche_nan().
+template <std::floating_point F>
+[[nodiscard]] constexpr bool is_niche_nan(F value) noexcept {
+    if constexpr (sizeof(F) == 4) {
+        return std::bit_cast<std::uint32_t>(value) == std::uint32_t{0x7FC0'5A5Au};
+    } else {
+        return std::bit_cast<std::uint64_t>(value) == std::uint64_t{0x7FF8'0000'5A5A'5A5Aull};
+    }
+}
+
+/// value, or the default quiet NaN if value is niche_nan(). Both are NaN,
+/// so no arithmetic result changes, only the payload.
+template <std::floating_point F>
+[[nodiscard]] constexpr F some_nan(F value) noexcept {
+    return is_niche_nan(value) ? std::numeric_limits<F>::quiet_NaN() : value;
+}
+
+/// Optional storage for types with a niche: just the T, with None encoded
+/// as niche_traits<T>::none(). Mirrors the parts of std::optional that
+/// Optional uses.
+template <typename T>
+class NicheStorage {
+public:
+    constexpr NicheStorage(std::nullopt_t) noexcept : m_value(niche_traits<T>::none()) {}
+    constexpr NicheStorage(T value) noexcept : m_value(to_some(std::move(value))) {
+#ifndef NDEBUG
+        if (niche_traits<T>::is_none(m_value)) {
+            panic("Some() of the value niche_traits reserves for None");
+        }
+#endif
+    }
+
+    [[nodiscard]] constexpr bool has_value() const noexcept {
+        return !niche_traits<T>::is_none(m_value);
+    }
+
+    [[nodiscard]] constexpr const T& operator*() const& noexcept { return m_value; }
+    [[nodiscard]] constexpr T& operator*() & noexcept { return m_value; }
+    [[nodiscard]] constexpr T&& operator*() && noexcept { return std::move(m_value); }
+
+    [[nodiscard]] constexpr bool operator==(const NicheStorage& other) const noexcept {
+        if (has_value() != other.has_value()) {
+            return false;
+        }
+        return !has_value() || m_value == other.m_value;
+    }
+
+private:
+    [[nodiscard]] static constexpr T to_some(T value) noexcept {
+        if constexpr (requires { niche_traits<T>::to_some(std::move(value)); }) {
+            return niche_traits<T>::to_some(std::move(value));
+        } else {
+            return value;
+        }
+    }
+
+    T m_value;
+};
+
+template <typename T>
+using optional_storage_t =
+    std::conditional_t<HasNiche<T>, NicheStorage<T>, std::optional<T>>;
+
+} // namespace detail
+
 /// A Rust-inspired Optional type wrapping std::optional with .expect() and .unwrap().
+/// Types that specialize niche_traits are stored without a separate flag.
 template <typename T>
 class Optional {
 public:
@@ -40,27 +155,29 @@ public:
     [[nodiscard]] constexpr bool is_none() const noexcept { return !has_value(); }
 
     /// Returns the contained value, or panics with the provided message.
-    [[nodiscard]] constexpr T expect(std::string_view message) const& {
+    [[nodiscard]] constexpr T expect(std::string_view message PULGACPP_SITE_PARAM) const& {
         if (!has_value()) {
+            PULGACPP_RECORD(Panic);
             panic(message);
         }
         return *m_value;
     }
 
-    [[nodiscard]] constexpr T expect(std::string_view message) && {
+    [[nodiscard]] constexpr T expect(std::string_view message PULGACPP_SITE_PARAM) && {
         if (!has_value()) {
+            PULGACPP_RECORD(Panic);
             panic(message);
         }
         return std::move(*m_value);
     }
 
     /// Returns the contained value, or panics with a generic message.
-    [[nodiscard]] constexpr T unwrap() const& {
-        return expect("called unwrap() on a None value");
+    [[nodiscard]] constexpr T unwrap(PULGACPP_SITE_PARAM_ONLY) const& {
+        return expect("called unwrap() on a None value" PULGACPP_SITE_ARG);
     }
 
-    [[nodiscard]] constexpr T unwrap() && {
-        return std::move(*this).expect("called unwrap() on a None value");
+    [[nodiscard]] constexpr T unwrap(PULGACPP_SITE_PARAM_ONLY) && {
+        return std::move(*this).expect("called unwrap() on a None value" PULGACPP_SITE_ARG);
     }
 
     /// Returns the contained value, or the provided default.
@@ -126,7 +243,7 @@ public:
     }
 
 private:
-    std::optional<T> m_value;
+    detail::optional_storage_t<T> m_value;
 };
 
 // Deduction guide
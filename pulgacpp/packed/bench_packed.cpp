@@ -0,0 +1,88 @@
+// Benchmark: PackedArray SWAR operations vs the same data as std::vector<u8>
+// Compile: g++ -std=c++23 -O2 -I../.. bench_packed.cpp -o bench_packed
+
+#include "packed.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 24;
+constexpr int ROUNDS = 20;
+
+/// Keeps `value` alive without letting the compiler see through it.
+template <typename T> void keep(T &value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+template <typename F> void run(const char *name, F body) {
+    body(); // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        body();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-36s %8.3f ns/element\n", name, ns / (double(ROUNDS) * COUNT));
+}
+
+template <unsigned Bits> void bench() {
+    using A = PackedArray<Bits, false>;
+    using E = typename A::element_type;
+    std::vector<u8> plain(COUNT), other(COUNT), out(COUNT);
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        plain[i] = u8(static_cast<std::uint8_t>(x & ((1u << Bits) - 1)));
+        other[i] = u8(static_cast<std::uint8_t>((x >> 8) & ((1u << Bits) - 1)));
+    }
+    A packed = A::from(plain).unwrap(), packed_other = A::from(other).unwrap();
+    E needle = E::template constant<1>();
+
+    std::printf("\n--- %u-bit values: %zu KB packed, %zu KB as u8 ---\n", Bits,
+                static_cast<std::size_t>(packed.storage_bytes().get() / 1024), COUNT / 1024);
+    char label[64];
+
+    std::snprintf(label, sizeof label, "vector<u8> count");
+    run(label, [&] {
+        auto n = std::count(plain.begin(), plain.end(), 1_u8);
+        keep(n);
+    });
+    std::snprintf(label, sizeof label, "PackedArray<%u> count", Bits);
+    run(label, [&] {
+        auto n = packed.count(needle);
+        keep(n);
+    });
+
+    std::snprintf(label, sizeof label, "vector<u8> saturating_add");
+    run(label, [&] {
+        constexpr std::uint8_t max = (1u << Bits) - 1;
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            unsigned sum = plain[i].get() + other[i].get();
+            out[i] = u8(static_cast<std::uint8_t>(sum > max ? max : sum));
+        }
+        keep(out[0]);
+    });
+    std::snprintf(label, sizeof label, "PackedArray<%u> saturating_add", Bits);
+    run(label, [&] {
+        auto sum = packed.saturating_add(packed_other);
+        keep(sum);
+    });
+}
+
+} // namespace
+
+int main() {
+    std::printf("=== Packed sub-byte arrays (%zu elements) ===\n", COUNT);
+    bench<1>();
+    bench<2>();
+    bench<4>();
+    return 0;
+}
@@ -0,0 +1,224 @@
+// Test program for pulgacpp::PackedArray and RankSelect
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_packed
+
+#include "packed.hpp"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+usize idx(std::size_t i) {
+    return usize(static_cast<usize::underlying_type>(i));
+}
+
+/// Random in-range values for A, as plain ints.
+template <typename A> std::vector<int> random_values(std::size_t count, unsigned seed) {
+    using E = typename A::element_type;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(E::MIN, E::MAX);
+    std::vector<int> values(count);
+    for (int &v : values) {
+        v = dist(rng);
+    }
+    return values;
+}
+
+template <typename A> A pack(const std::vector<int> &values) {
+    using T = typename A::element_type::underlying_type;
+    std::vector<typename A::element_type::value_type> raw;
+    for (int v : values) {
+        raw.emplace_back(static_cast<T>(v));
+    }
+    return A::from(raw).unwrap();
+}
+
+template <typename A> typename A::element_type element(int v) {
+    return A::element_type::from(v).unwrap();
+}
+
+/// Reads, writes, counts and addition against a std::vector<int> model.
+template <typename A> bool matches_model(unsigned seed) {
+    using E = typename A::element_type;
+    for (std::size_t size : {0u, 1u, A::LANES - 1, A::LANES, A::LANES + 1, 1000u}) {
+        auto a_values = random_values<A>(size, seed), b_values = random_values<A>(size, seed + 1);
+        A a = pack<A>(a_values), b = pack<A>(b_values);
+        if (a.size() != idx(size)) {
+            return false;
+        }
+        std::size_t i = 0;
+        for (E e : a) {
+            if (e.get().get() != a_values[i++]) {
+                return false;
+            }
+        }
+        if (i != size) {
+            return false;
+        }
+
+        bool overflow = false;
+        std::vector<int> saturated(size), wrapped(size);
+        for (std::size_t j = 0; j < size; ++j) {
+            int sum = a_values[j] + b_values[j];
+            overflow |= sum < E::MIN || sum > E::MAX;
+            saturated[j] = std::clamp(sum, int(E::MIN), int(E::MAX));
+            int range = E::MAX - E::MIN + 1;
+            wrapped[j] = ((sum - E::MIN) % range + range) % range + E::MIN;
+        }
+        auto checked = a.checked_add(b);
+        if (checked.is_some() == overflow || a.saturating_add(b) != pack<A>(saturated) ||
+            a.wrapping_add(b) != pack<A>(wrapped)) {
+            return false;
+        }
+        if (!overflow && checked.unwrap() != pack<A>(wrapped)) {
+            return false;
+        }
+
+        for (int v = E::MIN; v <= E::MAX; ++v) {
+            auto expected = static_cast<std::size_t>(std::count(a_values.begin(), a_values.end(), v));
+            if (a.count(element<A>(v)) != idx(expected)) {
+                return false;
+            }
+        }
+        std::size_t ones = 0;
+        for (int v : a_values) {
+            ones += static_cast<unsigned>(std::popcount(static_cast<unsigned>(v) & ((1u << A::BITS) - 1)));
+        }
+        if (a.count_ones() != idx(ones)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// rank and select against a linear scan, for every value.
+template <typename A> bool rank_select_matches(unsigned seed) {
+    using E = typename A::element_type;
+    for (std::size_t size : {0u, 1u, A::LANES * 8 - 1, A::LANES * 8, 5000u}) {
+        auto values = random_values<A>(size, seed);
+        A a = pack<A>(values);
+        for (int v = E::MIN; v <= E::MAX; ++v) {
+            auto index = RankSelect<A::BITS, A::IS_SIGNED>::from(a, element<A>(v));
+            std::size_t seen = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                if (index.rank(idx(i)).unwrap() != idx(seen)) {
+                    return false;
+                }
+                if (values[i] == v) {
+                    if (index.select(idx(seen)).unwrap() != idx(i)) {
+                        return false;
+                    }
+                    ++seen;
+                }
+            }
+            if (index.count() != idx(seen) || index.rank(idx(size)).unwrap() != idx(seen) ||
+                index.rank(idx(size + 1)).is_some() || index.select(idx(seen)).is_some()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== pulgacpp::PackedArray Test Suite ===\n\n";
+
+    // --- Storage ---
+    std::cout << "--- Storage ---\n";
+    {
+        auto a = PackedU2::zeros(1000_usize);
+        test(a.size() == 1000_usize && a.storage_bytes() == 256_usize, "1000 2-bit values take 32 words");
+        test(PackedArray<3, false>::LANES == 21 && PackedArray<7, true>::LANES == 9, "lanes per word");
+        test(PackedU4::element_type::MAX == 15 && PackedI4::element_type::MIN == -8 &&
+                 PackedI4::element_type::MAX == 7,
+             "element ranges");
+
+        a[7_usize] = PackedU2::element_type::constant<3>();
+        a[8_usize] = PackedU2::element_type::constant<2>();
+        test(a[7_usize].get().get() == 3_u8 && a.get(8_usize).unwrap().get() == 2_u8, "write and read back");
+        test(a.get(6_usize).unwrap().get() == 0_u8, "neighbours untouched");
+        test(a.get(1000_usize).is_none(), "get() past the end is None");
+        a[9_usize] = a[7_usize];
+        test(a[9_usize].get().get() == 3_u8, "proxy to proxy assignment");
+
+        PackedI4 s;
+        s.push(PackedI4::element_type::constant<-8>());
+        s.push(PackedI4::element_type::constant<7>());
+        s.push(PackedI4::element_type::constant<-1>());
+        test(s.size() == 3_usize && s[0_usize].get().get().get() == -8 && s[2_usize].get().get().get() == -1,
+             "signed values are sign-extended");
+        test(s.words()[0] == 0xF78, "two's complement lanes");
+
+        std::vector<u8> too_big = {1_u8, 16_u8};
+        test(PackedU4::from(too_big).is_none(), "from() rejects values that do not fit");
+        auto f = PackedArray<5, false>::filled(13_usize, PackedArray<5, false>::element_type::constant<31>());
+        test(f.count_ones() == 65_usize && f.words()[1] == 0x1F, "filled() leaves the tail zero");
+        f.clear();
+        test(f.is_empty() && f.storage_bytes() == 0_usize, "clear()");
+    }
+
+    // --- SWAR Addition ---
+    std::cout << "\n--- SWAR Addition ---\n";
+    {
+        std::vector<u8> x = {3_u8, 1_u8, 2_u8}, y = {1_u8, 1_u8, 1_u8};
+        auto a = PackedU2::from(x).unwrap(), b = PackedU2::from(y).unwrap();
+        test(a.checked_add(b).is_none(), "checked_add detects a lane overflow");
+        auto sat = a.saturating_add(b);
+        test(sat[0_usize].get().get() == 3_u8 && sat[1_usize].get().get() == 2_u8 &&
+                 sat[2_usize].get().get() == 3_u8,
+             "saturating_add clamps only the overflowing lane");
+        test(a.wrapping_add(b)[0_usize].get().get() == 0_u8, "wrapping_add");
+
+        test(matches_model<PackedU1>(1), "PackedU1 matches a vector model");
+        test(matches_model<PackedU2>(2), "PackedU2 matches a vector model");
+        test(matches_model<PackedU4>(3), "PackedU4 matches a vector model");
+        test(matches_model<PackedI4>(4), "PackedI4 matches a vector model");
+        test(matches_model<PackedArray<3, true>>(5), "PackedArray<3, true> matches a vector model");
+        test(matches_model<PackedArray<5, false>>(6), "PackedArray<5, false> matches a vector model");
+        test(matches_model<PackedArray<7, true>>(7), "PackedArray<7, true> matches a vector model");
+    }
+
+    // --- Rank and Select ---
+    std::cout << "\n--- Rank and Select ---\n";
+    {
+        auto bits = PackedU1::zeros(200_usize);
+        for (std::size_t i = 0; i < 200; i += 3) {
+            bits[idx(i)] = PackedU1::element_type::constant<1>();
+        }
+        auto ones = RankSelect<1, false>::from(bits, PackedU1::element_type::constant<1>());
+        test(ones.count() == 67_usize && bits.count_ones() == 67_usize, "count of ones");
+        test(ones.rank(100_usize).unwrap() == 34_usize, "rank(100)");
+        test(ones.select(50_usize).unwrap() == 150_usize, "select(50)");
+        test(ones.select(67_usize).is_none(), "select past the last one is None");
+
+        test(rank_select_matches<PackedU1>(8), "PackedU1 rank/select match a scan");
+        test(rank_select_matches<PackedU2>(9), "PackedU2 rank/select match a scan");
+        test(rank_select_matches<PackedI4>(10), "PackedI4 rank/select match a scan");
+        test(rank_select_matches<PackedArray<6, false>>(11), "PackedArray<6, false> rank/select match a scan");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,545 @@
+// pulgacpp::PackedArray - Dense arrays of 1 to 7-bit integers
+// SPDX-License-Identifier: MIT
+//
+// PackedArray<Bits, Signed> stores values of `Bits` bits in 64-bit words,
+// floor(64 / Bits) per word, so a 2-bit enumeration takes a quarter of the
+// memory of a u8 array. Elements are Bounded<u8, 0, 2^Bits - 1> (or
+// Bounded<i8, ...> for signed arrays), so a value that does not fit cannot
+// be stored in the first place.
+//
+// Whole-array operations work on all lanes of a word at once (SWAR):
+// checked/saturating/wrapping addition, counting a value and popcounts.
+// RankSelect adds an index for fast rank and select of one value.
+//
+// Usage:
+//   #include <pulgacpp/packed/packed.hpp>
+//
+//   auto states = PackedU2::zeros(1'000'000_usize);    // 250 KB
+//   states[42_usize] = PackedU2::element_type::constant<3>();
+//   usize active = states.count(PackedU2::element_type::constant<3>());
+//   auto index = RankSelect<2, false>::from(states, PackedU2::element_type::constant<3>());
+//   Optional<usize> where = index.select(0_usize);   // first active element
+
+#ifndef PULGACPP_PACKED_HPP
+#define PULGACPP_PACKED_HPP
+
+#include "../bounded/bounded.hpp"
+#include "../i8/i8.hpp"
+#include "../u64/u64.hpp"
+#include "../u8/u8.hpp"
+#include "../usize/usize.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pulgacpp {
+
+template <unsigned Bits, bool Signed>
+  requires(Bits >= 1 && Bits <= 7 && (!Signed || Bits >= 2))
+class RankSelect;
+
+namespace detail {
+
+[[nodiscard]] constexpr usize to_usize(std::size_t n) noexcept {
+  return usize(static_cast<usize::underlying_type>(n));
+}
+
+/// Bounded element type of a packed array.
+template <unsigned Bits, bool Signed>
+using packed_element_t = std::conditional_t<
+    Signed, Bounded<i8, std::int8_t(-(1 << (Bits - 1))), std::int8_t((1 << (Bits - 1)) - 1)>,
+    Bounded<u8, std::uint8_t(0), std::uint8_t((1u << Bits) - 1)>>;
+
+/// Word layout for Bits-wide lanes: LANES lanes, bit 0 is lane 0's lowest.
+template <unsigned Bits> struct PackedLayout {
+  static constexpr unsigned LANES = 64 / Bits;
+  static constexpr std::uint64_t LANE_MASK = (std::uint64_t(1) << Bits) - 1;
+
+  /// The lowest bit of every lane; `v * ONES` repeats v in every lane.
+  static constexpr std::uint64_t ONES = [] {
+    std::uint64_t ones = 0;
+    for (unsigned lane = 0; lane < LANES; ++lane) {
+      ones |= std::uint64_t(1) << (lane * Bits);
+    }
+    return ones;
+  }();
+
+  /// The highest (sign) bit of every lane.
+  static constexpr std::uint64_t HIGH = ONES << (Bits - 1);
+
+  /// Every lane bit; the top 64 % Bits bits of a word are unused.
+  static constexpr std::uint64_t USED = ONES * LANE_MASK;
+
+  /// Bits of the first `lanes` lanes (lanes < LANES).
+  [[nodiscard]] static constexpr std::uint64_t prefix(unsigned lanes) noexcept {
+    return (std::uint64_t(1) << (lanes * Bits)) - 1;
+  }
+
+  /// HIGH bit set in every lane that is zero.
+  [[nodiscard]] static constexpr std::uint64_t zero_lanes(std::uint64_t x) noexcept {
+    // Adding all-ones to the low bits of a lane carries into its high bit
+    // exactly when the low bits are non-zero; lanes never carry into each
+    // other because the high bit is masked off first
+    std::uint64_t nonzero = ((x & (USED ^ HIGH)) + (USED ^ HIGH)) | x;
+    return ~nonzero & HIGH;
+  }
+
+  /// All bits set in every lane whose HIGH bit is set in `high`.
+  [[nodiscard]] static constexpr std::uint64_t spread(std::uint64_t high) noexcept {
+    return (high >> (Bits - 1)) * LANE_MASK;
+  }
+};
+
+} // namespace detail
+
+/// A growable array of `Bits`-bit integers, densely packed.
+///
+/// Indexing takes a usize and is bounds-checked: operator[] panics on an
+/// index past the end, get() returns None. Whole-array arithmetic panics
+/// if the two arrays have different sizes, like the batch functions.
+template <unsigned Bits, bool Signed>
+  requires(Bits >= 1 && Bits <= 7 && (!Signed || Bits >= 2))
+class PackedArray {
+  using Layout = detail::PackedLayout<Bits>;
+
+public:
+  using element_type = detail::packed_element_t<Bits, Signed>;
+  using value_type = element_type;
+
+  static constexpr unsigned BITS = Bits;
+  static constexpr bool IS_SIGNED = Signed;
+
+  /// Elements stored per 64-bit word.
+  static constexpr unsigned LANES = Layout::LANES;
+
+  /// Proxy returned by operator[]: reads and assigns one element.
+  class reference {
+  public:
+    [[nodiscard]] constexpr element_type get() const noexcept {
+      return m_array->load(m_index);
+    }
+
+    [[nodiscard]] constexpr operator element_type() const noexcept { return get(); }
+
+    constexpr reference &operator=(element_type value) noexcept {
+      m_array->store(m_index, value);
+      return *this;
+    }
+
+    constexpr reference &operator=(const reference &other) noexcept {
+      return *this = other.get();
+    }
+
+  private:
+    friend class PackedArray;
+
+    constexpr reference(PackedArray *array, std::size_t index) noexcept
+        : m_array(array), m_index(index) {}
+
+    PackedArray *m_array;
+    std::size_t m_index;
+  };
+
+  /// Read-only iterator over the elements, by value.
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = element_type;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr const_iterator() noexcept = default;
+
+    [[nodiscard]] constexpr element_type operator*() const noexcept {
+      return m_array->load(m_index);
+    }
+
+    constexpr const_iterator &operator++() noexcept {
+      ++m_index;
+      return *this;
+    }
+
+    constexpr const_iterator operator++(int) noexcept {
+      const_iterator old = *this;
+      ++m_index;
+      return old;
+    }
+
+    [[nodiscard]] constexpr bool
+    operator==(const const_iterator &other) const noexcept = default;
+
+  private:
+    friend class PackedArray;
+
+    constexpr const_iterator(const PackedArray *array, std::size_t index) noexcept
+        : m_array(array), m_index(index) {}
+
+    const PackedArray *m_array = nullptr;
+    std::size_t m_index = 0;
+  };
+
+  // ==================== Construction ====================
+
+  /// Empty array.
+  PackedArray() noexcept = default;
+
+  /// `count` copies of `value`.
+  [[nodiscard]] static PackedArray filled(usize count, element_type value) {
+    PackedArray array;
+    array.m_size = count.get();
+    array.m_words.assign(word_count(array.m_size), Layout::ONES * lane_bits(value));
+    array.clear_tail();
+    return array;
+  }
+
+  /// `count` zeros.
+  [[nodiscard]] static PackedArray zeros(usize count) {
+    PackedArray array;
+    array.m_size = count.get();
+    array.m_words.assign(word_count(array.m_size), 0);
+    return array;
+  }
+
+  /// Packs `values`, or None if any of them does not fit in `Bits` bits.
+  [[nodiscard]] static Optional<PackedArray>
+  from(std::span<const typename element_type::value_type> values) {
+    PackedArray array = zeros(detail::to_usize(values.size()));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      auto element = element_type::from(values[i]);
+      if (element.is_none()) {
+        return None;
+      }
+      array.store(i, element.unwrap());
+    }
+    return Some(std::move(array));
+  }
+
+  // ==================== Size ====================
+
+  [[nodiscard]] usize size() const noexcept { return detail::to_usize(m_size); }
+  [[nodiscard]] bool is_empty() const noexcept { return m_size == 0; }
+
+  /// Bytes of element storage (whole 64-bit words).
+  [[nodiscard]] usize storage_bytes() const noexcept {
+    return detail::to_usize(m_words.size() * sizeof(std::uint64_t));
+  }
+
+  /// Appends one element.
+  void push(element_type value) {
+    if (m_size % LANES == 0) {
+      m_words.push_back(0);
+    }
+    store(m_size++, value);
+  }
+
+  /// Removes every element.
+  void clear() noexcept {
+    m_words.clear();
+    m_size = 0;
+  }
+
+  // ==================== Element Access ====================
+
+  /// The element at `index`, or None past the end.
+  [[nodiscard]] Optional<element_type> get(usize index) const noexcept {
+    if (index.get() >= m_size) {
+      return None;
+    }
+    return Some(load(index.get()));
+  }
+
+  /// Panics if `index` is past the end.
+  [[nodiscard]] element_type operator[](usize index) const noexcept {
+    return load(checked_index(index));
+  }
+
+  /// Panics if `index` is past the end.
+  [[nodiscard]] reference operator[](usize index) noexcept {
+    return reference(this, checked_index(index));
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  [[nodiscard]] const_iterator end() const noexcept { return const_iterator(this, m_size); }
+
+  /// The packed words: element i is bits [(i % LANES) * Bits, +Bits) of
+  /// word i / LANES. Unused bits are zero.
+  [[nodiscard]] std::span<const std::uint64_t> words() const noexcept { return m_words; }
+
+  // ==================== Counting ====================
+
+  /// Number of elements equal to `value`.
+  [[nodiscard]] usize count(element_type value) const noexcept {
+    std::uint64_t pattern = Layout::ONES * lane_bits(value);
+    std::size_t total = 0;
+    for (std::size_t w = 0; w < m_words.size(); ++w) {
+      total += u64(matches(w, pattern)).count_ones();
+    }
+    return detail::to_usize(total);
+  }
+
+  /// Total number of one bits over all elements (two's complement for
+  /// signed arrays). For a 1-bit array, the number of ones.
+  [[nodiscard]] usize count_ones() const noexcept {
+    std::size_t total = 0;
+    for (std::uint64_t word : m_words) {
+      total += u64(word).count_ones();
+    }
+    return detail::to_usize(total);
+  }
+
+  // ==================== Whole-Array Addition ====================
+  // Element-wise `a[i] + b[i]`, all lanes of a word in one go.
+
+  /// None if any element overflows.
+  [[nodiscard]] Optional<PackedArray> checked_add(const PackedArray &rhs) const {
+    check_same_size(rhs);
+    PackedArray out = with_words_of(*this);
+    std::uint64_t overflow = 0;
+    for (std::size_t w = 0; w < m_words.size(); ++w) {
+      auto [sum, lanes] = add_word(m_words[w], rhs.m_words[w]);
+      out.m_words[w] = sum;
+      overflow |= lanes;
+    }
+    if (overflow != 0) {
+      return None;
+    }
+    return Some(std::move(out));
+  }
+
+  /// Overflowing elements clamp to the element type's MIN or MAX.
+  [[nodiscard]] PackedArray saturating_add(const PackedArray &rhs) const {
+    check_same_size(rhs);
+    PackedArray out = with_words_of(*this);
+    for (std::size_t w = 0; w < m_words.size(); ++w) {
+      std::uint64_t a = m_words[w];
+      auto [sum, overflow] = add_word(a, rhs.m_words[w]);
+      std::uint64_t clamp = Layout::spread(overflow);
+      if constexpr (Signed) {
+        // Both operands had the same sign: positive lanes go to 011..1,
+        // negative lanes to 100..0
+        std::uint64_t negative = overflow & a;
+        std::uint64_t positive = Layout::spread(overflow & ~a) & ~Layout::HIGH;
+        out.m_words[w] = (sum & ~clamp) | positive | negative;
+      } else {
+        out.m_words[w] = sum | clamp;
+      }
+    }
+    return out;
+  }
+
+  /// Overflowing elements wrap around modulo 2^Bits.
+  [[nodiscard]] PackedArray wrapping_add(const PackedArray &rhs) const {
+    check_same_size(rhs);
+    PackedArray out = with_words_of(*this);
+    for (std::size_t w = 0; w < m_words.size(); ++w) {
+      out.m_words[w] = add_word(m_words[w], rhs.m_words[w]).first;
+    }
+    return out;
+  }
+
+  // ==================== Comparison ====================
+
+  [[nodiscard]] bool operator==(const PackedArray &other) const noexcept {
+    return m_size == other.m_size && m_words == other.m_words;
+  }
+
+private:
+  friend class RankSelect<Bits, Signed>;
+
+  [[nodiscard]] static constexpr std::size_t word_count(std::size_t size) noexcept {
+    return (size + LANES - 1) / LANES;
+  }
+
+  [[nodiscard]] static constexpr std::uint64_t lane_bits(element_type value) noexcept {
+    return static_cast<std::uint64_t>(value.get().get()) & Layout::LANE_MASK;
+  }
+
+  [[nodiscard]] static PackedArray with_words_of(const PackedArray &shape) {
+    PackedArray array;
+    array.m_size = shape.m_size;
+    array.m_words.resize(shape.m_words.size());
+    return array;
+  }
+
+  [[nodiscard]] std::size_t checked_index(usize index) const noexcept {
+    if (index.get() >= m_size) {
+      panic("PackedArray: index out of bounds");
+    }
+    return index.get();
+  }
+
+  void check_same_size(const PackedArray &rhs) const noexcept {
+    if (m_size != rhs.m_size) {
+      panic("PackedArray: sizes differ");
+    }
+  }
+
+  [[nodiscard]] constexpr element_type load(std::size_t index) const noexcept {
+    unsigned shift = static_cast<unsigned>(index % LANES) * Bits;
+    auto bits = static_cast<unsigned>((m_words[index / LANES] >> shift) & Layout::LANE_MASK);
+    using S = typename element_type::value_type;
+    using T = typename S::underlying_type;
+    T value;
+    if constexpr (Signed) {
+      // Sign-extend from Bits to 8 bits
+      value = static_cast<T>(static_cast<T>(bits << (8 - Bits)) >> (8 - Bits));
+    } else {
+      value = static_cast<T>(bits);
+    }
+    PULGACPP_ASSUME(value >= element_type::MIN && value <= element_type::MAX);
+    return element_type::from(S(value)).unwrap();
+  }
+
+  constexpr void store(std::size_t index, element_type value) noexcept {
+    unsigned shift = static_cast<unsigned>(index % LANES) * Bits;
+    std::uint64_t &word = m_words[index / LANES];
+    word = (word & ~(Layout::LANE_MASK << shift)) | (lane_bits(value) << shift);
+  }
+
+  /// Zeroes the lanes of the last word past the end.
+  void clear_tail() noexcept {
+    unsigned used = static_cast<unsigned>(m_size % LANES);
+    if (used != 0) {
+      m_words.back() &= Layout::prefix(used);
+    }
+  }
+
+  /// HIGH bit set in every lane of word `w` that holds `pattern`'s lane
+  /// value, ignoring lanes past the end.
+  [[nodiscard]] std::uint64_t matches(std::size_t w, std::uint64_t pattern) const noexcept {
+    std::uint64_t found = Layout::zero_lanes(m_words[w] ^ pattern);
+    if (w + 1 == m_words.size() && m_size % LANES != 0) {
+      found &= Layout::prefix(static_cast<unsigned>(m_size % LANES));
+    }
+    return found;
+  }
+
+  /// Lane-wise sum of two words and the HIGH bit of every lane that
+  /// overflowed.
+  [[nodiscard]] static constexpr std::pair<std::uint64_t, std::uint64_t>
+  add_word(std::uint64_t a, std::uint64_t b) noexcept {
+    // Add the low bits (they cannot carry out of their lane), then add the
+    // high bits without carry
+    constexpr std::uint64_t low = Layout::USED ^ Layout::HIGH;
+    std::uint64_t sum = ((a & low) + (b & low)) ^ ((a ^ b) & Layout::HIGH);
+    std::uint64_t overflow;
+    if constexpr (Signed) {
+      // Same-sign operands with a different-sign result
+      overflow = ~(a ^ b) & (a ^ sum) & Layout::HIGH;
+    } else {
+      // Carry out of the high bit: both set, or one set and the sum's clear
+      overflow = ((a & b) | ((a ^ b) & ~sum)) & Layout::HIGH;
+    }
+    return {sum, overflow};
+  }
+
+  std::vector<std::uint64_t> m_words;
+  std::size_t m_size = 0;
+};
+
+// ==================== Rank and Select ====================
+
+/// Rank and select for one value of a PackedArray: how many elements before
+/// an index equal it, and where its k-th occurrence is.
+///
+/// Keeps a running count per 8 words (8 bytes per 64 bytes of array) and
+/// refers to the array, which must outlive it and must not change while
+/// it is in use.
+template <unsigned Bits, bool Signed>
+  requires(Bits >= 1 && Bits <= 7 && (!Signed || Bits >= 2))
+class RankSelect {
+  using Array = PackedArray<Bits, Signed>;
+  using Layout = detail::PackedLayout<Bits>;
+  static constexpr std::size_t WORDS_PER_BLOCK = 8;
+
+public:
+  using element_type = typename Array::element_type;
+
+  /// Indexes the occurrences of `value` in `array`.
+  [[nodiscard]] static RankSelect from(const Array &array, element_type value) {
+    RankSelect index(array, Layout::ONES * Array::lane_bits(value));
+    std::size_t words = array.m_words.size();
+    index.m_blocks.reserve(words / WORDS_PER_BLOCK + 2);
+    std::size_t total = 0;
+    for (std::size_t w = 0; w < words; ++w) {
+      if (w % WORDS_PER_BLOCK == 0) {
+        index.m_blocks.push_back(total);
+      }
+      total += u64(array.matches(w, index.m_pattern)).count_ones();
+    }
+    index.m_blocks.push_back(total);
+    return index;
+  }
+
+  /// Number of occurrences in the whole array.
+  [[nodiscard]] usize count() const noexcept { return detail::to_usize(m_blocks.back()); }
+
+  /// Occurrences in [0, index), or None if index > size().
+  [[nodiscard]] Optional<usize> rank(usize index) const noexcept {
+    std::size_t i = index.get();
+    if (i > m_array->m_size) {
+      return None;
+    }
+    if (i == m_array->m_size) {
+      return Some(count());
+    }
+    std::size_t word = i / Array::LANES;
+    std::size_t first = word - word % WORDS_PER_BLOCK;
+    std::size_t total = m_blocks[first / WORDS_PER_BLOCK];
+    for (std::size_t w = first; w < word; ++w) {
+      total += u64(m_array->matches(w, m_pattern)).count_ones();
+    }
+    std::uint64_t before = Layout::prefix(static_cast<unsigned>(i % Array::LANES));
+    total += u64(m_array->matches(word, m_pattern) & before).count_ones();
+    return Some(detail::to_usize(total));
+  }
+
+  /// Index of the occurrence with rank k (k = 0 is the first), or None if
+  /// there are not that many.
+  [[nodiscard]] Optional<usize> select(usize k) const noexcept {
+    std::size_t remaining = k.get();
+    if (remaining >= m_blocks.back()) {
+      return None;
+    }
+    // Last block that starts at or before the k-th occurrence
+    auto block = std::upper_bound(m_blocks.begin(), m_blocks.end(), remaining) - 1;
+    remaining -= *block;
+    std::size_t w = static_cast<std::size_t>(block - m_blocks.begin()) * WORDS_PER_BLOCK;
+    for (;; ++w) {
+      std::uint64_t found = m_array->matches(w, m_pattern);
+      unsigned in_word = u64(found).count_ones();
+      if (remaining < in_word) {
+        for (; remaining != 0; --remaining) {
+          found &= found - 1;
+        }
+        unsigned lane = u64(found).trailing_zeros() / Bits;
+        return Some(detail::to_usize(w * Array::LANES + lane));
+      }
+      remaining -= in_word;
+    }
+  }
+
+private:
+  RankSelect(const Array &array, std::uint64_t pattern) noexcept
+      : m_array(&array), m_pattern(pattern) {}
+
+  const Array *m_array;
+  std::uint64_t m_pattern;
+  std::vector<std::size_t> m_blocks;
+};
+
+// ==================== Aliases ====================
+
+using PackedU1 = PackedArray<1, false>;
+using PackedU2 = PackedArray<2, false>;
+using PackedU4 = PackedArray<4, false>;
+using PackedI4 = PackedArray<4, true>;
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_PACKED_HPP
@@ -0,0 +1,141 @@
+// Test program for pulgacpp::Ranged
+// Compile: cl /std:c++latest /EHsc /W4 /I../.. main.cpp
+//      or: g++ -std=c++23 -O2 -Wall -I../.. main.cpp -o test_ranged
+
+#include "ranged.hpp"
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+// Simple test helper
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+void test(bool condition, std::string_view name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << '\n';
+        ++g_tests_passed;
+    } else {
+        std::cout << "[FAIL] " << name << '\n';
+        ++g_tests_failed;
+    }
+}
+
+template <typename A, typename B>
+concept Divisible = requires(A a, B b) { a / b; };
+
+template <typename S>
+concept HasRange = requires(S s) { ranged(s); };
+
+template <typename A, typename To>
+concept Widenable = requires(A a) { a.template widen<To>(); };
+
+// Ranges and storage are decided at compile time
+using Byte = decltype(ranged(u8()));
+using Wide = decltype(ranged(u8()) * ranged(u8()) + ranged(u16()));
+static_assert(std::is_same_v<Byte, Ranged<0, 255>> && std::is_same_v<Byte::value_type, u8>);
+static_assert(std::is_same_v<Wide, Ranged<0, 130560>> && std::is_same_v<Wide::value_type, u32>);
+static_assert(std::is_same_v<decltype(ranged(i8()) - ranged(u8())), Ranged<-383, 127>>);
+static_assert(std::is_same_v<decltype(ranged(i8()) - ranged(u8()))::value_type, i16>);
+static_assert(std::is_same_v<decltype(-ranged(i8())), Ranged<-127, 128>>);
+static_assert(std::is_same_v<decltype(ranged(i16()) * ranged(i16())), Ranged<-1073709056, 1073741824>>);
+static_assert(std::is_same_v<decltype(ranged(i32()) * ranged(i32()))::value_type, i64>);
+static_assert(sizeof(Ranged<0, 200>) == 1 && sizeof(Ranged<-1, 200>) == 2);
+
+// Only steps whose range cannot be proven fall back to CheckedExpr
+static_assert(std::is_same_v<decltype(ranged(i64()) + ranged(u8())), detail::CheckedExpr<i64>>);
+static_assert(std::is_same_v<decltype(ranged(i64()) * ranged(i32()) + ranged(u8())), detail::CheckedExpr<i64>>);
+static_assert(HasRange<u32> && !HasRange<u64>);
+
+// Division only by ranges without zero
+static_assert(Divisible<Ranged<0, 100>, Ranged<1, 10>> && Divisible<Ranged<-5, 5>, Ranged<-3, -1>>);
+static_assert(!Divisible<Ranged<0, 100>, Ranged<0, 10>>);
+static_assert(std::is_same_v<decltype(Ranged<-100, 100>() / Ranged<-3, -2>()), Ranged<-50, 50>>);
+
+// widen only when the target holds the whole range
+static_assert(Widenable<Ranged<0, 255>, u8> && !Widenable<Ranged<0, 256>, u8>);
+static_assert(Widenable<Ranged<-1, 1>, i8> && !Widenable<Ranged<-1, 1>, u8>);
+
+// Everything is constexpr
+constexpr auto SUM = ranged(200_u8) + ranged<100>();
+static_assert(SUM.get() == 300_u16);
+static_assert((ranged(250_u8) * ranged(250_u8)).widen<u16>() == 62500_u16);
+
+int main() {
+    std::cout << "=== pulgacpp::Ranged Test Suite ===\n\n";
+
+    // --- Construction ---
+    std::cout << "--- Construction ---\n";
+    {
+        using Digit = Ranged<0, 9>;
+        test(Digit::from(7_u8).unwrap().get() == 7_u8, "from SafeInt in range");
+        test(Digit::from(10).is_none() && Digit::from(i32(-1)).is_none(), "from outside the range is None");
+        test(Digit::from(u64(u64::MAX)).is_none(), "from a value beyond std::int64_t is None");
+        test(Digit::constant<3>().get() == 3_u8, "constant");
+        test(Digit().get() == 0_u8, "default is Lo");
+
+        auto weekday = Bounded<u8, 0, 6>::from(5_u8).unwrap();
+        auto day = ranged(weekday);
+        static_assert(std::is_same_v<decltype(day), Ranged<0, 6>>);
+        test(day.get() == 5_u8, "ranged(Bounded) keeps the range");
+    }
+
+    // --- Arithmetic ---
+    std::cout << "\n--- Arithmetic ---\n";
+    {
+        auto a = ranged(u8(u8::MAX)), b = ranged(u8(u8::MAX));
+        auto c = ranged(u16(u16::MAX));
+        auto wide = a * b + c;
+        test(wide.get() == 130560_u32, "u8 * u8 + u16 at the top of the range");
+
+        auto diff = ranged(i8(i8::MIN)) - ranged(u8(u8::MAX));
+        test(diff.get() == i16(std::int16_t{-383}), "i8 - u8 at the bottom of the range");
+
+        auto q = Ranged<-100, 100>::constant<-7>() / Ranged<1, 10>::constant<2>();
+        test(q == ranged<-3>(), "division truncates toward zero");
+        test((-ranged(i8(i8::MIN))).get() == 128_i16, "negating i8::MIN widens");
+
+        // RGB to luma in fixed point: the whole expression is unchecked
+        auto luma = ranged(255_u8) * ranged<77>() + ranged(255_u8) * ranged<150>() +
+                    ranged(255_u8) * ranged<29>();
+        test((luma / ranged<256>()).widen<u8>() == 255_u8, "luma stays within u8");
+    }
+
+    // --- Checked fallback ---
+    std::cout << "\n--- Checked fallback ---\n";
+    {
+        auto fine = ranged(1000_i64) * ranged(1000_i32) + ranged(7_u8);
+        test(fine.value().unwrap() == 1000007_i64, "unproven chain checks and succeeds");
+
+        auto big = ranged(i64(i64::MAX)) + ranged(1_u8);
+        test(big.is_overflowed(), "unproven chain reports overflow");
+
+        auto mixed = ranged(5_i64) * ranged(2_u8) - ranged(3_u8);
+        test(mixed.value().unwrap() == 7_i64, "Ranged operands continue a checked chain");
+    }
+
+    // --- Conversion and comparison ---
+    std::cout << "\n--- Conversion and Comparison ---\n";
+    {
+        auto v = ranged(200_u8) + ranged(100_u8);
+        test(v.narrow<u8>().is_none() && v.narrow<i16>().unwrap() == 300_i16, "narrow checks the value");
+        test(v.widen<i32>() == 300_i32, "widen to a larger type");
+        test(v.relax<-1000, 1000>() == v, "relax keeps the value");
+        test(ranged(3_u8) < ranged(i16(std::int16_t{4})), "values of different ranges compare");
+        std::ostringstream out;
+        out << v;
+        test(out.str() == "300", "stream output");
+    }
+
+    // --- Summary ---
+    std::cout << "\n=== Test Summary ===\n";
+    std::cout << "Passed: " << g_tests_passed << '\n';
+    std::cout << "Failed: " << g_tests_failed << '\n';
+
+    return g_tests_failed > 0 ? 1 : 0;
+}
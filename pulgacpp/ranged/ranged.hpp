@@ -0,0 +1,411 @@
+// pulgacpp::Ranged - Integers whose range is tracked at compile time
+// SPDX-License-Identifier: MIT
+//
+// Ranged<Lo, Hi> is an integer known to lie in [Lo, Hi]. Arithmetic on
+// Ranged values computes the range of the result at compile time, so
+// `a * b + c` for u8 a, b and u16 c is a Ranged<0, 130560>: it cannot
+// overflow, needs no check, and is stored in the narrowest SafeInt that
+// holds the range (u32 here).
+//
+// When the interval of a step does not fit in std::int64_t, nothing can be
+// proven and the step falls back to the checked path: the result is a
+// CheckedExpr<i64> (see checked_expr()), and the chain is checked once at
+// its end.
+//
+// Usage:
+//   #include <pulgacpp/ranged/ranged.hpp>
+//
+//   u8 r = ..., g = ..., b = ...;
+//   auto luma = ranged(r) * ranged<77>() + ranged(g) * ranged<150>()
+//             + ranged(b) * ranged<29>();        // Ranged<0, 65280>, no checks
+//   u8 y = (luma / ranged<256>()).widen<u8>();  // [0, 255] fits u8
+
+#ifndef PULGACPP_RANGED_HPP
+#define PULGACPP_RANGED_HPP
+
+#include "../bounded/bounded.hpp"
+#include "../core/checked_expr.hpp"
+#include "../i16/i16.hpp"
+#include "../i32/i32.hpp"
+#include "../i64/i64.hpp"
+#include "../i8/i8.hpp"
+#include "../u16/u16.hpp"
+#include "../u32/u32.hpp"
+#include "../u64/u64.hpp"
+#include "../u8/u8.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace pulgacpp {
+
+template <std::int64_t Lo, std::int64_t Hi>
+  requires(Lo <= Hi)
+class Ranged;
+
+namespace detail {
+
+/// Result range of an operation on two ranges. `ok` is false when an
+/// endpoint does not fit in std::int64_t.
+struct Interval {
+  std::int64_t lo = 0;
+  std::int64_t hi = 0;
+  bool ok = false;
+};
+
+// Endpoint arithmetic for the compiler only; written out rather than with
+// the overflow intrinsics so that it is constexpr everywhere.
+using Endpoint = std::pair<std::int64_t, bool>; // {value, fits}
+
+inline constexpr std::int64_t ENDPOINT_MIN = std::numeric_limits<std::int64_t>::min();
+inline constexpr std::int64_t ENDPOINT_MAX = std::numeric_limits<std::int64_t>::max();
+
+[[nodiscard]] constexpr Endpoint endpoint_add(std::int64_t a, std::int64_t b) noexcept {
+  if ((b > 0 && a > ENDPOINT_MAX - b) || (b < 0 && a < ENDPOINT_MIN - b)) {
+    return {0, false};
+  }
+  return {a + b, true};
+}
+
+[[nodiscard]] constexpr Endpoint endpoint_sub(std::int64_t a, std::int64_t b) noexcept {
+  if ((b < 0 && a > ENDPOINT_MAX + b) || (b > 0 && a < ENDPOINT_MIN + b)) {
+    return {0, false};
+  }
+  return {a - b, true};
+}
+
+[[nodiscard]] constexpr Endpoint endpoint_mul(std::int64_t a, std::int64_t b) noexcept {
+  if (a == 0 || b == 0) {
+    return {0, true};
+  }
+  auto magnitude = [](std::int64_t v) {
+    return v < 0 ? std::uint64_t{0} - static_cast<std::uint64_t>(v) : static_cast<std::uint64_t>(v);
+  };
+  std::uint64_t ma = magnitude(a), mb = magnitude(b);
+  if (ma > std::numeric_limits<std::uint64_t>::max() / mb) {
+    return {0, false};
+  }
+  std::uint64_t product = ma * mb;
+  bool negative = (a < 0) != (b < 0);
+  constexpr auto limit = static_cast<std::uint64_t>(ENDPOINT_MAX);
+  if (product > limit + (negative ? 1 : 0)) {
+    return {0, false};
+  }
+  return {negative ? static_cast<std::int64_t>(std::uint64_t{0} - product)
+                   : static_cast<std::int64_t>(product),
+          true};
+}
+
+[[nodiscard]] constexpr Endpoint endpoint_div(std::int64_t a, std::int64_t b) noexcept {
+  if (b == 0 || (a == ENDPOINT_MIN && b == -1)) {
+    return {0, false};
+  }
+  return {a / b, true};
+}
+
+/// Smallest and largest of the candidate endpoints, if all of them fit.
+[[nodiscard]] constexpr Interval interval_hull(std::initializer_list<Endpoint> corners) noexcept {
+  Interval result{ENDPOINT_MAX, ENDPOINT_MIN, true};
+  for (auto [value, fits] : corners) {
+    if (!fits) {
+      return Interval{};
+    }
+    result.lo = std::min(result.lo, value);
+    result.hi = std::max(result.hi, value);
+  }
+  return result;
+}
+
+[[nodiscard]] constexpr Interval interval_add(std::int64_t a_lo, std::int64_t a_hi,
+                                              std::int64_t b_lo,
+                                              std::int64_t b_hi) noexcept {
+  return interval_hull({endpoint_add(a_lo, b_lo), endpoint_add(a_hi, b_hi)});
+}
+
+[[nodiscard]] constexpr Interval interval_sub(std::int64_t a_lo, std::int64_t a_hi,
+                                              std::int64_t b_lo,
+                                              std::int64_t b_hi) noexcept {
+  return interval_hull({endpoint_sub(a_lo, b_hi), endpoint_sub(a_hi, b_lo)});
+}
+
+/// The extremes of a product are at the corners of the two ranges.
+[[nodiscard]] constexpr Interval interval_mul(std::int64_t a_lo, std::int64_t a_hi,
+                                              std::int64_t b_lo,
+                                              std::int64_t b_hi) noexcept {
+  return interval_hull({endpoint_mul(a_lo, b_lo), endpoint_mul(a_lo, b_hi),
+                        endpoint_mul(a_hi, b_lo), endpoint_mul(a_hi, b_hi)});
+}
+
+/// Truncating division by a range without 0 is monotonic in each operand,
+/// so the extremes are at the corners too.
+[[nodiscard]] constexpr Interval interval_div(std::int64_t a_lo, std::int64_t a_hi,
+                                              std::int64_t b_lo,
+                                              std::int64_t b_hi) noexcept {
+  return interval_hull({endpoint_div(a_lo, b_lo), endpoint_div(a_lo, b_hi),
+                        endpoint_div(a_hi, b_lo), endpoint_div(a_hi, b_hi)});
+}
+
+/// The narrowest SafeInt holding [Lo, Hi], unsigned when Lo >= 0.
+template <std::int64_t Lo, std::int64_t Hi>
+using range_storage_t = std::conditional_t<
+    (Lo >= 0),
+    std::conditional_t<
+        (Hi <= u8::MAX), u8,
+        std::conditional_t<(Hi <= u16::MAX), u16,
+                           std::conditional_t<(Hi <= u32::MAX), u32, u64>>>,
+    std::conditional_t<
+        (Lo >= i8::MIN && Hi <= i8::MAX), i8,
+        std::conditional_t<(Lo >= i16::MIN && Hi <= i16::MAX), i16,
+                           std::conditional_t<(Lo >= i32::MIN && Hi <= i32::MAX), i32, i64>>>>;
+
+/// True if every value of S is a std::int64_t, so S's range can be a Ranged.
+template <typename S>
+concept RangeableInteger =
+    SafeInteger<S> && std::cmp_greater_equal(S::MIN, std::numeric_limits<std::int64_t>::min()) &&
+    std::cmp_less_equal(S::MAX, std::numeric_limits<std::int64_t>::max());
+
+/// Lets the operators of one Ranged reach into another.
+struct RangedAccess {
+  template <typename R> [[nodiscard]] static constexpr std::int64_t raw(R value) noexcept {
+    return value.raw();
+  }
+  template <typename R> [[nodiscard]] static constexpr R make(std::int64_t value) noexcept {
+    return R(value);
+  }
+};
+
+template <typename T> struct is_ranged : std::false_type {};
+
+template <std::int64_t Lo, std::int64_t Hi>
+struct is_ranged<Ranged<Lo, Hi>> : std::true_type {};
+
+} // namespace detail
+
+/// Concept satisfied by every Ranged instantiation
+template <typename R>
+concept RangedInteger = detail::is_ranged<R>::value;
+
+/// An integer known to lie in [Lo, Hi], stored in the narrowest SafeInt
+/// that holds the range.
+template <std::int64_t Lo, std::int64_t Hi>
+  requires(Lo <= Hi)
+class Ranged {
+public:
+  using value_type = detail::range_storage_t<Lo, Hi>;
+  using underlying_type = typename value_type::underlying_type;
+
+  static constexpr std::int64_t MIN = Lo;
+  static constexpr std::int64_t MAX = Hi;
+
+  // ==================== Construction ====================
+
+  /// Returns None if `value` is outside [Lo, Hi].
+  template <detail::SafeInteger S>
+  [[nodiscard]] static constexpr Optional<Ranged> from(S value) noexcept {
+    if (std::cmp_less(value.get(), Lo) || std::cmp_greater(value.get(), Hi)) {
+      return None;
+    }
+    return Some(Ranged(static_cast<std::int64_t>(value.get())));
+  }
+
+  /// Returns None if `value` is outside [Lo, Hi].
+  template <std::integral T>
+    requires(!std::same_as<T, bool>)
+  [[nodiscard]] static constexpr Optional<Ranged> from(T value) noexcept {
+    if (std::cmp_less(value, Lo) || std::cmp_greater(value, Hi)) {
+      return None;
+    }
+    return Some(Ranged(static_cast<std::int64_t>(value)));
+  }
+
+  /// Compile-time constant: `Ranged<0, 9>::constant<3>()`.
+  template <std::int64_t Value>
+    requires(Value >= Lo && Value <= Hi)
+  [[nodiscard]] static constexpr Ranged constant() noexcept {
+    return Ranged(Value);
+  }
+
+  /// Default: Lo.
+  constexpr Ranged() noexcept : m_value(static_cast<underlying_type>(Lo)) {}
+
+  // ==================== Accessors ====================
+
+  /// The value. Also tells the optimizer it lies in [Lo, Hi].
+  [[nodiscard]] constexpr value_type get() const noexcept {
+    return value_type(static_cast<underlying_type>(raw()));
+  }
+
+  /// Converts to any SafeInt that holds all of [Lo, Hi]; no check.
+  template <detail::SafeInteger S>
+    requires(std::cmp_less_equal(S::MIN, Lo) && std::cmp_less_equal(Hi, S::MAX))
+  [[nodiscard]] constexpr S widen() const noexcept {
+    return S(static_cast<typename S::underlying_type>(raw()));
+  }
+
+  /// Converts to S, or None if the value does not fit.
+  template <detail::SafeInteger S>
+  [[nodiscard]] constexpr Optional<S> narrow() const noexcept {
+    return S::from(raw());
+  }
+
+  /// The same value with a range that contains this one.
+  template <std::int64_t NewLo, std::int64_t NewHi>
+    requires(NewLo <= Lo && Hi <= NewHi)
+  [[nodiscard]] constexpr Ranged<NewLo, NewHi> relax() const noexcept {
+    return detail::RangedAccess::make<Ranged<NewLo, NewHi>>(raw());
+  }
+
+  // ==================== Comparison ====================
+  // Values of different ranges compare by value.
+
+  template <std::int64_t L, std::int64_t H>
+  [[nodiscard]] constexpr bool operator==(Ranged<L, H> other) const noexcept {
+    return raw() == detail::RangedAccess::raw(other);
+  }
+
+  template <std::int64_t L, std::int64_t H>
+  [[nodiscard]] constexpr std::strong_ordering
+  operator<=>(Ranged<L, H> other) const noexcept {
+    return raw() <=> detail::RangedAccess::raw(other);
+  }
+
+  // ==================== Arithmetic ====================
+  // The result range is computed at compile time. When it fits in
+  // std::int64_t the operation cannot overflow and is done unchecked;
+  // otherwise the result is a CheckedExpr<i64>.
+
+  template <std::int64_t L, std::int64_t H>
+  [[nodiscard]] friend constexpr auto operator+(Ranged lhs, Ranged<L, H> rhs) noexcept {
+    constexpr detail::Interval r = detail::interval_add(Lo, Hi, L, H);
+    if constexpr (r.ok) {
+      return detail::RangedAccess::make<Ranged<r.lo, r.hi>>(lhs.raw() + detail::RangedAccess::raw(rhs));
+    } else {
+      return checked_expr(lhs.template widen<i64>()) + rhs.template widen<i64>();
+    }
+  }
+
+  template <std::int64_t L, std::int64_t H>
+  [[nodiscard]] friend constexpr auto operator-(Ranged lhs, Ranged<L, H> rhs) noexcept {
+    constexpr detail::Interval r = detail::interval_sub(Lo, Hi, L, H);
+    if constexpr (r.ok) {
+      return detail::RangedAccess::make<Ranged<r.lo, r.hi>>(lhs.raw() - detail::RangedAccess::raw(rhs));
+    } else {
+      return checked_expr(lhs.template widen<i64>()) - rhs.template widen<i64>();
+    }
+  }
+
+  template <std::int64_t L, std::int64_t H>
+  [[nodiscard]] friend constexpr auto operator*(Ranged lhs, Ranged<L, H> rhs) noexcept {
+    constexpr detail::Interval r = detail::interval_mul(Lo, Hi, L, H);
+    if constexpr (r.ok) {
+      return detail::RangedAccess::make<Ranged<r.lo, r.hi>>(lhs.raw() * detail::RangedAccess::raw(rhs));
+    } else {
+      return checked_expr(lhs.template widen<i64>()) * rhs.template widen<i64>();
+    }
+  }
+
+  /// Division truncates toward zero. Only for divisor ranges without 0,
+  /// where the quotient's range always fits (except MIN / -1 on the full
+  /// std::int64_t range, which does not compile).
+  template <std::int64_t L, std::int64_t H>
+    requires(L > 0 || H < 0) && (detail::interval_div(Lo, Hi, L, H).ok)
+  [[nodiscard]] friend constexpr auto operator/(Ranged lhs, Ranged<L, H> rhs) noexcept {
+    constexpr detail::Interval r = detail::interval_div(Lo, Hi, L, H);
+    return detail::RangedAccess::make<Ranged<r.lo, r.hi>>(lhs.raw() / detail::RangedAccess::raw(rhs));
+  }
+
+  [[nodiscard]] constexpr auto operator-() const noexcept
+    requires(Lo > std::numeric_limits<std::int64_t>::min())
+  {
+    return detail::RangedAccess::make<Ranged<-Hi, -Lo>>(-raw());
+  }
+
+  friend std::ostream &operator<<(std::ostream &os, Ranged value) {
+    return os << value.get();
+  }
+
+private:
+  friend struct detail::RangedAccess;
+
+  constexpr explicit Ranged(std::int64_t value) noexcept
+      : m_value(static_cast<underlying_type>(value)) {}
+
+  /// The value as std::int64_t, with the range passed to the optimizer.
+  [[nodiscard]] constexpr std::int64_t raw() const noexcept {
+    auto value = static_cast<std::int64_t>(m_value.get());
+    PULGACPP_ASSUME(value >= Lo && value <= Hi);
+    return value;
+  }
+
+  value_type m_value;
+};
+
+// ==================== Entry points ====================
+
+/// `value` with the full range of its type.
+template <detail::RangeableInteger S>
+[[nodiscard]] constexpr Ranged<S::MIN, S::MAX> ranged(S value) noexcept {
+  return Ranged<S::MIN, S::MAX>::from(value).unwrap();
+}
+
+/// A Bounded value keeps its range.
+template <detail::SafeInteger S, typename S::underlying_type Lo,
+          typename S::underlying_type Hi>
+  requires detail::RangeableInteger<S>
+[[nodiscard]] constexpr Ranged<Lo, Hi> ranged(Bounded<S, Lo, Hi> value) noexcept {
+  return Ranged<Lo, Hi>::from(value.get()).unwrap();
+}
+
+/// The constant `Value` as a one-value range.
+template <std::int64_t Value>
+[[nodiscard]] constexpr Ranged<Value, Value> ranged() noexcept {
+  return Ranged<Value, Value>::template constant<Value>();
+}
+
+// ==================== Checked fallback ====================
+// A step that could not be proven returns a CheckedExpr<i64>; these let the
+// chain continue with Ranged operands.
+
+template <std::int64_t Lo, std::int64_t Hi>
+[[nodiscard]] constexpr detail::CheckedExpr<i64>
+operator+(detail::CheckedExpr<i64> lhs, Ranged<Lo, Hi> rhs) noexcept {
+  return lhs + rhs.template widen<i64>();
+}
+template <std::int64_t Lo, std::int64_t Hi>
+[[nodiscard]] constexpr detail::CheckedExpr<i64>
+operator+(Ranged<Lo, Hi> lhs, detail::CheckedExpr<i64> rhs) noexcept {
+  return lhs.template widen<i64>() + rhs;
+}
+
+template <std::int64_t Lo, std::int64_t Hi>
+[[nodiscard]] constexpr detail::CheckedExpr<i64>
+operator-(detail::CheckedExpr<i64> lhs, Ranged<Lo, Hi> rhs) noexcept {
+  return lhs - rhs.template widen<i64>();
+}
+template <std::int64_t Lo, std::int64_t Hi>
+[[nodiscard]] constexpr detail::CheckedExpr<i64>
+operator-(Ranged<Lo, Hi> lhs, detail::CheckedExpr<i64> rhs) noexcept {
+  return lhs.template widen<i64>() - rhs;
+}
+
+template <std::int64_t Lo, std::int64_t Hi>
+[[nodiscard]] constexpr detail::CheckedExpr<i64>
+operator*(detail::CheckedExpr<i64> lhs, Ranged<Lo, Hi> rhs) noexcept {
+  return lhs * rhs.template widen<i64>();
+}
+template <std::int64_t Lo, std::int64_t Hi>
+[[nodiscard]] constexpr detail::CheckedExpr<i64>
+operator*(Ranged<Lo, Hi> lhs, detail::CheckedExpr<i64> rhs) noexcept {
+  return lhs.template widen<i64>() * rhs;
+}
+
+} // namespace pulgacpp
+
+#endif // PULGACPP_RANGED_HPP
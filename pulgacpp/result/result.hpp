@@ -97,30 +97,34 @@ public:
     // ==================== Value access ====================
 
     /// Returns the Ok value, panics if Err
-    [[nodiscard]] constexpr T unwrap() const& {
+    [[nodiscard]] constexpr T unwrap(PULGACPP_SITE_PARAM_ONLY) const& {
         if (is_err()) {
+            PULGACPP_RECORD(Panic);
             panic("called unwrap() on an Err value");
         }
         return std::get<0>(m_storage);
     }
 
-    [[nodiscard]] constexpr T unwrap() && {
+    [[nodiscard]] constexpr T unwrap(PULGACPP_SITE_PARAM_ONLY) && {
         if (is_err()) {
+            PULGACPP_RECORD(Panic);
             panic("called unwrap() on an Err value");
         }
         return std::get<0>(std::move(m_storage));
     }
 
     /// Returns the Ok value, panics with message if Err
-    [[nodiscard]] constexpr T expect(std::string_view message) const& {
+    [[nodiscard]] constexpr T expect(std::string_view message PULGACPP_SITE_PARAM) const& {
         if (is_err()) {
+            PULGACPP_RECORD(Panic);
             panic(message);
         }
         return std::get<0>(m_storage);
     }
 
-    [[nodiscard]] constexpr T expect(std::string_view message) && {
+    [[nodiscard]] constexpr T expect(std::string_view message PULGACPP_SITE_PARAM) && {
         if (is_err()) {
+            PULGACPP_RECORD(Panic);
             panic(message);
         }
         return std::get<0>(std::move(m_storage));
@@ -175,7 +179,6 @@ public:
     template <typename F>
         requires std::invocable<F, const T&>
     [[nodiscard]] constexpr auto map(F&& f) const& -> Result<std::invoke_result_t<F, const T&>, E> {
-        using U = std::invoke_result_t<F, const T&>;
         if (is_ok()) {
             return Ok(std::invoke(std::forward<F>(f), std::get<0>(m_storage)));
         }
@@ -186,7 +189,6 @@ public:
     template <typename F>
         requires std::invocable<F, const E&>
     [[nodiscard]] constexpr auto map_err(F&& f) const& -> Result<T, std::invoke_result_t<F, const E&>> {
-        using F2 = std::invoke_result_t<F, const E&>;
         if (is_err()) {
             return Err(std::invoke(std::forward<F>(f), std::get<1>(m_storage)));
         }
@@ -206,7 +208,6 @@ public:
     template <typename F>
         requires std::invocable<F, const T&>
     [[nodiscard]] constexpr auto and_then(F&& f) const& -> std::invoke_result_t<F, const T&> {
-        using ResultType = std::invoke_result_t<F, const T&>;
         if (is_ok()) {
             return std::invoke(std::forward<F>(f), std::get<0>(m_storage));
         }
@@ -226,7 +227,6 @@ public:
     template <typename F>
         requires std::invocable<F, const E&>
     [[nodiscard]] constexpr auto or_else(F&& f) const& -> std::invoke_result_t<F, const E&> {
-        using ResultType = std::invoke_result_t<F, const E&>;
         if (is_err()) {
             return std::invoke(std::forward<F>(f), std::get<1>(m_storage));
         }
@@ -288,14 +288,16 @@ public:
     [[nodiscard]] constexpr bool is_err() const noexcept { return m_error.has_value(); }
     [[nodiscard]] constexpr explicit operator bool() const noexcept { return is_ok(); }
 
-    constexpr void unwrap() const {
+    constexpr void unwrap(PULGACPP_SITE_PARAM_ONLY) const {
         if (is_err()) {
+            PULGACPP_RECORD(Panic);
             panic("called unwrap() on an Err value");
         }
     }
 
-    constexpr void expect(std::string_view message) const {
+    constexpr void expect(std::string_view message PULGACPP_SITE_PARAM) const {
         if (is_err()) {
+            PULGACPP_RECORD(Panic);
             panic(message);
         }
     }
@@ -50,7 +50,7 @@ int main() {
   test(large_add.is_none(), "Half MAX + Half MAX overflows");
 
   // Normal addition
-  auto normal_add = 1000000000_i64.checked_add(2000000000_i64);
+  auto normal_add = (1000000000_i64).checked_add(2000000000_i64);
   test(normal_add.is_some() && normal_add.unwrap().get() == 3000000000,
        "Normal i64 add works");
 
@@ -66,7 +66,7 @@ int main() {
   test(sub_overflow.is_none(), "i64::MAX - (-1) overflows");
 
   // Normal subtraction
-  auto normal_sub = 5000000000_i64.checked_sub(2000000000_i64);
+  auto normal_sub = (5000000000_i64).checked_sub(2000000000_i64);
   test(normal_sub.is_some() && normal_sub.unwrap().get() == 3000000000,
        "Normal i64 sub works");
 
@@ -87,7 +87,7 @@ int main() {
   test(min_mul.is_none(), "i64::MIN * 2 overflows");
 
   // Normal multiplication
-  auto normal_mul = 1000000_i64.checked_mul(1000000_i64);
+  auto normal_mul = (1000000_i64).checked_mul(1000000_i64);
   test(normal_mul.is_some() && normal_mul.unwrap().get() == 1000000000000LL,
        "1M * 1M = 1T works");
 
@@ -107,7 +107,7 @@ int main() {
        "u64::MAX + 0 works");
 
   // Normal addition
-  auto u64_normal = 10000000000_u64.checked_add(5000000000_u64);
+  auto u64_normal = (10000000000_u64).checked_add(5000000000_u64);
   test(u64_normal.is_some() && u64_normal.unwrap().get() == 15000000000ULL,
        "Normal u64 add works");
 
@@ -121,7 +121,7 @@ int main() {
   test(u64_sub_underflow.is_none(), "u64: 0 - 1 underflows");
 
   // Normal subtraction
-  auto u64_sub_normal = 10000000000_u64.checked_sub(5000000000_u64);
+  auto u64_sub_normal = (10000000000_u64).checked_sub(5000000000_u64);
   test(u64_sub_normal.is_some() &&
            u64_sub_normal.unwrap().get() == 5000000000ULL,
        "Normal u64 sub works");
@@ -139,7 +139,7 @@ int main() {
   test(u64_large_mul.is_none(), "2^32 * 2^32 overflows (would be 2^64)");
 
   // Normal multiplication
-  auto u64_normal_mul = 1000000_u64.checked_mul(1000000_u64);
+  auto u64_normal_mul = (1000000_u64).checked_mul(1000000_u64);
   test(u64_normal_mul.is_some() &&
            u64_normal_mul.unwrap().get() == 1000000000000ULL,
        "1M * 1M = 1T works");
@@ -58,18 +58,18 @@ int main() {
     // Test overflow detection
     std::cout << "\n--- Overflow Detection ---\n";
     
-    auto overflow8 = 127_i8.checked_add(1_i8);
+    auto overflow8 = (127_i8).checked_add(1_i8);
     std::cout << "i8: 127 + 1 = " << (overflow8.is_some() ? "Some" : "None (overflow!)") << "\n";
     
-    auto overflow_u8 = 255_u8.checked_add(1_u8);
+    auto overflow_u8 = (255_u8).checked_add(1_u8);
     std::cout << "u8: 255 + 1 = " << (overflow_u8.is_some() ? "Some" : "None (overflow!)") << "\n";
 
     // Test wrapping
     std::cout << "\n--- Wrapping Arithmetic ---\n";
-    auto wrapped = 127_i8.wrapping_add(1_i8);
+    auto wrapped = (127_i8).wrapping_add(1_i8);
     std::cout << "i8: 127 wrapping_add 1 = " << wrapped << " (wrapped to MIN)\n";
 
-    auto wrapped_u = 255_u8.wrapping_add(1_u8);
+    auto wrapped_u = (255_u8).wrapping_add(1_u8);
     std::cout << "u8: 255 wrapping_add 1 = " << wrapped_u << " (wrapped to 0)\n";
 
     // Test inter-type conversions
@@ -86,7 +86,7 @@ int main() {
 
     // narrow: i32 -> i16 -> i8
     auto big = 1000_i32;
-    auto narrowed_ok = 50_i32.narrow<i8>();
+    auto narrowed_ok = (50_i32).narrow<i8>();
     auto narrowed_fail = big.narrow<i8>();
     std::cout << "i32(50).narrow<i8>() = " << (narrowed_ok.is_some() ? std::to_string(narrowed_ok.unwrap().get()) : "None") << "\n";
     std::cout << "i32(1000).narrow<i8>() = " << (narrowed_fail.is_some() ? "Some" : "None (overflow!)") << "\n";
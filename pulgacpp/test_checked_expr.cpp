@@ -0,0 +1,126 @@
+// Test for sticky-overflow checked expressions
+// Compile: cl /std:c++latest /EHsc /W4 /I. test_checked_expr.cpp
+
+#include "i16/i16.hpp"
+#include "i64/i64.hpp"
+#include "i8/i8.hpp"
+#include "u32/u32.hpp"
+#include "u64/u64.hpp"
+#include "u8/u8.hpp"
+#include <iostream>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const char *name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+/// Same chain written with per-step checked_* calls, for comparison.
+Optional<i64> polynomial_checked(i64 x) {
+  auto sq = x.checked_mul(x);
+  if (sq.is_none())
+    return None;
+  auto cube = sq.unwrap().checked_mul(x);
+  if (cube.is_none())
+    return None;
+  auto sum = cube.unwrap().checked_add(3_i64);
+  if (sum.is_none())
+    return None;
+  return sum.unwrap().checked_sub(x);
+}
+
+Optional<i64> polynomial_expr(i64 x) {
+  return (checked_expr(x) * x * x + 3_i64 - x).value();
+}
+
+int main() {
+  std::cout << "=== Checked Expression Test ===\n\n";
+
+  // ===================== Basics =====================
+  std::cout << "--- Basics ---\n";
+
+  auto total = checked_expr(12_i64) * 4_i64 + 10_i64 - 8_i64;
+  test(!total.is_overflowed(), "in-range chain does not overflow");
+  test(total.value().is_some() && total.value().unwrap() == 50_i64,
+       "12 * 4 + 10 - 8 = 50");
+
+  auto over = checked_expr(i8(i8::MAX)) + 1_i8 - 1_i8;
+  test(over.is_overflowed(), "MAX + 1 - 1 stays overflowed (sticky)");
+  test(over.value().is_none(), "overflowed chain yields None");
+  test(over.value_or(0_i8) == 0_i8, "value_or returns fallback on overflow");
+  test(over.wrapped() == i8(i8::MAX), "wrapped() holds the wrapping result");
+
+  auto under = checked_expr(3_u8) - 5_u8 + 10_u8;
+  test(under.is_overflowed(), "u8 3 - 5 + 10 flags the intermediate underflow");
+
+  // ===================== Compound assignment =====================
+  std::cout << "\n--- Compound Assignment ---\n";
+
+  detail::CheckedExpr<u32> acc;
+  for (int i = 0; i < 20; ++i) {
+    acc += 1000_u32;
+    acc *= 3_u32;
+  }
+  test(acc.is_overflowed(), "u32 accumulator loop overflows");
+
+  detail::CheckedExpr<u64> sum;
+  std::vector<u64> values{1_u64, 2_u64, 3_u64, 4_u64};
+  for (auto v : values) {
+    sum += checked_expr(v) * v;
+  }
+  test(sum.value().is_some() && sum.value().unwrap() == 30_u64,
+       "sum of squares accumulates");
+
+  // ===================== Combining expressions =====================
+  std::cout << "\n--- Combining Expressions ---\n";
+
+  auto bad = checked_expr(i16(i16::MAX)) * 2_i16;
+  auto good = checked_expr(5_i16);
+  test((good + bad).is_overflowed(), "overflow flag propagates through +");
+  test((good * good - good).value().unwrap() == 20_i16,
+       "expr op expr without overflow");
+  test((100_i16 - good).value().unwrap() == 95_i16,
+       "SafeInt on the left-hand side");
+
+  // ===================== Agreement with checked_* =====================
+  std::cout << "\n--- Matches per-step checked_* ---\n";
+
+  bool agree = true;
+  for (std::int64_t v : {0LL, 1LL, -7LL, 1000LL, 2097151LL, 2097152LL,
+                         -2097153LL, 3037000499LL}) {
+    auto a = polynomial_checked(i64(v));
+    auto b = polynomial_expr(i64(v));
+    if (a.is_some() != b.is_some() ||
+        (a.is_some() && a.unwrap() != b.unwrap())) {
+      agree = false;
+    }
+  }
+  test(agree, "x^3 + 3 - x agrees with checked_* chain at boundaries");
+
+  // ===================== constexpr =====================
+  constexpr auto ce = (checked_expr(6_u8) * 7_u8).value_or(0_u8);
+  static_assert(ce.get() == 42);
+  constexpr bool ce_over = (checked_expr(16_u8) * 16_u8).is_overflowed();
+  static_assert(ce_over);
+  constexpr bool ce64 = (checked_expr(u64(u64::MAX)) + 1_u64).is_overflowed();
+  static_assert(ce64);
+  test(true, "usable in constant expressions");
+
+  // ===================== Summary =====================
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,168 @@
+// Test for per-call-site overflow instrumentation
+// Compile: cl /std:c++latest /EHsc /W4 /I. /DPULGACPP_INSTRUMENT=1 test_instrument.cpp
+//      or: g++ -std=c++23 -O2 -Wall -pthread -I. -DPULGACPP_INSTRUMENT=1 test_instrument.cpp
+
+#ifndef PULGACPP_INSTRUMENT
+#define PULGACPP_INSTRUMENT 1
+#endif
+
+#include "i32/i32.hpp"
+#include "i8/i8.hpp"
+#include "u8/u8.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const char *name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+/// Count at the site on `line` of this file, 0 if it had no events.
+std::uint64_t count_at(std::uint32_t line, instrument::Event event) {
+  for (const auto &site : instrument::snapshot()) {
+    if (site.line == line && site.event == event &&
+        site.file == std::source_location::current().file_name()) {
+      return site.count;
+    }
+  }
+  return 0;
+}
+
+std::uint32_t add_line = 0;
+
+void add_many(int times) {
+  for (int i = 0; i < times; ++i) {
+    add_line = std::source_location::current().line() + 1;
+    (void)u8(u8::MAX).checked_add(1_u8);
+  }
+}
+
+int hook_calls = 0;
+
+/// Set on a thread to make its nothrow allocations (the site table) fail.
+thread_local bool fail_nothrow_new = false;
+
+[[gnu::noinline]] void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return fail_nothrow_new ? nullptr : std::malloc(size == 0 ? 1 : size);
+}
+
+[[gnu::noinline]] void operator delete(void *p, const std::nothrow_t &) noexcept {
+  std::free(p);
+}
+
+// The constant-evaluated path records nothing and stays constexpr
+static_assert(u8(u8::MAX).checked_add(1_u8).is_none());
+static_assert(u8(u8::MAX).saturating_add(1_u8) == u8(u8::MAX));
+
+int main() {
+  std::cout << "=== pulgacpp::instrument Test Suite ===\n\n";
+  test(instrument::ENABLED, "enabled by PULGACPP_INSTRUMENT");
+
+  // ===================== Counting =====================
+  std::cout << "--- Counting ---\n";
+  {
+    instrument::reset();
+    auto line = std::source_location::current().line() + 2;
+    for (int i = 0; i < 5; ++i) {
+      (void)i8(i8::MIN).checked_neg();
+    }
+    test(count_at(line, instrument::Event::CheckedNone) == 5,
+         "checked_neg returning None counted at the caller's line");
+
+    line = std::source_location::current().line() + 1;
+    (void)(100_i8).checked_mul(2_i8);
+    (void)(10_i8).checked_mul(2_i8); // fits: no event
+    test(count_at(line, instrument::Event::CheckedNone) == 1 &&
+             count_at(line + 1, instrument::Event::CheckedNone) == 0,
+         "only failing calls are counted");
+
+    line = std::source_location::current().line() + 1;
+    auto clamped = (200_u8).saturating_add(100_u8);
+    auto from = u8::saturating_from(-5);
+    test(clamped == u8(u8::MAX) && from == u8(u8::MIN), "saturating results unchanged");
+    test(count_at(line, instrument::Event::Saturated) == 1 &&
+             count_at(line + 1, instrument::Event::Saturated) == 1,
+         "saturation counted per site");
+
+    line = std::source_location::current().line() + 1;
+    (void)(10_i32).checked_div(0_i32);
+    test(count_at(line, instrument::Event::CheckedNone) == 1, "division by zero counted");
+  }
+
+  // ===================== Threads =====================
+  std::cout << "\n--- Threads ---\n";
+  {
+    instrument::reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back(add_many, 1000);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    test(count_at(add_line, instrument::Event::CheckedNone) == 4000,
+         "counts of finished threads are merged");
+
+    auto sites = instrument::snapshot();
+    bool sorted = true;
+    for (std::size_t i = 1; i < sites.size(); ++i) {
+      sorted = sorted && sites[i - 1].count >= sites[i].count;
+    }
+    test(sites.size() == 1 && sorted, "one site after reset, sorted by count");
+
+    std::thread starved([] {
+      fail_nothrow_new = true;
+      add_many(3);
+    });
+    starved.join();
+    test(count_at(add_line, instrument::Event::CheckedNone) == 4000 &&
+             instrument::dropped() == 3,
+         "events on a thread without a table are counted as dropped");
+  }
+
+  // ===================== Dump and hook =====================
+  std::cout << "\n--- Dump and Hook ---\n";
+  {
+    std::ostringstream out;
+    instrument::dump(out);
+    std::string text = out.str();
+    test(text.find("4000\tchecked_none\t") == 0 &&
+             text.find("test_instrument.cpp:" + std::to_string(add_line)) != std::string::npos,
+         "dump writes count, event and location");
+
+    instrument::set_hook(+[](instrument::Event, const std::source_location &) noexcept { ++hook_calls; });
+    (void)(0_u8).checked_sub(1_u8);
+    (void)(0_u8).saturating_sub(1_u8);
+    (void)(1_u8).checked_sub(1_u8);
+    instrument::set_hook(nullptr);
+    (void)(0_u8).checked_sub(1_u8);
+    test(hook_calls == 2, "hook called once per event");
+
+    instrument::reset();
+    test(instrument::snapshot().empty() && instrument::dropped() == 0, "reset clears every count");
+  }
+
+  // ===================== Summary =====================
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+// Test for niche-optimized Optional
+// Compile: cl /std:c++latest /EHsc /W4 /I. test_niche.cpp
+
+#include "geometry/geometry.hpp"
+#include "i32/i32.hpp"
+#include "u8/u8.hpp"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const char *name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+/// A user type that reserves -1 (an index that is never valid).
+struct SlotIndex {
+  int value;
+  constexpr bool operator==(const SlotIndex &) const noexcept = default;
+};
+
+template <> struct pulgacpp::niche_traits<SlotIndex> {
+  static constexpr SlotIndex none() noexcept { return SlotIndex{-1}; }
+  static constexpr bool is_none(const SlotIndex &s) noexcept {
+    return s.value == -1;
+  }
+};
+
+int main() {
+  std::cout << "=== Niche-optimized Optional Test Suite ===\n\n";
+
+  // --- Size ---
+  std::cout << "--- Size ---\n";
+  {
+    test(sizeof(Optional<PointD>) == sizeof(PointD), "Optional<PointD> is 16 bytes");
+    test(sizeof(Optional<PointF>) == sizeof(PointF), "Optional<PointF> is 8 bytes");
+    test(sizeof(Optional<Vec2d>) == sizeof(Vec2d), "Optional<Vec2d> has no flag");
+    test(sizeof(Optional<Vec3d>) == sizeof(Vec3d), "Optional<Vec3d> has no flag");
+    test(sizeof(Optional<SlotIndex>) == sizeof(int), "user-declared niche");
+    test(sizeof(Optional<Point32>) > sizeof(Point32), "integer points keep the flag");
+    test(sizeof(Optional<u8>) == 2, "types without a niche are unchanged");
+    test(std::is_trivially_copyable_v<Optional<PointD>>,
+         "Optional<PointD> stays trivially copyable");
+  }
+
+  // --- Semantics ---
+  std::cout << "\n--- Semantics ---\n";
+  {
+    Optional<PointD> none;
+    test(none.is_none(), "default is None");
+    auto p = Some(PointD::from(1.5, -2.0));
+    test(p.is_some() && p.unwrap() == PointD::from(1.5, -2.0), "Some holds the value");
+    test(none == None && p != None, "comparison with None");
+    test(Optional<PointD>() == Optional<PointD>(None), "None == None despite NaN");
+    test(p.map([](PointD q) { return q.x(); }).unwrap() == 1.5, "map");
+    test(none.unwrap_or(PointD::origin()) == PointD::origin(), "unwrap_or");
+
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    auto nan_point = Some(PointD::from(nan, 0.0));
+    test(nan_point.is_some(), "an ordinary NaN coordinate is still Some");
+    auto computed = Some(PointD::from(0.0 * std::numeric_limits<double>::infinity(), 1.0));
+    test(computed.is_some(), "NaN produced by arithmetic is still Some");
+    volatile float one = 1.0f;
+    float carried = detail::niche_nan<float>() + one; // the payload propagates
+    auto v = Some(Vec3f::from(carried, 0.0f, 0.0f));
+    test(v.is_some() && std::isnan(v.unwrap().x()), "NaN carrying the reserved payload is Some");
+    test(Some(PointD::from(detail::niche_nan<double>(), 2.0)).is_some(),
+         "the reserved payload itself is Some");
+
+    Optional<SlotIndex> slot = SlotIndex{3};
+    test(slot.is_some() && slot.unwrap().value == 3, "user niche Some");
+    slot = None;
+    test(slot.is_none(), "user niche reassigned to None");
+  }
+
+  // --- Geometry functions returning Optional ---
+  std::cout << "\n--- Geometry ---\n";
+  {
+    auto seg1 = LineSegment<double>::from(PointD::from(0, 0), PointD::from(2, 2));
+    auto seg2 = LineSegment<double>::from(PointD::from(0, 2), PointD::from(2, 0));
+    auto hit = seg1.intersection(seg2);
+    test(hit.is_some() && hit.unwrap() == PointD::from(1, 1), "segment intersection is Some");
+    auto seg3 = LineSegment<double>::from(PointD::from(0, 1), PointD::from(2, 3));
+    test(seg1.intersection(seg3).is_none(), "parallel segments give None");
+    test(vec_normalized(Vec2d::from(0, 0)).is_none(), "normalizing zero vector is None");
+  }
+
+  // --- constexpr ---
+  {
+    constexpr Optional<PointD> none;
+    static_assert(none.is_none());
+    constexpr auto some = Some(PointD::from(1.0, 2.0));
+    static_assert(some.is_some());
+    test(true, "niche Optional is constexpr");
+  }
+
+  // --- Summary ---
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+// Test for SafeInt text conversion (parse / to_chars)
+// Compile: cl /std:c++latest /EHsc /W4 /I. test_parse.cpp
+
+#include "i128/i128.hpp"
+#include "i16/i16.hpp"
+#include "i32/i32.hpp"
+#include "i64/i64.hpp"
+#include "i8/i8.hpp"
+#include "u128/u128.hpp"
+#include "u32/u32.hpp"
+#include "u64/u64.hpp"
+#include "u8/u8.hpp"
+#include <charconv>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace pulgacpp;
+using namespace pulgacpp::literals;
+
+int passed = 0;
+int failed = 0;
+
+void test(bool condition, const char *name) {
+  if (condition) {
+    std::cout << "[PASS] " << name << "\n";
+    ++passed;
+  } else {
+    std::cout << "[FAIL] " << name << "\n";
+    ++failed;
+  }
+}
+
+template <typename S> std::string print(S value) {
+  char buffer[S::MAX_CHARS];
+  auto [end, ec] = value.to_chars(buffer, buffer + sizeof(buffer));
+  return ec == std::errc{} ? std::string(buffer, end) : "<error>";
+}
+
+template <typename S> bool is_error(std::string_view text, ParseError expected) {
+  auto r = S::parse(text);
+  return r.is_err() && r.unwrap_err() == expected;
+}
+
+/// Parses and prints random values of every digit count and compares with
+/// std::to_chars / std::from_chars.
+template <typename S> bool agrees_with_std(std::uint64_t seed) {
+  using T = typename S::underlying_type;
+  std::mt19937_64 rng(seed);
+  for (int i = 0; i < 20000; ++i) {
+    auto value = static_cast<T>(rng() >> (rng() % 64));
+    char expected[32];
+    auto [end, ec] = std::to_chars(expected, expected + sizeof(expected), value);
+    std::string_view text(expected, static_cast<std::size_t>(end - expected));
+
+    auto parsed = S::parse(text);
+    if (parsed.is_err() || parsed.unwrap().get() != value || print(S(value)) != text) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  std::cout << "=== SafeInt parse / to_chars Test Suite ===\n\n";
+
+  // --- Parsing ---
+  std::cout << "--- Parsing ---\n";
+  {
+    test(i32::parse("12345").unwrap() == 12345_i32, "simple value");
+    test(i32::parse("-2147483648").unwrap() == i32(i32::MIN), "i32::MIN");
+    test(i32::parse("+2147483647").unwrap() == i32(i32::MAX), "i32::MAX with plus sign");
+    test(u8::parse("000000000000255").unwrap() == 255_u8, "leading zeros are fine");
+    test(i64::parse("-9223372036854775808").unwrap() == i64(i64::MIN), "i64::MIN");
+    test(u64::parse("18446744073709551615").unwrap() == u64(u64::MAX), "u64::MAX");
+    test(i8::parse("-128").unwrap() == i8(i8::MIN), "i8::MIN");
+  }
+
+  // --- Errors ---
+  std::cout << "\n--- Errors ---\n";
+  {
+    test(is_error<i32>("", {ParseError::Kind::Empty, 0}), "empty string");
+    test(is_error<i32>("-", {ParseError::Kind::InvalidDigit, 1}), "lone minus sign");
+    test(is_error<i32>("12a4", {ParseError::Kind::InvalidDigit, 2}), "invalid digit position");
+    test(is_error<i32>(" 1", {ParseError::Kind::InvalidDigit, 0}), "leading space rejected");
+    test(is_error<i32>("1 ", {ParseError::Kind::InvalidDigit, 1}), "trailing space rejected");
+    test(is_error<u32>("-1", {ParseError::Kind::InvalidDigit, 0}), "minus sign on unsigned type");
+    test(is_error<u8>("256", {ParseError::Kind::PosOverflow, 2}), "u8 overflow at last digit");
+    test(is_error<i8>("-129", {ParseError::Kind::NegOverflow, 3}), "i8 negative overflow");
+    test(is_error<i32>("2147483648", {ParseError::Kind::PosOverflow, 9}), "i32::MAX + 1");
+    test(is_error<u64>("18446744073709551616", {ParseError::Kind::PosOverflow, 19}),
+         "u64::MAX + 1 (overflow inside a SWAR block)");
+    test(is_error<i64>("123456789012345678901234567890", {ParseError::Kind::PosOverflow, 19}),
+         "long digit run reports the first digit past the range");
+    test(is_error<i32>("1234567x", {ParseError::Kind::InvalidDigit, 7}),
+         "non-digit inside the first 8 characters");
+    test(ParseError{ParseError::Kind::Empty, 0}.message() ==
+             "cannot parse integer from empty string",
+         "error message");
+  }
+
+  // --- Formatting ---
+  std::cout << "\n--- Formatting ---\n";
+  {
+    test(print(0_i32) == "0", "zero");
+    test(print(i8(i8::MIN)) == "-128", "i8::MIN");
+    test(print(i64(i64::MIN)) == "-9223372036854775808", "i64::MIN");
+    test(print(u64(u64::MAX)) == "18446744073709551615", "u64::MAX");
+    test(print(i128(i128::MIN)) == "-170141183460469231731687303715884105728", "i128::MIN");
+    test(print(u128(u128::MAX)) == "340282366920938463463374607431768211455", "u128::MAX");
+    test(print(u128(static_cast<unsigned __int128>(1) << 64)) == "18446744073709551616",
+         "2^64 keeps zero padding inside the 19-digit block");
+
+    char small[3];
+    auto [ptr, ec] = (1234_i32).to_chars(small, small + sizeof(small));
+    test(ec == std::errc::value_too_large && ptr == small + sizeof(small),
+         "buffer too small reports value_too_large");
+
+    std::ostringstream os;
+    os << i128(i128::MIN) << ' ' << 42_u8;
+    test(os.str() == "-170141183460469231731687303715884105728 42", "operator<< unchanged");
+  }
+
+  // --- Agreement with <charconv> ---
+  std::cout << "\n--- Agreement with std::to_chars ---\n";
+  {
+    test(agrees_with_std<i8>(1), "i8 random values");
+    test(agrees_with_std<u8>(2), "u8 random values");
+    test(agrees_with_std<i16>(3), "i16 random values");
+    test(agrees_with_std<i32>(4), "i32 random values");
+    test(agrees_with_std<u32>(5), "u32 random values");
+    test(agrees_with_std<i64>(6), "i64 random values");
+    test(agrees_with_std<u64>(7), "u64 random values");
+
+    std::mt19937_64 rng(8);
+    bool ok = true;
+    for (int i = 0; i < 20000; ++i) {
+      auto value = static_cast<__int128>((static_cast<unsigned __int128>(rng()) << 64) | rng()) >>
+                   (rng() % 128);
+      auto text = print(i128(value));
+      auto parsed = i128::parse(text);
+      ok = ok && parsed.is_ok() && parsed.unwrap().get() == value;
+    }
+    test(ok, "i128 round trip");
+  }
+
+  // --- constexpr ---
+  {
+    constexpr auto parsed = i32::parse("-12345678901");
+    static_assert(parsed.is_err());
+    static_assert(u64::parse("18446744073709551615").unwrap() == u64(u64::MAX));
+    test(true, "parse is constexpr");
+  }
+
+  // --- Summary ---
+  std::cout << "\n=== Test Summary ===\n";
+  std::cout << "Passed: " << passed << "\n";
+  std::cout << "Failed: " << failed << "\n";
+
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+// pulgacpp::u128 - Type-safe unsigned 128-bit integer
+// SPDX-License-Identifier: MIT
+
+#ifndef PULGACPP_U128_HPP
+#define PULGACPP_U128_HPP
+
+#include "../core/safe_int.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#if PULGACPP_HAS_INT128
+
+namespace pulgacpp {
+
+/// Type-safe unsigned 128-bit integer with Rust-like semantics.
+/// No implicit conversions. Checked arithmetic returns Optional<u128>.
+/// Note: There is no wider type, so overflow is detected with the compiler
+/// builtins (or a two-limb fallback). Requires __int128 (GCC/Clang, 64-bit).
+using u128 = detail::SafeInt<unsigned __int128, unsigned __int128, 128, false>;
+
+// Literal suffix for u128 (e.g., 340282366920938463463374607431768211455_u128)
+// This is a raw literal operator, so values beyond unsigned long long work.
+namespace literals {
+    template <char... Chars>
+    [[nodiscard]] constexpr u128 operator""_u128() {
+        auto [value, overflow] = detail::parse_u128_literal<Chars...>();
+        if (overflow) {
+            panic("u128 literal out of range");
+        }
+        return u128(static_cast<u128::underlying_type>(value));
+    }
+} // namespace literals
+
+} // namespace pulgacpp
+
+// std::hash specialization for unordered containers
+template <>
+struct std::hash<pulgacpp::u128> {
+    [[nodiscard]] std::size_t operator()(pulgacpp::u128 value) const noexcept {
+        auto bits = value.get();
+        auto low = static_cast<std::uint64_t>(bits);
+        auto high = static_cast<std::uint64_t>(bits >> 64);
+        return std::hash<std::uint64_t>{}(low ^ (high * 0x9E3779B97F4A7C15ULL));
+    }
+};
+
+#endif // PULGACPP_HAS_INT128
+
+#endif // PULGACPP_U128_HPP